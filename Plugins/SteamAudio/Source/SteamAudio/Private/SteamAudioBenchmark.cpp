@@ -0,0 +1,898 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioBenchmark.h"
+#include "Algo/BinarySearch.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeExit.h"
+#include "UObject/StrongObjectPtr.h"
+#include "SteamAudioCommon.h"
+#include "SteamAudioManager.h"
+#include "SteamAudioOcclusion.h"
+#include "SteamAudioOcclusionSettings.h"
+#include "SteamAudioReverb.h"
+#include "SteamAudioReverbSettings.h"
+#include "SteamAudioScene.h"
+#include "SteamAudioSerializedObject.h"
+#include "SteamAudioSourceComponent.h"
+#include "SteamAudioSpatialization.h"
+#include "SteamAudioSpatializationSettings.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioTrajectory
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool FSteamAudioTrajectory::Load(const FString& FileName)
+{
+    Listener.Reset();
+    Sources.Reset();
+
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *FileName))
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to read trajectory file: %s"), *FileName);
+        return false;
+    }
+
+    TMap<FString, int32> SourceIndices;
+
+    for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        FString Line = Lines[LineIndex].TrimStartAndEnd();
+        if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+            continue;
+
+        TArray<FString> Fields;
+        Line.ParseIntoArray(Fields, TEXT(","), false);
+        if (Fields.Num() != 5 && Fields.Num() != 8)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Invalid trajectory on line %d of %s."), LineIndex + 1, *FileName);
+            return false;
+        }
+
+        FSteamAudioTrajectoryKey Key;
+        Key.Time = FCString::Atod(*Fields[0]);
+
+        FVector Location(FCString::Atod(*Fields[2]), FCString::Atod(*Fields[3]), FCString::Atod(*Fields[4]));
+        FRotator Rotation = FRotator::ZeroRotator;
+        if (Fields.Num() == 8)
+        {
+            Rotation = FRotator(FCString::Atod(*Fields[5]), FCString::Atod(*Fields[6]), FCString::Atod(*Fields[7]));
+        }
+
+        Key.Transform = FTransform(Rotation, Location);
+
+        FString Id = Fields[1].TrimStartAndEnd();
+        if (Id == TEXT("L"))
+        {
+            Listener.Add(Key);
+        }
+        else
+        {
+            int32* SourceIndex = SourceIndices.Find(Id);
+            if (!SourceIndex)
+            {
+                SourceIndex = &SourceIndices.Add(Id, Sources.AddDefaulted());
+            }
+
+            Sources[*SourceIndex].Add(Key);
+        }
+    }
+
+    auto ByTime = [](const FSteamAudioTrajectoryKey& A, const FSteamAudioTrajectoryKey& B) { return A.Time < B.Time; };
+
+    Listener.StableSort(ByTime);
+    for (TArray<FSteamAudioTrajectoryKey>& Keys : Sources)
+    {
+        Keys.StableSort(ByTime);
+    }
+
+    return true;
+}
+
+double FSteamAudioTrajectory::GetDuration() const
+{
+    double Duration = (Listener.Num() > 0) ? Listener.Last().Time : 0.0;
+    for (const TArray<FSteamAudioTrajectoryKey>& Keys : Sources)
+    {
+        if (Keys.Num() > 0)
+        {
+            Duration = FMath::Max(Duration, Keys.Last().Time);
+        }
+    }
+
+    return Duration;
+}
+
+FTransform FSteamAudioTrajectory::Evaluate(const TArray<FSteamAudioTrajectoryKey>& Keys, double Time)
+{
+    if (Keys.Num() == 0)
+        return FTransform::Identity;
+
+    int32 Next = Algo::UpperBoundBy(Keys, Time, &FSteamAudioTrajectoryKey::Time);
+    if (Next == 0)
+        return Keys[0].Transform;
+    if (Next == Keys.Num())
+        return Keys.Last().Transform;
+
+    const FSteamAudioTrajectoryKey& A = Keys[Next - 1];
+    const FSteamAudioTrajectoryKey& B = Keys[Next];
+
+    float Alpha = (B.Time > A.Time) ? static_cast<float>((Time - A.Time) / (B.Time - A.Time)) : 0.0f;
+
+    FTransform Result;
+    Result.Blend(A.Transform, B.Transform, Alpha);
+    return Result;
+}
+
+FSteamAudioTrajectory FSteamAudioTrajectory::MakeOrbits(int32 NumSources, double Duration)
+{
+    const double KeysPerSecond = 60.0;
+    const int32 NumKeys = FMath::Max(FMath::CeilToInt32(Duration * KeysPerSecond), 1) + 1;
+
+    FSteamAudioTrajectory Trajectory;
+    Trajectory.Listener.Add({0.0, FTransform::Identity});
+
+    for (int32 SourceIndex = 0; SourceIndex < NumSources; ++SourceIndex)
+    {
+        double Radius = 200.0 + 150.0 * (SourceIndex % 16);
+        double Height = 100.0 * ((SourceIndex % 3) - 1);
+        double Speed = 0.25 + 0.05 * (SourceIndex % 7);
+        double Phase = (2.0 * PI * SourceIndex) / NumSources;
+
+        TArray<FSteamAudioTrajectoryKey>& Keys = Trajectory.Sources.AddDefaulted_GetRef();
+        for (int32 KeyIndex = 0; KeyIndex < NumKeys; ++KeyIndex)
+        {
+            double Time = KeyIndex / KeysPerSecond;
+            double Angle = Phase + Speed * Time;
+
+            FSteamAudioTrajectoryKey& Key = Keys.AddDefaulted_GetRef();
+            Key.Time = Time;
+            Key.Transform = FTransform(FVector(Radius * FMath::Cos(Angle), Radius * FMath::Sin(Angle), Height));
+        }
+    }
+
+    return Trajectory;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioTrajectoryRecorder
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool FSteamAudioTrajectoryRecorder::Open(const FString& InFileName)
+{
+    Close();
+
+    Writer = TUniquePtr<FArchive>(IFileManager::Get().CreateFileWriter(*InFileName));
+    if (!Writer)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create trajectory file: %s"), *InFileName);
+        return false;
+    }
+
+    FileName = InFileName;
+    WriteLine(TEXT("# Time,Id,X,Y,Z,Pitch,Yaw,Roll"));
+    return true;
+}
+
+void FSteamAudioTrajectoryRecorder::Close()
+{
+    if (Writer)
+    {
+        Writer->Close();
+        Writer.Reset();
+    }
+}
+
+void FSteamAudioTrajectoryRecorder::RecordListener(double Time, const FTransform& Transform)
+{
+    FVector Location = Transform.GetLocation();
+    FRotator Rotation = Transform.Rotator();
+
+    WriteLine(FString::Printf(TEXT("%.6f,L,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f"), Time,
+        Location.X, Location.Y, Location.Z, Rotation.Pitch, Rotation.Yaw, Rotation.Roll));
+}
+
+void FSteamAudioTrajectoryRecorder::RecordSource(double Time, uint32 SourceId, const FTransform& Transform)
+{
+    FVector Location = Transform.GetLocation();
+    FRotator Rotation = Transform.Rotator();
+
+    WriteLine(FString::Printf(TEXT("%.6f,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f"), Time, SourceId,
+        Location.X, Location.Y, Location.Z, Rotation.Pitch, Rotation.Yaw, Rotation.Roll));
+}
+
+void FSteamAudioTrajectoryRecorder::WriteLine(const FString& Line)
+{
+    if (!Writer)
+        return;
+
+    FTCHARToUTF8 Converted(*(Line + TEXT("\n")));
+    Writer->Serialize(const_cast<ANSICHAR*>(Converted.Get()), Converted.Length());
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioBenchmarkTimings
+// ---------------------------------------------------------------------------------------------------------------------
+
+double FSteamAudioBenchmarkTimings::GetMean() const
+{
+    if (Microseconds.Num() == 0)
+        return 0.0;
+
+    double Sum = 0.0;
+    for (double Value : Microseconds)
+    {
+        Sum += Value;
+    }
+
+    return Sum / Microseconds.Num();
+}
+
+double FSteamAudioBenchmarkTimings::GetPercentile(double Percentile) const
+{
+    if (Microseconds.Num() == 0)
+        return 0.0;
+
+    TArray<double> Sorted = Microseconds;
+    Sorted.Sort();
+
+    // Nearest-rank percentile.
+    int32 Rank = FMath::CeilToInt32((Percentile / 100.0) * Sorted.Num());
+    return Sorted[FMath::Clamp(Rank - 1, 0, Sorted.Num() - 1)];
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioBenchmarkResult
+// ---------------------------------------------------------------------------------------------------------------------
+
+double FSteamAudioBenchmarkResult::GetVoicesPerCore(double Percentile) const
+{
+    double VoiceMicroseconds = Occlusion.GetPercentile(Percentile) + Spatialization.GetPercentile(Percentile) + Reverb.GetPercentile(Percentile);
+    if (VoiceMicroseconds <= 0.0 || SamplingRate <= 0)
+        return 0.0;
+
+    double BufferMicroseconds = (1e6 * FrameSize) / SamplingRate;
+    return BufferMicroseconds / VoiceMicroseconds;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSourceBenchmarkResult
+// ---------------------------------------------------------------------------------------------------------------------
+
+double FSteamAudioSourceBenchmarkResult::GetMicrosecondsPerSource() const
+{
+    return (NumSources > 0) ? Tick.GetMean() / NumSources : 0.0;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Simulates occlusion, transmission, and reflections for each voice against a loaded scene, using a simulator separate
+ * from the manager's, so the manager's sources and scene are left alone.
+ */
+class FBenchmarkSimulation
+{
+public:
+    FBenchmarkSimulation()
+        : Scene(nullptr)
+        , StaticMesh(nullptr)
+        , Simulator(nullptr)
+    {}
+
+    ~FBenchmarkSimulation()
+    {
+        for (IPLSource& Source : Sources)
+        {
+            iplSourceRemove(Source, Simulator);
+            iplSourceRelease(&Source);
+        }
+
+        if (StaticMesh)
+        {
+            iplStaticMeshRemove(StaticMesh, Scene);
+            iplStaticMeshRelease(&StaticMesh);
+        }
+
+        iplSimulatorRelease(&Simulator);
+        iplSceneRelease(&Scene);
+    }
+
+    bool Initialize(USteamAudioSerializedObject* SceneAsset, int32 NumVoices)
+    {
+        FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
+        IPLContext Context = Manager.GetContext();
+
+        if (!Manager.CreateEmptyScene(Scene))
+            return false;
+
+        StaticMesh = LoadStaticMeshFromSerializedObject(SceneAsset, Context, Scene);
+        if (!StaticMesh)
+            return false;
+
+        iplStaticMeshAdd(StaticMesh, Scene);
+        iplSceneCommit(Scene);
+
+        SimulationSettings = Manager.GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_DIRECT | IPL_SIMULATIONFLAGS_REFLECTIONS));
+
+        IPLerror Status = iplSimulatorCreate(Context, &SimulationSettings, &Simulator);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create simulator. [%d]"), Status);
+            return false;
+        }
+
+        iplSimulatorSetScene(Simulator, Scene);
+
+        IPLSourceSettings SourceSettings{};
+        SourceSettings.flags = SimulationSettings.flags;
+
+        Sources.SetNumZeroed(NumVoices);
+        for (IPLSource& Source : Sources)
+        {
+            Status = iplSourceCreate(Simulator, &SourceSettings, &Source);
+            if (Status != IPL_STATUS_SUCCESS)
+            {
+                UE_LOG(LogSteamAudio, Error, TEXT("Unable to create source. [%d]"), Status);
+                return false;
+            }
+
+            iplSourceAdd(Source, Simulator);
+        }
+
+        iplSimulatorCommit(Simulator);
+
+        // Simulate the voices as if they were all using the default Steam Audio Source component settings, with
+        // occlusion, transmission, and reflections turned on.
+        const FSteamAudioSettings& SteamAudioSettings = Manager.GetSteamAudioSettings();
+        GetDefault<USteamAudioSourceComponent>()->GetInputs(SourceInputs, SteamAudioSettings);
+        SourceInputs.flags = SimulationSettings.flags;
+        SourceInputs.directFlags = static_cast<IPLDirectSimulationFlags>(IPL_DIRECTSIMULATIONFLAGS_OCCLUSION | IPL_DIRECTSIMULATIONFLAGS_TRANSMISSION);
+        SourceInputs.baked = IPL_FALSE;
+
+        SharedInputs.numRays = SimulationSettings.maxNumRays;
+        SharedInputs.numBounces = SteamAudioSettings.RealTimeBounces;
+        SharedInputs.duration = SimulationSettings.maxDuration;
+        SharedInputs.order = SimulationSettings.maxOrder;
+        SharedInputs.irradianceMinDistance = SteamAudioSettings.RealTimeIrradianceMinDistance;
+
+        return true;
+    }
+
+    /** Runs direct simulation, and optionally reflections, and copies the results into the given outputs, which
+        must have one entry per voice, as must SourceCoordinates. Like the manager, runs once per listener, each time
+        including only the voices assigned to that listener by VoiceListeners. */
+    void Run(const FSteamAudioListenerArray& Listeners, const TArray<int32>& VoiceListeners, const TArray<IPLCoordinateSpace3>& SourceCoordinates,
+        bool bRunReflections, TArray<FSteamAudioSourceOutputs>& Outputs)
+    {
+        IPLSimulationFlags Flags = bRunReflections ? SimulationSettings.flags : IPL_SIMULATIONFLAGS_DIRECT;
+
+        for (int32 ListenerIndex = 0; ListenerIndex < Listeners.Num(); ++ListenerIndex)
+        {
+            SharedInputs.listener = Listeners[ListenerIndex];
+            iplSimulatorSetSharedInputs(Simulator, Flags, &SharedInputs);
+
+            for (int32 Voice = 0; Voice < Sources.Num(); ++Voice)
+            {
+                IPLSimulationInputs Inputs = SourceInputs;
+                Inputs.source = SourceCoordinates[Voice];
+                if (VoiceListeners[Voice] != ListenerIndex)
+                {
+                    Inputs.flags = static_cast<IPLSimulationFlags>(0);
+                    Inputs.directFlags = static_cast<IPLDirectSimulationFlags>(0);
+                }
+
+                iplSourceSetInputs(Sources[Voice], Flags, &Inputs);
+            }
+
+            iplSimulatorRunDirect(Simulator);
+            if (bRunReflections)
+            {
+                iplSimulatorRunReflections(Simulator);
+            }
+
+            // Copy out the results for the voices included in this run before the next run overwrites them.
+            for (int32 Voice = 0; Voice < Sources.Num(); ++Voice)
+            {
+                if (VoiceListeners[Voice] != ListenerIndex)
+                    continue;
+
+                IPLSimulationOutputs SimulationOutputs{};
+                iplSourceGetOutputs(Sources[Voice], Flags, &SimulationOutputs);
+
+                FSteamAudioSourceOutputs& VoiceOutputs = Outputs[Voice];
+                VoiceOutputs.Occlusion = SimulationOutputs.direct.occlusion;
+                VoiceOutputs.Transmission[0] = SimulationOutputs.direct.transmission[0];
+                VoiceOutputs.Transmission[1] = SimulationOutputs.direct.transmission[1];
+                VoiceOutputs.Transmission[2] = SimulationOutputs.direct.transmission[2];
+
+                if (bRunReflections)
+                {
+                    VoiceOutputs.bHasIndirectOutputs = true;
+                    VoiceOutputs.Reflections = SimulationOutputs.reflections;
+                }
+            }
+        }
+    }
+
+private:
+    IPLScene Scene;
+    IPLStaticMesh StaticMesh;
+    IPLSimulator Simulator;
+    TArray<IPLSource> Sources;
+    IPLSimulationSettings SimulationSettings{};
+    IPLSimulationSharedInputs SharedInputs{};
+    IPLSimulationInputs SourceInputs{};
+};
+
+/** Distance from the primary listener to each of the other listeners, in Unreal units. */
+static constexpr float ListenerSpacing = 1000.0f;
+
+/** Returns the time elapsed since the given cycle count, in microseconds. */
+static double GetMicrosecondsSince(uint64 StartCycles)
+{
+    return FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1e6;
+}
+
+/** Adds the given buffer into another of the same size. */
+static void MixInto(const Audio::FAlignedFloatBuffer& Source, Audio::FAlignedFloatBuffer& Destination)
+{
+    check(Source.Num() == Destination.Num());
+
+    for (int32 i = 0; i < Source.Num(); ++i)
+    {
+        Destination[i] += Source[i];
+    }
+}
+
+bool RunBenchmark(const FSteamAudioBenchmarkSettings& Settings, FSteamAudioBenchmarkResult& OutResult)
+{
+    check(IsInGameThread());
+
+    if (Settings.NumVoices <= 0)
+        return false;
+
+    if (!FSteamAudioModule::BeginOfflineSession())
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to initialize Steam Audio for benchmarking."));
+        return false;
+    }
+
+    ON_SCOPE_EXIT
+    {
+        FSteamAudioModule::EndOfflineSession();
+    };
+
+    FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
+
+    FSteamAudioSettingsSnapshotPtr Snapshot = Manager.GetSettingsSnapshot();
+    check(Snapshot);
+
+    const int32 NumVoices = Settings.NumVoices;
+    const int32 NumListeners = FMath::Clamp(Settings.NumListeners, 1, MaxListeners);
+    const int32 SamplingRate = Snapshot->AudioSettings.samplingRate;
+    const int32 FrameSize = Snapshot->AudioSettings.frameSize;
+    const double BufferSeconds = static_cast<double>(FrameSize) / SamplingRate;
+
+    // Without a recorded trajectory, circle the voices around a stationary listener.
+    FSteamAudioTrajectory Trajectory = Settings.Trajectory;
+    if (Trajectory.Sources.Num() == 0)
+    {
+        double Duration = (Settings.NumBuffers > 0) ? Settings.NumBuffers * BufferSeconds : 10.0;
+        Trajectory = FSteamAudioTrajectory::MakeOrbits(NumVoices, Duration);
+    }
+
+    const int32 NumBuffers = (Settings.NumBuffers > 0) ? Settings.NumBuffers : FMath::Max(FMath::CeilToInt32(Trajectory.GetDuration() / BufferSeconds), 1);
+
+    OutResult = FSteamAudioBenchmarkResult();
+    OutResult.SamplingRate = SamplingRate;
+    OutResult.FrameSize = FrameSize;
+    OutResult.NumVoices = NumVoices;
+    OutResult.NumListeners = NumListeners;
+    OutResult.NumBuffers = NumBuffers;
+
+    TUniquePtr<FBenchmarkSimulation> Simulation;
+    if (Settings.Scene)
+    {
+        Simulation = MakeUnique<FBenchmarkSimulation>();
+        if (!Simulation->Initialize(Settings.Scene, NumVoices))
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to set up simulation for scene %s."), *Settings.Scene->GetPathName());
+            return false;
+        }
+    }
+
+    // Set up the plugins the same way the audio mixer does, with one source per voice.
+    FAudioPluginInitializationParams InitializationParams;
+    InitializationParams.NumSources = NumVoices;
+    InitializationParams.NumOutputChannels = 2;
+    InitializationParams.SampleRate = SamplingRate;
+    InitializationParams.BufferLength = FrameSize;
+    InitializationParams.AudioDevicePtr = nullptr;
+
+    TStrongObjectPtr<USteamAudioOcclusionSettings> OcclusionSettings(NewObject<USteamAudioOcclusionSettings>());
+    OcclusionSettings->bApplyDistanceAttenuation = true;
+    OcclusionSettings->bApplyAirAbsorption = true;
+    OcclusionSettings->bApplyOcclusion = true;
+    OcclusionSettings->bApplyTransmission = true;
+
+    TStrongObjectPtr<USteamAudioSpatializationSettings> SpatializationSettings(NewObject<USteamAudioSpatializationSettings>());
+    SpatializationSettings->bBinaural = true;
+
+    TStrongObjectPtr<USteamAudioReverbSettings> ReverbSettings(NewObject<USteamAudioReverbSettings>());
+    ReverbSettings->bApplyReflections = true;
+
+    FSteamAudioOcclusionPlugin OcclusionPlugin;
+    FSteamAudioSpatializationPlugin SpatializationPlugin;
+    FSteamAudioReverbPlugin ReverbPlugin;
+    FSteamAudioReverbSubmixPlugin ReverbSubmixPlugin;
+
+    OcclusionPlugin.Initialize(InitializationParams);
+    SpatializationPlugin.Initialize(InitializationParams);
+    ReverbPlugin.Initialize(InitializationParams);
+    ReverbSubmixPlugin.SetReverbPlugin(&ReverbPlugin);
+
+    for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+    {
+        FName VoiceName(TEXT("BenchmarkVoice"), Voice);
+        OcclusionPlugin.OnInitSource(Voice, VoiceName, 1, OcclusionSettings.Get());
+        SpatializationPlugin.OnInitSource(Voice, VoiceName, SpatializationSettings.Get());
+        ReverbPlugin.OnInitSource(Voice, VoiceName, 1, ReverbSettings.Get());
+    }
+
+    // Everything the plugins read or write while processing is allocated up front, so allocations made by the
+    // harness don't show up in the timings.
+    TArray<Audio::FAlignedFloatBuffer> VoiceInputs;
+    VoiceInputs.SetNum(NumVoices);
+    for (Audio::FAlignedFloatBuffer& Input : VoiceInputs)
+    {
+        Input.SetNumZeroed(FrameSize);
+    }
+
+    FAudioPluginSourceOutputData OcclusionOutput;
+    OcclusionOutput.AudioBuffer.SetNumZeroed(FrameSize);
+
+    FAudioPluginSourceOutputData SpatializationOutput;
+    SpatializationOutput.AudioBuffer.SetNumZeroed(2 * FrameSize);
+
+    FAudioPluginSourceOutputData ReverbOutput;
+    ReverbOutput.AudioBuffer.SetNumZeroed(2 * FrameSize);
+
+    Audio::FAlignedFloatBuffer SubmixInput;
+    Audio::FAlignedFloatBuffer SubmixOutput;
+    Audio::FAlignedFloatBuffer Mix;
+    SubmixInput.SetNumZeroed(2 * FrameSize);
+    SubmixOutput.SetNumZeroed(2 * FrameSize);
+    Mix.SetNumZeroed(2 * FrameSize);
+
+    TArray<FRandomStream> Noise;
+    for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+    {
+        Noise.Emplace(Settings.Seed + Voice);
+    }
+
+    TArray<FSpatializationParams> SpatializationParams;
+    SpatializationParams.SetNum(NumVoices);
+
+    TArray<FSteamAudioSourceOutputs> VoiceOutputs;
+    VoiceOutputs.SetNum(NumVoices);
+
+    TArray<IPLCoordinateSpace3> VoiceCoordinates;
+    VoiceCoordinates.SetNum(NumVoices);
+
+    TArray<int32> VoiceListeners;
+    VoiceListeners.SetNumZeroed(NumVoices);
+
+    TArray<FTransform, TInlineAllocator<MaxListeners>> ListenerTransforms;
+    FSteamAudioListenerArray ListenerCoordinates;
+
+    // Audio Component ids are offset by one, since 0 means "no Audio Component".
+    TArray<uint64> AudioComponentIds;
+    AudioComponentIds.SetNum(NumVoices);
+    for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+    {
+        AudioComponentIds[Voice] = Voice + 1;
+    }
+
+    int32 NumTimedBuffers = FMath::Max(NumBuffers - Settings.NumWarmupBuffers, 0);
+    OutResult.Occlusion.Microseconds.Reserve(NumTimedBuffers * NumVoices);
+    OutResult.Spatialization.Microseconds.Reserve(NumTimedBuffers * NumVoices);
+    OutResult.Reverb.Microseconds.Reserve(NumTimedBuffers * NumVoices);
+    OutResult.ReverbSubmix.Microseconds.Reserve(NumTimedBuffers);
+    OutResult.Simulation.Microseconds.Reserve(NumTimedBuffers);
+    OutResult.Output.Reserve(static_cast<int64>(NumBuffers) * 2 * FrameSize);
+
+    for (int32 Buffer = 0; Buffer < NumBuffers; ++Buffer)
+    {
+        const bool bTimed = (Buffer >= Settings.NumWarmupBuffers);
+        const double Time = Buffer * BufferSeconds;
+
+        // Move the listeners and voices, standing in for the audio device and the manager's tick. Any listeners after
+        // the first stand in a circle around it, as if other local players were nearby.
+        FTransform PrimaryListenerTransform = FSteamAudioTrajectory::Evaluate(Trajectory.Listener, Time);
+        Manager.SetListenerTransform(PrimaryListenerTransform);
+
+        ListenerTransforms.Reset();
+        ListenerCoordinates.Reset();
+        for (int32 ListenerIndex = 0; ListenerIndex < NumListeners; ++ListenerIndex)
+        {
+            FTransform Transform = PrimaryListenerTransform;
+            if (ListenerIndex > 0)
+            {
+                float Angle = (2.0f * PI * (ListenerIndex - 1)) / (NumListeners - 1);
+                Transform.AddToTranslation(FVector(ListenerSpacing * FMath::Cos(Angle), ListenerSpacing * FMath::Sin(Angle), 0.0f));
+            }
+
+            ListenerTransforms.Add(Transform);
+            ListenerCoordinates.Add(ConvertCoordinateSpace(Transform));
+        }
+
+        for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+        {
+            FTransform SourceTransform = FSteamAudioTrajectory::Evaluate(Trajectory.Sources[Voice % Trajectory.Sources.Num()], Time);
+
+            // Render each voice for the closest listener, as the manager does.
+            int32 ClosestListener = 0;
+            for (int32 ListenerIndex = 1; ListenerIndex < NumListeners; ++ListenerIndex)
+            {
+                if (FVector::DistSquared(ListenerTransforms[ListenerIndex].GetLocation(), SourceTransform.GetLocation()) <
+                    FVector::DistSquared(ListenerTransforms[ClosestListener].GetLocation(), SourceTransform.GetLocation()))
+                {
+                    ClosestListener = ListenerIndex;
+                }
+            }
+
+            const FTransform& ListenerTransform = ListenerTransforms[ClosestListener];
+            VoiceListeners[Voice] = ClosestListener;
+
+            FSpatializationParams& Params = SpatializationParams[Voice];
+            Params.ListenerPosition = ListenerTransform.GetLocation();
+            Params.ListenerOrientation = ListenerTransform.GetRotation();
+            Params.EmitterWorldPosition = SourceTransform.GetLocation();
+            Params.EmitterWorldRotation = SourceTransform.GetRotation();
+            Params.EmitterPosition = ListenerTransform.InverseTransformPosition(SourceTransform.GetLocation());
+            Params.Distance = static_cast<float>(FVector::Dist(Params.ListenerPosition, Params.EmitterWorldPosition));
+
+            VoiceCoordinates[Voice] = ConvertCoordinateSpace(SourceTransform);
+            VoiceOutputs[Voice].bHasListenerCoordinates = true;
+            VoiceOutputs[Voice].ListenerCoordinates = ListenerCoordinates[ClosestListener];
+        }
+
+        if (Simulation)
+        {
+            bool bRunReflections = (Buffer % FMath::Max(Settings.ReflectionsInterval, 1)) == 0;
+
+            uint64 StartCycles = FPlatformTime::Cycles64();
+            Simulation->Run(ListenerCoordinates, VoiceListeners, VoiceCoordinates, bRunReflections, VoiceOutputs);
+            if (bTimed)
+            {
+                OutResult.Simulation.Microseconds.Add(GetMicrosecondsSince(StartCycles));
+            }
+        }
+
+        Manager.PublishOutputsForVoices(AudioComponentIds, VoiceOutputs);
+
+        FMemory::Memzero(Mix.GetData(), Mix.Num() * sizeof(float));
+        FMemory::Memzero(SubmixInput.GetData(), SubmixInput.Num() * sizeof(float));
+
+        for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+        {
+            Audio::FAlignedFloatBuffer& Input = VoiceInputs[Voice];
+            for (int32 i = 0; i < FrameSize; ++i)
+            {
+                Input[i] = 0.25f * Noise[Voice].FRandRange(-1.0f, 1.0f);
+            }
+
+            FAudioPluginSourceInputData InputData;
+            InputData.SourceId = Voice;
+            InputData.AudioBuffer = &Input;
+            InputData.NumChannels = 1;
+            InputData.AudioComponentId = AudioComponentIds[Voice];
+            InputData.SpatializationParams = &SpatializationParams[Voice];
+
+            // The reverb plugin is fed the voice's dry signal, in parallel with occlusion followed by spatialization.
+            if (Settings.bReverb)
+            {
+                uint64 StartCycles = FPlatformTime::Cycles64();
+                ReverbPlugin.ProcessSourceAudio(InputData, ReverbOutput);
+                if (bTimed)
+                {
+                    OutResult.Reverb.Microseconds.Add(GetMicrosecondsSince(StartCycles));
+                }
+
+                MixInto(ReverbOutput.AudioBuffer, SubmixInput);
+            }
+
+            if (Settings.bOcclusion)
+            {
+                uint64 StartCycles = FPlatformTime::Cycles64();
+                OcclusionPlugin.ProcessAudio(InputData, OcclusionOutput);
+                if (bTimed)
+                {
+                    OutResult.Occlusion.Microseconds.Add(GetMicrosecondsSince(StartCycles));
+                }
+
+                InputData.AudioBuffer = &OcclusionOutput.AudioBuffer;
+            }
+
+            if (Settings.bSpatialization)
+            {
+                uint64 StartCycles = FPlatformTime::Cycles64();
+                SpatializationPlugin.ProcessAudio(InputData, SpatializationOutput);
+                if (bTimed)
+                {
+                    OutResult.Spatialization.Microseconds.Add(GetMicrosecondsSince(StartCycles));
+                }
+
+                MixInto(SpatializationOutput.AudioBuffer, Mix);
+            }
+        }
+
+        if (Settings.bReverb)
+        {
+            FSoundEffectSubmixInputData SubmixInputData;
+            SubmixInputData.NumFrames = FrameSize;
+            SubmixInputData.NumChannels = 2;
+            SubmixInputData.NumDeviceChannels = 2;
+            SubmixInputData.AudioBuffer = &SubmixInput;
+
+            FSoundEffectSubmixOutputData SubmixOutputData;
+            SubmixOutputData.NumChannels = 2;
+            SubmixOutputData.AudioBuffer = &SubmixOutput;
+
+            uint64 StartCycles = FPlatformTime::Cycles64();
+            ReverbSubmixPlugin.OnProcessAudio(SubmixInputData, SubmixOutputData);
+            if (bTimed)
+            {
+                OutResult.ReverbSubmix.Microseconds.Add(GetMicrosecondsSince(StartCycles));
+            }
+
+            MixInto(SubmixOutput, Mix);
+        }
+
+        OutResult.Output.Append(Mix.GetData(), Mix.Num());
+    }
+
+    for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+    {
+        OcclusionPlugin.OnReleaseSource(Voice);
+        SpatializationPlugin.OnReleaseSource(Voice);
+        ReverbPlugin.OnReleaseSource(Voice);
+    }
+
+    // Don't leave the harness's outputs and listener behind for whatever plays next.
+    Manager.PublishOutputsForVoices(TArrayView<const uint64>(), TArrayView<const FSteamAudioSourceOutputs>());
+    Manager.SetListenerTransform(FTransform::Identity);
+
+    return true;
+}
+
+bool RunSourceBenchmark(UWorld* World, int32 NumSources, int32 NumTicks, FSteamAudioSourceBenchmarkResult& OutResult)
+{
+    check(IsInGameThread());
+
+    const float SpawnRadius = 5000.0f;
+    const float Speed = 300.0f;
+    const float DeltaTime = 1.0f / 60.0f;
+
+    FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
+    if (!World || !World->AreActorsInitialized() || !Manager.IsInitialized() || NumSources <= 0 || NumTicks <= 0)
+        return false;
+
+    OutResult = FSteamAudioSourceBenchmarkResult();
+    OutResult.NumTicks = NumTicks;
+
+    FRandomStream Random(0);
+    FVector Center = ConvertVectorInverse(Manager.GetListenerCoordinates().origin);
+
+    TArray<AActor*> Actors;
+    TArray<FVector> Velocities;
+
+    ON_SCOPE_EXIT
+    {
+        for (AActor* Actor : Actors)
+        {
+            Actor->Destroy();
+        }
+    };
+
+    for (int32 i = 0; i < NumSources; ++i)
+    {
+        AActor* Actor = World->SpawnActor<AActor>();
+        if (!Actor)
+            continue;
+
+        USceneComponent* Root = NewObject<USceneComponent>(Actor);
+        Actor->SetRootComponent(Root);
+        Root->RegisterComponent();
+        Root->SetWorldLocation(Center + Random.GetUnitVector() * Random.FRandRange(0.0f, SpawnRadius));
+
+        USteamAudioSourceComponent* Source = NewObject<USteamAudioSourceComponent>(Actor);
+        Source->bSimulateOcclusion = true;
+        Source->RegisterComponent();
+
+        // In a world that is playing, registering the component begins play on it. Otherwise (e.g., in a commandlet),
+        // begin play on the actor here. Either way, this adds the source to the manager.
+        if (!Actor->HasActorBegunPlay())
+        {
+            Actor->DispatchBeginPlay();
+        }
+
+        Actors.Add(Actor);
+        Velocities.Add(Random.GetUnitVector() * Speed);
+    }
+
+    OutResult.NumSources = Actors.Num();
+
+    // The first tick commits the simulator with all the new sources, which isn't what we want to measure.
+    Manager.Tick(DeltaTime);
+
+    OutResult.Tick.Microseconds.Reserve(NumTicks);
+
+    for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+    {
+        for (int32 i = 0; i < Actors.Num(); ++i)
+        {
+            Actors[i]->AddActorWorldOffset(Velocities[i] * DeltaTime);
+        }
+
+        uint64 StartCycles = FPlatformTime::Cycles64();
+        Manager.Tick(DeltaTime);
+        OutResult.Tick.Microseconds.Add(GetMicrosecondsSince(StartCycles));
+    }
+
+    return true;
+}
+
+int64 CompareBenchmarkOutputs(const TArray<float>& Output, const TArray<float>& Baseline, float Tolerance, float& OutMaxError)
+{
+    OutMaxError = 0.0f;
+
+    // Missing or extra samples all count as mismatches.
+    int64 NumMismatches = FMath::Abs(Output.Num() - Baseline.Num());
+    int32 NumSamples = FMath::Min(Output.Num(), Baseline.Num());
+
+    for (int32 i = 0; i < NumSamples; ++i)
+    {
+        float Error = FMath::Abs(Output[i] - Baseline[i]);
+        OutMaxError = FMath::Max(OutMaxError, Error);
+
+        // With no tolerance, compare bits, so that e.g. -0 and 0 or differing NaNs are caught too.
+        bool bMatches = (Tolerance > 0.0f) ? (Error <= Tolerance) : (FMemory::Memcmp(&Output[i], &Baseline[i], sizeof(float)) == 0);
+        if (!bMatches)
+        {
+            NumMismatches++;
+        }
+    }
+
+    return NumMismatches;
+}
+
+}
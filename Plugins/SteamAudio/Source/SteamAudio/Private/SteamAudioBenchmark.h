@@ -0,0 +1,230 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioModule.h"
+
+class USteamAudioSerializedObject;
+class UWorld;
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioTrajectory
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * The pose of the listener or a source at one point in time.
+ */
+struct FSteamAudioTrajectoryKey
+{
+    /** Time since recording started, in seconds. */
+    double Time = 0.0;
+
+    /** World-space position and orientation. */
+    FTransform Transform;
+};
+
+/**
+ * Listener and source poses recorded during gameplay, which can be replayed through the audio plugins offline.
+ *
+ * Trajectories are stored as text, with one pose per line:
+ *
+ *   Time,Id,X,Y,Z,Pitch,Yaw,Roll
+ *
+ * Time is in seconds, Id is L for the listener or any number identifying a source, position is in Unreal units, and
+ * rotation is in degrees. Empty lines and lines starting with # are ignored.
+ */
+struct STEAMAUDIO_API FSteamAudioTrajectory
+{
+    /** Listener poses, in order of time. */
+    TArray<FSteamAudioTrajectoryKey> Listener;
+
+    /** Poses for each source, in order of time. Sources are numbered in the order they first appear in the file. */
+    TArray<TArray<FSteamAudioTrajectoryKey>> Sources;
+
+    /** Loads a trajectory from a file. Returns false if the file could not be read or contains invalid lines. */
+    bool Load(const FString& FileName);
+
+    /** Returns the time of the last pose. */
+    double GetDuration() const;
+
+    /** Returns the pose at the given time, interpolating between the nearest keys. */
+    static FTransform Evaluate(const TArray<FSteamAudioTrajectoryKey>& Keys, double Time);
+
+    /** Returns a trajectory in which the listener stands still at the origin and each source circles it at a
+        different distance, height, and speed. Used when no recorded trajectory is available. */
+    static FSteamAudioTrajectory MakeOrbits(int32 NumSources, double Duration);
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioTrajectoryRecorder
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Writes listener and source poses to a trajectory file.
+ */
+class STEAMAUDIO_API FSteamAudioTrajectoryRecorder
+{
+public:
+    /** Creates the file, replacing it if it exists. Returns false if it could not be created. */
+    bool Open(const FString& FileName);
+
+    /** Flushes and closes the file. */
+    void Close();
+
+    /** Returns the name of the file being written. */
+    const FString& GetFileName() const { return FileName; }
+
+    /** Writes the listener's pose at the given time. */
+    void RecordListener(double Time, const FTransform& Transform);
+
+    /** Writes the pose of the source with the given id at the given time. */
+    void RecordSource(double Time, uint32 SourceId, const FTransform& Transform);
+
+private:
+    /** Writes one line to the file. */
+    void WriteLine(const FString& Line);
+
+    /** The file being written. */
+    TUniquePtr<FArchive> Writer;
+
+    /** Name of the file being written. */
+    FString FileName;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Configures a run of the audio plugins over a trajectory.
+ */
+struct FSteamAudioBenchmarkSettings
+{
+    /** Listener and source poses to replay. Voices are assigned to sources in order, wrapping around if there are
+        more voices than sources. */
+    FSteamAudioTrajectory Trajectory;
+
+    /** Static geometry (as exported for a level) to simulate occlusion, transmission, and reflections against. If
+        null, nothing is simulated, and the plugins are given default (unoccluded, dry) outputs. */
+    USteamAudioSerializedObject* Scene = nullptr;
+
+    /** Number of voices to play at once. */
+    int32 NumVoices = 32;
+
+    /** Number of listeners, as with local split-screen, up to MaxListeners. The first follows the trajectory's
+        listener, and the others stand in a circle around it. Each voice is simulated and rendered for the closest
+        listener. */
+    int32 NumListeners = 1;
+
+    /** Number of audio buffers to process. If 0, covers the whole trajectory. */
+    int32 NumBuffers = 0;
+
+    /** Number of buffers processed at the start without recording timings, so one-time allocations and cache misses
+        don't skew the results. Their output is still recorded. */
+    int32 NumWarmupBuffers = 8;
+
+    /** Reflections are simulated once every this many buffers. Direct simulation runs every buffer. */
+    int32 ReflectionsInterval = 4;
+
+    /** Seed used to generate the noise played by each voice. */
+    int32 Seed = 0;
+
+    /** Whether to run each plugin. */
+    bool bOcclusion = true;
+    bool bSpatialization = true;
+    bool bReverb = true;
+};
+
+/**
+ * Time taken by each call to one of the plugin callbacks.
+ */
+struct STEAMAUDIO_API FSteamAudioBenchmarkTimings
+{
+    /** Time taken by each call, in microseconds. */
+    TArray<double> Microseconds;
+
+    /** Returns the mean time per call, in microseconds. */
+    double GetMean() const;
+
+    /** Returns the given percentile (0-100) of the time per call, in microseconds. */
+    double GetPercentile(double Percentile) const;
+};
+
+/**
+ * Timings and output audio from a run of the audio plugins.
+ */
+struct STEAMAUDIO_API FSteamAudioBenchmarkResult
+{
+    int32 SamplingRate = 0;
+    int32 FrameSize = 0;
+    int32 NumVoices = 0;
+    int32 NumListeners = 0;
+    int32 NumBuffers = 0;
+
+    /** Per-voice callbacks. */
+    FSteamAudioBenchmarkTimings Occlusion;
+    FSteamAudioBenchmarkTimings Spatialization;
+    FSteamAudioBenchmarkTimings Reverb;
+
+    /** Per-buffer callbacks. */
+    FSteamAudioBenchmarkTimings ReverbSubmix;
+    FSteamAudioBenchmarkTimings Simulation;
+
+    /** Interleaved stereo mix of every voice and the reverb submix, for the whole run. */
+    TArray<float> Output;
+
+    /** Returns the number of voices a single core could process within the duration of one buffer, based on the sum
+        of the given percentile of each per-voice callback's timings. */
+    double GetVoicesPerCore(double Percentile) const;
+};
+
+/** Plays noise through the occlusion, spatialization, and reverb plugins for each voice, moving the listeners and
+    voices along the given trajectory, with no audio device. Initializes Steam Audio for the duration of the run, so
+    must be called from the game thread while nothing else is playing. Returns false if the plugins could not be set
+    up. */
+STEAMAUDIO_API bool RunBenchmark(const FSteamAudioBenchmarkSettings& Settings, FSteamAudioBenchmarkResult& OutResult);
+
+/**
+ * Game thread time taken by the Steam Audio Manager's tick while many Steam Audio Sources move around.
+ */
+struct STEAMAUDIO_API FSteamAudioSourceBenchmarkResult
+{
+    int32 NumSources = 0;
+    int32 NumTicks = 0;
+
+    /** Time taken by each tick. */
+    FSteamAudioBenchmarkTimings Tick;
+
+    /** Returns the mean time per tick spent on each source, in microseconds. */
+    double GetMicrosecondsPerSource() const;
+};
+
+/** Spawns actors with Steam Audio Source components (with occlusion on) around the listener in the given world, moves
+    them for a number of ticks of the Steam Audio Manager, and times each tick. The actors are destroyed afterwards.
+    Steam Audio must be initialized, and the world's actors must be initialized (the world need not be playing). Must
+    be called from the game thread. */
+STEAMAUDIO_API bool RunSourceBenchmark(UWorld* World, int32 NumSources, int32 NumTicks, FSteamAudioSourceBenchmarkResult& OutResult);
+
+/** Compares output audio against a baseline. Samples match if they differ by no more than Tolerance; a Tolerance of 0
+    requires bit-exact output. Returns the number of mismatched samples, and the largest difference found. */
+STEAMAUDIO_API int64 CompareBenchmarkOutputs(const TArray<float>& Output, const TArray<float>& Baseline, float Tolerance, float& OutMaxError);
+
+}
@@ -15,6 +15,12 @@
 //
 
 #include "SteamAudioCommon.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+DEFINE_STAT(STAT_SteamAudioVoiceSlabMisses);
 
 namespace SteamAudio {
 
@@ -39,6 +45,11 @@ float ConvertSteamAudioDistanceToUnreal(float Distance)
     return Distance / SCALEFACTOR;
 }
 
+float ConvertUnrealDistanceToSteamAudio(float Distance)
+{
+    return Distance * SCALEFACTOR;
+}
+
 IPLVector3 ConvertVector(const FVector& UnrealCoords, bool bScale /* = true */)
 {
     IPLVector3 SteamAudioCoords;
@@ -117,6 +128,17 @@ IPLMatrix4x4 ConvertTransform(const FTransform& UnrealTransform, bool bRowMajor
     return Matrix;
 }
 
+IPLCoordinateSpace3 ConvertCoordinateSpace(const FTransform& UnrealTransform)
+{
+    IPLCoordinateSpace3 CoordinateSpace{};
+    CoordinateSpace.origin = ConvertVector(UnrealTransform.GetLocation());
+    CoordinateSpace.ahead = ConvertVector(UnrealTransform.GetUnitAxis(EAxis::X), false);
+    CoordinateSpace.up = ConvertVector(UnrealTransform.GetUnitAxis(EAxis::Z), false);
+    CoordinateSpace.right = ConvertVector(UnrealTransform.GetUnitAxis(EAxis::Y), false);
+
+    return CoordinateSpace;
+}
+
 int CalcIRSizeForDuration(float Duration, int SamplingRate)
 {
     check(Duration > 0.0f);
@@ -160,6 +182,17 @@ IPLSpeakerLayout GetSpeakerLayoutForNumChannels(int NumChannels)
     return SpeakerLayout;
 }
 
+int GetSupportedLayoutIndex(int NumChannels)
+{
+    for (int i = 0; i < NumSupportedLayouts; ++i)
+    {
+        if (SupportedNumChannels[i] == NumChannels)
+            return i;
+    }
+
+    return INDEX_NONE;
+}
+
 int GetNumThreadsForCPUCoresPercentage(float Percentage)
 {
     check(0.0f <= Percentage && Percentage <= 100.0f);
@@ -168,4 +201,136 @@ int GetNumThreadsForCPUCoresPercentage(float Percentage)
     return FPlatformMath::Max(0, FPlatformMath::Min(FPlatformMath::CeilToInt((Percentage / 100.0f) * NumLogicalCores), NumLogicalCores));
 }
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FScopedNoAllocation
+// ---------------------------------------------------------------------------------------------------------------------
+
+#if !UE_BUILD_SHIPPING
+/**
+ * Wraps the engine's allocator, and checks every allocation made through FMemory against FScopedNoAllocation before
+ * passing it on.
+ */
+class FNoAllocationMallocProxy : public FMalloc
+{
+public:
+    explicit FNoAllocationMallocProxy(FMalloc* InMalloc)
+        : UsedMalloc(InMalloc)
+    {}
+
+    virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+    {
+        FScopedNoAllocation::CheckAllocation(Count, TEXT("FMemory"));
+        return UsedMalloc->Malloc(Count, Alignment);
+    }
+
+    virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+    {
+        FScopedNoAllocation::CheckAllocation(Count, TEXT("FMemory"));
+        return UsedMalloc->TryMalloc(Count, Alignment);
+    }
+
+    virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+    {
+        // Reallocating to zero bytes frees the original.
+        if (Count > 0)
+        {
+            FScopedNoAllocation::CheckAllocation(Count, TEXT("FMemory"));
+        }
+
+        return UsedMalloc->Realloc(Original, Count, Alignment);
+    }
+
+    virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+    {
+        if (Count > 0)
+        {
+            FScopedNoAllocation::CheckAllocation(Count, TEXT("FMemory"));
+        }
+
+        return UsedMalloc->TryRealloc(Original, Count, Alignment);
+    }
+
+    virtual void Free(void* Original) override { UsedMalloc->Free(Original); }
+    virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return UsedMalloc->QuantizeSize(Count, Alignment); }
+    virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return UsedMalloc->GetAllocationSize(Original, SizeOut); }
+    virtual void Trim(bool bTrimThreadCaches) override { UsedMalloc->Trim(bTrimThreadCaches); }
+    virtual void SetupTLSCachesOnCurrentThread() override { UsedMalloc->SetupTLSCachesOnCurrentThread(); }
+    virtual void ClearAndDisableTLSCachesOnCurrentThread() override { UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+    virtual void InitializeStatsMetadata() override { UsedMalloc->InitializeStatsMetadata(); }
+    virtual void UpdateStats() override { UsedMalloc->UpdateStats(); }
+    virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { UsedMalloc->GetAllocatorStats(OutStats); }
+    virtual void DumpAllocatorStats(FOutputDevice& Ar) override { UsedMalloc->DumpAllocatorStats(Ar); }
+    virtual bool IsInternallyThreadSafe() const override { return UsedMalloc->IsInternallyThreadSafe(); }
+    virtual bool ValidateHeap() override { return UsedMalloc->ValidateHeap(); }
+    virtual const TCHAR* GetDescriptiveName() override { return UsedMalloc->GetDescriptiveName(); }
+
+private:
+    FMalloc* UsedMalloc;
+};
+
+static bool GCheckProcessAllocations = false;
+static FAutoConsoleVariableRef CVarCheckProcessAllocations(
+    TEXT("SteamAudio.CheckProcessAllocations"),
+    GCheckProcessAllocations,
+    TEXT("If true, any heap allocation made while processing audio fails an assertion. Allocations made through ")
+    TEXT("FMemory are only checked if the process was started with -SteamAudioCheckAllocations."));
+
+/** Number of FScopedNoAllocation instances in scope on the current thread. */
+static thread_local int32 GNoAllocationScopeDepth = 0;
+
+/** True while a failed check is being reported on the current thread, since reporting it allocates. */
+static thread_local bool GReportingAllocation = false;
+#endif
+
+void FScopedNoAllocation::InstallAllocatorProxy()
+{
+#if !UE_BUILD_SHIPPING
+    static bool bProxyInstalled = false;
+    if (bProxyInstalled || !GMalloc || !FParse::Param(FCommandLine::Get(), TEXT("SteamAudioCheckAllocations")))
+        return;
+
+    // The proxy is never removed, since memory allocated through it may be freed at any time. While checking is
+    // turned off it just passes everything through.
+    GMalloc = new FNoAllocationMallocProxy(GMalloc);
+    GCheckProcessAllocations = true;
+    bProxyInstalled = true;
+#endif
+}
+
+FScopedNoAllocation::FScopedNoAllocation()
+{
+#if !UE_BUILD_SHIPPING
+    ++GNoAllocationScopeDepth;
+#endif
+}
+
+FScopedNoAllocation::~FScopedNoAllocation()
+{
+#if !UE_BUILD_SHIPPING
+    --GNoAllocationScopeDepth;
+#endif
+}
+
+bool FScopedNoAllocation::IsActive()
+{
+#if !UE_BUILD_SHIPPING
+    return GCheckProcessAllocations && GNoAllocationScopeDepth > 0;
+#else
+    return false;
+#endif
+}
+
+void FScopedNoAllocation::CheckAllocation(uint64 Size, const TCHAR* Allocator)
+{
+#if !UE_BUILD_SHIPPING
+    if (!IsActive() || GReportingAllocation)
+        return;
+
+    GReportingAllocation = true;
+    checkf(false, TEXT("%s allocated %llu bytes while processing audio."), Allocator, Size);
+    GReportingAllocation = false;
+#endif
+}
+
 }
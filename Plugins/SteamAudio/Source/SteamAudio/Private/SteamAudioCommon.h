@@ -18,6 +18,12 @@
 
 #include "SteamAudioModule.h"
 #include "Async/Async.h"
+#include "Misc/SecureHash.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("Steam Audio"), STATGROUP_SteamAudio, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Voice Slab Misses"), STAT_SteamAudioVoiceSlabMisses, STATGROUP_SteamAudio, );
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Helper Functions
@@ -31,6 +37,9 @@ float STEAMAUDIO_API ConvertDbToLinear(float dBGain);
 /** Converts a distance from Steam Audio units to Unreal units. */
 float STEAMAUDIO_API ConvertSteamAudioDistanceToUnreal(float Distance);
 
+/** Converts a distance from Unreal units to Steam Audio units. */
+float STEAMAUDIO_API ConvertUnrealDistanceToSteamAudio(float Distance);
+
 /** Converts a 3D vector from Unreal's coordinate system to Steam Audio's coordinate system. */
 IPLVector3 STEAMAUDIO_API ConvertVector(const FVector& UnrealCoords, bool bScale = true);
 
@@ -40,6 +49,9 @@ FVector STEAMAUDIO_API ConvertVectorInverse(const IPLVector3& SteamAudioCoords,
 /** Converts a transform from Unreal's coordinate system to a 4x4 matrix in Steam Audio's coordinate system. */
 IPLMatrix4x4 STEAMAUDIO_API ConvertTransform(const FTransform& UnrealTransform, bool bRowMajor = true, bool bScale = true);
 
+/** Converts a transform from Unreal's coordinate system to a coordinate space in Steam Audio's coordinate system. */
+IPLCoordinateSpace3 STEAMAUDIO_API ConvertCoordinateSpace(const FTransform& UnrealTransform);
+
 /** Returns the IR size (in samples) corresponding to the given duration (in seconds). */
 int STEAMAUDIO_API CalcIRSizeForDuration(float Duration, int SamplingRate);
 
@@ -49,6 +61,14 @@ int STEAMAUDIO_API CalcNumChannelsForAmbisonicOrder(int Order);
 /** Returns the speaker layout corresponding to the given number of channels. */
 IPLSpeakerLayout STEAMAUDIO_API GetSpeakerLayoutForNumChannels(int NumChannels);
 
+/** Channel counts of the speaker layouts that GetSpeakerLayoutForNumChannels supports. The audio plugins prepare
+    effects and buffers for each of these up front, so a voice with any of them can start without allocating. */
+constexpr int SupportedNumChannels[] = { 1, 2, 4, 6, 8 };
+constexpr int NumSupportedLayouts = UE_ARRAY_COUNT(SupportedNumChannels);
+
+/** Returns the index into SupportedNumChannels of the given number of channels, or INDEX_NONE if it isn't there. */
+int STEAMAUDIO_API GetSupportedLayoutIndex(int NumChannels);
+
 /** Returns the number of threads corresponding to the given CPU cores percentage. */
 int STEAMAUDIO_API GetNumThreadsForCPUCoresPercentage(float Percentage);
 
@@ -84,4 +104,211 @@ inline void RunInGameThread(TUniqueFunction<void()> Function)
     Future.Wait();
 }
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+// TSteamAudioSlabs
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Base for a slab: the effects and buffers that an audio plugin allocates for every voice up front, for a given set of
+ * settings.
+ */
+struct FSteamAudioSlab
+{
+    virtual ~FSteamAudioSlab() {}
+
+    /** Number of voices rendering with this slab. */
+    std::atomic<int32> NumPins{ 0 };
+};
+
+/**
+ * Slabs built on the game thread and rendered with on the audio thread. The game thread publishes a new slab whenever
+ * the settings change. A voice pins the published slab when it starts and unpins it when it stops, so voices that are
+ * already playing keep the slab they started with. Slabs are only ever freed on the game thread, once they are no
+ * longer published and no voice has them pinned, so the audio thread never allocates or frees one.
+ */
+template <typename SlabType>
+class TSteamAudioSlabs
+{
+public:
+    ~TSteamAudioSlabs()
+    {
+        Reset();
+    }
+
+    /** Pins and returns the published slab, or returns nullptr if none has been published. Lock-free. */
+    SlabType* Pin()
+    {
+        // Let the game thread know we're between reading the pointer and pinning the slab, so it doesn't free the
+        // slab in the meantime.
+        NumPinning.fetch_add(1);
+        SlabType* Slab = Published.load();
+        if (Slab)
+        {
+            Slab->NumPins.fetch_add(1);
+        }
+        NumPinning.fetch_sub(1);
+
+        return Slab;
+    }
+
+    /** Unpins a slab returned by Pin. Lock-free. */
+    void Unpin(SlabType* Slab)
+    {
+        if (Slab)
+        {
+            Slab->NumPins.fetch_sub(1);
+        }
+    }
+
+    /** Returns the published slab without pinning it. Only safe to dereference on the game thread. */
+    SlabType* GetPublished() const
+    {
+        return Published.load(std::memory_order_acquire);
+    }
+
+    /** Makes the given slab the one returned by Pin, and frees old slabs that are no longer pinned. Game thread
+        only. */
+    void Publish(TUniquePtr<SlabType>&& Slab)
+    {
+        check(IsInGameThread());
+
+        Published.store(Slab.Get());
+        Slabs.Add(MoveTemp(Slab));
+
+        CollectGarbage();
+    }
+
+    /** Frees slabs that are no longer published or pinned. Game thread only. */
+    void CollectGarbage()
+    {
+        // A voice in the middle of pinning may have read the pointer to an old slab, so try again later.
+        if (NumPinning.load() != 0)
+            return;
+
+        SlabType* Current = Published.load();
+        Slabs.RemoveAll([Current](const TUniquePtr<SlabType>& Slab)
+        {
+            return Slab.Get() != Current && Slab->NumPins.load() == 0;
+        });
+    }
+
+    /** Frees every slab. Only call once no voice can be using them, e.g. when the owning plugin is destroyed. */
+    void Reset()
+    {
+        Published.store(nullptr);
+        Slabs.Reset();
+    }
+
+private:
+    /** The slab that voices pin when they start. */
+    std::atomic<SlabType*> Published{ nullptr };
+
+    /** Number of voices in the middle of pinning a slab. */
+    std::atomic<int32> NumPinning{ 0 };
+
+    /** Every slab that hasn't been freed yet, including the published one. Game thread only. */
+    TArray<TUniquePtr<SlabType>> Slabs;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FContentHash
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Builds a deterministic hash of the inputs used to create some exported or baked data, so that the work can be
+ * skipped when the hash of the current inputs matches the hash stored with the existing data.
+ */
+class FContentHash
+{
+public:
+    /** Adds raw bytes to the hash. */
+    void Update(const void* Data, int64 Size)
+    {
+        Hash.Update(static_cast<const uint8*>(Data), static_cast<uint64>(Size));
+    }
+
+    /** Adds a value to the hash. The value must not contain any padding. */
+    template <typename T>
+    void Update(const T& Value)
+    {
+        static_assert(TIsTriviallyCopyConstructible<T>::Value, "Only plain data can be hashed.");
+        Update(&Value, sizeof(T));
+    }
+
+    /** Adds the contents of an array to the hash. The elements must not contain any padding. */
+    template <typename T>
+    void Update(const TArray<T>& Values)
+    {
+        static_assert(TIsTriviallyCopyConstructible<T>::Value, "Only plain data can be hashed.");
+        Update(Values.Num());
+        Update(Values.GetData(), Values.Num() * sizeof(T));
+    }
+
+    void Update(const FString& Value)
+    {
+        Update(Value.Len());
+        Update(*Value, Value.Len() * sizeof(TCHAR));
+    }
+
+    void Update(const FVector& Value)
+    {
+        Update(Value.X);
+        Update(Value.Y);
+        Update(Value.Z);
+    }
+
+    void Update(const FTransform& Value)
+    {
+        Update(Value.GetLocation());
+        Update(Value.GetRotation().Euler());
+        Update(Value.GetScale3D());
+    }
+
+    /** Returns the hash as a hex string. Must only be called once. */
+    FString Finalize()
+    {
+        uint8 Digest[FSHA1::DigestSize];
+        Hash.Final();
+        Hash.GetHash(Digest);
+
+        return BytesToHex(Digest, FSHA1::DigestSize);
+    }
+
+private:
+    FSHA1 Hash;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FScopedNoAllocation
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Marks the current thread as being inside an audio processing callback. While an instance is in scope, and the
+ * SteamAudio.CheckProcessAllocations console variable is set, any heap allocation made on this thread by Steam Audio
+ * fails an assertion. Allocations made through FMemory are checked too if the process was started with
+ * -SteamAudioCheckAllocations. Does nothing in shipping builds.
+ */
+class FScopedNoAllocation
+{
+public:
+    FScopedNoAllocation();
+
+    ~FScopedNoAllocation();
+
+    /** Returns true if heap allocations on the current thread should fail an assertion. */
+    static bool IsActive();
+
+    /** Fails an assertion if heap allocations on the current thread should fail one. Allocator names whatever made
+        the allocation, for the assertion message. */
+    static void CheckAllocation(uint64 Size, const TCHAR* Allocator);
+
+    /** If -SteamAudioCheckAllocations is on the command line, wraps GMalloc so that allocations made through FMemory
+        are checked, and turns checking on. Must be called before any audio threads exist, since GMalloc can't
+        safely be replaced while they allocate. */
+    static void InstallAllocatorProxy();
+};
+
 }
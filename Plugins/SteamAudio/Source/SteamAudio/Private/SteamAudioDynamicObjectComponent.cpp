@@ -32,6 +32,7 @@ USteamAudioDynamicObjectComponent::USteamAudioDynamicObjectComponent()
     : Asset()
     , Scene(nullptr)
     , InstancedMesh(nullptr)
+    , PivotOffset(FVector::ZeroVector)
 {
     PrimaryComponentTick.bCanEverTick = false;
 }
@@ -47,7 +48,8 @@ void USteamAudioDynamicObjectComponent::BeginPlay()
 
     GetOwner()->GetRootComponent()->TransformUpdated.AddUObject(this, &USteamAudioDynamicObjectComponent::OnTransformUpdated);
 
-    SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+    const FTransform& RootComponentTransform = GetOwner()->GetRootComponent()->GetComponentTransform();
+    PivotOffset = RootComponentTransform.InverseTransformPosition(GetOwner()->GetComponentsBoundingBox().GetCenter());
 
     FSoftObjectPath AssetToLoad = GetAssetToLoad();
 
@@ -55,9 +57,20 @@ void USteamAudioDynamicObjectComponent::BeginPlay()
     if (!AssetToLoad.IsAsset())
         return;
 
-    if (!Manager.InitializeSteamAudio(SteamAudio::EManagerInitReason::PLAYING))
+    // Initialization may still be running in the background, in which case registration waits for it to finish.
+    SteamAudio::FSteamAudioModule::GetManager().WhenInitialized(this, [this]()
+    {
+        OnSteamAudioInitialized();
+    });
+}
+
+void USteamAudioDynamicObjectComponent::OnSteamAudioInitialized()
+{
+    if (!HasBegunPlay())
         return;
 
+    SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+
     Scene = iplSceneRetain(Manager.GetScene());
     if (!Scene)
         return;
@@ -69,7 +82,29 @@ void USteamAudioDynamicObjectComponent::BeginPlay()
         return;
     }
 
-    iplInstancedMeshAdd(InstancedMesh, Scene);
+    IPLInstancedMesh MeshToAdd = iplInstancedMeshRetain(InstancedMesh);
+    IPLScene TargetScene = iplSceneRetain(Scene);
+    Manager.EnqueueSceneUpdate([MeshToAdd, TargetScene]() mutable
+    {
+        iplInstancedMeshAdd(MeshToAdd, TargetScene);
+        iplInstancedMeshRelease(&MeshToAdd);
+        iplSceneRelease(&TargetScene);
+    });
+}
+
+void USteamAudioDynamicObjectComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // The owner may be torn down before this component is garbage collected, so stop tracking transform changes now.
+    AActor* Owner = GetOwner();
+    USceneComponent* RootComponent = (Owner) ? Owner->GetRootComponent() : nullptr;
+    if (RootComponent)
+    {
+        RootComponent->TransformUpdated.RemoveAll(this);
+    }
+
+    SteamAudio::FSteamAudioModule::GetManager().RemoveDirtyDynamicObject(this);
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void USteamAudioDynamicObjectComponent::BeginDestroy()
@@ -78,9 +113,19 @@ void USteamAudioDynamicObjectComponent::BeginDestroy()
 
     SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
 
+    Manager.RemoveDirtyDynamicObject(this);
+
     if (Scene && InstancedMesh)
     {
-        iplInstancedMeshRemove(InstancedMesh, Scene);
+        IPLInstancedMesh MeshToRemove = iplInstancedMeshRetain(InstancedMesh);
+        IPLScene TargetScene = iplSceneRetain(Scene);
+        Manager.EnqueueSceneUpdate([MeshToRemove, TargetScene]() mutable
+        {
+            iplInstancedMeshRemove(MeshToRemove, TargetScene);
+            iplInstancedMeshRelease(&MeshToRemove);
+            iplSceneRelease(&TargetScene);
+        });
+
         Manager.UnloadDynamicObject(this);
         iplInstancedMeshRelease(&InstancedMesh);
         iplSceneRelease(&Scene);
@@ -89,15 +134,30 @@ void USteamAudioDynamicObjectComponent::BeginDestroy()
 
 void USteamAudioDynamicObjectComponent::OnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
 {
+    // This can be called many times per frame, so just note that the transform changed. The manager applies the
+    // latest transform once, before the next scene commit.
     if (Scene && InstancedMesh)
     {
-        FTransform RootComponentTransform = GetOwner()->GetRootComponent()->GetComponentTransform();
-        RootComponentTransform.SetTranslation(GetOwner()->GetComponentsBoundingBox().GetCenter());
-        IPLMatrix4x4 Transform = SteamAudio::ConvertTransform(RootComponentTransform);
-        iplInstancedMeshUpdateTransform(InstancedMesh, Scene, Transform);
+        SteamAudio::FSteamAudioModule::GetManager().AddDirtyDynamicObject(this);
     }
 }
 
+void USteamAudioDynamicObjectComponent::UpdateTransform()
+{
+    if (!Scene || !InstancedMesh)
+        return;
+
+    AActor* Owner = GetOwner();
+    USceneComponent* RootComponent = (Owner) ? Owner->GetRootComponent() : nullptr;
+    if (!RootComponent)
+        return;
+
+    FTransform RootComponentTransform = RootComponent->GetComponentTransform();
+    RootComponentTransform.SetTranslation(RootComponentTransform.TransformPosition(PivotOffset));
+
+    iplInstancedMeshUpdateTransform(InstancedMesh, Scene, SteamAudio::ConvertTransform(RootComponentTransform));
+}
+
 #if WITH_EDITOR
 void USteamAudioDynamicObjectComponent::CleaupDynamicComponentAsset()
 {
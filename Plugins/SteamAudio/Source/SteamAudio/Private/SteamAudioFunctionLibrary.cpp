@@ -19,6 +19,7 @@
 #include "SteamAudioAudioEngineInterface.h"
 #include "SteamAudioModule.h"
 #include "SteamAudioManager.h"
+#include "SteamAudioMaterial.h"
 
 using namespace SteamAudio;
 
@@ -47,6 +48,14 @@ void USteamAudioFunctionLibrary::UpdateStaticMeshMaterial(AStaticMeshActor* Stat
 	FSteamAudioModule::GetManager().UpdateStaticMeshMaterial(StaticMeshActor);
 }
 
+void USteamAudioFunctionLibrary::PreloadMaterials(const TArray<TSoftObjectPtr<USteamAudioMaterial>>& Materials)
+{
+	for (const TSoftObjectPtr<USteamAudioMaterial>& Material : Materials)
+	{
+		FSteamAudioModule::GetManager().PreloadMaterial(Material.ToSoftObjectPath());
+	}
+}
+
 void USteamAudioFunctionLibrary::ShutDownSteamAudio(bool bResetFlags)
 {
 	FSteamAudioModule::GetManager().ShutDownSteamAudio(bResetFlags);
@@ -67,6 +76,20 @@ void USteamAudioFunctionLibrary::RemoveSource(USteamAudioSourceComponent* Source
 	FSteamAudioModule::GetManager().RemoveSource(Source);
 }
 
+TArray<USteamAudioSourceComponent*> USteamAudioFunctionLibrary::GetSourcesInRadius(FVector Location, float Radius)
+{
+	TArray<USteamAudioSourceComponent*> Sources;
+	FSteamAudioModule::GetManager().FindSourcesInRadius(Location, Radius, Sources);
+	return Sources;
+}
+
+TArray<USteamAudioSourceComponent*> USteamAudioFunctionLibrary::GetNearestSources(FVector Location, int32 Count)
+{
+	TArray<USteamAudioSourceComponent*> Sources;
+	FSteamAudioModule::GetManager().FindNearestSources(Location, Count, Sources);
+	return Sources;
+}
+
 void USteamAudioFunctionLibrary::AddListener(USteamAudioListenerComponent* Listener)
 {
 	FSteamAudioModule::GetManager().AddListener(Listener);
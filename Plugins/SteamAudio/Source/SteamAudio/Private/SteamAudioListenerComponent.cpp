@@ -46,6 +46,14 @@ void USteamAudioListenerComponent::SetInputs()
 		return;
 
     IPLSimulationInputs Inputs{};
+    GetInputs(Inputs);
+
+    iplSourceSetInputs(Source, IPL_SIMULATIONFLAGS_REFLECTIONS, &Inputs);
+}
+
+void USteamAudioListenerComponent::GetInputs(IPLSimulationInputs& Inputs) const
+{
+    const FSteamAudioSettings& SteamAudioSettings = SteamAudio::FSteamAudioModule::GetManager().GetSteamAudioSettings();
 
     if (bSimulateReverb)
     {
@@ -77,18 +85,15 @@ void USteamAudioListenerComponent::SetInputs()
         Inputs.source.right = SteamAudio::ConvertVector(SourceTransform.GetUnitAxis(EAxis::Y), false);
 	}
 
-
     Inputs.reverbScale[0] = 1.0f;
     Inputs.reverbScale[1] = 1.0f;
     Inputs.reverbScale[2] = 1.0f;
-    Inputs.hybridReverbTransitionTime = Manager.GetSteamAudioSettings().HybridReverbTransitionTime;
-    Inputs.hybridReverbOverlapPercent = Manager.GetSteamAudioSettings().HybridReverbOverlapPercent / 100.0f;
+    Inputs.hybridReverbTransitionTime = SteamAudioSettings.HybridReverbTransitionTime;
+    Inputs.hybridReverbOverlapPercent = SteamAudioSettings.HybridReverbOverlapPercent / 100.0f;
     Inputs.baked = (ReverbType != EReverbSimulationType::REALTIME) ? IPL_TRUE : IPL_FALSE;
 
     Inputs.bakedDataIdentifier.type = IPL_BAKEDDATATYPE_REFLECTIONS;
     Inputs.bakedDataIdentifier.variation = IPL_BAKEDDATAVARIATION_REVERB;
-
-    iplSourceSetInputs(Source, IPL_SIMULATIONFLAGS_REFLECTIONS, &Inputs);
 }
 
 IPLSimulationOutputs USteamAudioListenerComponent::GetOutputs()
@@ -139,10 +144,20 @@ void USteamAudioListenerComponent::BeginPlay()
 
 	PlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
 
-	SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
-	if (!Manager.InitializeSteamAudio(SteamAudio::EManagerInitReason::PLAYING))
+	// Initialization may still be running in the background, in which case registration waits for it to finish.
+	SteamAudio::FSteamAudioModule::GetManager().WhenInitialized(this, [this]()
+	{
+		OnSteamAudioInitialized();
+	});
+}
+
+void USteamAudioListenerComponent::OnSteamAudioInitialized()
+{
+	if (!HasBegunPlay())
 		return;
 
+	SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+
     Simulator = iplSimulatorRetain(Manager.GetSimulator());
 	if (!Simulator)
 		return;
@@ -17,9 +17,17 @@
 #include "SteamAudioManager.h"
 #include "AudioDevice.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Components/AudioComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
 #include "HAL/UnrealMemory.h"
+#include "Math/RandomStream.h"
+#include "Misc/Paths.h"
 #include "Engine/StaticMeshActor.h"
 #include "SteamAudioAudioEngineInterface.h"
+#include "SteamAudioBenchmark.h"
 #include "SteamAudioCommon.h"
 #include "SteamAudioDynamicObjectComponent.h"
 #include "SteamAudioListenerComponent.h"
@@ -29,18 +37,547 @@
 #include "SteamAudioStaticMeshActor.h"
 #include "SOFAFile.h"
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Settings Snapshot Rebuilds"), STAT_SteamAudioSettingsSnapshotRebuilds, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listeners"), STAT_SteamAudioListeners, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Registered Sources"), STAT_SteamAudioRegisteredSources, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulated Sources"), STAT_SteamAudioSimulatedSources, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Decimated Sources"), STAT_SteamAudioDecimatedSources, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skipped Sources"), STAT_SteamAudioSkippedSources, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Manager Tick"), STAT_SteamAudioManagerTick, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Update Source Transforms"), STAT_SteamAudioUpdateSourceTransforms, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Schedule Sources"), STAT_SteamAudioScheduleSources, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Source Grid Cell Changes"), STAT_SteamAudioSourceGridCellChanges, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Set Source Inputs"), STAT_SteamAudioSetSourceInputs, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Run Direct Simulation"), STAT_SteamAudioRunDirect, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Update Source Outputs"), STAT_SteamAudioUpdateSourceOutputs, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Commit Scene"), STAT_SteamAudioCommitScene, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Update Dynamic Objects"), STAT_SteamAudioUpdateDynamicObjects, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dynamic Object Transforms Applied"), STAT_SteamAudioDynamicObjectTransformsApplied, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dynamic Object Transforms Coalesced"), STAT_SteamAudioDynamicObjectTransformsCoalesced, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Apply Material Changes"), STAT_SteamAudioApplyMaterialChanges, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Material Changes Applied"), STAT_SteamAudioMaterialChangesApplied, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Material Changes Coalesced"), STAT_SteamAudioMaterialChangesCoalesced, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Material Changes Waiting"), STAT_SteamAudioMaterialChangesWaiting, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Stage Indirect Inputs"), STAT_SteamAudioStageIndirectInputs, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Collect Indirect Outputs"), STAT_SteamAudioCollectIndirectOutputs, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Publish Outputs"), STAT_SteamAudioPublishOutputs, STATGROUP_SteamAudio);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Indirect Queue Latency (ms)"), STAT_SteamAudioIndirectQueueLatency, STATGROUP_SteamAudio);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Indirect Simulation Time (ms)"), STAT_SteamAudioIndirectSimulationTime, STATGROUP_SteamAudio);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Indirect Publish Latency (ms)"), STAT_SteamAudioIndirectPublishLatency, STATGROUP_SteamAudio);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Initialization Time (ms)"), STAT_SteamAudioInitializationTime, STATGROUP_SteamAudio);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("HRTF Build Time (ms)"), STAT_SteamAudioHRTFBuildTime, STATGROUP_SteamAudio);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HRTF Cache Hits"), STAT_SteamAudioHRTFCacheHits, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cached HRTFs"), STAT_SteamAudioCachedHRTFs, STATGROUP_SteamAudio);
+
 namespace SteamAudio {
 
+/** Number of sources processed by each task when updating sources in parallel. */
+static constexpr int32 SourcesPerBatch = 32;
+
+/** Maximum number of HRTFs kept in the cache. More than one is only needed if the audio device changes its sampling
+    rate or frame size, or the HRTF settings are edited. */
+static constexpr int32 MaxCachedHRTFs = 4;
+
+/** Fills in the HRTF settings from the Steam Audio settings, loading the SOFA file asset if one is specified. */
+static void GetHRTFSettings(IPLHRTFSettings& HRTFSettings)
+{
+    HRTFSettings.type = IPL_HRTFTYPE_DEFAULT;
+    HRTFSettings.volume = 1.0f;
+    HRTFSettings.normType = IPL_HRTFNORMTYPE_NONE;
+
+    const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
+    if (Settings)
+    {
+        HRTFSettings.volume = SteamAudio::ConvertDbToLinear(Settings->HRTFVolume);
+        HRTFSettings.normType = static_cast<IPLHRTFNormType>(Settings->HRTFNormalizationType);
+
+        if (Settings->SOFAFile.IsValid())
+        {
+            USOFAFile* SOFAFile = Cast<USOFAFile>(Settings->SOFAFile.TryLoad());
+            if (SOFAFile)
+            {
+                HRTFSettings.type = IPL_HRTFTYPE_SOFA;
+                HRTFSettings.sofaData = SOFAFile->Data.GetData();
+                HRTFSettings.sofaDataSize = SOFAFile->Data.Num();
+                HRTFSettings.volume = SteamAudio::ConvertDbToLinear(SOFAFile->Volume);
+                HRTFSettings.normType = static_cast<IPLHRTFNormType>(SOFAFile->NormalizationType);
+            }
+        }
+    }
+}
+
+/** Returns the number of occlusion samples or transmission rays to use for a decimated source. */
+static int32 DecimateSampleCount(int32 NumSamples, float Fraction)
+{
+    return (NumSamples > 0) ? FMath::Max(1, FMath::CeilToInt(NumSamples * Fraction)) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSourceGrid
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioSourceGrid::FSteamAudioSourceGrid(float InCellSize /* = DefaultCellSize */)
+    : CellSize(FMath::Max(InCellSize, UE_KINDA_SMALL_NUMBER))
+{}
+
+/** Largest cell index along any axis. Positions further out than this share the outermost cells, which keeps
+    non-finite or very distant positions from overflowing the cell index. */
+static constexpr float MaxGridCellIndex = 1 << 20;
+
+/** Returns the index of the cell containing a coordinate along one axis. */
+static int32 GetGridCellIndex(float Coordinate, float CellSize)
+{
+    float Index = FMath::FloorToFloat(Coordinate / CellSize);
+    if (FMath::IsNaN(Index))
+        return 0;
+
+    return static_cast<int32>(FMath::Clamp(Index, -MaxGridCellIndex, MaxGridCellIndex));
+}
+
+FIntVector FSteamAudioSourceGrid::GetCell(const FVector3f& Position) const
+{
+    return FIntVector(GetGridCellIndex(Position.X, CellSize), GetGridCellIndex(Position.Y, CellSize), GetGridCellIndex(Position.Z, CellSize));
+}
+
+void FSteamAudioSourceGrid::Add(const FVector3f& Position)
+{
+    FIntVector Cell = GetCell(Position);
+
+    Cells.FindOrAdd(Cell).Add(Positions.Num());
+    Positions.Add(Position);
+    EntryCells.Add(Cell);
+}
+
+void FSteamAudioSourceGrid::RemoveAtSwap(int32 Index)
+{
+    check(Positions.IsValidIndex(Index));
+
+    TArray<int32>& CellEntries = Cells.FindChecked(EntryCells[Index]);
+    CellEntries.RemoveSingleSwap(Index, EAllowShrinking::No);
+    if (CellEntries.Num() == 0)
+    {
+        Cells.Remove(EntryCells[Index]);
+    }
+
+    // The last entry takes the removed entry's index.
+    int32 LastIndex = Positions.Num() - 1;
+    if (Index != LastIndex)
+    {
+        TArray<int32>& LastCellEntries = Cells.FindChecked(EntryCells[LastIndex]);
+        LastCellEntries[LastCellEntries.Find(LastIndex)] = Index;
+    }
+
+    Positions.RemoveAtSwap(Index);
+    EntryCells.RemoveAtSwap(Index);
+}
+
+bool FSteamAudioSourceGrid::Update(int32 Index, const FVector3f& Position)
+{
+    Positions[Index] = Position;
+
+    FIntVector Cell = GetCell(Position);
+    if (Cell == EntryCells[Index])
+        return false;
+
+    TArray<int32>& OldCellEntries = Cells.FindChecked(EntryCells[Index]);
+    OldCellEntries.RemoveSingleSwap(Index, EAllowShrinking::No);
+    if (OldCellEntries.Num() == 0)
+    {
+        Cells.Remove(EntryCells[Index]);
+    }
+
+    Cells.FindOrAdd(Cell).Add(Index);
+    EntryCells[Index] = Cell;
+    return true;
+}
+
+void FSteamAudioSourceGrid::FindInRadius(const FVector3f& Center, float Radius, TArray<int32>& OutIndices) const
+{
+    OutIndices.Reset();
+
+    if (!(Radius >= 0.0f) || Positions.Num() == 0)
+        return;
+
+    FIntVector MinCell = GetCell(Center - FVector3f(Radius));
+    FIntVector MaxCell = GetCell(Center + FVector3f(Radius));
+    float RadiusSquared = Radius * Radius;
+
+    auto GatherCell = [&](const TArray<int32>& CellEntries)
+    {
+        for (int32 Index : CellEntries)
+        {
+            if (FVector3f::DistSquared(Positions[Index], Center) <= RadiusSquared)
+            {
+                OutIndices.Add(Index);
+            }
+        }
+    };
+
+    // For large radii, it's cheaper to visit the occupied cells than every cell in range.
+    int64 NumCellsInRange = (int64(MaxCell.X) - MinCell.X + 1) * (int64(MaxCell.Y) - MinCell.Y + 1) * (int64(MaxCell.Z) - MinCell.Z + 1);
+    if (NumCellsInRange > Cells.Num())
+    {
+        for (const TPair<FIntVector, TArray<int32>>& Cell : Cells)
+        {
+            const FIntVector& Key = Cell.Key;
+            if (Key.X >= MinCell.X && Key.X <= MaxCell.X && Key.Y >= MinCell.Y && Key.Y <= MaxCell.Y && Key.Z >= MinCell.Z && Key.Z <= MaxCell.Z)
+            {
+                GatherCell(Cell.Value);
+            }
+        }
+    }
+    else
+    {
+        for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+        {
+            for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+            {
+                for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+                {
+                    if (const TArray<int32>* CellEntries = Cells.Find(FIntVector(X, Y, Z)))
+                    {
+                        GatherCell(*CellEntries);
+                    }
+                }
+            }
+        }
+    }
+}
+
+FBox3f FSteamAudioSourceGrid::GetOccupiedBounds() const
+{
+    FIntVector MinCell(MAX_int32);
+    FIntVector MaxCell(MIN_int32);
+    for (const TPair<FIntVector, TArray<int32>>& Cell : Cells)
+    {
+        MinCell = FIntVector(FMath::Min(MinCell.X, Cell.Key.X), FMath::Min(MinCell.Y, Cell.Key.Y), FMath::Min(MinCell.Z, Cell.Key.Z));
+        MaxCell = FIntVector(FMath::Max(MaxCell.X, Cell.Key.X), FMath::Max(MaxCell.Y, Cell.Key.Y), FMath::Max(MaxCell.Z, Cell.Key.Z));
+    }
+
+    return FBox3f(FVector3f(MinCell) * CellSize, (FVector3f(MaxCell) + FVector3f(1.0f)) * CellSize);
+}
+
+void FSteamAudioSourceGrid::FindNearest(const FVector3f& Center, int32 Count, TArray<int32>& OutIndices) const
+{
+    OutIndices.Reset();
+
+    if (Count <= 0 || Positions.Num() == 0)
+        return;
+
+    // Every entry lies within the occupied cells, so there's no point searching further out than their farthest
+    // corner. This is NaN if the center isn't finite, which skips straight to the linear scan below.
+    FBox3f OccupiedBounds = GetOccupiedBounds();
+    FVector3f FarthestOffset = FVector3f::Max((Center - OccupiedBounds.Min).GetAbs(), (OccupiedBounds.Max - Center).GetAbs());
+    float MaxRadius = FarthestOffset.Size();
+
+    // Grow the search radius until it contains enough entries. Everything within the radius has been found, so the
+    // closest Count of them are the closest overall.
+    float Radius = FMath::Max(CellSize, FMath::Sqrt(OccupiedBounds.ComputeSquaredDistanceToPoint(Center)));
+    while (Radius < MaxRadius)
+    {
+        FindInRadius(Center, Radius, OutIndices);
+        if (OutIndices.Num() >= Count || OutIndices.Num() == Positions.Num())
+            break;
+
+        Radius *= 2.0f;
+    }
+
+    // Entries outside the outermost cells, or a center that isn't finite, can leave the search short, so fall back
+    // to considering every entry.
+    if (OutIndices.Num() < Count && OutIndices.Num() < Positions.Num())
+    {
+        OutIndices.Reset();
+        for (int32 Index = 0; Index < Positions.Num(); ++Index)
+        {
+            OutIndices.Add(Index);
+        }
+    }
+
+    OutIndices.Sort([this, &Center](int32 A, int32 B)
+    {
+        return FVector3f::DistSquared(Positions[A], Center) < FVector3f::DistSquared(Positions[B], Center);
+    });
+
+    if (OutIndices.Num() > Count)
+    {
+        OutIndices.SetNum(Count, EAllowShrinking::No);
+    }
+}
+
+/**
+ * Moves a set of random points around for a number of ticks, and logs the time taken to update the grid and run
+ * radius and nearest-neighbor queries, compared to linear scans over all points.
+ */
+static void BenchmarkSourceGrid(const TArray<FString>& Args)
+{
+    const int32 NumSources = (Args.Num() > 0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10000;
+    const int32 NumTicks = (Args.Num() > 1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 100;
+    const float WorldSize = 1000.0f;
+    const float QueryRadius = 100.0f;
+    const int32 NearestCount = 32;
+    const float DeltaTime = 1.0f / 60.0f;
+
+    FRandomStream Random(0);
+
+    TArray<FVector3f> Positions;
+    TArray<FVector3f> Velocities;
+    FSteamAudioSourceGrid Grid;
+    for (int32 i = 0; i < NumSources; ++i)
+    {
+        Positions.Add(FVector3f(Random.FRandRange(0.0f, WorldSize), Random.FRandRange(0.0f, WorldSize), Random.FRandRange(0.0f, 20.0f)));
+        Velocities.Add(FVector3f(Random.FRandRange(-10.0f, 10.0f), Random.FRandRange(-10.0f, 10.0f), 0.0f));
+        Grid.Add(Positions[i]);
+    }
+
+    TArray<int32> Results;
+    TArray<int32> LinearResults;
+    double UpdateSeconds = 0.0;
+    double GridRadiusSeconds = 0.0;
+    double LinearRadiusSeconds = 0.0;
+    double GridNearestSeconds = 0.0;
+    double LinearNearestSeconds = 0.0;
+    int64 NumCellChanges = 0;
+    int32 NumMismatches = 0;
+
+    for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+    {
+        uint64 StartCycles = FPlatformTime::Cycles64();
+        for (int32 i = 0; i < NumSources; ++i)
+        {
+            Positions[i] += Velocities[i] * DeltaTime;
+            NumCellChanges += Grid.Update(i, Positions[i]) ? 1 : 0;
+        }
+        UpdateSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+        FVector3f Center(Random.FRandRange(0.0f, WorldSize), Random.FRandRange(0.0f, WorldSize), 10.0f);
+
+        StartCycles = FPlatformTime::Cycles64();
+        Grid.FindInRadius(Center, QueryRadius, Results);
+        GridRadiusSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+        StartCycles = FPlatformTime::Cycles64();
+        LinearResults.Reset();
+        for (int32 i = 0; i < NumSources; ++i)
+        {
+            if (FVector3f::DistSquared(Positions[i], Center) <= QueryRadius * QueryRadius)
+            {
+                LinearResults.Add(i);
+            }
+        }
+        LinearRadiusSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+        NumMismatches += (Results.Num() != LinearResults.Num()) ? 1 : 0;
+
+        StartCycles = FPlatformTime::Cycles64();
+        Grid.FindNearest(Center, NearestCount, Results);
+        GridNearestSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+        StartCycles = FPlatformTime::Cycles64();
+        LinearResults.Reset();
+        for (int32 i = 0; i < NumSources; ++i)
+        {
+            LinearResults.Add(i);
+        }
+        LinearResults.Sort([&Positions, &Center](int32 A, int32 B)
+        {
+            return FVector3f::DistSquared(Positions[A], Center) < FVector3f::DistSquared(Positions[B], Center);
+        });
+        LinearResults.SetNum(FMath::Min(NearestCount, NumSources), EAllowShrinking::No);
+        LinearNearestSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+        NumMismatches += (Results.Num() != LinearResults.Num() || (Results.Num() > 0 && Results.Last() != LinearResults.Last())) ? 1 : 0;
+    }
+
+    UE_LOG(LogSteamAudio, Log, TEXT("Source grid benchmark, %d sources, %d ticks: update %.3f ms/tick (%.1f cell changes/tick), radius query %.3f ms (linear %.3f ms), %d nearest %.3f ms (linear %.3f ms), %d mismatches."),
+        NumSources, NumTicks, (UpdateSeconds * 1000.0) / NumTicks, double(NumCellChanges) / NumTicks,
+        (GridRadiusSeconds * 1000.0) / NumTicks, (LinearRadiusSeconds * 1000.0) / NumTicks,
+        NearestCount, (GridNearestSeconds * 1000.0) / NumTicks, (LinearNearestSeconds * 1000.0) / NumTicks, NumMismatches);
+}
+
+static FAutoConsoleCommand GBenchmarkSourceGridCommand(
+    TEXT("SteamAudio.BenchmarkSourceGrid"),
+    TEXT("Logs the time taken to update the source grid for moving sources and to run radius and nearest-neighbor ")
+    TEXT("queries against it, compared to linear scans. Usage: SteamAudio.BenchmarkSourceGrid [NumSources] [NumTicks]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkSourceGrid));
+
+/** Starts or stops recording the listener and source poses to a trajectory file, for replaying with the
+    SteamAudioBenchmark commandlet. */
+static void RecordTrajectory(const TArray<FString>& Args)
+{
+    FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
+
+    FString FileName = Manager.GetTrajectoryFileName();
+    if (!FileName.IsEmpty())
+    {
+        Manager.StopRecordingTrajectory();
+        UE_LOG(LogSteamAudio, Display, TEXT("Stopped recording trajectory to %s."), *FileName);
+        return;
+    }
+
+    FileName = (Args.Num() > 0) ? Args[0] : FPaths::ProjectSavedDir() / TEXT("SteamAudio") / FString::Printf(TEXT("Trajectory-%s.csv"), *FDateTime::Now().ToString());
+    if (Manager.StartRecordingTrajectory(FileName))
+    {
+        UE_LOG(LogSteamAudio, Display, TEXT("Recording trajectory to %s."), *FileName);
+    }
+}
+
+static FAutoConsoleCommand GRecordTrajectoryCommand(
+    TEXT("SteamAudio.RecordTrajectory"),
+    TEXT("Starts or stops writing the listener and Steam Audio Source poses to a file every tick, for replaying with ")
+    TEXT("the SteamAudioBenchmark commandlet. Usage: SteamAudio.RecordTrajectory [FileName]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&RecordTrajectory));
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSourceRegistry
+// ---------------------------------------------------------------------------------------------------------------------
+
+void FSteamAudioSourceRegistry::Add(USteamAudioSourceComponent* Component, IPLSource Handle, int32 OutputSlot)
+{
+    if (Components.Contains(Component))
+        return;
+
+    Components.Add(Component);
+    Handles.Add(Handle);
+    Transforms.AddZeroed();
+    Flags.Add(IPL_SIMULATIONFLAGS_DIRECT);
+    BakedDataIdentifiers.AddZeroed();
+    OutputSlots.Add(OutputSlot);
+    LODs.Add(ESimulationLOD::FULL);
+    IndirectScheduled.Add(false);
+    Scores.Add(0.0f);
+    ListenerIndices.Add(0);
+    Grid.Add(FVector3f::ZeroVector);
+}
+
+bool FSteamAudioSourceRegistry::Remove(USteamAudioSourceComponent* Component)
+{
+    int32 Index = Components.Find(Component);
+    if (Index == INDEX_NONE)
+        return false;
+
+    Components.RemoveAtSwap(Index);
+    Handles.RemoveAtSwap(Index);
+    Transforms.RemoveAtSwap(Index);
+    Flags.RemoveAtSwap(Index);
+    BakedDataIdentifiers.RemoveAtSwap(Index);
+    OutputSlots.RemoveAtSwap(Index);
+    LODs.RemoveAtSwap(Index);
+    IndirectScheduled.RemoveAtSwap(Index);
+    Scores.RemoveAtSwap(Index);
+    ListenerIndices.RemoveAtSwap(Index);
+    Grid.RemoveAtSwap(Index);
+    return true;
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // FSteamAudioPluginListener
 // ---------------------------------------------------------------------------------------------------------------------
 
+FSteamAudioPluginListener::FSteamAudioPluginListener()
+    : ListenerCoordinates{}
+    , NumListeners(1)
+    , NumListenersThisRound(0)
+{}
+
 void FSteamAudioPluginListener::OnListenerUpdated(FAudioDevice* AudioDevice, const int32 ViewportIndex, const FTransform& ListenerTransform, const float InDeltaSeconds)
 {
-    ListenerCoordinates.origin = SteamAudio::ConvertVector(ListenerTransform.GetLocation());
-    ListenerCoordinates.ahead = SteamAudio::ConvertVector(ListenerTransform.GetUnitAxis(EAxis::X), false);
-    ListenerCoordinates.up = SteamAudio::ConvertVector(ListenerTransform.GetUnitAxis(EAxis::Z), false);
-    ListenerCoordinates.right = SteamAudio::ConvertVector(ListenerTransform.GetUnitAxis(EAxis::Y), false);
+    if (ViewportIndex < 0 || ViewportIndex >= MaxListeners)
+        return;
+
+    FScopeLock Lock(&ListenerLock);
+
+    // Listeners are updated in viewport order every frame, so the primary listener coming around again means the
+    // last round is complete. Listeners that weren't updated during it have gone away, e.g. when a player leaves
+    // split-screen.
+    if (ViewportIndex == 0)
+    {
+        NumListeners = FMath::Max(NumListenersThisRound, 1);
+        NumListenersThisRound = 0;
+    }
+
+    ListenerCoordinates[ViewportIndex] = SteamAudio::ConvertCoordinateSpace(ListenerTransform);
+
+    NumListenersThisRound = FMath::Max(NumListenersThisRound, ViewportIndex + 1);
+    NumListeners = FMath::Max(NumListeners, NumListenersThisRound);
+}
+
+IPLCoordinateSpace3 FSteamAudioPluginListener::GetListenerCoordinates()
+{
+    FScopeLock Lock(&ListenerLock);
+    return ListenerCoordinates[0];
+}
+
+void FSteamAudioPluginListener::GetAllListenerCoordinates(FSteamAudioListenerArray& OutListeners)
+{
+    FScopeLock Lock(&ListenerLock);
+    OutListeners.Reset();
+    OutListeners.Append(ListenerCoordinates, NumListeners);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioIndirectJob
+// ---------------------------------------------------------------------------------------------------------------------
+
+void FSteamAudioIndirectJob::Reset()
+{
+    for (IPLSource& Handle : Handles)
+    {
+        iplSourceRelease(&Handle);
+    }
+
+    for (IPLSource& Handle : ListenerHandles)
+    {
+        iplSourceRelease(&Handle);
+    }
+
+    Handles.Reset();
+    Inputs.Reset();
+    ListenerIndices.Reset();
+    OutputSlots.Reset();
+    OutputSlotGenerations.Reset();
+    Outputs.Reset();
+    ListenerHandles.Reset();
+    ListenerInputs.Reset();
+    Listeners.Reset();
+
+    StagedCycles = 0;
+    StartCycles = 0;
+    EndCycles = 0;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioHRTFCacheKey
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioHRTFCacheKey::FSteamAudioHRTFCacheKey(const IPLAudioSettings& AudioSettings, const IPLHRTFSettings& HRTFSettings)
+    : SamplingRate(AudioSettings.samplingRate)
+    , FrameSize(AudioSettings.frameSize)
+    , Type(HRTFSettings.type)
+    , Volume(HRTFSettings.volume)
+    , NormType(HRTFSettings.normType)
+    , SOFADataSize(0)
+    , SOFADataCrc(0)
+{
+    if (HRTFSettings.type == IPL_HRTFTYPE_SOFA && HRTFSettings.sofaData)
+    {
+        SOFADataSize = HRTFSettings.sofaDataSize;
+        SOFADataCrc = FCrc::MemCrc32(HRTFSettings.sofaData, HRTFSettings.sofaDataSize);
+    }
+}
+
+bool FSteamAudioHRTFCacheKey::operator==(const FSteamAudioHRTFCacheKey& Other) const
+{
+    return SamplingRate == Other.SamplingRate &&
+        FrameSize == Other.FrameSize &&
+        Type == Other.Type &&
+        Volume == Other.Volume &&
+        NormType == Other.NormType &&
+        SOFADataSize == Other.SOFADataSize &&
+        SOFADataCrc == Other.SOFADataCrc;
 }
 
 
@@ -51,6 +588,10 @@ void FSteamAudioPluginListener::OnListenerUpdated(FAudioDevice* AudioDevice, con
 FSteamAudioManager::FSteamAudioManager()
     : Context(nullptr)
     , HRTF(nullptr)
+    , CapturedHRTFSettings{}
+    , bHRTFSettingsCaptured(false)
+    , bInitializationRequested(false)
+    , InitializationStartTime(0.0)
     , EmbreeDevice(nullptr)
     , OpenCLDevice(nullptr)
     , RadeonRaysDevice(nullptr)
@@ -61,9 +602,21 @@ FSteamAudioManager::FSteamAudioManager()
     , bInitializationSucceded(false)
     , SteamAudioSettings()
     , bSettingsLoaded(false)
+    , SettingsSnapshot(nullptr)
+    , SettingsGeneration(0)
+    , DynamicObjectTransformRequests(0)
+    , MaterialChangesCoalesced(0)
+    , TrajectoryRecordingTime(0.0)
     , SimulationUpdateTimeElapsed(0.0f)
     , ThreadPool(nullptr)
     , ThreadPoolIdle(true)
+    , VoiceOutputs(nullptr)
+    , NextPendingVoice(0)
+    , SimulationTickCount(0)
+    , bSimulatorCommitRequested(false)
+    , StagingIndirectJob(0)
+    , bIndirectJobStaged(false)
+    , bIndirectJobInFlight(false)
 {
     IPLContextSettings ContextSettings{};
     ContextSettings.version = STEAMAUDIO_VERSION;
@@ -87,662 +640,1980 @@ FSteamAudioManager::FSteamAudioManager()
         UE_LOG(LogSteamAudio, Error, TEXT("Unable to create context. [%d]"), Status);
     }
 
-    AudioPluginListener = TAudioPluginListenerPtr(new FSteamAudioPluginListener());
+    AudioPluginListener = TAudioPluginListenerPtr(new FSteamAudioPluginListener());
+}
+
+FSteamAudioManager::~FSteamAudioManager()
+{
+    ShutDownSteamAudio();
+
+    for (TFuture<void>& Task : HRTFPrewarmTasks)
+    {
+        Task.Wait();
+    }
+
+    for (TPair<FSteamAudioHRTFCacheKey, IPLHRTF>& Entry : HRTFCache)
+    {
+        iplHRTFRelease(&Entry.Value);
+    }
+}
+
+bool FSteamAudioManager::CreateEmptyScene(IPLScene& SubScene)
+{
+    return CreateEmptyScene(SubScene, ActualSceneType);
+}
+
+bool FSteamAudioManager::CreateEmptyScene(IPLScene& SubScene, IPLSceneType SceneType)
+{
+    IPLSceneSettings SceneSettings{};
+    SceneSettings.type = SceneType;
+    SceneSettings.embreeDevice = EmbreeDevice;
+    SceneSettings.radeonRaysDevice = RadeonRaysDevice;
+
+    IPLerror Status = iplSceneCreate(Context, &SceneSettings, &SubScene);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create scene. [%d]"), Status);
+        return false;
+    }
+
+    return true;
+}
+
+void FSteamAudioManager::UpdateStaticMesh()
+{
+    UWorld* World = GEngine->GetCurrentPlayWorld();
+    ULevel* Level = World->GetCurrentLevel();
+    auto StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
+    if (StaticMeshActor)
+    {
+        StaticMeshActor->UpdateStaticMesh();
+    }
+}
+
+void FSteamAudioManager::UpdateStaticMeshMaterial(AStaticMeshActor* StaticMeshActor)
+{
+    check(IsInGameThread());
+
+    if (!StaticMeshActor)
+        return;
+
+    bool bAlreadyPending = false;
+    PendingMaterialActors.Add(StaticMeshActor, &bAlreadyPending);
+    if (bAlreadyPending)
+    {
+        ++MaterialChangesCoalesced;
+    }
+
+    // Start loading the new material right away, so it's likely to be ready by the time the change is applied.
+    FSoftObjectPath MaterialAsset;
+    int32 ExportIndex = 0;
+    if (GetRuntimeMaterialChange(StaticMeshActor, MaterialAsset, ExportIndex))
+    {
+        GetMaterialCache().Preload(MaterialAsset);
+    }
+}
+
+void FSteamAudioManager::PreloadMaterial(const FSoftObjectPath& MaterialAsset)
+{
+    check(IsInGameThread());
+    GetMaterialCache().Preload(MaterialAsset);
+}
+
+FMaterialCache& FSteamAudioManager::GetMaterialCache()
+{
+    if (!MaterialCache)
+    {
+        MaterialCache = MakeUnique<FMaterialCache>();
+    }
+
+    return *MaterialCache;
+}
+
+void FSteamAudioManager::ApplyMaterialChanges()
+{
+    if (PendingMaterialActors.Num() == 0)
+        return;
+
+    SCOPE_CYCLE_COUNTER(STAT_SteamAudioApplyMaterialChanges);
+
+    FMaterialCache& Materials = GetMaterialCache();
+
+    // Group the changes by level, so that each level's static geometry is only updated once.
+    TMap<ASteamAudioStaticMeshActor*, TArray<FStaticMeshMaterialChange>> ChangesByLevel;
+    int32 NumApplied = 0;
+
+    for (auto It = PendingMaterialActors.CreateIterator(); It; ++It)
+    {
+        AStaticMeshActor* Actor = It->Get();
+
+        FSoftObjectPath MaterialAsset;
+        FStaticMeshMaterialChange Change;
+        if (!Actor || !GetRuntimeMaterialChange(Actor, MaterialAsset, Change.ExportIndex))
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        const IPLMaterial* Material = Materials.Find(MaterialAsset);
+        if (!Material)
+        {
+            // Keep the change until its material has loaded, unless it can't be loaded at all.
+            if (!Materials.IsLoading(MaterialAsset))
+            {
+                It.RemoveCurrent();
+            }
+
+            continue;
+        }
+
+        ASteamAudioStaticMeshActor* SteamAudioStaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(Actor->GetWorld(), Actor->GetLevel());
+        if (SteamAudioStaticMeshActor)
+        {
+            Change.Actor = Actor;
+            Change.MaterialAsset = MaterialAsset;
+            Change.Material = *Material;
+            ChangesByLevel.FindOrAdd(SteamAudioStaticMeshActor).Add(Change);
+            ++NumApplied;
+        }
+
+        It.RemoveCurrent();
+    }
+
+    for (TPair<ASteamAudioStaticMeshActor*, TArray<FStaticMeshMaterialChange>>& Changes : ChangesByLevel)
+    {
+        Changes.Key->UpdateStaticMeshMaterials(Changes.Value);
+    }
+
+    SET_DWORD_STAT(STAT_SteamAudioMaterialChangesApplied, NumApplied);
+    SET_DWORD_STAT(STAT_SteamAudioMaterialChangesCoalesced, MaterialChangesCoalesced);
+    SET_DWORD_STAT(STAT_SteamAudioMaterialChangesWaiting, PendingMaterialActors.Num());
+
+    MaterialChangesCoalesced = 0;
+}
+
+void FSteamAudioManager::SetSteamAudioEnabled(bool bNewIsSteamAudioEnabled)
+{
+    bIsSteamAudioEnabled = bNewIsSteamAudioEnabled;
+}
+
+IPLCoordinateSpace3 FSteamAudioManager::GetListenerCoordinates()
+{
+    IPLCoordinateSpace3 ListenerCoordinates{};
+
+    if (GetDefault<USteamAudioSettings>()->AudioEngine == EAudioEngineType::UNREAL)
+    {
+        // We're running Unreal's built-in audio engine, so use the data provided via the IAudioPluginListener API.
+        if (AudioPluginListener)
+        {
+            ListenerCoordinates = StaticCastSharedPtr<FSteamAudioPluginListener>(AudioPluginListener)->GetListenerCoordinates();
+        }
+    }
+    else
+    {
+        // We're using third-party audio middleware, so use the Steam Audio IAudioEngineState API to get the
+        // listener transform.
+        IAudioEngineState* AudioEngineState = FSteamAudioModule::GetAudioEngineState();
+        if (AudioEngineState)
+        {
+            FTransform ListenerTransform = AudioEngineState->GetListenerTransform();
+
+            ListenerCoordinates.origin = SteamAudio::ConvertVector(ListenerTransform.GetLocation());
+            ListenerCoordinates.ahead = SteamAudio::ConvertVector(ListenerTransform.GetUnitAxis(EAxis::X), false);
+            ListenerCoordinates.up = SteamAudio::ConvertVector(ListenerTransform.GetUnitAxis(EAxis::Z), false);
+            ListenerCoordinates.right = SteamAudio::ConvertVector(ListenerTransform.GetUnitAxis(EAxis::Y), false);
+        }
+    }
+
+    return ListenerCoordinates;
+}
+
+void FSteamAudioManager::GetAllListenerCoordinates(FSteamAudioListenerArray& OutListeners)
+{
+    // Only Unreal's built-in audio engine tells us about more than one listener.
+    if (GetDefault<USteamAudioSettings>()->AudioEngine == EAudioEngineType::UNREAL && AudioPluginListener)
+    {
+        StaticCastSharedPtr<FSteamAudioPluginListener>(AudioPluginListener)->GetAllListenerCoordinates(OutListeners);
+        return;
+    }
+
+    OutListeners.Reset();
+    OutListeners.Add(GetListenerCoordinates());
+}
+
+bool FSteamAudioManager::InitHRTF(IPLAudioSettings& AudioSettings)
+{
+    FScopeLock Lock(&HRTFLock);
+
+    // If we're using Unreal's built-in audio engine, we may have already initialized the HRTF when the
+    // spatialization plugin was initialized. In that case, do nothing.
+    if (HRTF)
+        return true;
+
+    double StartTime = FPlatformTime::Seconds();
+
+    if (!bHRTFSettingsCaptured && IsInGameThread())
+    {
+        CaptureHRTFSettings();
+    }
+
+    IPLHRTFSettings HRTFSettings{};
+    if (bHRTFSettingsCaptured)
+    {
+        HRTFSettings = CapturedHRTFSettings;
+        HRTFSettings.sofaData = CapturedSOFAData.GetData();
+    }
+    else
+    {
+        // Loading the SOFA asset isn't allowed here, so all we can do is use the default HRTF.
+        UE_LOG(LogSteamAudio, Warning, TEXT("HRTF requested before its settings were read on the game thread, using default HRTF."));
+
+        HRTFSettings.type = IPL_HRTFTYPE_DEFAULT;
+        HRTFSettings.volume = 1.0f;
+        HRTFSettings.normType = IPL_HRTFNORMTYPE_NONE;
+    }
+
+    bool bCached = false;
+    IPLerror Status = FindOrCreateHRTF(AudioSettings, HRTFSettings, HRTF, bCached);
+    if (Status != IPL_STATUS_SUCCESS && HRTFSettings.type == IPL_HRTFTYPE_SOFA)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create HRTF from SOFA file %s, reverting to default HRTF. [%d]"), *GetDefault<USteamAudioSettings>()->SOFAFile.GetAssetPathString(), Status);
+
+        HRTFSettings.type = IPL_HRTFTYPE_DEFAULT;
+        HRTFSettings.sofaData = nullptr;
+        HRTFSettings.sofaDataSize = 0;
+
+        Status = FindOrCreateHRTF(AudioSettings, HRTFSettings, HRTF, bCached);
+    }
+
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create HRTF. [%d]"), Status);
+        return false;
+    }
+
+    UE_LOG(LogSteamAudio, Log, TEXT("HRTF for %d Hz, %d samples per frame ready in %.2f ms (%s)."), AudioSettings.samplingRate, AudioSettings.frameSize,
+        (FPlatformTime::Seconds() - StartTime) * 1000.0, (bCached) ? TEXT("cached") : TEXT("built"));
+
+    return true;
+}
+
+IPLHRTF FSteamAudioManager::GetHRTF()
+{
+    // ShutDownSteamAudio releases the HRTF under the lock, so retain it before letting go of the lock.
+    FScopeLock Lock(&HRTFLock);
+    return (HRTF) ? iplHRTFRetain(HRTF) : nullptr;
+}
+
+void FSteamAudioManager::PrewarmHRTF(const IPLAudioSettings& AudioSettings)
+{
+    HRTFPrewarmTasks.RemoveAll([](const TFuture<void>& Task) { return Task.IsReady(); });
+
+    CaptureHRTFSettings();
+
+    // The captured settings may be replaced before the task runs, so give it its own copy of the data.
+    IPLHRTFSettings HRTFSettings{};
+    TArray<uint8> SOFAData;
+    {
+        FScopeLock Lock(&HRTFLock);
+        HRTFSettings = CapturedHRTFSettings;
+        SOFAData = CapturedSOFAData;
+    }
+
+    HRTFPrewarmTasks.Add(Async(EAsyncExecution::ThreadPool, [this, AudioSettings, HRTFSettings, SOFAData = MoveTemp(SOFAData)]() mutable
+    {
+        HRTFSettings.sofaData = SOFAData.GetData();
+
+        FScopeLock Lock(&HRTFLock);
+
+        IPLHRTF PrewarmedHRTF = nullptr;
+        bool bCached = false;
+        if (FindOrCreateHRTF(AudioSettings, HRTFSettings, PrewarmedHRTF, bCached) == IPL_STATUS_SUCCESS)
+        {
+            iplHRTFRelease(&PrewarmedHRTF);
+        }
+    }));
+}
+
+void FSteamAudioManager::CaptureHRTFSettings()
+{
+    check(IsInGameThread());
+
+    IPLHRTFSettings HRTFSettings{};
+    GetHRTFSettings(HRTFSettings);
+
+    // The SOFA asset may be unloaded later, so keep our own copy of the data.
+    TArray<uint8> SOFAData;
+    if (HRTFSettings.type == IPL_HRTFTYPE_SOFA)
+    {
+        SOFAData.Append(HRTFSettings.sofaData, HRTFSettings.sofaDataSize);
+    }
+
+    HRTFSettings.sofaData = nullptr;
+
+    FScopeLock Lock(&HRTFLock);
+    CapturedHRTFSettings = HRTFSettings;
+    CapturedSOFAData = MoveTemp(SOFAData);
+    bHRTFSettingsCaptured = true;
+}
+
+IPLerror FSteamAudioManager::FindOrCreateHRTF(const IPLAudioSettings& AudioSettings, const IPLHRTFSettings& HRTFSettings, IPLHRTF& OutHRTF, bool& bOutCached)
+{
+    FSteamAudioHRTFCacheKey Key(AudioSettings, HRTFSettings);
+
+    for (int32 i = 0; i < HRTFCache.Num(); ++i)
+    {
+        if (HRTFCache[i].Key == Key)
+        {
+            // Move the entry to the end, so the least recently used entry is evicted first.
+            TPair<FSteamAudioHRTFCacheKey, IPLHRTF> Entry = HRTFCache[i];
+            HRTFCache.RemoveAt(i);
+            HRTFCache.Add(Entry);
+
+            INC_DWORD_STAT(STAT_SteamAudioHRTFCacheHits);
+
+            OutHRTF = iplHRTFRetain(Entry.Value);
+            bOutCached = true;
+            return IPL_STATUS_SUCCESS;
+        }
+    }
+
+    double StartTime = FPlatformTime::Seconds();
+
+    IPLAudioSettings CreateAudioSettings = AudioSettings;
+    IPLHRTFSettings CreateHRTFSettings = HRTFSettings;
+
+    IPLHRTF NewHRTF = nullptr;
+    IPLerror Status = iplHRTFCreate(Context, &CreateAudioSettings, &CreateHRTFSettings, &NewHRTF);
+    if (Status != IPL_STATUS_SUCCESS)
+        return Status;
+
+    INC_FLOAT_STAT_BY(STAT_SteamAudioHRTFBuildTime, (float) ((FPlatformTime::Seconds() - StartTime) * 1000.0));
+
+    if (HRTFCache.Num() >= MaxCachedHRTFs)
+    {
+        iplHRTFRelease(&HRTFCache[0].Value);
+        HRTFCache.RemoveAt(0);
+    }
+
+    HRTFCache.Emplace(Key, NewHRTF);
+    SET_DWORD_STAT(STAT_SteamAudioCachedHRTFs, HRTFCache.Num());
+
+    OutHRTF = iplHRTFRetain(NewHRTF);
+    bOutCached = false;
+    return IPL_STATUS_SUCCESS;
+}
+
+bool FSteamAudioManager::InitializeSteamAudio(EManagerInitReason Reason)
+{
+    // If initialization is already running in the background, wait for it instead of starting over.
+    if (InitializationTask.IsValid())
+    {
+        FinishInitialization();
+    }
+
+    // We already tried initializing before, so just return a flag indicating whether or not we succeeded when we last
+    // tried.
+    if (bInitializationAttempted)
+        return bInitializationSucceded;
+
+    InitializationStartTime = FPlatformTime::Seconds();
+
+    IPLAudioSettings AudioSettings{};
+    IPLSimulationSettings RealTimeSettings{};
+    if (!BeginInitialization(Reason, AudioSettings, RealTimeSettings))
+        return false;
+
+    return EndInitialization(Reason, CreateDevices(Reason, AudioSettings, RealTimeSettings));
+}
+
+bool FSteamAudioManager::InitializeSteamAudioAsync()
+{
+    check(IsInGameThread());
+
+    if (InitializationTask.IsValid())
+    {
+        if (!InitializationTask.IsReady())
+            return false;
+
+        FinishInitialization();
+    }
+
+    if (bInitializationAttempted)
+        return bInitializationSucceded;
+
+    InitializationStartTime = FPlatformTime::Seconds();
+
+    IPLAudioSettings AudioSettings{};
+    IPLSimulationSettings RealTimeSettings{};
+    if (!BeginInitialization(EManagerInitReason::PLAYING, AudioSettings, RealTimeSettings))
+        return false;
+
+    // Creating the devices, scene, simulator, and HRTF can take a long time, so do it on a separate thread. None of
+    // these objects are used by anything else until EndInitialization runs on the game thread.
+    InitializationTask = Async(EAsyncExecution::Thread, [this, AudioSettings, RealTimeSettings]()
+    {
+        return CreateDevices(EManagerInitReason::PLAYING, AudioSettings, RealTimeSettings);
+    });
+
+    return false;
+}
+
+void FSteamAudioManager::RequestInitialization()
+{
+    if (bInitializationSucceded || bInitializationRequested.exchange(true))
+        return;
+
+    AsyncTask(ENamedThreads::GameThread, [this]()
+    {
+        InitializeSteamAudioAsync();
+    });
+}
+
+void FSteamAudioManager::WhenInitialized(UObject* Owner, TFunction<void()>&& Function)
+{
+    check(IsInGameThread());
+
+    if (InitializeSteamAudioAsync())
+    {
+        Function();
+        return;
+    }
+
+    // Initialization failed, so there is nothing to wait for.
+    if (bInitializationAttempted && !InitializationTask.IsValid())
+        return;
+
+    PendingInitializationCallbacks.Emplace(Owner, MoveTemp(Function));
+}
+
+void FSteamAudioManager::FinishInitialization()
+{
+    check(InitializationTask.IsValid());
+
+    FSteamAudioDeviceCreationResult Result = InitializationTask.Get();
+    InitializationTask.Reset();
+
+    EndInitialization(EManagerInitReason::PLAYING, Result);
+}
+
+void FSteamAudioManager::RunInitializationCallbacks()
+{
+    if (PendingInitializationCallbacks.Num() == 0)
+        return;
+
+    // Callbacks may register more callbacks, which will now run immediately, so take ownership of the list first.
+    TArray<TPair<TWeakObjectPtr<UObject>, TFunction<void()>>> Callbacks = MoveTemp(PendingInitializationCallbacks);
+    PendingInitializationCallbacks.Reset();
+
+    for (TPair<TWeakObjectPtr<UObject>, TFunction<void()>>& Callback : Callbacks)
+    {
+        if (Callback.Key.IsValid())
+        {
+            Callback.Value();
+        }
+    }
+}
+
+bool FSteamAudioManager::BeginInitialization(EManagerInitReason Reason, IPLAudioSettings& OutAudioSettings, IPLSimulationSettings& OutRealTimeSettings)
+{
+    bInitializationAttempted = true;
+
+    const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
+    if (!Settings)
+    {
+        bInitializationSucceded = false;
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to load Steam Audio Settings."));
+        return false;
+    }
+
+    SteamAudioSettings = Settings->GetSettings();
+    bSettingsLoaded = true;
+
+    ActualSceneType = SteamAudioSettings.SceneType;
+    ActualReflectionEffectType = SteamAudioSettings.ReflectionEffectType;
+
+    if (Reason == EManagerInitReason::EXPORTING_SCENE || Reason == EManagerInitReason::GENERATING_PROBES)
+    {
+        ActualSceneType = IPL_SCENETYPE_DEFAULT;
+    }
+
+    if (Reason == EManagerInitReason::BAKING || Reason == EManagerInitReason::PLAYING)
+    {
+        // Set up communication with the audio engine.
+        IAudioEngineStateFactory* AudioEngineStateFactory = nullptr;
+
+        if (SteamAudioSettings.AudioEngine == EAudioEngineType::FMODSTUDIO)
+        {
+            // We're using FMOD Studio, so try to load the corresponding support plugin. If this is not enabled in
+            // project settings, this step will fail.
+            AudioEngineStateFactory = FModuleManager::LoadModulePtr<IAudioEngineStateFactory>(TEXT("SteamAudioFMODStudio"));
+        }
+
+        if (SteamAudioSettings.AudioEngine == EAudioEngineType::WWISE)
+        {
+            // We're using Wwise, so try to load the corresponding support plugin. If this is not enabled in
+            // project settings, this step will fail.
+            AudioEngineStateFactory = FModuleManager::LoadModulePtr<IAudioEngineStateFactory>(TEXT("SteamAudioWwise"));
+        }
+
+        if (!AudioEngineStateFactory)
+        {
+            // We are either configured to use Unreal's built-in audio engine, or loading the support plugin for
+            // third-party middleware failed, so fall back to using the built-in audio engine.
+            AudioEngineStateFactory = &FSteamAudioModule::Get();
+        }
+
+        check(AudioEngineStateFactory);
+
+        FSteamAudioModule::SetAudioEngineState(AudioEngineStateFactory->CreateAudioEngineState());
+    }
+
+    if (Reason == EManagerInitReason::PLAYING)
+    {
+        IAudioEngineState* AudioEngineState = FSteamAudioModule::GetAudioEngineState();
+        if (AudioEngineState)
+        {
+            OutAudioSettings = AudioEngineState->GetAudioSettings();
+        }
+
+        // CreateDevices may run on a worker thread, where the SOFA asset can't be loaded.
+        CaptureHRTFSettings();
+
+        // Likewise, read the settings the simulator is created with here, rather than on the worker thread.
+        OutRealTimeSettings = GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_DIRECT | IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
+    }
+
+    return true;
+}
+
+FSteamAudioDeviceCreationResult FSteamAudioManager::CreateDevices(EManagerInitReason Reason, IPLAudioSettings AudioSettings, IPLSimulationSettings RealTimeSettings)
+{
+    IPLSceneType ConfiguredSceneType = SteamAudioSettings.SceneType;
+    IPLReflectionEffectType ConfiguredReflectionEffectType = SteamAudioSettings.ReflectionEffectType;
+
+    // Start from the types BeginInitialization chose, and fall back from there if a device can't be created.
+    FSteamAudioDeviceCreationResult Result;
+    Result.ActualSceneType = ActualSceneType;
+    Result.ActualReflectionEffectType = ActualReflectionEffectType;
+
+    bool bShouldInitEmbree = (Reason == EManagerInitReason::BAKING || Reason == EManagerInitReason::PLAYING) && (ConfiguredSceneType == IPL_SCENETYPE_EMBREE);
+    bool bShouldInitRadeonRays = (Reason == EManagerInitReason::BAKING || Reason == EManagerInitReason::PLAYING) && (ConfiguredSceneType == IPL_SCENETYPE_RADEONRAYS);
+    bool bShouldInitTrueAudioNext = (Reason == EManagerInitReason::PLAYING) && (ConfiguredReflectionEffectType == IPL_REFLECTIONEFFECTTYPE_TAN);
+    Result.bShouldInitOpenCL = (bShouldInitRadeonRays || bShouldInitTrueAudioNext);
+
+    if (bShouldInitEmbree)
+    {
+        check(!EmbreeDevice);
+
+        IPLerror Status = iplEmbreeDeviceCreate(Context, nullptr, &EmbreeDevice);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            Result.ActualSceneType = IPL_SCENETYPE_DEFAULT;
+            UE_LOG(LogSteamAudio, Warning, TEXT("Unable to initialize Embree device. [%d] Falling back to default."), Status);
+        }
+    }
+
+    if (Result.bShouldInitOpenCL)
+    {
+        check(!OpenCLDevice);
+
+        IPLOpenCLDeviceSettings OpenCLDeviceSettings{};
+        OpenCLDeviceSettings.type = SteamAudioSettings.OpenCLDeviceType;
+        OpenCLDeviceSettings.numCUsToReserve = SteamAudioSettings.MaxReservedComputeUnits;
+        OpenCLDeviceSettings.fractionCUsForIRUpdate = SteamAudioSettings.FractionComputeUnitsForIRUpdate;
+        OpenCLDeviceSettings.requiresTAN = (ConfiguredReflectionEffectType == IPL_REFLECTIONEFFECTTYPE_TAN) ? IPL_TRUE : IPL_FALSE;
+
+        IPLOpenCLDeviceList OpenCLDeviceList = nullptr;
+        IPLerror Status = iplOpenCLDeviceListCreate(Context, &OpenCLDeviceSettings, &OpenCLDeviceList);
+        if (Status == IPL_STATUS_SUCCESS)
+        {
+            int NumDevices = iplOpenCLDeviceListGetNumDevices(OpenCLDeviceList);
+
+            if (NumDevices <= 0 && !OpenCLDeviceSettings.requiresTAN && OpenCLDeviceSettings.numCUsToReserve > 0)
+            {
+                // We didn't find any devices, but we had CU reservation specified even though we're not using TAN. So try
+                // initializing without CU reservation.
+                UE_LOG(LogSteamAudio, Warning, TEXT("No OpenCL devices found that match the provided parameters, attempting to initialize without CU reservation."));
+
+                iplOpenCLDeviceListRelease(&OpenCLDeviceList);
+
+                OpenCLDeviceSettings.numCUsToReserve = 0;
+                OpenCLDeviceSettings.fractionCUsForIRUpdate = 0.0f;
+
+                Status = iplOpenCLDeviceListCreate(Context, &OpenCLDeviceSettings, &OpenCLDeviceList);
+                if (Status == IPL_STATUS_SUCCESS)
+                {
+                    NumDevices = iplOpenCLDeviceListGetNumDevices(OpenCLDeviceList);
+                }
+            }
+
+            if (NumDevices > 0)
+            {
+                Status = iplOpenCLDeviceCreate(Context, OpenCLDeviceList, 0, &OpenCLDevice);
+                if (Status != IPL_STATUS_SUCCESS)
+                {
+                    UE_LOG(LogSteamAudio, Warning, TEXT("Unable to create OpenCL device. [%d]"), Status);
+                }
+            }
+            else
+            {
+                UE_LOG(LogSteamAudio, Warning, TEXT("No OpenCL devices found."));
+            }
+
+            iplOpenCLDeviceListRelease(&OpenCLDeviceList);
+        }
+        else
+        {
+            UE_LOG(LogSteamAudio, Warning, TEXT("Unable to create OpenCL device list. [%d]"), Status);
+        }
+    }
+
+    if (bShouldInitRadeonRays)
+    {
+        check(!RadeonRaysDevice);
+
+        IPLerror Status = iplRadeonRaysDeviceCreate(OpenCLDevice, nullptr, &RadeonRaysDevice);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            Result.ActualSceneType = IPL_SCENETYPE_DEFAULT;
+            UE_LOG(LogSteamAudio, Warning, TEXT("Unable to initialize Radeon Rays device. [%d] Falling back to default."), Status);
+        }
+    }
+
+    check(!Scene);
+
+    if (!CreateEmptyScene(Scene, Result.ActualSceneType))
+        return Result;
+
+    if (Reason == EManagerInitReason::PLAYING)
+    {
+        check(!Simulator);
+
+        IPLSimulationSettings SimulationSettings = RealTimeSettings;
+        SimulationSettings.sceneType = Result.ActualSceneType;
+        SimulationSettings.openCLDevice = OpenCLDevice;
+        SimulationSettings.radeonRaysDevice = RadeonRaysDevice;
+
+        IPLerror Status = iplSimulatorCreate(Context, &SimulationSettings, &Simulator);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create simulator. [%d]"), Status);
+            return Result;
+        }
+
+        if (!InitHRTF(AudioSettings))
+            return Result;
+
+        if (bShouldInitTrueAudioNext)
+        {
+            check(!TrueAudioNextDevice);
+
+            IPLTrueAudioNextDeviceSettings TrueAudioNextSettings{};
+            TrueAudioNextSettings.frameSize = AudioSettings.frameSize;
+            TrueAudioNextSettings.irSize = CalcIRSizeForDuration(SteamAudioSettings.TANDuration, AudioSettings.samplingRate);
+            TrueAudioNextSettings.order = SteamAudioSettings.TANAmbisonicOrder;
+            TrueAudioNextSettings.maxSources = SteamAudioSettings.TANMaxSources;
+
+            Status = iplTrueAudioNextDeviceCreate(OpenCLDevice, &TrueAudioNextSettings, &TrueAudioNextDevice);
+            if (Status != IPL_STATUS_SUCCESS)
+            {
+                Result.ActualReflectionEffectType = IPL_REFLECTIONEFFECTTYPE_CONVOLUTION;
+                UE_LOG(LogSteamAudio, Warning, TEXT("Unable to initialize TrueAudio Next device. [%d] Falling back to convolution."), Status);
+            }
+        }
+    }
+
+    Result.bDevicesCreated = true;
+    return Result;
+}
+
+bool FSteamAudioManager::EndInitialization(EManagerInitReason Reason, const FSteamAudioDeviceCreationResult& Result)
+{
+    check(IsInGameThread());
+
+    ActualSceneType = Result.ActualSceneType;
+    ActualReflectionEffectType = Result.ActualReflectionEffectType;
+    bShouldInitOpenCL = Result.bShouldInitOpenCL;
+
+    if (!Result.bDevicesCreated)
+    {
+        ShutDownSteamAudio(false);
+        bInitializationSucceded = false;
+        PendingInitializationCallbacks.Reset();
+        return false;
+    }
+
+    if (Reason == EManagerInitReason::PLAYING)
+    {
+        if (!ThreadPool)
+        {
+            ThreadPool = FQueuedThreadPool::Allocate();
+            if (ThreadPool)
+            {
+                ThreadPool->Create(1);
+            }
+        }
+
+        ThreadPoolIdle = true;
+
+        IAudioEngineState* AudioEngineState = FSteamAudioModule::GetAudioEngineState();
+        if (AudioEngineState)
+        {
+            IPLSimulationSettings SimulationSettings = GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_DIRECT | IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
+            SimulationSettings.openCLDevice = OpenCLDevice;
+            SimulationSettings.radeonRaysDevice = RadeonRaysDevice;
+            SimulationSettings.tanDevice = TrueAudioNextDevice;
+
+            AudioEngineState->Initialize(Context, HRTF, SimulationSettings);
+        }
+    }
+
+    bInitializationSucceded = true;
+    RebuildSettingsSnapshot();
+    RequestSimulatorCommit();
+
+    double InitializationTime = (FPlatformTime::Seconds() - InitializationStartTime) * 1000.0;
+    INC_FLOAT_STAT_BY(STAT_SteamAudioInitializationTime, (float) InitializationTime);
+    UE_LOG(LogSteamAudio, Log, TEXT("Initialized Steam Audio in %.2f ms."), InitializationTime);
+
+    return true;
+}
+
+
+void FSteamAudioManager::ShutDownSteamAudio(bool bResetFlags /* = true */)
+{
+    if (!bInitializationAttempted)
+        return;
+
+    StopRecordingTrajectory();
+
+    // Let background initialization finish, so the devices it created are released below.
+    if (InitializationTask.IsValid())
+    {
+        InitializationTask.Wait();
+        InitializationTask.Reset();
+    }
+
+    IAudioEngineState* AudioEngineState = FSteamAudioModule::GetAudioEngineState();
+    if (AudioEngineState)
+    {
+        AudioEngineState->Destroy();
+    }
+
+    FSteamAudioModule::SetAudioEngineState(nullptr);
+
+    // The cache keeps its own reference, so the HRTF isn't destroyed here.
+    {
+        FScopeLock Lock(&HRTFLock);
+        iplHRTFRelease(&HRTF);
+    }
+
+    if (ThreadPool)
+    {
+        ThreadPool->Destroy();
+        ThreadPool = nullptr;
+        ThreadPoolIdle = true;
+        SimulationUpdateTimeElapsed = 0.0f;
+    }
+
+    // The worker thread is gone, so nothing else can be using the jobs. Queued scene changes hold references to the
+    // objects they modify, so run them to release those references before the scene goes away.
+    IndirectJobs[0].Reset();
+    IndirectJobs[1].Reset();
+    bIndirectJobStaged = false;
+    bIndirectJobInFlight = false;
+
+    TFunction<void()> SceneUpdate;
+    while (PendingSceneUpdates.Dequeue(SceneUpdate))
+    {
+        SceneUpdate();
+    }
+
+    bSimulatorCommitRequested = false;
+    DirtyDynamicObjects.Reset();
+    DynamicObjectTransformRequests = 0;
+    PendingMaterialActors.Reset();
+    MaterialChangesCoalesced = 0;
+
+    if (MaterialCache)
+    {
+        MaterialCache->Reset();
+    }
+
+    iplSimulatorRelease(&Simulator);
+    iplSceneRelease(&Scene);
+    iplTrueAudioNextDeviceRelease(&TrueAudioNextDevice);
+    iplRadeonRaysDeviceRelease(&RadeonRaysDevice);
+    iplOpenCLDeviceRelease(&OpenCLDevice);
+    iplEmbreeDeviceRelease(&EmbreeDevice);
+
+    if (bResetFlags)
+    {
+        bInitializationAttempted = false;
+        bInitializationRequested = false;
+        bInitializationSucceded = false;
+        bSettingsLoaded = false;
+        PendingInitializationCallbacks.Reset();
+    }
+
+    RebuildSettingsSnapshot();
+}
+
+void FSteamAudioManager::RegisterAudioPluginListener(FAudioDevice* OwningDevice)
+{
+    check(OwningDevice);
+    OwningDevice->RegisterPluginListener(AudioPluginListener);
+}
+
+IPLSimulationSettings FSteamAudioManager::GetRealTimeSettings(IPLSimulationFlags Flags)
+{
+    check(bSettingsLoaded);
+
+    FSteamAudioSettingsSnapshotPtr Snapshot = GetSettingsSnapshot();
+    if (!Snapshot)
+        return BuildRealTimeSettings(Flags, GetAudioEngineSettings());
+
+    IPLSimulationSettings SimulationSettings = Snapshot->RealTimeSettings;
+    SimulationSettings.flags = Flags;
+    return SimulationSettings;
+}
+
+IPLSimulationSettings FSteamAudioManager::GetBakingSettings(IPLSimulationFlags Flags)
+{
+    check(bSettingsLoaded);
+
+    FSteamAudioSettingsSnapshotPtr Snapshot = GetSettingsSnapshot();
+    if (!Snapshot)
+        return BuildBakingSettings(Flags, GetAudioEngineSettings());
+
+    IPLSimulationSettings SimulationSettings = Snapshot->BakingSettings;
+    SimulationSettings.flags = Flags;
+    return SimulationSettings;
+}
+
+FSteamAudioSettingsSnapshotPtr FSteamAudioManager::GetSettingsSnapshot() const
+{
+    FScopeLock Lock(&SettingsSnapshotLock);
+    return SettingsSnapshot;
+}
+
+void FSteamAudioManager::RefreshSettingsSnapshot(FSteamAudioSettingsSnapshotPtr& InOutSnapshot, uint32& InOutGeneration) const
+{
+    // Compare against the generation the caller last fetched, rather than the snapshot's own generation, so that
+    // having no snapshot (before initialization, or after it failed) doesn't take the lock on every audio buffer.
+    uint32 Generation = SettingsGeneration.load(std::memory_order_acquire);
+    if (Generation == InOutGeneration)
+        return;
+
+    InOutSnapshot = GetSettingsSnapshot();
+    InOutGeneration = (InOutSnapshot) ? InOutSnapshot->Generation : Generation;
+}
+
+void FSteamAudioManager::RebuildSettingsSnapshot()
+{
+    check(IsInGameThread());
+
+    FSteamAudioSettingsSnapshotPtr NewSnapshot = nullptr;
+    {
+        FScopeLock Lock(&SettingsSnapshotLock);
+
+        uint32 Generation = SettingsGeneration.load(std::memory_order_relaxed) + 1;
+
+        // If Steam Audio isn't initialized, there are no settings to take a snapshot of. We still bump the generation
+        // so consumers drop their reference to the previous snapshot.
+        if (bSettingsLoaded && bInitializationSucceded)
+        {
+            IPLSimulationFlags AllFlags = static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_DIRECT | IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING);
+
+            TSharedRef<FSteamAudioSettingsSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FSteamAudioSettingsSnapshot, ESPMode::ThreadSafe>();
+            Snapshot->Generation = Generation;
+            Snapshot->Settings = SteamAudioSettings;
+            Snapshot->AudioSettings = GetAudioEngineSettings();
+            Snapshot->RealTimeSettings = BuildRealTimeSettings(AllFlags, Snapshot->AudioSettings);
+            Snapshot->BakingSettings = BuildBakingSettings(AllFlags, Snapshot->AudioSettings);
+            NewSnapshot = Snapshot;
+
+            INC_DWORD_STAT(STAT_SteamAudioSettingsSnapshotRebuilds);
+        }
+
+        SettingsSnapshot = NewSnapshot;
+        SettingsGeneration.store(Generation, std::memory_order_release);
+    }
+
+    OnSettingsSnapshotRebuilt.Broadcast(NewSnapshot);
+}
+
+IPLAudioSettings FSteamAudioManager::GetAudioEngineSettings() const
+{
+    IPLAudioSettings AudioSettings{};
+    IAudioEngineState* AudioEngineState = FSteamAudioModule::GetAudioEngineState();
+    if (AudioEngineState)
+    {
+        AudioSettings = AudioEngineState->GetAudioSettings();
+    }
+
+    return AudioSettings;
+}
+
+IPLSimulationSettings FSteamAudioManager::BuildRealTimeSettings(IPLSimulationFlags Flags, const IPLAudioSettings& AudioSettings) const
+{
+    IPLSimulationSettings SimulationSettings{};
+    SimulationSettings.flags = Flags;
+    SimulationSettings.sceneType = ActualSceneType;
+    SimulationSettings.reflectionType = ActualReflectionEffectType;
+    SimulationSettings.maxNumOcclusionSamples = SteamAudioSettings.MaxOcclusionSamples;
+    SimulationSettings.maxNumRays = SteamAudioSettings.RealTimeRays;
+    SimulationSettings.numDiffuseSamples = 32;
+    SimulationSettings.maxDuration = (SteamAudioSettings.ReflectionEffectType == IPL_REFLECTIONEFFECTTYPE_TAN) ? SteamAudioSettings.TANDuration : SteamAudioSettings.RealTimeDuration;
+    SimulationSettings.maxOrder = (SteamAudioSettings.ReflectionEffectType == IPL_REFLECTIONEFFECTTYPE_TAN) ? SteamAudioSettings.TANAmbisonicOrder : SteamAudioSettings.RealTimeAmbisonicOrder;
+    SimulationSettings.maxNumSources = (SteamAudioSettings.ReflectionEffectType == IPL_REFLECTIONEFFECTTYPE_TAN) ? SteamAudioSettings.TANMaxSources : SteamAudioSettings.RealTimeMaxSources;
+    SimulationSettings.numThreads = GetNumThreadsForCPUCoresPercentage(SteamAudioSettings.RealTimeCPUCoresPercentage);
+    SimulationSettings.rayBatchSize = 1;
+    SimulationSettings.numVisSamples = SteamAudioSettings.BakingVisibilitySamples;
+    SimulationSettings.samplingRate = AudioSettings.samplingRate;
+    SimulationSettings.frameSize = AudioSettings.frameSize;
+    SimulationSettings.openCLDevice = OpenCLDevice;
+    SimulationSettings.radeonRaysDevice = RadeonRaysDevice;
+    SimulationSettings.tanDevice = TrueAudioNextDevice;
+
+    return SimulationSettings;
+}
+
+IPLSimulationSettings FSteamAudioManager::BuildBakingSettings(IPLSimulationFlags Flags, const IPLAudioSettings& AudioSettings) const
+{
+    IPLSimulationSettings SimulationSettings{};
+    SimulationSettings.flags = Flags;
+    SimulationSettings.sceneType = ActualSceneType;
+    SimulationSettings.reflectionType = ActualReflectionEffectType;
+    SimulationSettings.maxNumOcclusionSamples = SteamAudioSettings.MaxOcclusionSamples;
+    SimulationSettings.maxNumRays = SteamAudioSettings.BakingRays;
+    SimulationSettings.numDiffuseSamples = 32;
+    SimulationSettings.maxDuration = SteamAudioSettings.BakingDuration;
+    SimulationSettings.maxOrder = SteamAudioSettings.BakingAmbisonicOrder;
+    SimulationSettings.maxNumSources = SteamAudioSettings.RealTimeMaxSources;
+    SimulationSettings.numThreads = GetNumThreadsForCPUCoresPercentage(SteamAudioSettings.BakingCPUCoresPercentage);
+    SimulationSettings.rayBatchSize = 1;
+    SimulationSettings.numVisSamples = SteamAudioSettings.BakingVisibilitySamples;
+    SimulationSettings.samplingRate = AudioSettings.samplingRate;
+    SimulationSettings.frameSize = AudioSettings.frameSize;
+    SimulationSettings.openCLDevice = OpenCLDevice;
+    SimulationSettings.radeonRaysDevice = RadeonRaysDevice;
+    SimulationSettings.tanDevice = TrueAudioNextDevice;
+
+    return SimulationSettings;
+}
+
+IPLInstancedMesh FSteamAudioManager::LoadDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent)
+{
+    check(DynamicObjectComponent);
+
+    if (!bInitializationSucceded)
+        return nullptr;
+
+    if (!DynamicObjectComponent->GetAssetToLoad().IsAsset())
+        return nullptr;
+
+    FString AssetName = DynamicObjectComponent->GetAssetToLoad().GetAssetPathString();
+
+    IPLScene SubScene = nullptr;
+    if (DynamicObjects.Contains(AssetName))
+    {
+        SubScene = DynamicObjects[AssetName];
+        DynamicObjectRefCounts[AssetName]++;
+    }
+    else
+    {
+        if (!CreateEmptyScene(SubScene))
+        {
+            return nullptr;
+        }
+
+        IPLStaticMesh StaticMesh = LoadStaticMeshFromAsset(DynamicObjectComponent->GetAssetToLoad(), Context, SubScene);
+        if (!StaticMesh)
+        {
+            iplSceneRelease(&SubScene);
+            return nullptr;
+        }
+
+        iplStaticMeshAdd(StaticMesh, SubScene);
+        iplSceneCommit(SubScene);
+
+        iplStaticMeshRelease(&StaticMesh);
+
+        DynamicObjects.Add(AssetName, SubScene);
+        DynamicObjectRefCounts.Add(AssetName, 1);
+    }
+
+    IPLInstancedMeshSettings InstancedMeshSettings{};
+    InstancedMeshSettings.subScene = SubScene;
+    InstancedMeshSettings.transform = ConvertTransform(DynamicObjectComponent->GetOwner()->GetRootComponent()->GetComponentTransform());
+
+    IPLInstancedMesh InstancedMesh = nullptr;
+    IPLerror Status = iplInstancedMeshCreate(Scene, &InstancedMeshSettings, &InstancedMesh);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create instanced mesh. [%d]"), Status);
+        return nullptr;
+    }
+
+    return InstancedMesh;
+}
+
+void FSteamAudioManager::UnloadDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent)
+{
+    check(DynamicObjectComponent);
+
+    if (!DynamicObjectComponent->GetAssetToLoad().IsAsset())
+        return;
+
+    FString AssetName = DynamicObjectComponent->GetAssetToLoad().GetAssetPathString();
+
+    if (DynamicObjects.Contains(AssetName))
+    {
+        DynamicObjectRefCounts[AssetName]--;
+        if (DynamicObjectRefCounts[AssetName] <= 0)
+        {
+            iplSceneRelease(&DynamicObjects[AssetName]);
+
+            DynamicObjectRefCounts.Remove(AssetName);
+            DynamicObjects.Remove(AssetName);
+        }
+    }
+}
+
+void FSteamAudioManager::AddSource(USteamAudioSourceComponent* Source)
+{
+    check(Source);
+
+    if (Source->GetOutputSlot() != INDEX_NONE)
+        return;
+
+    int32 Slot = INDEX_NONE;
+    if (FreeOutputSlots.Num() > 0)
+    {
+        Slot = FreeOutputSlots.Pop();
+    }
+    else
+    {
+        Slot = StagedOutputs.AddDefaulted();
+        OutputSlotGenerations.Add(0);
+    }
+
+    StagedOutputs[Slot] = FSteamAudioSourceOutputs();
+    Source->SetOutputSlot(Slot);
+
+    Sources.Add(Source, Source->GetSource(), Slot);
+    RequestSimulatorCommit();
+
+    // Audio Components that were previously found to have no Steam Audio Source component may now have one, so
+    // look them up again.
+    for (auto It = AudioComponentSlots.CreateIterator(); It; ++It)
+    {
+        if (It.Value() == INDEX_NONE)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FSteamAudioManager::RemoveSource(USteamAudioSourceComponent* Source)
+{
+    check(Source);
+
+    if (!Sources.Remove(Source))
+        return;
+
+    int32 Slot = Source->GetOutputSlot();
+    if (Slot == INDEX_NONE)
+        return;
+
+    for (auto It = AudioComponentSlots.CreateIterator(); It; ++It)
+    {
+        if (It.Value() == Slot)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    // Voices hold their own copies of published outputs, so the slot can be reused right away.
+    StagedOutputs[Slot] = FSteamAudioSourceOutputs();
+    ++OutputSlotGenerations[Slot];
+    FreeOutputSlots.Add(Slot);
+    Source->SetOutputSlot(INDEX_NONE);
+
+    RequestSimulatorCommit();
+}
+
+void FSteamAudioManager::FindSourcesInRadius(const FVector& Location, float Radius, TArray<USteamAudioSourceComponent*>& OutSources) const
+{
+    OutSources.Reset();
+
+    IPLVector3 Center = ConvertVector(Location);
+
+    TArray<int32> SourceIndices;
+    Sources.Grid.FindInRadius(FVector3f(Center.x, Center.y, Center.z), ConvertUnrealDistanceToSteamAudio(Radius), SourceIndices);
+
+    for (int32 SourceIndex : SourceIndices)
+    {
+        OutSources.Add(Sources.Components[SourceIndex]);
+    }
+}
+
+void FSteamAudioManager::FindNearestSources(const FVector& Location, int32 Count, TArray<USteamAudioSourceComponent*>& OutSources) const
+{
+    OutSources.Reset();
+
+    IPLVector3 Center = ConvertVector(Location);
+
+    TArray<int32> SourceIndices;
+    Sources.Grid.FindNearest(FVector3f(Center.x, Center.y, Center.z), Count, SourceIndices);
+
+    for (int32 SourceIndex : SourceIndices)
+    {
+        OutSources.Add(Sources.Components[SourceIndex]);
+    }
+}
+
+void FSteamAudioManager::AddListener(USteamAudioListenerComponent* Listener)
+{
+    check(Listener);
+    Listeners.Add(Listener);
+    RequestSimulatorCommit();
+}
+
+void FSteamAudioManager::RemoveListener(USteamAudioListenerComponent* Listener)
+{
+    check(Listener);
+    Listeners.Remove(Listener);
+    RequestSimulatorCommit();
+}
+
+void FSteamAudioManager::EnqueueSceneUpdate(TFunction<void()>&& Update)
+{
+    PendingSceneUpdates.Enqueue(MoveTemp(Update));
+}
+
+void FSteamAudioManager::RequestSimulatorCommit()
+{
+    bSimulatorCommitRequested = true;
+}
+
+void FSteamAudioManager::AddDirtyDynamicObject(USteamAudioDynamicObjectComponent* DynamicObject)
+{
+    check(DynamicObject);
+    DirtyDynamicObjects.Add(DynamicObject);
+    ++DynamicObjectTransformRequests;
+}
+
+void FSteamAudioManager::RemoveDirtyDynamicObject(USteamAudioDynamicObjectComponent* DynamicObject)
+{
+    DirtyDynamicObjects.Remove(DynamicObject);
+}
+
+TStatId FSteamAudioManager::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(FSteamAudioManager, STATGROUP_Tickables);
+}
+
+void FSteamAudioManager::ReserveVoiceOutputs(int32 NumVoices)
+{
+    check(IsInGameThread());
+
+    FSteamAudioVoiceOutputsArray* Current = VoiceOutputs.load(std::memory_order_relaxed);
+    if (Current && Current->NumVoices >= NumVoices)
+        return;
+
+    // Voices still reading from the old array carry on doing so until their next read, and only miss outputs for a
+    // single buffer.
+    TUniquePtr<FSteamAudioVoiceOutputsArray> Array = MakeUnique<FSteamAudioVoiceOutputsArray>();
+    Array->Voices = MakeUnique<FSteamAudioVoiceOutputs[]>(NumVoices);
+    Array->NumVoices = NumVoices;
+
+    VoiceOutputs.store(Array.Get(), std::memory_order_release);
+    VoiceOutputsArrays.Add(MoveTemp(Array));
+
+    VoiceAudioComponentIds.SetNumZeroed(NumVoices);
+}
+
+bool FSteamAudioManager::GetSourceOutputs(uint32 SourceId, uint64 AudioComponentId, FSteamAudioSourceOutputs& OutOutputs)
+{
+    // Sounds that aren't played through an Audio Component can't have a Steam Audio Source component.
+    if (AudioComponentId == 0)
+        return false;
+
+    FSteamAudioVoiceOutputsArray* Voices = VoiceOutputs.load(std::memory_order_acquire);
+    if (!Voices || SourceId >= static_cast<uint32>(Voices->NumVoices))
+        return false;
+
+    const FSteamAudioVoiceOutputs::FBuffer& Buffer = Voices->Voices[SourceId].Read();
+    if (Buffer.AudioComponentId != AudioComponentId)
+    {
+        // The voice has started playing an Audio Component we haven't seen it play before, so ask the game thread to
+        // look up its Steam Audio Source component.
+        PostPendingVoice(SourceId, AudioComponentId);
+        return false;
+    }
+
+    if (!Buffer.bHasOutputs)
+        return false;
+
+    OutOutputs = Buffer.Outputs;
+    return true;
 }
 
-FSteamAudioManager::~FSteamAudioManager()
+void FSteamAudioManager::SetListenerTransform(const FTransform& ListenerTransform)
 {
-    ShutDownSteamAudio();
+    if (AudioPluginListener)
+    {
+        AudioPluginListener->OnListenerUpdated(nullptr, 0, ListenerTransform, 0.0f);
+    }
 }
 
-bool FSteamAudioManager::CreateEmptyScene(IPLScene& SubScene)
+void FSteamAudioManager::PublishOutputsForVoices(TArrayView<const uint64> AudioComponentIds, TArrayView<const FSteamAudioSourceOutputs> Outputs)
 {
-    IPLSceneSettings SceneSettings{};
-    SceneSettings.type = static_cast<IPLSceneType>(ActualSceneType);
-    SceneSettings.embreeDevice = EmbreeDevice;
-    SceneSettings.radeonRaysDevice = RadeonRaysDevice;
+    check(AudioComponentIds.Num() == Outputs.Num());
 
-    IPLerror Status = iplSceneCreate(Context, &SceneSettings, &SubScene);
-    if (Status != IPL_STATUS_SUCCESS)
+    ReserveVoiceOutputs(Outputs.Num());
+
+    FSteamAudioVoiceOutputsArray* Voices = VoiceOutputs.load(std::memory_order_relaxed);
+    for (int32 Voice = 0; Voice < Voices->NumVoices; ++Voice)
     {
-        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create scene. [%d]"), Status);
-        return false;
+        FSteamAudioVoiceOutputs::FBuffer& Buffer = Voices->Voices[Voice].BeginWrite();
+        Buffer.AudioComponentId = (Voice < Outputs.Num()) ? AudioComponentIds[Voice] : 0;
+        Buffer.bHasOutputs = (Voice < Outputs.Num());
+        if (Buffer.bHasOutputs)
+        {
+            Buffer.Outputs = Outputs[Voice];
+        }
+        Voices->Voices[Voice].EndWrite();
     }
-
-    return true;
 }
 
-void FSteamAudioManager::UpdateStaticMesh()
+bool FSteamAudioManager::StartRecordingTrajectory(const FString& FileName)
 {
-    UWorld* World = GEngine->GetCurrentPlayWorld();
-    ULevel* Level = World->GetCurrentLevel();
-    auto StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
-    if (StaticMeshActor)
-    {
-        StaticMeshActor->UpdateStaticMesh();
-    }
+    StopRecordingTrajectory();
+
+    TUniquePtr<FSteamAudioTrajectoryRecorder> Recorder = MakeUnique<FSteamAudioTrajectoryRecorder>();
+    if (!Recorder->Open(FileName))
+        return false;
+
+    TrajectoryRecorder = MoveTemp(Recorder);
+    TrajectoryRecordingTime = 0.0;
+    return true;
 }
 
-void FSteamAudioManager::UpdateStaticMeshMaterial(AStaticMeshActor* StaticMeshActor)
+void FSteamAudioManager::StopRecordingTrajectory()
 {
-    UWorld* World = GEngine->GetCurrentPlayWorld();
-    ULevel* Level = World->GetCurrentLevel();
-    auto SteamAudioStaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
-    if (SteamAudioStaticMeshActor)
+    if (TrajectoryRecorder)
     {
-        SteamAudioStaticMeshActor->UpdateStaticMeshMaterial(StaticMeshActor);
+        TrajectoryRecorder->Close();
+        TrajectoryRecorder.Reset();
     }
 }
 
-void FSteamAudioManager::SetSteamAudioEnabled(bool bNewIsSteamAudioEnabled)
+FString FSteamAudioManager::GetTrajectoryFileName() const
 {
-    bIsSteamAudioEnabled = bNewIsSteamAudioEnabled;
+    return (TrajectoryRecorder) ? TrajectoryRecorder->GetFileName() : FString();
 }
 
-IPLCoordinateSpace3 FSteamAudioManager::GetListenerCoordinates()
+void FSteamAudioManager::RecordTrajectory(float DeltaTime, const IPLCoordinateSpace3& ListenerCoordinates)
 {
-    IPLCoordinateSpace3 ListenerCoordinates{};
+    TrajectoryRecordingTime += DeltaTime;
 
-    if (GetDefault<USteamAudioSettings>()->AudioEngine == EAudioEngineType::UNREAL)
+    FVector ListenerAhead = ConvertVectorInverse(ListenerCoordinates.ahead, false);
+    FVector ListenerUp = ConvertVectorInverse(ListenerCoordinates.up, false);
+    FTransform ListenerTransform(FRotationMatrix::MakeFromXZ(ListenerAhead, ListenerUp).ToQuat(), ConvertVectorInverse(ListenerCoordinates.origin));
+
+    TrajectoryRecorder->RecordListener(TrajectoryRecordingTime, ListenerTransform);
+
+    for (USteamAudioSourceComponent* Source : Sources.Components)
     {
-        // We're running Unreal's built-in audio engine, so use the data provided via the IAudioPluginListener API.
-        if (AudioPluginListener)
+        AActor* Owner = Source->GetOwner();
+        if (Owner)
         {
-            ListenerCoordinates = StaticCastSharedPtr<FSteamAudioPluginListener>(AudioPluginListener)->GetListenerCoordinates();
+            TrajectoryRecorder->RecordSource(TrajectoryRecordingTime, Source->GetUniqueID(), Owner->GetActorTransform());
         }
     }
-    else
+}
+
+void FSteamAudioManager::ParallelForEachSource(TFunctionRef<void(int32)> Function) const
+{
+    int32 NumSources = Sources.Num();
+    int32 NumBatches = FMath::DivideAndRoundUp(NumSources, SourcesPerBatch);
+
+    ParallelFor(NumBatches, [&](int32 BatchIndex)
     {
-        // We're using third-party audio middleware, so use the Steam Audio IAudioEngineState API to get the
-        // listener transform.
-        IAudioEngineState* AudioEngineState = FSteamAudioModule::GetAudioEngineState();
-        if (AudioEngineState)
-        {
-            FTransform ListenerTransform = AudioEngineState->GetListenerTransform();
+        int32 Start = BatchIndex * SourcesPerBatch;
+        int32 End = FMath::Min(Start + SourcesPerBatch, NumSources);
 
-            ListenerCoordinates.origin = SteamAudio::ConvertVector(ListenerTransform.GetLocation());
-            ListenerCoordinates.ahead = SteamAudio::ConvertVector(ListenerTransform.GetUnitAxis(EAxis::X), false);
-            ListenerCoordinates.up = SteamAudio::ConvertVector(ListenerTransform.GetUnitAxis(EAxis::Z), false);
-            ListenerCoordinates.right = SteamAudio::ConvertVector(ListenerTransform.GetUnitAxis(EAxis::Y), false);
+        for (int32 SourceIndex = Start; SourceIndex < End; ++SourceIndex)
+        {
+            Function(SourceIndex);
         }
-    }
-
-    return ListenerCoordinates;
+    }, (NumBatches > 1) ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
 }
 
-bool FSteamAudioManager::InitHRTF(IPLAudioSettings& AudioSettings)
+void FSteamAudioManager::UpdateSourceTransforms()
 {
-    // If we're using Unreal's built-in audio engine, we may have already initialized the HRTF when the
-    // spatialization plugin was initialized. In that case, do nothing.
-    if (HRTF)
-        return true;
-
-    IPLHRTFSettings HRTFSettings{};
-    HRTFSettings.type = IPL_HRTFTYPE_DEFAULT;
-    HRTFSettings.volume = 1.0f;
-    HRTFSettings.normType = IPL_HRTFNORMTYPE_NONE;
+    SCOPE_CYCLE_COUNTER(STAT_SteamAudioUpdateSourceTransforms);
 
-    const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
-    if (Settings)
+    ParallelForEachSource([this](int32 SourceIndex)
     {
-        HRTFSettings.volume = SteamAudio::ConvertDbToLinear(Settings->HRTFVolume);
-        HRTFSettings.normType = static_cast<IPLHRTFNormType>(Settings->HRTFNormalizationType);
+        AActor* Owner = Sources.Components[SourceIndex]->GetOwner();
+        if (Owner)
+        {
+            Sources.Transforms[SourceIndex] = ConvertCoordinateSpace(Owner->GetTransform());
+        }
 
-        if (Settings->SOFAFile.IsValid())
+        // Each source is simulated and rendered for whichever listener is closest, the same way the audio engine
+        // picks a listener for each sound.
+        const IPLVector3& Origin = Sources.Transforms[SourceIndex].origin;
+        FVector3f Position(Origin.x, Origin.y, Origin.z);
+
+        int32 ClosestListener = 0;
+        float ClosestDistSquared = TNumericLimits<float>::Max();
+        for (int32 ListenerIndex = 0; ListenerIndex < TickListeners.Num(); ++ListenerIndex)
         {
-            USOFAFile* SOFAFile = Cast<USOFAFile>(Settings->SOFAFile.TryLoad());
-            if (SOFAFile)
+            const IPLVector3& ListenerOrigin = TickListeners[ListenerIndex].origin;
+            float DistSquared = FVector3f::DistSquared(Position, FVector3f(ListenerOrigin.x, ListenerOrigin.y, ListenerOrigin.z));
+            if (DistSquared < ClosestDistSquared)
             {
-                HRTFSettings.type = IPL_HRTFTYPE_SOFA;
-                HRTFSettings.sofaData = SOFAFile->Data.GetData();
-                HRTFSettings.sofaDataSize = SOFAFile->Data.Num();
-                HRTFSettings.volume = SteamAudio::ConvertDbToLinear(SOFAFile->Volume);
-                HRTFSettings.normType = static_cast<IPLHRTFNormType>(SOFAFile->NormalizationType);
+                ClosestListener = ListenerIndex;
+                ClosestDistSquared = DistSquared;
             }
         }
-    }
-
-    IPLerror Status = iplHRTFCreate(Context, &AudioSettings, &HRTFSettings, &HRTF);
-    if (Status == IPL_STATUS_SUCCESS)
-    {
-        return true;
-    }
-    else
-    {
-        if (HRTFSettings.type == IPL_HRTFTYPE_SOFA)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create HRTF from SOFA file %s, reverting to default HRTF. [%d]"), *Settings->SOFAFile.GetAssetPathString(), Status);
 
-            HRTFSettings.type = IPL_HRTFTYPE_DEFAULT;
+        Sources.ListenerIndices[SourceIndex] = static_cast<uint8>(ClosestListener);
 
-            Status = iplHRTFCreate(Context, &AudioSettings, &HRTFSettings, &HRTF);
-            if (Status == IPL_STATUS_SUCCESS)
-                return true;
+        // Publish the listener pose along with the other outputs, so the audio thread renders the source for the same
+        // listener it was simulated for.
+        int32 Slot = Sources.OutputSlots[SourceIndex];
+        if (StagedOutputs.IsValidIndex(Slot))
+        {
+            StagedOutputs[Slot].ListenerCoordinates = TickListeners[ClosestListener];
+            StagedOutputs[Slot].bHasListenerCoordinates = true;
         }
+    });
 
-        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create HRTF. [%d]"), Status);
-        return false;
+    // Most sources stay in the same cell from one tick to the next, so this rarely changes the grid.
+    int32 NumCellChanges = 0;
+    for (int32 SourceIndex = 0; SourceIndex < Sources.Num(); ++SourceIndex)
+    {
+        const IPLVector3& Origin = Sources.Transforms[SourceIndex].origin;
+        NumCellChanges += Sources.Grid.Update(SourceIndex, FVector3f(Origin.x, Origin.y, Origin.z)) ? 1 : 0;
     }
+
+    SET_DWORD_STAT(STAT_SteamAudioSourceGridCellChanges, NumCellChanges);
 }
 
-bool FSteamAudioManager::InitializeSteamAudio(EManagerInitReason Reason)
+void FSteamAudioManager::ScheduleSources(const FSteamAudioSettings& Settings)
 {
-    // We already tried initializing before, so just return a flag indicating whether or not we succeeded when we last
-    // tried.
-    if (bInitializationAttempted)
-        return bInitializationSucceded;
+    SCOPE_CYCLE_COUNTER(STAT_SteamAudioScheduleSources);
 
-    bInitializationAttempted = true;
+    int32 NumSources = Sources.Num();
+    ++SimulationTickCount;
 
-    const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
-    if (!Settings)
+    if (!Settings.bEnableSimulationLOD)
     {
-        bInitializationSucceded = false;
-        UE_LOG(LogSteamAudio, Error, TEXT("Unable to load Steam Audio Settings."));
-        return false;
-    }
-
-    SteamAudioSettings = Settings->GetSettings();
-    bSettingsLoaded = true;
+        for (int32 SourceIndex = 0; SourceIndex < NumSources; ++SourceIndex)
+        {
+            Sources.LODs[SourceIndex] = ESimulationLOD::FULL;
+            Sources.IndirectScheduled[SourceIndex] = true;
+        }
 
-    IPLSceneType ConfiguredSceneType = SteamAudioSettings.SceneType;
-    IPLReflectionEffectType ConfiguredReflectionEffectType = SteamAudioSettings.ReflectionEffectType;
+        SET_DWORD_STAT(STAT_SteamAudioSimulatedSources, NumSources);
+        SET_DWORD_STAT(STAT_SteamAudioDecimatedSources, 0);
+        SET_DWORD_STAT(STAT_SteamAudioSkippedSources, 0);
+        return;
+    }
 
-    ActualSceneType = ConfiguredSceneType;
-    ActualReflectionEffectType = ConfiguredReflectionEffectType;
+    int32 NumSimulated = 0;
+    int32 NumDecimated = 0;
 
-    if (Reason == EManagerInitReason::EXPORTING_SCENE || Reason == EManagerInitReason::GENERATING_PROBES)
+    // Everything is skipped unless it's in range and audible.
+    for (int32 SourceIndex = 0; SourceIndex < NumSources; ++SourceIndex)
     {
-        ActualSceneType = IPL_SCENETYPE_DEFAULT;
+        Sources.LODs[SourceIndex] = ESimulationLOD::SKIPPED;
+        Sources.IndirectScheduled[SourceIndex] = false;
+        Sources.Scores[SourceIndex] = 0.0f;
     }
 
-    bool bShouldInitEmbree = (Reason == EManagerInitReason::BAKING || Reason == EManagerInitReason::PLAYING) && (ConfiguredSceneType == IPL_SCENETYPE_EMBREE);
-    bool bShouldInitRadeonRays = (Reason == EManagerInitReason::BAKING || Reason == EManagerInitReason::PLAYING) && (ConfiguredSceneType == IPL_SCENETYPE_RADEONRAYS);
-    bool bShouldInitTrueAudioNext = (Reason == EManagerInitReason::PLAYING) && (ConfiguredReflectionEffectType == IPL_REFLECTIONEFFECTTYPE_TAN);
-    bShouldInitOpenCL = (bShouldInitRadeonRays || bShouldInitTrueAudioNext);
+    // Score every source that is in range of its listener and audible. Closer, louder, and higher-priority sources
+    // score higher. Only sources within the cull distance are looked at, using the grid. A source that is out of
+    // range of its listener is out of range of every listener, since its listener is the closest one, and keeping
+    // only the sources assigned to each listener means sources near more than one listener are only scored once.
+    ScheduleOrder.Reset();
 
-    if (bShouldInitEmbree)
+    for (int32 ListenerIndex = 0; ListenerIndex < TickListeners.Num(); ++ListenerIndex)
     {
-        check(!EmbreeDevice);
+        const IPLVector3& ListenerOrigin = TickListeners[ListenerIndex].origin;
+        FVector3f Listener(ListenerOrigin.x, ListenerOrigin.y, ListenerOrigin.z);
+        Sources.Grid.FindInRadius(Listener, Settings.SimulationLODCullDistance, ScheduleCandidates);
 
-        IPLerror Status = iplEmbreeDeviceCreate(Context, nullptr, &EmbreeDevice);
-        if (Status != IPL_STATUS_SUCCESS)
+        for (int32 SourceIndex : ScheduleCandidates)
         {
-            ActualSceneType = IPL_SCENETYPE_DEFAULT;
-            UE_LOG(LogSteamAudio, Warning, TEXT("Unable to initialize Embree device. [%d] Falling back to default."), Status);
+            if (Sources.ListenerIndices[SourceIndex] != ListenerIndex)
+                continue;
+
+            USteamAudioSourceComponent* Component = Sources.Components[SourceIndex];
+            float Audibility = Component->GetAudibility();
+
+            if (Audibility <= 0.0f || Component->SimulationPriority <= 0.0f)
+                continue;
+
+            // Sources beyond the decimation distance are marked by a negative score, so they are never given full
+            // detail but are still ranked among themselves.
+            float Distance = FVector3f::Dist(Sources.Grid.GetPosition(SourceIndex), Listener);
+            float Score = (Component->SimulationPriority * Audibility) / FMath::Max(Distance, 1.0f);
+            Sources.Scores[SourceIndex] = (Distance > Settings.SimulationLODDecimationDistance) ? -1.0f / Score : Score;
+            ScheduleOrder.Add(SourceIndex);
         }
     }
 
-    if (bShouldInitOpenCL)
+    ScheduleOrder.Sort([this](int32 A, int32 B)
     {
-        check(!OpenCLDevice);
-
-        IPLOpenCLDeviceSettings OpenCLDeviceSettings{};
-        OpenCLDeviceSettings.type = SteamAudioSettings.OpenCLDeviceType;
-        OpenCLDeviceSettings.numCUsToReserve = SteamAudioSettings.MaxReservedComputeUnits;
-        OpenCLDeviceSettings.fractionCUsForIRUpdate = SteamAudioSettings.FractionComputeUnitsForIRUpdate;
-        OpenCLDeviceSettings.requiresTAN = (ConfiguredReflectionEffectType == IPL_REFLECTIONEFFECTTYPE_TAN) ? IPL_TRUE : IPL_FALSE;
+        return Sources.Scores[A] > Sources.Scores[B];
+    });
 
-        IPLOpenCLDeviceList OpenCLDeviceList = nullptr;
-        IPLerror Status = iplOpenCLDeviceListCreate(Context, &OpenCLDeviceSettings, &OpenCLDeviceList);
-        if (Status == IPL_STATUS_SUCCESS)
-        {
-            int NumDevices = iplOpenCLDeviceListGetNumDevices(OpenCLDeviceList);
+    // Hand out the per-tick budgets in score order. Anything that doesn't fit is decimated; decimated sources are
+    // updated in a round-robin fashion, keeping their last outputs on the ticks in between.
+    bool bLimitSamples = (Settings.SimulationLODOcclusionSampleBudget > 0);
+    int32 SampleBudget = Settings.SimulationLODOcclusionSampleBudget;
+    int32 DecimatedUpdateInterval = FMath::Max(Settings.SimulationLODDecimatedUpdateInterval, 1);
 
-            if (NumDevices <= 0 && !OpenCLDeviceSettings.requiresTAN && OpenCLDeviceSettings.numCUsToReserve > 0)
-            {
-                // We didn't find any devices, but we had CU reservation specified even though we're not using TAN. So try
-                // initializing without CU reservation.
-                UE_LOG(LogSteamAudio, Warning, TEXT("No OpenCL devices found that match the provided parameters, attempting to initialize without CU reservation."));
+    for (int32 Rank = 0; Rank < ScheduleOrder.Num(); ++Rank)
+    {
+        int32 SourceIndex = ScheduleOrder[Rank];
+        USteamAudioSourceComponent* Component = Sources.Components[SourceIndex];
 
-                iplOpenCLDeviceListRelease(&OpenCLDeviceList);
+        Sources.IndirectScheduled[SourceIndex] = (Rank < Settings.SimulationLODMaxIndirectSources);
 
-                OpenCLDeviceSettings.numCUsToReserve = 0;
-                OpenCLDeviceSettings.fractionCUsForIRUpdate = 0.0f;
+        int32 NumSamples = Component->GetOcclusionSampleCount();
+        bool bWithinBudget = !bLimitSamples || NumSamples <= SampleBudget;
 
-                Status = iplOpenCLDeviceListCreate(Context, &OpenCLDeviceSettings, &OpenCLDeviceList);
-                if (Status == IPL_STATUS_SUCCESS)
-                {
-                    NumDevices = iplOpenCLDeviceListGetNumDevices(OpenCLDeviceList);
-                }
-            }
+        if (Rank < Settings.SimulationLODMaxFullRateSources && Sources.Scores[SourceIndex] > 0.0f && bWithinBudget)
+        {
+            Sources.LODs[SourceIndex] = ESimulationLOD::FULL;
+            SampleBudget -= NumSamples;
+            ++NumSimulated;
+            continue;
+        }
 
-            if (NumDevices > 0)
-            {
-                Status = iplOpenCLDeviceCreate(Context, OpenCLDeviceList, 0, &OpenCLDevice);
-                if (Status != IPL_STATUS_SUCCESS)
-                {
-                    UE_LOG(LogSteamAudio, Warning, TEXT("Unable to create OpenCL device. [%d]"), Status);
-                }
-            }
-            else
-            {
-                UE_LOG(LogSteamAudio, Warning, TEXT("No OpenCL devices found."));
-            }
+        int32 NumDecimatedSamples = DecimateSampleCount(NumSamples, Settings.SimulationLODDecimatedSampleFraction);
+        bool bUpdateThisTick = ((SimulationTickCount + Sources.OutputSlots[SourceIndex]) % DecimatedUpdateInterval) == 0;
 
-            iplOpenCLDeviceListRelease(&OpenCLDeviceList);
-        }
-        else
+        if (bUpdateThisTick && (!bLimitSamples || NumDecimatedSamples <= SampleBudget))
         {
-            UE_LOG(LogSteamAudio, Warning, TEXT("Unable to create OpenCL device list. [%d]"), Status);
+            Sources.LODs[SourceIndex] = ESimulationLOD::DECIMATED;
+            SampleBudget -= NumDecimatedSamples;
+            ++NumDecimated;
         }
     }
 
-    if (bShouldInitRadeonRays)
+    SET_DWORD_STAT(STAT_SteamAudioSimulatedSources, NumSimulated);
+    SET_DWORD_STAT(STAT_SteamAudioDecimatedSources, NumDecimated);
+    SET_DWORD_STAT(STAT_SteamAudioSkippedSources, NumSources - NumSimulated - NumDecimated);
+}
+
+void FSteamAudioManager::BuildSourceInputs(int32 SourceIndex, bool bIndirect, const FSteamAudioSettings& Settings, IPLSimulationInputs& Inputs)
+{
+    USteamAudioSourceComponent* Component = Sources.Components[SourceIndex];
+
+    // The baked data identifier is only used by reflections and pathing, and looking it up involves searching
+    // for components, so only refresh it when we need it.
+    if (bIndirect)
     {
-        check(!RadeonRaysDevice);
+        Sources.BakedDataIdentifiers[SourceIndex] = Component->GetBakedDataIdentifier();
+    }
 
-        IPLerror Status = iplRadeonRaysDeviceCreate(OpenCLDevice, nullptr, &RadeonRaysDevice);
-        if (Status != IPL_STATUS_SUCCESS)
+    Component->GetInputs(Inputs, Settings);
+    Inputs.source = Sources.Transforms[SourceIndex];
+    Inputs.bakedDataIdentifier = Sources.BakedDataIdentifiers[SourceIndex];
+
+    if (bIndirect)
+    {
+        // Sources outside the budget keep the reflections and pathing outputs from the last time they were
+        // included in an update.
+        if (!Sources.IndirectScheduled[SourceIndex])
         {
-            ActualSceneType = IPL_SCENETYPE_DEFAULT;
-            UE_LOG(LogSteamAudio, Warning, TEXT("Unable to initialize Radeon Rays device. [%d] Falling back to default."), Status);
+            Inputs.flags = static_cast<IPLSimulationFlags>(Inputs.flags & ~(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
         }
-    }
 
-    check(!Scene);
+        Sources.Flags[SourceIndex] = Inputs.flags;
+        return;
+    }
 
-    if (!CreateEmptyScene(Scene))
+    switch (Sources.LODs[SourceIndex])
     {
-        ShutDownSteamAudio(false);
-        bInitializationSucceded = false;
-        return false;
+    case ESimulationLOD::DECIMATED:
+        Inputs.numOcclusionSamples = DecimateSampleCount(Inputs.numOcclusionSamples, Settings.SimulationLODDecimatedSampleFraction);
+        Inputs.numTransmissionRays = DecimateSampleCount(Inputs.numTransmissionRays, Settings.SimulationLODDecimatedSampleFraction);
+        break;
+
+    case ESimulationLOD::SKIPPED:
+        Inputs.flags = static_cast<IPLSimulationFlags>(Inputs.flags & ~IPL_SIMULATIONFLAGS_DIRECT);
+        Inputs.directFlags = static_cast<IPLDirectSimulationFlags>(0);
+        break;
+
+    default:
+        break;
     }
+}
 
-    if (Reason == EManagerInitReason::BAKING || Reason == EManagerInitReason::PLAYING)
-    {
-        // Set up communication with the audio engine.
-        IAudioEngineStateFactory* AudioEngineStateFactory = nullptr;
+void FSteamAudioManager::SetSourceDirectInputs(int32 ListenerIndex, const FSteamAudioSettings& Settings)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SteamAudioSetSourceInputs);
 
-        if (SteamAudioSettings.AudioEngine == EAudioEngineType::FMODSTUDIO)
-        {
-            // We're using FMOD Studio, so try to load the corresponding support plugin. If this is not enabled in
-            // project settings, this step will fail.
-            AudioEngineStateFactory = FModuleManager::LoadModulePtr<IAudioEngineStateFactory>(TEXT("SteamAudioFMODStudio"));
-        }
+    ParallelForEachSource([this, ListenerIndex, &Settings](int32 SourceIndex)
+    {
+        IPLSimulationInputs Inputs{};
 
-        if (SteamAudioSettings.AudioEngine == EAudioEngineType::WWISE)
+        // Sources assigned to other listeners are left out of this run, the same way as skipped sources, so their
+        // outputs from their own listener's run are kept.
+        if (Sources.ListenerIndices[SourceIndex] == ListenerIndex)
         {
-            // We're using Wwise, so try to load the corresponding support plugin. If this is not enabled in
-            // project settings, this step will fail.
-            AudioEngineStateFactory = FModuleManager::LoadModulePtr<IAudioEngineStateFactory>(TEXT("SteamAudioWwise"));
+            BuildSourceInputs(SourceIndex, false, Settings, Inputs);
         }
-
-        if (!AudioEngineStateFactory)
+        else
         {
-            // We are either configured to use Unreal's built-in audio engine, or loading the support plugin for
-            // third-party middleware failed, so fall back to using the built-in audio engine.
-            AudioEngineStateFactory = &FSteamAudioModule::Get();
+            Inputs.source = Sources.Transforms[SourceIndex];
         }
 
-        check(AudioEngineStateFactory);
+        iplSourceSetInputs(Sources.Handles[SourceIndex], IPL_SIMULATIONFLAGS_DIRECT, &Inputs);
+    });
+}
 
-        FSteamAudioModule::SetAudioEngineState(AudioEngineStateFactory->CreateAudioEngineState());
-    }
+void FSteamAudioManager::UpdateSourceDirectOutputs(int32 ListenerIndex)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SteamAudioUpdateSourceOutputs);
 
-    if (Reason == EManagerInitReason::PLAYING)
+    ParallelForEachSource([this, ListenerIndex](int32 SourceIndex)
     {
-        check(!Simulator);
+        if (Sources.LODs[SourceIndex] == ESimulationLOD::SKIPPED || Sources.ListenerIndices[SourceIndex] != ListenerIndex)
+            return;
 
-        IPLSimulationSettings SimulationSettings = GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_DIRECT | IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
-        SimulationSettings.openCLDevice = OpenCLDevice;
-        SimulationSettings.radeonRaysDevice = RadeonRaysDevice;
-        SimulationSettings.tanDevice = TrueAudioNextDevice;
+        Sources.Components[SourceIndex]->UpdateOutputs(IPL_SIMULATIONFLAGS_DIRECT);
+        StageDirectOutputs(SourceIndex);
+    });
+}
 
-        IPLerror Status = iplSimulatorCreate(Context, &SimulationSettings, &Simulator);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            ShutDownSteamAudio(false);
-            bInitializationSucceded = false;
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create simulator. [%d]"), Status);
-            return false;
-        }
+void FSteamAudioManager::StageDirectOutputs(int32 SourceIndex)
+{
+    int32 Slot = Sources.OutputSlots[SourceIndex];
+    if (!StagedOutputs.IsValidIndex(Slot))
+        return;
 
-        if (!ThreadPool)
+    USteamAudioSourceComponent* Source = Sources.Components[SourceIndex];
+
+    // These are either the simulated values or the values specified on the component, depending on whether
+    // occlusion and transmission are being simulated.
+    FSteamAudioSourceOutputs& Outputs = StagedOutputs[Slot];
+    Outputs.Occlusion = Source->OcclusionValue;
+    Outputs.Transmission[0] = Source->TransmissionLowValue;
+    Outputs.Transmission[1] = Source->TransmissionMidValue;
+    Outputs.Transmission[2] = Source->TransmissionHighValue;
+}
+
+void FSteamAudioManager::ResolveAudioComponentSlots()
+{
+    for (FPendingVoice& PendingVoice : PendingVoices)
+    {
+        if (PendingVoice.State.load(std::memory_order_acquire) != 2)
+            continue;
+
+        if (VoiceAudioComponentIds.IsValidIndex(PendingVoice.SourceId))
         {
-            ThreadPool = FQueuedThreadPool::Allocate();
-            if (ThreadPool)
-            {
-                ThreadPool->Create(1);
-            }
+            VoiceAudioComponentIds[PendingVoice.SourceId] = PendingVoice.AudioComponentId;
         }
 
-        ThreadPoolIdle = true;
-
-        IAudioEngineState* AudioEngineState = FSteamAudioModule::GetAudioEngineState();
+        PendingVoice.State.store(0, std::memory_order_release);
+    }
 
-        IPLAudioSettings AudioSettings{};
-        if (AudioEngineState)
+    // Forget about Audio Components that have been destroyed.
+    for (auto It = AudioComponentSlots.CreateIterator(); It; ++It)
+    {
+        if (!UAudioComponent::GetAudioComponentFromID(It.Key()))
         {
-            AudioSettings = AudioEngineState->GetAudioSettings();
+            It.RemoveCurrent();
         }
+    }
 
-        if (!InitHRTF(AudioSettings))
+    for (uint64& AudioComponentId : VoiceAudioComponentIds)
+    {
+        if (AudioComponentId == 0 || AudioComponentSlots.Contains(AudioComponentId))
+            continue;
+
+        UAudioComponent* AudioComponent = UAudioComponent::GetAudioComponentFromID(AudioComponentId);
+        if (!AudioComponent)
         {
-            ShutDownSteamAudio(false);
-            bInitializationSucceded = false;
-            return false;
+            AudioComponentId = 0;
+            continue;
         }
 
-        if (bShouldInitTrueAudioNext)
-        {
-            check(!TrueAudioNextDevice);
+        AActor* Owner = AudioComponent->GetOwner();
+        USteamAudioSourceComponent* SourceComponent = (Owner) ? Owner->FindComponentByClass<USteamAudioSourceComponent>() : nullptr;
 
-            IPLTrueAudioNextDeviceSettings TrueAudioNextSettings{};
-            TrueAudioNextSettings.frameSize = AudioSettings.frameSize;
-            TrueAudioNextSettings.irSize = CalcIRSizeForDuration(SteamAudioSettings.TANDuration, AudioSettings.samplingRate);
-            TrueAudioNextSettings.order = SteamAudioSettings.TANAmbisonicOrder;
-            TrueAudioNextSettings.maxSources = SteamAudioSettings.TANMaxSources;
+        AudioComponentSlots.Add(AudioComponentId, (SourceComponent) ? SourceComponent->GetOutputSlot() : INDEX_NONE);
+    }
+}
 
-            Status = iplTrueAudioNextDeviceCreate(OpenCLDevice, &TrueAudioNextSettings, &TrueAudioNextDevice);
-            if (Status != IPL_STATUS_SUCCESS)
-            {
-                ActualReflectionEffectType = IPL_REFLECTIONEFFECTTYPE_CONVOLUTION;
-                UE_LOG(LogSteamAudio, Warning, TEXT("Unable to initialize TrueAudio Next device. [%d] Falling back to convolution."), Status);
-            }
-        }
+void FSteamAudioManager::PostPendingVoice(uint32 SourceId, uint64 AudioComponentId)
+{
+    // Probe a few entries from a rotating start, so concurrent posts rarely contend. If they're all taken, drop the
+    // voice: the audio thread posts it again the next time the lookup fails.
+    static constexpr int32 MaxProbes = 8;
 
-        if (AudioEngineState)
+    uint32 Start = NextPendingVoice.fetch_add(1, std::memory_order_relaxed);
+    for (int32 Probe = 0; Probe < MaxProbes; ++Probe)
+    {
+        FPendingVoice& PendingVoice = PendingVoices[(Start + Probe) % MaxPendingVoices];
+
+        uint32 Expected = 0;
+        if (PendingVoice.State.compare_exchange_strong(Expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
         {
-            AudioEngineState->Initialize(Context, HRTF, SimulationSettings);
+            PendingVoice.SourceId = SourceId;
+            PendingVoice.AudioComponentId = AudioComponentId;
+            PendingVoice.State.store(2, std::memory_order_release);
+            return;
         }
     }
-
-    bInitializationSucceded = true;
-    return true;
 }
 
-void FSteamAudioManager::ShutDownSteamAudio(bool bResetFlags /* = true */)
+void FSteamAudioManager::PublishOutputs()
 {
-    if (!bInitializationAttempted)
+    FSteamAudioVoiceOutputsArray* Voices = VoiceOutputs.load(std::memory_order_relaxed);
+    if (!Voices)
         return;
 
-    IAudioEngineState* AudioEngineState = FSteamAudioModule::GetAudioEngineState();
-    if (AudioEngineState)
+    for (int32 Voice = 0; Voice < Voices->NumVoices; ++Voice)
     {
-        AudioEngineState->Destroy();
+        uint64 AudioComponentId = VoiceAudioComponentIds[Voice];
+        const int32* Slot = (AudioComponentId != 0) ? AudioComponentSlots.Find(AudioComponentId) : nullptr;
+
+        FSteamAudioVoiceOutputs::FBuffer& Buffer = Voices->Voices[Voice].BeginWrite();
+        Buffer.AudioComponentId = AudioComponentId;
+        Buffer.bHasOutputs = (Slot && StagedOutputs.IsValidIndex(*Slot));
+        if (Buffer.bHasOutputs)
+        {
+            Buffer.Outputs = StagedOutputs[*Slot];
+        }
+        Voices->Voices[Voice].EndWrite();
     }
+}
 
-    FSteamAudioModule::SetAudioEngineState(nullptr);
+void FSteamAudioManager::FlushSceneUpdates()
+{
+    check(!bIndirectJobInFlight);
 
-    iplHRTFRelease(&HRTF);
+    bool bCommit = bSimulatorCommitRequested.exchange(false);
 
-    if (ThreadPool)
+    TFunction<void()> SceneUpdate;
+    while (PendingSceneUpdates.Dequeue(SceneUpdate))
     {
-        ThreadPool->Destroy();
-        ThreadPool = nullptr;
-        ThreadPoolIdle = true;
-        SimulationUpdateTimeElapsed = 0.0f;
+        SceneUpdate();
+        bCommit = true;
     }
 
-    iplSimulatorRelease(&Simulator);
-    iplSceneRelease(&Scene);
-    iplTrueAudioNextDeviceRelease(&TrueAudioNextDevice);
-    iplRadeonRaysDeviceRelease(&RadeonRaysDevice);
-    iplOpenCLDeviceRelease(&OpenCLDevice);
-    iplEmbreeDeviceRelease(&EmbreeDevice);
-
-    if (bResetFlags)
+    // Dynamic objects can move many times per frame; only their latest transforms are applied.
+    if (DirtyDynamicObjects.Num() > 0)
     {
-        bInitializationAttempted = false;
-        bInitializationSucceded = false;
-        bSettingsLoaded = false;
-    }
-}
+        SCOPE_CYCLE_COUNTER(STAT_SteamAudioUpdateDynamicObjects);
 
-void FSteamAudioManager::RegisterAudioPluginListener(FAudioDevice* OwningDevice)
-{
-    check(OwningDevice);
-    OwningDevice->RegisterPluginListener(AudioPluginListener);
-}
+        for (USteamAudioDynamicObjectComponent* DynamicObject : DirtyDynamicObjects)
+        {
+            DynamicObject->UpdateTransform();
+        }
 
-IPLSimulationSettings FSteamAudioManager::GetRealTimeSettings(IPLSimulationFlags Flags)
-{
-    check(bSettingsLoaded);
+        SET_DWORD_STAT(STAT_SteamAudioDynamicObjectTransformsApplied, DirtyDynamicObjects.Num());
+        SET_DWORD_STAT(STAT_SteamAudioDynamicObjectTransformsCoalesced, DynamicObjectTransformRequests - DirtyDynamicObjects.Num());
 
-    IPLAudioSettings AudioSettings{};
-    IAudioEngineState* AudioEngineState = FSteamAudioModule::GetAudioEngineState();
-    if (AudioEngineState)
-    {
-        AudioSettings = AudioEngineState->GetAudioSettings();
+        DirtyDynamicObjects.Reset();
+        DynamicObjectTransformRequests = 0;
+        bCommit = true;
     }
 
-    IPLSimulationSettings SimulationSettings{};
-    SimulationSettings.flags = Flags;
-    SimulationSettings.sceneType = ActualSceneType;
-    SimulationSettings.reflectionType = ActualReflectionEffectType;
-    SimulationSettings.maxNumOcclusionSamples = SteamAudioSettings.MaxOcclusionSamples;
-    SimulationSettings.maxNumRays = SteamAudioSettings.RealTimeRays;
-    SimulationSettings.numDiffuseSamples = 32;
-    SimulationSettings.maxDuration = (SteamAudioSettings.ReflectionEffectType == IPL_REFLECTIONEFFECTTYPE_TAN) ? SteamAudioSettings.TANDuration : SteamAudioSettings.RealTimeDuration;
-    SimulationSettings.maxOrder = (SteamAudioSettings.ReflectionEffectType == IPL_REFLECTIONEFFECTTYPE_TAN) ? SteamAudioSettings.TANAmbisonicOrder : SteamAudioSettings.RealTimeAmbisonicOrder;
-    SimulationSettings.maxNumSources = (SteamAudioSettings.ReflectionEffectType == IPL_REFLECTIONEFFECTTYPE_TAN) ? SteamAudioSettings.TANMaxSources : SteamAudioSettings.RealTimeMaxSources;
-    SimulationSettings.numThreads = GetNumThreadsForCPUCoresPercentage(SteamAudioSettings.RealTimeCPUCoresPercentage);
-    SimulationSettings.rayBatchSize = 1;
-    SimulationSettings.numVisSamples = SteamAudioSettings.BakingVisibilitySamples;
-    SimulationSettings.samplingRate = AudioSettings.samplingRate;
-    SimulationSettings.frameSize = AudioSettings.frameSize;
-    SimulationSettings.openCLDevice = OpenCLDevice;
-    SimulationSettings.radeonRaysDevice = RadeonRaysDevice;
-    SimulationSettings.tanDevice = TrueAudioNextDevice;
+    if (!bCommit)
+        return;
 
-    return SimulationSettings;
+    SCOPE_CYCLE_COUNTER(STAT_SteamAudioCommitScene);
+
+    iplSceneCommit(Scene);
+
+    iplSimulatorSetScene(Simulator, Scene);
+    iplSimulatorCommit(Simulator);
 }
 
-IPLSimulationSettings FSteamAudioManager::GetBakingSettings(IPLSimulationFlags Flags)
+void FSteamAudioManager::StageIndirectJob(const IPLSimulationSharedInputs& SharedInputs, const FSteamAudioSettingsSnapshot& Snapshot)
 {
-    check(bSettingsLoaded);
+    SCOPE_CYCLE_COUNTER(STAT_SteamAudioStageIndirectInputs);
 
-    IPLAudioSettings AudioSettings{};
-    IAudioEngineState* AudioEngineState = FSteamAudioModule::GetAudioEngineState();
-    if (AudioEngineState)
+    // If the worker thread was too busy to pick up the previously staged inputs, they are simply replaced.
+    FSteamAudioIndirectJob& Job = IndirectJobs[StagingIndirectJob];
+    Job.Reset();
+
+    int32 NumSources = Sources.Num();
+
+    Job.SharedInputs = SharedInputs;
+    Job.Listeners = TickListeners;
+    Job.NumPathingCoeffs = CalcNumChannelsForAmbisonicOrder(Snapshot.RealTimeSettings.maxOrder);
+    Job.Handles.SetNumUninitialized(NumSources);
+    Job.Inputs.SetNumZeroed(NumSources);
+    Job.ListenerIndices = Sources.ListenerIndices;
+    Job.OutputSlots.SetNumUninitialized(NumSources);
+    Job.OutputSlotGenerations.SetNumUninitialized(NumSources);
+    Job.Outputs.SetNum(NumSources);
+
+    ParallelForEachSource([this, &Job, &Snapshot](int32 SourceIndex)
     {
-        AudioSettings = AudioEngineState->GetAudioSettings();
+        BuildSourceInputs(SourceIndex, true, Snapshot.Settings, Job.Inputs[SourceIndex]);
+    });
+
+    for (int32 SourceIndex = 0; SourceIndex < NumSources; ++SourceIndex)
+    {
+        int32 Slot = Sources.OutputSlots[SourceIndex];
+
+        Job.Handles[SourceIndex] = iplSourceRetain(Sources.Handles[SourceIndex]);
+        Job.OutputSlots[SourceIndex] = Slot;
+        Job.OutputSlotGenerations[SourceIndex] = OutputSlotGenerations[Slot];
     }
 
-    IPLSimulationSettings SimulationSettings{};
-    SimulationSettings.flags = Flags;
-    SimulationSettings.sceneType = ActualSceneType;
-    SimulationSettings.reflectionType = ActualReflectionEffectType;
-    SimulationSettings.maxNumOcclusionSamples = SteamAudioSettings.MaxOcclusionSamples;
-    SimulationSettings.maxNumRays = SteamAudioSettings.BakingRays;
-    SimulationSettings.numDiffuseSamples = 32;
-    SimulationSettings.maxDuration = SteamAudioSettings.BakingDuration;
-    SimulationSettings.maxOrder = SteamAudioSettings.BakingAmbisonicOrder;
-    SimulationSettings.maxNumSources = SteamAudioSettings.RealTimeMaxSources;
-    SimulationSettings.numThreads = GetNumThreadsForCPUCoresPercentage(SteamAudioSettings.BakingCPUCoresPercentage);
-    SimulationSettings.rayBatchSize = 1;
-    SimulationSettings.numVisSamples = SteamAudioSettings.BakingVisibilitySamples;
-    SimulationSettings.samplingRate = AudioSettings.samplingRate;
-    SimulationSettings.frameSize = AudioSettings.frameSize;
-    SimulationSettings.openCLDevice = OpenCLDevice;
-    SimulationSettings.radeonRaysDevice = RadeonRaysDevice;
-    SimulationSettings.tanDevice = TrueAudioNextDevice;
+    for (USteamAudioListenerComponent* Listener : Listeners)
+    {
+        IPLSource ListenerSource = Listener->GetSource();
+        if (!ListenerSource)
+            continue;
 
-    return SimulationSettings;
+        IPLSimulationInputs& Inputs = Job.ListenerInputs.AddZeroed_GetRef();
+        Listener->GetInputs(Inputs);
+
+        Job.ListenerHandles.Add(iplSourceRetain(ListenerSource));
+    }
+
+    Job.StagedCycles = FPlatformTime::Cycles64();
+    bIndirectJobStaged = true;
 }
 
-IPLInstancedMesh FSteamAudioManager::LoadDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent)
+void FSteamAudioManager::KickIndirectJob()
 {
-    check(DynamicObjectComponent);
+    check(!bIndirectJobInFlight && bIndirectJobStaged);
 
-    if (!bInitializationSucceded)
-        return nullptr;
+    // Running reflections without a valid OpenCL device may crash when using Radeon Rays or TrueAudio Next.
+    if (bShouldInitOpenCL && !OpenCLDevice)
+        return;
 
-    if (!DynamicObjectComponent->GetAssetToLoad().IsAsset())
-        return nullptr;
+    FSteamAudioIndirectJob& Job = IndirectJobs[StagingIndirectJob];
 
-    FString AssetName = DynamicObjectComponent->GetAssetToLoad().GetAssetPathString();
+    // From here on, the worker thread owns this job, and new inputs are staged into the other one.
+    StagingIndirectJob = 1 - StagingIndirectJob;
+    bIndirectJobStaged = false;
+    bIndirectJobInFlight = true;
+    ThreadPoolIdle = false;
 
-    IPLScene SubScene = nullptr;
-    if (DynamicObjects.Contains(AssetName))
+    AsyncPool(*ThreadPool, [this, &Job]
     {
-        SubScene = DynamicObjects[AssetName];
-        DynamicObjectRefCounts[AssetName]++;
-    }
-    else
+        RunIndirectJob(Job);
+        ThreadPoolIdle.store(true, std::memory_order_release);
+    });
+}
+
+void FSteamAudioManager::RunIndirectJob(FSteamAudioIndirectJob& Job)
+{
+    Job.StartCycles = FPlatformTime::Cycles64();
+
+    IPLSimulationFlags IndirectFlags = static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING);
+
+    // The simulator only takes one listener at a time, so run once per listener, each time including only the
+    // sources assigned to that listener. The scene is shared, and was committed before the job was handed over.
+    // Reflections and pathing inputs are only ever set on this thread, so they don't need to be synchronized with
+    // the direct inputs set on the game thread.
+    for (int32 ListenerIndex = 0; ListenerIndex < Job.Listeners.Num(); ++ListenerIndex)
     {
-        if (!CreateEmptyScene(SubScene))
+        Job.SharedInputs.listener = Job.Listeners[ListenerIndex];
+        iplSimulatorSetSharedInputs(Simulator, IndirectFlags, &Job.SharedInputs);
+
+        for (int32 Index = 0; Index < Job.Handles.Num(); ++Index)
         {
-            return nullptr;
+            IPLSimulationInputs Inputs = Job.Inputs[Index];
+            if (Job.ListenerIndices[Index] != ListenerIndex)
+            {
+                Inputs.flags = static_cast<IPLSimulationFlags>(Inputs.flags & ~IndirectFlags);
+            }
+
+            iplSourceSetInputs(Job.Handles[Index], IndirectFlags, &Inputs);
         }
 
-        IPLStaticMesh StaticMesh = LoadStaticMeshFromAsset(DynamicObjectComponent->GetAssetToLoad(), Context, SubScene);
-        if (!StaticMesh)
+        // Listener-centric reverb is only simulated for the primary listener.
+        for (int32 Index = 0; Index < Job.ListenerHandles.Num(); ++Index)
         {
-            iplSceneRelease(&SubScene);
-            return nullptr;
+            IPLSimulationInputs Inputs = Job.ListenerInputs[Index];
+            if (ListenerIndex != 0)
+            {
+                Inputs.flags = static_cast<IPLSimulationFlags>(0);
+            }
+
+            iplSourceSetInputs(Job.ListenerHandles[Index], IPL_SIMULATIONFLAGS_REFLECTIONS, &Inputs);
         }
 
-        iplStaticMeshAdd(StaticMesh, SubScene);
-        iplSceneCommit(SubScene);
+        iplSimulatorRunReflections(Simulator);
+        iplSimulatorRunPathing(Simulator);
 
-        iplStaticMeshRelease(&StaticMesh);
+        for (int32 Index = 0; Index < Job.Handles.Num(); ++Index)
+        {
+            if (Job.ListenerIndices[Index] != ListenerIndex || !(Job.Inputs[Index].flags & IndirectFlags))
+                continue;
 
-        DynamicObjects.Add(AssetName, SubScene);
-        DynamicObjectRefCounts.Add(AssetName, 1);
-    }
+            IPLSimulationOutputs SimulationOutputs{};
+            iplSourceGetOutputs(Job.Handles[Index], IndirectFlags, &SimulationOutputs);
 
-    IPLInstancedMeshSettings InstancedMeshSettings{};
-    InstancedMeshSettings.subScene = SubScene;
-    InstancedMeshSettings.transform = ConvertTransform(DynamicObjectComponent->GetOwner()->GetRootComponent()->GetComponentTransform());
+            FSteamAudioSourceOutputs& Outputs = Job.Outputs[Index];
+            Outputs.bHasIndirectOutputs = true;
+            Outputs.Reflections = SimulationOutputs.reflections;
+            Outputs.Pathing = SimulationOutputs.pathing;
+            Outputs.Pathing.shCoeffs = nullptr;
 
-    IPLInstancedMesh InstancedMesh = nullptr;
-    IPLerror Status = iplInstancedMeshCreate(Scene, &InstancedMeshSettings, &InstancedMesh);
-    if (Status != IPL_STATUS_SUCCESS)
-    {
-        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create instanced mesh. [%d]"), Status);
-        return nullptr;
+            // The coefficients are owned by the simulator and will be overwritten by the next simulation run, so copy
+            // them.
+            if (SimulationOutputs.pathing.shCoeffs)
+            {
+                Outputs.NumPathingCoeffs = FMath::Min(Job.NumPathingCoeffs, MaxPathingCoeffs);
+                FMemory::Memcpy(Outputs.PathingCoeffs, SimulationOutputs.pathing.shCoeffs, Outputs.NumPathingCoeffs * sizeof(float));
+            }
+        }
     }
 
-    return InstancedMesh;
+    Job.EndCycles = FPlatformTime::Cycles64();
 }
 
-void FSteamAudioManager::UnloadDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent)
+void FSteamAudioManager::CollectIndirectJob()
 {
-    check(DynamicObjectComponent);
-
-    if (!DynamicObjectComponent->GetAssetToLoad().IsAsset())
+    if (!bIndirectJobInFlight || !ThreadPoolIdle.load(std::memory_order_acquire))
         return;
 
-    FString AssetName = DynamicObjectComponent->GetAssetToLoad().GetAssetPathString();
+    SCOPE_CYCLE_COUNTER(STAT_SteamAudioCollectIndirectOutputs);
 
-    if (DynamicObjects.Contains(AssetName))
+    FSteamAudioIndirectJob& Job = IndirectJobs[1 - StagingIndirectJob];
+
+    for (int32 Index = 0; Index < Job.Handles.Num(); ++Index)
     {
-        DynamicObjectRefCounts[AssetName]--;
-        if (DynamicObjectRefCounts[AssetName] <= 0)
-        {
-            iplSceneRelease(&DynamicObjects[AssetName]);
+        const FSteamAudioSourceOutputs& JobOutputs = Job.Outputs[Index];
+        if (!JobOutputs.bHasIndirectOutputs)
+            continue;
+
+        // Skip sources that were unregistered while the job was running.
+        int32 Slot = Job.OutputSlots[Index];
+        if (!StagedOutputs.IsValidIndex(Slot) || OutputSlotGenerations[Slot] != Job.OutputSlotGenerations[Index])
+            continue;
+
+        FSteamAudioSourceOutputs& Outputs = StagedOutputs[Slot];
+        Outputs.bHasIndirectOutputs = true;
+        Outputs.Reflections = JobOutputs.Reflections;
+        Outputs.Pathing = JobOutputs.Pathing;
+        Outputs.NumPathingCoeffs = JobOutputs.NumPathingCoeffs;
+        FMemory::Memcpy(Outputs.PathingCoeffs, JobOutputs.PathingCoeffs, JobOutputs.NumPathingCoeffs * sizeof(float));
+    }
 
-            DynamicObjectRefCounts.Remove(AssetName);
-            DynamicObjects.Remove(AssetName);
-        }
+    for (USteamAudioListenerComponent* Listener : Listeners)
+    {
+        Listener->UpdateOutputs();
     }
-}
 
-void FSteamAudioManager::AddSource(USteamAudioSourceComponent* Source)
-{
-    check(Source);
-    Sources.Add(Source);
-}
+    uint64 CollectedCycles = FPlatformTime::Cycles64();
+    SET_FLOAT_STAT(STAT_SteamAudioIndirectQueueLatency, FPlatformTime::ToMilliseconds64(Job.StartCycles - Job.StagedCycles));
+    SET_FLOAT_STAT(STAT_SteamAudioIndirectSimulationTime, FPlatformTime::ToMilliseconds64(Job.EndCycles - Job.StartCycles));
+    SET_FLOAT_STAT(STAT_SteamAudioIndirectPublishLatency, FPlatformTime::ToMilliseconds64(CollectedCycles - Job.EndCycles));
 
-void FSteamAudioManager::RemoveSource(USteamAudioSourceComponent* Source)
-{
-    check(Source);
-    Sources.Remove(Source);
+    Job.Reset();
+    bIndirectJobInFlight = false;
 }
 
-void FSteamAudioManager::AddListener(USteamAudioListenerComponent* Listener)
+void FSteamAudioManager::Tick(float DeltaTime)
 {
-    check(Listener);
-    Listeners.Add(Listener);
-}
+    SCOPE_CYCLE_COUNTER(STAT_SteamAudioManagerTick);
 
-void FSteamAudioManager::RemoveListener(USteamAudioListenerComponent* Listener)
-{
-    check(Listener);
-    Listeners.Remove(Listener);
-}
+    // Initialization runs in the background; until it is done there is nothing to simulate.
+    if (!InitializeSteamAudioAsync())
+        return;
 
-TStatId FSteamAudioManager::GetStatId() const
-{
-    RETURN_QUICK_DECLARE_CYCLE_STAT(FSteamAudioManager, STATGROUP_Tickables);
-}
+    // Register everything that was waiting for initialization.
+    RunInitializationCallbacks();
 
-void FSteamAudioManager::Tick(float DeltaTime)
-{
-    if (!InitializeSteamAudio(EManagerInitReason::PLAYING))
+    FSteamAudioSettingsSnapshotPtr Snapshot = GetSettingsSnapshot();
+    if (!Snapshot)
         return;
 
-    if (ThreadPool && ThreadPoolIdle)
-    {
-        iplSceneCommit(Scene);
+    ResolveAudioComponentSlots();
 
-        iplSimulatorSetScene(Simulator, Scene);
-        iplSimulatorCommit(Simulator);
+    // Pick up the results of the last reflections and pathing run, if it has finished. Scene changes can only be
+    // committed while the worker thread is idle.
+    CollectIndirectJob();
+
+    // Material changes made since the last tick are queued as scene changes, so they share the next commit.
+    ApplyMaterialChanges();
+
+    if (!bIndirectJobInFlight)
+    {
+        FlushSceneUpdates();
     }
 
-    IPLSimulationSettings SimulationSettings = GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_DIRECT | IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
+    const IPLSimulationSettings& SimulationSettings = Snapshot->RealTimeSettings;
+
+    GetAllListenerCoordinates(TickListeners);
 
     IPLSimulationSharedInputs SharedInputs{};
-    SharedInputs.listener = GetListenerCoordinates();
+    SharedInputs.listener = TickListeners[0];
 	SharedInputs.numRays = SimulationSettings.maxNumRays;
 	SharedInputs.numBounces = SteamAudioSettings.RealTimeBounces;
 	SharedInputs.duration = SimulationSettings.maxDuration;
 	SharedInputs.order = SimulationSettings.maxOrder;
 	SharedInputs.irradianceMinDistance = SteamAudioSettings.RealTimeIrradianceMinDistance;
 
-    iplSimulatorSetSharedInputs(Simulator, IPL_SIMULATIONFLAGS_DIRECT, &SharedInputs);
+    SET_DWORD_STAT(STAT_SteamAudioListeners, TickListeners.Num());
+    SET_DWORD_STAT(STAT_SteamAudioRegisteredSources, Sources.Num());
 
-    for (USteamAudioSourceComponent* Source : Sources)
-    {
-        Source->SetInputs(IPL_SIMULATIONFLAGS_DIRECT);
-    }
+    UpdateSourceTransforms();
+    ScheduleSources(Snapshot->Settings);
 
-    iplSimulatorRunDirect(Simulator);
-
-    for (USteamAudioSourceComponent* Source : Sources)
+    if (TrajectoryRecorder)
     {
-        Source->UpdateOutputs(IPL_SIMULATIONFLAGS_DIRECT);
+        RecordTrajectory(DeltaTime, SharedInputs.listener);
     }
 
-    SimulationUpdateTimeElapsed += DeltaTime;
-    if (SimulationUpdateTimeElapsed < SteamAudioSettings.SimulationUpdateInterval)
-        return;
-
-    if (ThreadPool && ThreadPoolIdle)
+    // Direct simulation is run once per listener, through the same simulator and scene, each time including only
+    // the sources closest to that listener. With a single listener, this is a single run over every source.
+    for (int32 ListenerIndex = 0; ListenerIndex < TickListeners.Num(); ++ListenerIndex)
     {
-        for (USteamAudioSourceComponent* Source : Sources)
-        {
-            Source->UpdateOutputs(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
-        }
+        SharedInputs.listener = TickListeners[ListenerIndex];
+        iplSimulatorSetSharedInputs(Simulator, IPL_SIMULATIONFLAGS_DIRECT, &SharedInputs);
+
+        SetSourceDirectInputs(ListenerIndex, Snapshot->Settings);
 
-        for (USteamAudioListenerComponent* Listener : Listeners)
         {
-            Listener->UpdateOutputs();
+            SCOPE_CYCLE_COUNTER(STAT_SteamAudioRunDirect);
+            iplSimulatorRunDirect(Simulator);
         }
 
-        iplSimulatorSetSharedInputs(Simulator, static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING), &SharedInputs);
+        UpdateSourceDirectOutputs(ListenerIndex);
+    }
 
-        for (USteamAudioSourceComponent* Source : Sources)
-        {
-            Source->SetInputs(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
-        }
+    SimulationUpdateTimeElapsed += DeltaTime;
 
-        for (USteamAudioListenerComponent* Listener : Listeners)
-        {
-            Listener->SetInputs();
-        }
+    // Inputs for the next reflections and pathing run are staged once per update interval, even while the worker
+    // thread is still busy with the previous run, and handed over as soon as it is done.
+    if (ThreadPool && SimulationUpdateTimeElapsed >= Snapshot->Settings.SimulationUpdateInterval)
+    {
+        StageIndirectJob(SharedInputs, *Snapshot);
+        SimulationUpdateTimeElapsed = 0.0f;
+    }
 
-        ThreadPoolIdle = false;
+    if (ThreadPool && bIndirectJobStaged && !bIndirectJobInFlight)
+    {
+        KickIndirectJob();
+    }
 
-        if (!bShouldInitOpenCL || (bShouldInitOpenCL && OpenCLDevice))
-        AsyncPool(*ThreadPool, [this] // May cause a crash when OpenCL device is not initialized
-        {
-            iplSimulatorRunReflections(Simulator);
-            iplSimulatorRunPathing(Simulator);
-            ThreadPoolIdle = true;
-        });
+    {
+        SCOPE_CYCLE_COUNTER(STAT_SteamAudioPublishOutputs);
+        PublishOutputs();
     }
 }
 
@@ -766,6 +2637,9 @@ void FSteamAudioManager::LogCallback(IPLLogLevel Level, IPLstring Message)
 
 void* FSteamAudioManager::AllocateCallback(IPLsize Size, IPLsize Alignment)
 {
+    // Effects and buffers are allocated up front, so nothing should be allocated while processing audio.
+    FScopedNoAllocation::CheckAllocation(Size, TEXT("Steam Audio"));
+
     return FMemory::Malloc(Size, Alignment);
 }
 
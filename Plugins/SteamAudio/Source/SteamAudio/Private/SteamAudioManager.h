@@ -21,6 +21,8 @@
 #include "HAL/Runnable.h"
 #include "HAL/RunnableThread.h"
 #include "Misc/QueuedThreadPool.h"
+#include "Containers/Queue.h"
+#include "Async/Future.h"
 #include "SteamAudioCommon.h"
 #include "SteamAudioSettings.h"
 
@@ -35,24 +37,420 @@ namespace SteamAudio {
 // FSteamAudioPluginListener
 // ---------------------------------------------------------------------------------------------------------------------
 
+/** Maximum number of listeners simulated at once, e.g. one per player in local split-screen. Listeners for viewports
+    beyond this are ignored. */
+static constexpr int32 MaxListeners = 4;
+
+/** Positions and orientations of the active listeners, primary listener first. */
+typedef TArray<IPLCoordinateSpace3, TInlineAllocator<MaxListeners>> FSteamAudioListenerArray;
+
 /**
  * Receives callbacks from Unreal's built-in audio engine.
  */
 class FSteamAudioPluginListener : public IAudioPluginListener
 {
 public:
+    FSteamAudioPluginListener();
+
     /**
      * Inherited from IAudioPluginListener
      */
 
-    /** Called to specify the latest listener position and orientation. */
+    /** Called to specify the latest listener position and orientation. Called once per viewport, in viewport order. */
     virtual void OnListenerUpdated(FAudioDevice* AudioDevice, const int32 ViewportIndex, const FTransform& ListenerTransform, const float InDeltaSeconds) override;
 
-    IPLCoordinateSpace3 GetListenerCoordinates() { return ListenerCoordinates; }
+    /** Returns the position and orientation of the primary listener. */
+    IPLCoordinateSpace3 GetListenerCoordinates();
+
+    /** Returns the position and orientation of every active listener, primary listener first. */
+    void GetAllListenerCoordinates(FSteamAudioListenerArray& OutListeners);
 
 private:
-    /** The current listener position and orientation. */
-    IPLCoordinateSpace3 ListenerCoordinates;
+    /** Guards the members below, which are written on the audio thread and read on the game and audio threads. */
+    FCriticalSection ListenerLock;
+
+    /** The current position and orientation of each listener, indexed by viewport. */
+    IPLCoordinateSpace3 ListenerCoordinates[MaxListeners];
+
+    /** Number of listeners updated during the last complete round of updates. */
+    int32 NumListeners;
+
+    /** Number of listeners updated so far during the current round of updates. */
+    int32 NumListenersThisRound;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSourceOutputs
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Maximum number of Ambisonic coefficients stored for pathing (up to third order). */
+static constexpr int32 MaxPathingCoeffs = 16;
+
+/**
+ * Simulation outputs for a single Steam Audio Source component, copied out on the game thread so they can be read by
+ * the audio thread without touching any UObjects.
+ */
+struct FSteamAudioSourceOutputs
+{
+    /** The occlusion attenuation value. */
+    float Occlusion = 1.0f;
+
+    /** The low, mid, and high frequency transmission values. */
+    float Transmission[3] = { 1.0f, 1.0f, 1.0f };
+
+    /** True if ListenerCoordinates has been set since the source was registered. */
+    bool bHasListenerCoordinates = false;
+
+    /** Position and orientation of the listener closest to the source, which the source was simulated for, as of the
+        most recent tick. */
+    IPLCoordinateSpace3 ListenerCoordinates{};
+
+    /** True if reflections and pathing outputs have been retrieved at least once since the source was registered. */
+    bool bHasIndirectOutputs = false;
+
+    /** Reflection effect parameters, as returned by the simulator. */
+    IPLReflectionEffectParams Reflections{};
+
+    /** Path effect parameters, as returned by the simulator. shCoeffs is always null, use PathingCoeffs instead. */
+    IPLPathEffectParams Pathing{};
+
+    /** Number of valid entries in PathingCoeffs. Zero if the simulator has not produced pathing coefficients yet. */
+    int32 NumPathingCoeffs = 0;
+
+    /** Copy of the Ambisonic coefficients for pathing. */
+    float PathingCoeffs[MaxPathingCoeffs] = {};
+};
+
+/**
+ * Simulation outputs published for a single voice, i.e., a source id of the audio mixer. Stored as a triple buffer:
+ * the game thread fills one buffer while the audio thread reads another, and the third holds the most recently
+ * published outputs. The audio mixer never processes a voice on two threads at once, so each voice has a single
+ * reader, which only needs one acquire load to find the most recent buffer.
+ */
+struct FSteamAudioVoiceOutputs
+{
+    struct FBuffer
+    {
+        /** The Audio Component the voice was playing when the outputs were published. 0 if the voice is unbound. */
+        uint64 AudioComponentId = 0;
+
+        /** True if the Audio Component is driven by a Steam Audio Source component, and Outputs holds its outputs. */
+        bool bHasOutputs = false;
+
+        /** Outputs of the Steam Audio Source component. */
+        FSteamAudioSourceOutputs Outputs;
+    };
+
+    /** Set on SharedBuffer when it holds outputs that the reader hasn't picked up yet. */
+    static constexpr uint32 NewBufferFlag = 4;
+
+    FBuffer Buffers[3];
+
+    /** Index of the most recently published buffer, plus NewBufferFlag. */
+    std::atomic<uint32> SharedBuffer{ 0 };
+
+    /** Index of the buffer being filled by the game thread. */
+    uint32 WriteBuffer = 1;
+
+    /** Index of the buffer being read by the audio thread. */
+    uint32 ReadBuffer = 2;
+
+    /** Returns the buffer to fill. Game thread only. */
+    FBuffer& BeginWrite()
+    {
+        return Buffers[WriteBuffer];
+    }
+
+    /** Publishes the buffer returned by BeginWrite. Game thread only. */
+    void EndWrite()
+    {
+        WriteBuffer = SharedBuffer.exchange(WriteBuffer | NewBufferFlag, std::memory_order_acq_rel) & ~NewBufferFlag;
+    }
+
+    /** Returns the most recently published buffer. Only called by the thread processing the voice. */
+    const FBuffer& Read()
+    {
+        if (SharedBuffer.load(std::memory_order_acquire) & NewBufferFlag)
+        {
+            ReadBuffer = SharedBuffer.exchange(ReadBuffer, std::memory_order_acq_rel) & ~NewBufferFlag;
+        }
+
+        return Buffers[ReadBuffer];
+    }
+};
+
+/**
+ * Fixed-size array of per-voice outputs. Arrays are only ever replaced by larger ones, and old arrays are kept until
+ * the manager is destroyed, so the audio thread can never be left reading freed memory.
+ */
+struct FSteamAudioVoiceOutputsArray
+{
+    TUniquePtr<FSteamAudioVoiceOutputs[]> Voices;
+    int32 NumVoices = 0;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSourceGrid
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Spatial hash of source positions, in Steam Audio's coordinate system. Entries are indexed the same way as
+ * FSteamAudioSourceRegistry: they are appended when added and removed by swapping with the last entry. Moving an
+ * entry only touches the grid if it crosses into a different cell.
+ */
+struct FSteamAudioSourceGrid
+{
+    /** Default size of a grid cell, in meters. */
+    static constexpr float DefaultCellSize = 10.0f;
+
+    explicit FSteamAudioSourceGrid(float InCellSize = DefaultCellSize);
+
+    /** Returns the number of entries. */
+    int32 Num() const { return Positions.Num(); }
+
+    /** Returns the position of an entry. */
+    const FVector3f& GetPosition(int32 Index) const { return Positions[Index]; }
+
+    /** Appends an entry at the given position. */
+    void Add(const FVector3f& Position);
+
+    /** Removes an entry by swapping the last entry into its place. */
+    void RemoveAtSwap(int32 Index);
+
+    /** Moves an entry. Returns true if it moved into a different cell. */
+    bool Update(int32 Index, const FVector3f& Position);
+
+    /** Finds the entries within the given distance of a point. Results are in no particular order. */
+    void FindInRadius(const FVector3f& Center, float Radius, TArray<int32>& OutIndices) const;
+
+    /** Finds up to Count entries closest to a point, closest first. */
+    void FindNearest(const FVector3f& Center, int32 Count, TArray<int32>& OutIndices) const;
+
+private:
+    /** Returns the cell containing a point. */
+    FIntVector GetCell(const FVector3f& Position) const;
+
+    /** Returns the bounds of all non-empty cells. Must not be called while the grid is empty. */
+    FBox3f GetOccupiedBounds() const;
+
+    /** Size of a grid cell. */
+    float CellSize;
+
+    /** Position of each entry. */
+    TArray<FVector3f> Positions;
+
+    /** Cell containing each entry. */
+    TArray<FIntVector> EntryCells;
+
+    /** Entries in each non-empty cell. */
+    TMap<FIntVector, TArray<int32>> Cells;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSourceRegistry
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Level of detail at which a source is simulated during a given tick.
+ */
+enum class ESimulationLOD : uint8
+{
+    /** Simulated with the occlusion samples and transmission rays specified on the component. */
+    FULL,
+    /** Simulated with a reduced number of occlusion samples and transmission rays. */
+    DECIMATED,
+    /** Not simulated; the outputs from the last time the source was simulated are carried over. */
+    SKIPPED,
+};
+
+/**
+ * Dense, structure-of-arrays storage for the Steam Audio Source components that are registered for simulation, so
+ * that per-tick work can be split into batches and run in parallel. Entries are removed by swapping with the last
+ * entry, so indices are only stable until the next removal.
+ */
+struct FSteamAudioSourceRegistry
+{
+    /** The registered components. */
+    TArray<USteamAudioSourceComponent*> Components;
+
+    /** The Steam Audio source object owned by each component. */
+    TArray<IPLSource> Handles;
+
+    /** Source coordinates, updated once per tick. */
+    TArray<IPLCoordinateSpace3> Transforms;
+
+    /** Simulation flags from the most recent reflections and pathing inputs. */
+    TArray<IPLSimulationFlags> Flags;
+
+    /** Baked data identifiers, updated whenever reflections and pathing inputs are set. */
+    TArray<IPLBakedDataIdentifier> BakedDataIdentifiers;
+
+    /** Index of each source in the simulation outputs published by the manager. */
+    TArray<int32> OutputSlots;
+
+    /** Level of detail chosen by the scheduler for the current tick. */
+    TArray<ESimulationLOD> LODs;
+
+    /** True if the source is within the budget for the next reflections and pathing update. */
+    TArray<bool> IndirectScheduled;
+
+    /** Scheduling score from the current tick. Higher scores are simulated first. */
+    TArray<float> Scores;
+
+    /** Index of the listener closest to each source, updated along with Transforms. Each source is only simulated
+        for this listener. */
+    TArray<uint8> ListenerIndices;
+
+    /** Spatial index of source positions, updated along with Transforms. */
+    FSteamAudioSourceGrid Grid;
+
+    /** Returns the number of registered sources. */
+    int32 Num() const { return Components.Num(); }
+
+    /** Adds an entry for the given component. Does nothing if the component is already registered. */
+    void Add(USteamAudioSourceComponent* Component, IPLSource Handle, int32 OutputSlot);
+
+    /** Removes the entry for the given component. Returns false if the component is not registered. */
+    bool Remove(USteamAudioSourceComponent* Component);
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioHRTFCacheKey
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Everything that affects the contents of an HRTF. Two HRTFs built with equal keys are interchangeable.
+ */
+struct FSteamAudioHRTFCacheKey
+{
+    FSteamAudioHRTFCacheKey(const IPLAudioSettings& AudioSettings, const IPLHRTFSettings& HRTFSettings);
+
+    bool operator==(const FSteamAudioHRTFCacheKey& Other) const;
+
+    int32 SamplingRate;
+    int32 FrameSize;
+    IPLHRTFType Type;
+    float Volume;
+    IPLHRTFNormType NormType;
+
+    /** Size and checksum of the SOFA data, if Type is IPL_HRTFTYPE_SOFA. */
+    int32 SOFADataSize;
+    uint32 SOFADataCrc;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSettingsSnapshot
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Immutable copy of the settings used by the simulation and rendering code. A new snapshot with a new generation is
+ * built whenever the Steam Audio settings or the audio device change, so consumers can hold on to a snapshot and only
+ * need to compare generations to find out if it is still current.
+ */
+struct FSteamAudioSettingsSnapshot
+{
+    /** Incremented each time a snapshot is built. */
+    uint32 Generation = 0;
+
+    /** The Steam Audio settings that were loaded when Steam Audio was initialized. */
+    FSteamAudioSettings Settings;
+
+    /** Sampling rate and frame size of the audio engine. */
+    IPLAudioSettings AudioSettings{};
+
+    /** Simulation settings to use at runtime, with all simulation flags set. */
+    IPLSimulationSettings RealTimeSettings{};
+
+    /** Simulation settings to use while baking, with all simulation flags set. */
+    IPLSimulationSettings BakingSettings{};
+};
+
+typedef TSharedPtr<const FSteamAudioSettingsSnapshot, ESPMode::ThreadSafe> FSteamAudioSettingsSnapshotPtr;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSteamAudioSettingsSnapshotRebuilt, const FSteamAudioSettingsSnapshotPtr&);
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioDeviceCreationResult
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * What CreateDevices was able to set up. CreateDevices may run on a worker thread, so it returns this instead of
+ * writing to the manager, and EndInitialization applies it on the game thread.
+ */
+struct FSteamAudioDeviceCreationResult
+{
+    /** True if the devices, scene, simulator, and HRTF were created successfully. */
+    bool bDevicesCreated = false;
+
+    /** The scene type we were actually able to initialize. */
+    IPLSceneType ActualSceneType = IPL_SCENETYPE_DEFAULT;
+
+    /** The reflection effect type we were actually able to initialize. */
+    IPLReflectionEffectType ActualReflectionEffectType = IPL_REFLECTIONEFFECTTYPE_CONVOLUTION;
+
+    /** True if OpenCL was needed by the configured scene or reflection effect type. */
+    bool bShouldInitOpenCL = false;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioIndirectJob
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Inputs and outputs for one run of reflections and pathing simulation. The manager keeps two of these, so that the
+ * game thread can stage inputs for the next run while the worker thread is simulating the previous one. All source
+ * handles are retained until the job is reset, so sources can be unregistered while a job is in flight.
+ */
+struct FSteamAudioIndirectJob
+{
+    /** Shared inputs for the run. The listener is replaced with each of Listeners in turn. */
+    IPLSimulationSharedInputs SharedInputs{};
+
+    /** Listeners to simulate for, primary listener first. Reflections and pathing are run once per listener. */
+    FSteamAudioListenerArray Listeners;
+
+    /** Number of Ambisonic coefficients to copy from pathing outputs. */
+    int32 NumPathingCoeffs = 0;
+
+    /** Steam Audio source objects to simulate. */
+    TArray<IPLSource> Handles;
+
+    /** Reflections and pathing inputs for each source. */
+    TArray<IPLSimulationInputs> Inputs;
+
+    /** Index into Listeners of the listener each source is simulated for. */
+    TArray<uint8> ListenerIndices;
+
+    /** Output slot of each source. */
+    TArray<int32> OutputSlots;
+
+    /** Generation of each output slot when the job was staged, so that outputs are not copied into a slot that has
+        been given to a different source in the meantime. */
+    TArray<uint32> OutputSlotGenerations;
+
+    /** Reflections and pathing outputs for each source, written by the worker thread. */
+    TArray<FSteamAudioSourceOutputs> Outputs;
+
+    /** Steam Audio source objects for listener-centric reverb. These are simulated for the primary listener. */
+    TArray<IPLSource> ListenerHandles;
+
+    /** Reverb inputs for each listener. */
+    TArray<IPLSimulationInputs> ListenerInputs;
+
+    /** Timestamps, in cycles, of when the job was staged, started simulating, and finished simulating. */
+    uint64 StagedCycles = 0;
+    uint64 StartCycles = 0;
+    uint64 EndCycles = 0;
+
+    /** Releases all source handles and empties the job, keeping allocations for the next run. */
+    void Reset();
 };
 
 
@@ -60,7 +458,9 @@ private:
 // FSteamAudioManager
 // ---------------------------------------------------------------------------------------------------------------------
 
+class FMaterialCache;
 class FSimulationThreadRunnable;
+class FSteamAudioTrajectoryRecorder;
 
 enum class EManagerInitReason : uint8
 {
@@ -92,28 +492,65 @@ public:
     virtual TStatId GetStatId() const override;
 
     IPLContext GetContext() { return Context; }
-    IPLHRTF GetHRTF() { return HRTF; }
     IPLScene GetScene() { return Scene; }
     IPLSimulator GetSimulator() { return Simulator; }
     IPLCoordinateSpace3 GetListenerCoordinates();
-    FSteamAudioSettings GetSteamAudioSettings() const { return SteamAudioSettings; }
+    const FSteamAudioSettings& GetSteamAudioSettings() const { return SteamAudioSettings; }
     bool IsInitialized() const { return bInitializationSucceded; }
 
+    /** Returns a new reference to the HRTF, or nullptr if there is none. The caller must release it. */
+    IPLHRTF GetHRTF();
+
+    /** Returns the position and orientation of every active listener, primary listener first. There is always at least
+        one listener, which is the one returned by GetListenerCoordinates. */
+    void GetAllListenerCoordinates(FSteamAudioListenerArray& OutListeners);
+
     /** Creates empty IPLScene based on active scene settings. */
     bool CreateEmptyScene(IPLScene& SubScene);
 
     /** Updates the iplStaticMesh data. */
     void UpdateStaticMesh();
 
-    /** Updates the iplStaticMesh material data on specified StaticMeshActor. */
+    /** Queues an update of the iplStaticMesh material data on specified StaticMeshActor. Material changes made
+        during a frame are merged, and applied together with a single scene commit once their material assets have
+        loaded. */
     void UpdateStaticMeshMaterial(AStaticMeshActor* StaticMeshActor);
 
-    /** Initializes the HRTF. */
+    /** Starts loading a Steam Audio Material asset, so that changing to it at runtime doesn't have to wait. */
+    void PreloadMaterial(const FSoftObjectPath& MaterialAsset);
+
+    /** Returns the cache of Steam Audio Material assets, creating it on first use. Must only be used from the game
+        thread. */
+    FMaterialCache& GetMaterialCache();
+
+    /** Initializes the HRTF from the settings last captured by CaptureHRTFSettings. If an HRTF with the same settings
+        was built before, reuses it. Can run on any thread. */
     bool InitHRTF(IPLAudioSettings& AudioSettings);
 
-    /** Initializes the global Steam Audio state. */
+    /** Starts building the HRTF for the given audio settings on a worker thread, so that it's already cached when
+        InitHRTF is called. Must be called from the game thread. */
+    void PrewarmHRTF(const IPLAudioSettings& AudioSettings);
+
+    /** Reads the HRTF settings, loading the SOFA file asset if one is specified, and keeps a copy of them for
+        InitHRTF. Must be called from the game thread. */
+    void CaptureHRTFSettings();
+
+    /** Initializes the global Steam Audio state. Blocks until initialization is complete. */
     bool InitializeSteamAudio(EManagerInitReason Reason);
 
+    /** Starts initializing the global Steam Audio state for gameplay, creating devices, the scene, the simulator, and
+        the HRTF on a worker thread. Call again (e.g., every tick) to finish initialization once the worker is done.
+        Returns true once initialization has succeeded. Must be called from the game thread. */
+    bool InitializeSteamAudioAsync();
+
+    /** Asks the game thread to start initializing Steam Audio, unless it already has been or has already been asked
+        to. Doesn't wait for the game thread, so it can be called from the audio render thread. */
+    void RequestInitialization();
+
+    /** Calls the given function on the game thread once Steam Audio is initialized, or right away if it already is.
+        The function is dropped if initialization fails or Owner is destroyed before then. */
+    void WhenInitialized(UObject* Owner, TFunction<void()>&& Function);
+
     /** Sets the Steam Audio enabled mode. */
     void SetSteamAudioEnabled(bool bNewIsSteamAudioEnabled);
 
@@ -132,6 +569,23 @@ public:
     /** Returns the Steam Audio simulation settings to use while baking. */
     IPLSimulationSettings GetBakingSettings(IPLSimulationFlags Flags);
 
+    /** Returns the current settings snapshot, or null if Steam Audio is not initialized. Safe to call from any
+        thread. */
+    FSteamAudioSettingsSnapshotPtr GetSettingsSnapshot() const;
+
+    /** Replaces the given snapshot with the current settings snapshot if it is out of date. InOutGeneration holds
+        the generation the snapshot was fetched for, and should start at 0. This only costs an atomic load if nothing
+        has changed, including while there is no snapshot at all, so it can be called once per audio buffer. */
+    void RefreshSettingsSnapshot(FSteamAudioSettingsSnapshotPtr& InOutSnapshot, uint32& InOutGeneration) const;
+
+    /** Rebuilds the settings snapshot. Called when Steam Audio is initialized or the audio device changes. */
+    void RebuildSettingsSnapshot();
+
+    /** Broadcast on the game thread each time the settings snapshot is rebuilt, with the new snapshot. The snapshot is
+        null if Steam Audio isn't initialized. The audio plugins use this to build their slabs off the audio
+        thread. */
+    FOnSteamAudioSettingsSnapshotRebuilt OnSettingsSnapshotRebuilt;
+
     /** Creates an Instanced Mesh object for use by the given Steam Audio Dynamic Object component. If needed, loads
         the geometry and material data into a Scene object before instantiation. If another component has already
         loaded this data, we just reference it. */
@@ -147,12 +601,64 @@ public:
     /** Unregisters a Steam Audio Source component from simulation. */
     void RemoveSource(USteamAudioSourceComponent* Source);
 
+    /** Finds the registered Steam Audio Source components within the given distance (in Unreal units) of a location.
+        Uses source positions from the most recent tick. */
+    void FindSourcesInRadius(const FVector& Location, float Radius, TArray<USteamAudioSourceComponent*>& OutSources) const;
+
+    /** Finds up to Count registered Steam Audio Source components closest to a location, closest first. Uses source
+        positions from the most recent tick. */
+    void FindNearestSources(const FVector& Location, int32 Count, TArray<USteamAudioSourceComponent*>& OutSources) const;
+
     /** Registers a Steam Audio Listener component for simulation. */
     void AddListener(USteamAudioListenerComponent* Listener);
 
     /** Unregisters a Steam Audio Listener component from simulation. */
     void RemoveListener(USteamAudioListenerComponent* Listener);
 
+    /** Makes room for publishing outputs to the given number of voices. Called by the audio plugins when they are
+        initialized, on the game thread. */
+    void ReserveVoiceOutputs(int32 NumVoices);
+
+    /** Copies the most recently published simulation outputs for the voice with the given source id, which is
+        playing the given Audio Component. Safe to call from the audio render thread, and never blocks or allocates.
+        Returns false if no outputs are available; if that's because the voice hasn't been seen playing the Audio
+        Component yet, the pair is queued for lookup on the next tick. */
+    bool GetSourceOutputs(uint32 SourceId, uint64 AudioComponentId, FSteamAudioSourceOutputs& OutOutputs);
+
+    /** Queues a change to the scene. Queued changes are applied on the game thread, followed by a single scene and
+        simulator commit, the next time no reflections or pathing simulation is running. */
+    void EnqueueSceneUpdate(TFunction<void()>&& Update);
+
+    /** Requests a simulator commit at the next opportunity, e.g. after adding or removing sources or probe batches. */
+    void RequestSimulatorCommit();
+
+    /** Marks a dynamic object as moved. The transforms of all moved dynamic objects are applied together, just before
+        the next scene commit. */
+    void AddDirtyDynamicObject(USteamAudioDynamicObjectComponent* DynamicObject);
+
+    /** Discards a pending transform update for a dynamic object, e.g. when it is being destroyed. */
+    void RemoveDirtyDynamicObject(USteamAudioDynamicObjectComponent* DynamicObject);
+
+    /** Sets the listener position and orientation seen by the audio plugins, in place of the one reported by the
+        audio device. Used to drive the plugins offline. */
+    void SetListenerTransform(const FTransform& ListenerTransform);
+
+    /** Publishes Outputs[i] to the voice with source id i, which is playing the Audio Component with id
+        AudioComponentIds[i], in place of the outputs of the registered Steam Audio Source components. Used to drive
+        the plugins offline; the next tick publishes the registered sources' outputs again. */
+    void PublishOutputsForVoices(TArrayView<const uint64> AudioComponentIds, TArrayView<const FSteamAudioSourceOutputs> Outputs);
+
+    /** Starts writing the listener pose and the poses of all registered Steam Audio Source components to the given
+        trajectory file every tick, so they can be replayed offline. Returns false if the file could not be
+        created. */
+    bool StartRecordingTrajectory(const FString& FileName);
+
+    /** Stops writing poses to the trajectory file. */
+    void StopRecordingTrajectory();
+
+    /** Returns the name of the trajectory file being written, or an empty string if not recording. */
+    FString GetTrajectoryFileName() const;
+
 private:
     /** a cached value indicating whether OpenCL should be initialized */
     bool bShouldInitOpenCL = false;
@@ -172,6 +678,36 @@ private:
     /** The (default) HRTF. */
     IPLHRTF HRTF;
 
+    /** HRTFs that have been built so far, least recently used first. These outlive ShutDownSteamAudio, so starting
+        again with the same settings doesn't need to rebuild the HRTF. */
+    TArray<TPair<FSteamAudioHRTFCacheKey, IPLHRTF>> HRTFCache;
+
+    /** HRTF settings captured on the game thread by CaptureHRTFSettings, so that InitHRTF never has to load the SOFA
+        asset itself. The settings don't point at any SOFA data; CapturedSOFAData holds a copy of it instead. */
+    IPLHRTFSettings CapturedHRTFSettings;
+    TArray<uint8> CapturedSOFAData;
+    bool bHRTFSettingsCaptured;
+
+    /** Guards HRTF, HRTFCache, and the captured HRTF settings. Held while building an HRTF, so that it is only built
+        once. */
+    FCriticalSection HRTFLock;
+
+    /** HRTFs being built by PrewarmHRTF. */
+    TArray<TFuture<void>> HRTFPrewarmTasks;
+
+    /** Creates devices, the scene, the simulator, and the HRTF while InitializeSteamAudioAsync is in progress. */
+    TFuture<FSteamAudioDeviceCreationResult> InitializationTask;
+
+    /** True if RequestInitialization has queued a call to InitializeSteamAudioAsync on the game thread. Cleared when
+        Steam Audio is shut down, so it can be requested again. */
+    std::atomic<bool> bInitializationRequested;
+
+    /** Time at which the current initialization attempt started. */
+    double InitializationStartTime;
+
+    /** Functions waiting for initialization to complete, along with the objects that registered them. */
+    TArray<TPair<TWeakObjectPtr<UObject>, TFunction<void()>>> PendingInitializationCallbacks;
+
     /** The Embree device. */
     IPLEmbreeDevice EmbreeDevice;
 
@@ -202,14 +738,39 @@ private:
     /** True if we've loaded the Steam Audio settings. */
     bool bSettingsLoaded;
 
+    /** The current settings snapshot. Only accessed while holding SettingsSnapshotLock. */
+    FSteamAudioSettingsSnapshotPtr SettingsSnapshot;
+
+    /** Guards access to SettingsSnapshot. */
+    mutable FCriticalSection SettingsSnapshotLock;
+
+    /** Generation of the current settings snapshot. */
+    std::atomic<uint32> SettingsGeneration;
+
     /** Scenes referenced by each dynamic object that's currently loaded. */
     TMap<FString, IPLScene> DynamicObjects;
 
     /** Reference counts for the scenes referenced by dynamic objects. */
     TMap<FString, int> DynamicObjectRefCounts;
 
+    /** Dynamic objects that have moved since their transforms were last applied. */
+    TSet<USteamAudioDynamicObjectComponent*> DirtyDynamicObjects;
+
+    /** Number of times dynamic objects were marked as moved since their transforms were last applied. */
+    uint32 DynamicObjectTransformRequests;
+
+    /** Static geometry actors whose material has changed, waiting to be applied. */
+    TSet<TWeakObjectPtr<AStaticMeshActor>> PendingMaterialActors;
+
+    /** Number of material changes requested for actors that already had one waiting since changes were last
+        applied. */
+    uint32 MaterialChangesCoalesced;
+
+    /** Steam Audio Material assets used by runtime material changes. */
+    TUniquePtr<FMaterialCache> MaterialCache;
+
     /** Steam Audio Source components that are currently registered for simulation. */
-    TSet<USteamAudioSourceComponent*> Sources;
+    FSteamAudioSourceRegistry Sources;
 
     /** Steam Audio Listener components that are currently registered for simulation. */
     TSet<USteamAudioListenerComponent*> Listeners;
@@ -217,7 +778,13 @@ private:
     /** The audio plugin listener used to receive global data from the built-in audio engine. */
     TAudioPluginListenerPtr AudioPluginListener;
 
-    /** Time elapsed since the last time the simulation thread was run. */
+    /** Writes poses to a trajectory file every tick, if recording. */
+    TUniquePtr<FSteamAudioTrajectoryRecorder> TrajectoryRecorder;
+
+    /** Time since trajectory recording started. */
+    double TrajectoryRecordingTime;
+
+    /** Time elapsed since reflections and pathing inputs were last staged. */
     float SimulationUpdateTimeElapsed;
 
     /** Thread pool containing the simulation thread. */
@@ -226,6 +793,170 @@ private:
     /** If true, the simulation thread is idle. */
     std::atomic<bool> ThreadPoolIdle;
 
+    /** Outputs for each registered source, written on the game thread and published to voices once per tick. */
+    TArray<FSteamAudioSourceOutputs> StagedOutputs;
+
+    /** Output slots that can be reused by newly registered sources. */
+    TArray<int32> FreeOutputSlots;
+
+    /** Maps Audio Component ids to output slots. INDEX_NONE marks Audio Components without a Steam Audio Source. */
+    TMap<uint64, int32> AudioComponentSlots;
+
+    /** The Audio Component each voice was last seen playing by the audio thread, indexed by source id. 0 if
+        unknown. Game thread only. */
+    TArray<uint64> VoiceAudioComponentIds;
+
+    /** The per-voice outputs that the audio thread reads from. Only replaced on the game thread. */
+    std::atomic<FSteamAudioVoiceOutputsArray*> VoiceOutputs;
+
+    /** Every per-voice outputs array allocated so far. */
+    TArray<TUniquePtr<FSteamAudioVoiceOutputsArray>> VoiceOutputsArrays;
+
+    /** A voice that the audio thread found playing an Audio Component it had no outputs for. */
+    struct FPendingVoice
+    {
+        /** 0 if the entry is empty, 1 while it is being written, and 2 once it is ready to be read. */
+        std::atomic<uint32> State{ 0 };
+        uint32 SourceId = 0;
+        uint64 AudioComponentId = 0;
+    };
+
+    /** Voices posted by the audio thread. A fixed ring of entries, so that posting from the audio thread never
+        allocates. */
+    static constexpr int32 MaxPendingVoices = 256;
+    FPendingVoice PendingVoices[MaxPendingVoices];
+
+    /** Entry at which the audio thread starts looking for room to post the next pending voice. */
+    std::atomic<uint32> NextPendingVoice;
+
+    /** Number of ticks run so far. Used to stagger updates of decimated sources across ticks. */
+    uint32 SimulationTickCount;
+
+    /** Scratch array of source indices, sorted by scheduling score. */
+    TArray<int32> ScheduleOrder;
+
+    /** Scratch array of source indices found near one listener while scheduling. */
+    TArray<int32> ScheduleCandidates;
+
+    /** Listeners being simulated for during the current tick, primary listener first. */
+    FSteamAudioListenerArray TickListeners;
+
+    /** Changes to the scene that are waiting for a safe point to be applied. */
+    TQueue<TFunction<void()>, EQueueMode::Mpsc> PendingSceneUpdates;
+
+    /** True if the simulator should be committed at the next safe point. */
+    std::atomic<bool> bSimulatorCommitRequested;
+
+    /** Incremented each time an output slot is released. */
+    TArray<uint32> OutputSlotGenerations;
+
+    /** Reflections and pathing jobs. One is staged on the game thread while the other is simulated. */
+    FSteamAudioIndirectJob IndirectJobs[2];
+
+    /** Index into IndirectJobs of the job being staged on the game thread. */
+    int32 StagingIndirectJob;
+
+    /** True if the staging job contains inputs that are waiting to be simulated. */
+    bool bIndirectJobStaged;
+
+    /** True if the other job has been handed to the worker thread and not yet collected. */
+    bool bIndirectJobInFlight;
+
+    /** Returns the sampling rate and frame size used by the audio engine. */
+    IPLAudioSettings GetAudioEngineSettings() const;
+
+    /** Loads settings, captures the HRTF settings, and creates the audio engine state. Runs on the game thread.
+        Returns the audio settings used by the audio engine, for building the HRTF, and the real-time simulation
+        settings, for creating the simulator. */
+    bool BeginInitialization(EManagerInitReason Reason, IPLAudioSettings& OutAudioSettings, IPLSimulationSettings& OutRealTimeSettings);
+
+    /** Creates devices, the scene, and (when playing) the simulator and HRTF. Can run on any thread, since it only
+        uses settings that BeginInitialization read on the game thread, and doesn't write any settings itself. */
+    FSteamAudioDeviceCreationResult CreateDevices(EManagerInitReason Reason, IPLAudioSettings AudioSettings, IPLSimulationSettings RealTimeSettings);
+
+    /** Applies the result of CreateDevices and finishes initialization on the game thread, or shuts down again if
+        CreateDevices failed. */
+    bool EndInitialization(EManagerInitReason Reason, const FSteamAudioDeviceCreationResult& Result);
+
+    /** Creates an empty scene of the given type. */
+    bool CreateEmptyScene(IPLScene& SubScene, IPLSceneType SceneType);
+
+    /** Waits for InitializationTask and finishes initialization. */
+    void FinishInitialization();
+
+    /** Calls the functions that were waiting for initialization to complete. */
+    void RunInitializationCallbacks();
+
+    /** Returns a retained reference to a cached HRTF with the given settings, building and caching it if there isn't
+        one. Must be called while holding HRTFLock. */
+    IPLerror FindOrCreateHRTF(const IPLAudioSettings& AudioSettings, const IPLHRTFSettings& HRTFSettings, IPLHRTF& OutHRTF, bool& bOutCached);
+
+    /** Builds the Steam Audio simulation settings to use at runtime. */
+    IPLSimulationSettings BuildRealTimeSettings(IPLSimulationFlags Flags, const IPLAudioSettings& AudioSettings) const;
+
+    /** Builds the Steam Audio simulation settings to use while baking. */
+    IPLSimulationSettings BuildBakingSettings(IPLSimulationFlags Flags, const IPLAudioSettings& AudioSettings) const;
+
+    /** Calls the given function once for each registered source, in parallel batches. */
+    void ParallelForEachSource(TFunctionRef<void(int32)> Function) const;
+
+    /** Updates the coordinates of every registered source from its owning actor, and assigns each source to the
+        closest of TickListeners. */
+    void UpdateSourceTransforms();
+
+    /** Chooses a level of detail for every registered source based on distance to its listener, audibility and
+        priority, subject to the budgets in the Steam Audio settings. The budgets are shared by all listeners. */
+    void ScheduleSources(const FSteamAudioSettings& Settings);
+
+    /** Builds simulation inputs for the given source, taking its level of detail into account. */
+    void BuildSourceInputs(int32 SourceIndex, bool bIndirect, const FSteamAudioSettings& Settings, IPLSimulationInputs& Inputs);
+
+    /** Sets direct simulation inputs on every registered source. Sources assigned to other listeners are skipped. */
+    void SetSourceDirectInputs(int32 ListenerIndex, const FSteamAudioSettings& Settings);
+
+    /** Retrieves direct simulation outputs for every source simulated for the given listener this tick and copies
+        them into their output slots. */
+    void UpdateSourceDirectOutputs(int32 ListenerIndex);
+
+    /** Copies direct simulation outputs for the given source into its output slot. */
+    void StageDirectOutputs(int32 SourceIndex);
+
+    /** Applies the pending material changes whose material assets have loaded, queuing one scene change for each
+        level's static geometry. */
+    void ApplyMaterialChanges();
+
+    /** Applies queued scene changes and commits the scene and simulator. Only call when no reflections or pathing
+        simulation is running. */
+    void FlushSceneUpdates();
+
+    /** Builds reflections and pathing inputs for every registered source and listener into the staging job. */
+    void StageIndirectJob(const IPLSimulationSharedInputs& SharedInputs, const FSteamAudioSettingsSnapshot& Snapshot);
+
+    /** Hands the staging job over to the worker thread and starts simulating it. */
+    void KickIndirectJob();
+
+    /** Sets the inputs from the given job on the simulator and runs reflections and pathing simulation, once per
+        listener. Called on the worker thread. */
+    void RunIndirectJob(FSteamAudioIndirectJob& Job);
+
+    /** If the job on the worker thread has finished, copies its outputs into the output slots of their sources. */
+    void CollectIndirectJob();
+
+    /** Records the Audio Components that the audio thread found voices playing, maps them to output slots, and drops
+        ids whose Audio Components no longer exist. */
+    void ResolveAudioComponentSlots();
+
+    /** Asks the game thread to look up the Steam Audio Source component for the Audio Component a voice is playing.
+        Safe to call from the audio thread while processing audio. */
+    void PostPendingVoice(uint32 SourceId, uint64 AudioComponentId);
+
+    /** Copies the staged outputs of each voice's Steam Audio Source component into its buffers and makes them
+        visible to the audio thread. */
+    void PublishOutputs();
+
+    /** Writes the current listener pose and the pose of every registered source to the trajectory file. */
+    void RecordTrajectory(float DeltaTime, const IPLCoordinateSpace3& ListenerCoordinates);
+
     /** Called by Steam Audio, writes Steam Audio log messages to the Unreal log. */
     static void IPLCALL LogCallback(IPLLogLevel Level, IPLstring Message);
 
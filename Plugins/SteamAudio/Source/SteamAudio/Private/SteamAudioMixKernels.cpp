@@ -0,0 +1,255 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#include "SteamAudioMixKernels.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "SteamAudioCommon.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Mix Kernels
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Returns a register containing the horizontal sums of A, B, C, and D, in that order. */
+static FORCEINLINE VectorRegister4Float VectorHorizontalSum4(const VectorRegister4Float& A, const VectorRegister4Float& B,
+    const VectorRegister4Float& C, const VectorRegister4Float& D)
+{
+    VectorRegister4Float AB = VectorAdd(VectorShuffle(A, B, 0, 2, 0, 2), VectorShuffle(A, B, 1, 3, 1, 3));
+    VectorRegister4Float CD = VectorAdd(VectorShuffle(C, D, 0, 2, 0, 2), VectorShuffle(C, D, 1, 3, 1, 3));
+    return VectorAdd(VectorShuffle(AB, CD, 0, 2, 0, 2), VectorShuffle(AB, CD, 1, 3, 1, 3));
+}
+
+void DeinterleaveDownmixAndScale(const float* RESTRICT In, int NumChannels, int NumFrames, float Gain, float* RESTRICT Out)
+{
+    check(In && Out && NumChannels > 0 && NumFrames >= 0);
+
+    // Each iteration of the vectorized loops below produces 4 output frames.
+    const int NumVectorFrames = (NumChannels == 1 || NumChannels == 2 || NumChannels == 4 || NumChannels == 6 ||
+        NumChannels == 8) ? (NumFrames & ~3) : 0;
+
+    const float Scale = Gain / NumChannels;
+    const VectorRegister4Float ScaleVector = VectorSetFloat1(Scale);
+    const VectorRegister4Float Zero = VectorZeroFloat();
+
+    const float* RESTRICT Src = In;
+    float* RESTRICT Dst = Out;
+
+    switch (NumVectorFrames > 0 ? NumChannels : 0)
+    {
+    case 1:
+        for (int i = 0; i < NumVectorFrames; i += 4, Src += 4, Dst += 4)
+        {
+            VectorStore(VectorMultiply(VectorLoad(Src), ScaleVector), Dst);
+        }
+        break;
+
+    case 2:
+        for (int i = 0; i < NumVectorFrames; i += 4, Src += 8, Dst += 4)
+        {
+            VectorRegister4Float R0 = VectorLoad(Src);
+            VectorRegister4Float R1 = VectorLoad(Src + 4);
+            VectorRegister4Float Left = VectorShuffle(R0, R1, 0, 2, 0, 2);
+            VectorRegister4Float Right = VectorShuffle(R0, R1, 1, 3, 1, 3);
+            VectorStore(VectorMultiply(VectorAdd(Left, Right), ScaleVector), Dst);
+        }
+        break;
+
+    case 4:
+        for (int i = 0; i < NumVectorFrames; i += 4, Src += 16, Dst += 4)
+        {
+            VectorRegister4Float Sum = VectorHorizontalSum4(VectorLoad(Src), VectorLoad(Src + 4), VectorLoad(Src + 8), VectorLoad(Src + 12));
+            VectorStore(VectorMultiply(Sum, ScaleVector), Dst);
+        }
+        break;
+
+    case 6:
+        for (int i = 0; i < NumVectorFrames; i += 4, Src += 24, Dst += 4)
+        {
+            // 4 frames of 6 channels span 6 registers. Frames 0 and 1 share register 1, frames 2 and 3 share
+            // register 4.
+            VectorRegister4Float R0 = VectorLoad(Src);
+            VectorRegister4Float R1 = VectorLoad(Src + 4);
+            VectorRegister4Float R2 = VectorLoad(Src + 8);
+            VectorRegister4Float R3 = VectorLoad(Src + 12);
+            VectorRegister4Float R4 = VectorLoad(Src + 16);
+            VectorRegister4Float R5 = VectorLoad(Src + 20);
+
+            VectorRegister4Float Frame0 = VectorAdd(R0, VectorShuffle(R1, Zero, 0, 1, 0, 0));
+            VectorRegister4Float Frame1 = VectorAdd(R2, VectorShuffle(R1, Zero, 2, 3, 0, 0));
+            VectorRegister4Float Frame2 = VectorAdd(R3, VectorShuffle(R4, Zero, 0, 1, 0, 0));
+            VectorRegister4Float Frame3 = VectorAdd(R5, VectorShuffle(R4, Zero, 2, 3, 0, 0));
+
+            VectorStore(VectorMultiply(VectorHorizontalSum4(Frame0, Frame1, Frame2, Frame3), ScaleVector), Dst);
+        }
+        break;
+
+    case 8:
+        for (int i = 0; i < NumVectorFrames; i += 4, Src += 32, Dst += 4)
+        {
+            VectorRegister4Float Frame0 = VectorAdd(VectorLoad(Src), VectorLoad(Src + 4));
+            VectorRegister4Float Frame1 = VectorAdd(VectorLoad(Src + 8), VectorLoad(Src + 12));
+            VectorRegister4Float Frame2 = VectorAdd(VectorLoad(Src + 16), VectorLoad(Src + 20));
+            VectorRegister4Float Frame3 = VectorAdd(VectorLoad(Src + 24), VectorLoad(Src + 28));
+
+            VectorStore(VectorMultiply(VectorHorizontalSum4(Frame0, Frame1, Frame2, Frame3), ScaleVector), Dst);
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    // Remaining frames, and channel counts without a vectorized path.
+    for (int i = NumVectorFrames; i < NumFrames; ++i, Src += NumChannels, ++Dst)
+    {
+        float Sum = 0.0f;
+        for (int j = 0; j < NumChannels; ++j)
+        {
+            Sum += Src[j];
+        }
+
+        *Dst = Sum * Scale;
+    }
+}
+
+void CopyAndScale(const float* RESTRICT In, int NumFrames, float Gain, float* RESTRICT Out)
+{
+    check(In && Out && NumFrames >= 0);
+
+    const int NumVectorFrames = NumFrames & ~3;
+    const VectorRegister4Float GainVector = VectorSetFloat1(Gain);
+
+    for (int i = 0; i < NumVectorFrames; i += 4)
+    {
+        VectorStore(VectorMultiply(VectorLoad(In + i), GainVector), Out + i);
+    }
+
+    for (int i = NumVectorFrames; i < NumFrames; ++i)
+    {
+        Out[i] = In[i] * Gain;
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Mix Kernel Benchmark
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Scalar equivalent of iplAudioBufferDeinterleave, iplAudioBufferDownmix, and a gain loop, each as a separate pass
+ * over memory. Used as the baseline when benchmarking DeinterleaveDownmixAndScale.
+ */
+static void DeinterleaveDownmixAndScaleSeparatePasses(const float* In, int NumChannels, int NumFrames, float Gain,
+    TArray<TArray<float>>& Deinterleaved, float* Out)
+{
+    for (int i = 0; i < NumFrames; ++i)
+    {
+        for (int j = 0; j < NumChannels; ++j)
+        {
+            Deinterleaved[j][i] = In[i * NumChannels + j];
+        }
+    }
+
+    const float DownmixScale = 1.0f / NumChannels;
+    for (int i = 0; i < NumFrames; ++i)
+    {
+        float Sum = 0.0f;
+        for (int j = 0; j < NumChannels; ++j)
+        {
+            Sum += Deinterleaved[j][i];
+        }
+
+        Out[i] = Sum * DownmixScale;
+    }
+
+    for (int i = 0; i < NumFrames; ++i)
+    {
+        Out[i] *= Gain;
+    }
+}
+
+/**
+ * Times the fused mix kernel against separate deinterleave, downmix, and gain passes, for 1, 2, 6, and 8 channel
+ * inputs, and logs the time taken per frame.
+ */
+static void BenchmarkMixKernels(const TArray<FString>& Args)
+{
+    const int NumFrames = (Args.Num() > 0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1024;
+    const int NumIterations = (Args.Num() > 1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10000;
+    const float Gain = 0.7f;
+
+    FRandomStream Random(0);
+
+    for (int NumChannels : { 1, 2, 6, 8 })
+    {
+        TArray<float> In;
+        In.SetNumUninitialized(NumChannels * NumFrames);
+        for (float& Sample : In)
+        {
+            Sample = Random.FRandRange(-1.0f, 1.0f);
+        }
+
+        TArray<TArray<float>> Deinterleaved;
+        Deinterleaved.SetNum(NumChannels);
+        for (TArray<float>& Channel : Deinterleaved)
+        {
+            Channel.SetNumZeroed(NumFrames);
+        }
+
+        TArray<float> SeparateOut;
+        TArray<float> FusedOut;
+        SeparateOut.SetNumZeroed(NumFrames);
+        FusedOut.SetNumZeroed(NumFrames);
+
+        uint64 StartCycles = FPlatformTime::Cycles64();
+        for (int i = 0; i < NumIterations; ++i)
+        {
+            DeinterleaveDownmixAndScaleSeparatePasses(In.GetData(), NumChannels, NumFrames, Gain, Deinterleaved, SeparateOut.GetData());
+        }
+        double SeparateSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+        StartCycles = FPlatformTime::Cycles64();
+        for (int i = 0; i < NumIterations; ++i)
+        {
+            DeinterleaveDownmixAndScale(In.GetData(), NumChannels, NumFrames, Gain, FusedOut.GetData());
+        }
+        double FusedSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+        float MaxError = 0.0f;
+        for (int i = 0; i < NumFrames; ++i)
+        {
+            MaxError = FMath::Max(MaxError, FMath::Abs(SeparateOut[i] - FusedOut[i]));
+        }
+
+        const double TotalFrames = static_cast<double>(NumFrames) * NumIterations;
+        const double SeparateNsPerFrame = (SeparateSeconds * 1e9) / TotalFrames;
+        const double FusedNsPerFrame = (FusedSeconds * 1e9) / TotalFrames;
+
+        UE_LOG(LogSteamAudio, Log, TEXT("Mix kernel benchmark, %d channel(s): separate passes %.3f ns/frame, fused %.3f ns/frame (%.2fx), max error %g."),
+            NumChannels, SeparateNsPerFrame, FusedNsPerFrame, (FusedNsPerFrame > 0.0) ? SeparateNsPerFrame / FusedNsPerFrame : 0.0, MaxError);
+    }
+}
+
+static FAutoConsoleCommand GBenchmarkMixKernelsCommand(
+    TEXT("SteamAudio.BenchmarkMixKernels"),
+    TEXT("Logs the time per frame taken to deinterleave, downmix, and scale 1, 2, 6, and 8 channel inputs, using both ")
+    TEXT("separate passes and the fused kernel. Usage: SteamAudio.BenchmarkMixKernels [NumFrames] [NumIterations]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkMixKernels));
+
+}
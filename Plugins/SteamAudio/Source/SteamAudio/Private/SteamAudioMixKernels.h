@@ -0,0 +1,40 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Mix Kernels
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Deinterleaves, downmixes, and scales an interleaved buffer into a mono buffer, in a single pass over the input.
+ * The result is the average of all channels multiplied by Gain, which matches iplAudioBufferDeinterleave and
+ * iplAudioBufferDownmix followed by a gain. 1, 2, 4, 6, and 8 channel inputs use vectorized code paths.
+ */
+void STEAMAUDIO_API DeinterleaveDownmixAndScale(const float* RESTRICT In, int NumChannels, int NumFrames, float Gain, float* RESTRICT Out);
+
+/**
+ * Copies a mono buffer, multiplying each sample by Gain.
+ */
+void STEAMAUDIO_API CopyAndScale(const float* RESTRICT In, int NumFrames, float Gain, float* RESTRICT Out);
+
+}
@@ -55,6 +55,9 @@ void FSteamAudioModule::SetAudioEngineState(TSharedPtr<IAudioEngineState> State)
 
 void FSteamAudioModule::StartupModule()
 {
+    // The module loads before the audio device is created, so no audio threads are allocating yet.
+    FScopedNoAllocation::InstallAllocatorProxy();
+
     TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin("SteamAudio");
     check(Plugin);
 
@@ -116,7 +119,7 @@ void FSteamAudioModule::OnEngineLoopInitComplete()
 {
     if (Manager)
     {
-        Manager->InitializeSteamAudio(EManagerInitReason::PLAYING);
+        Manager->InitializeSteamAudioAsync();
     }
 
     PIEInitCount = 1;
@@ -140,6 +143,31 @@ bool FSteamAudioModule::IsPlaying()
     return (PIEInitCount > 0);
 }
 
+bool FSteamAudioModule::BeginOfflineSession()
+{
+    if (!GetManager().InitializeSteamAudio(EManagerInitReason::PLAYING))
+        return false;
+
+    FScopeLock Lock(&PIEInitCountMutex);
+    PIEInitCount++;
+    return true;
+}
+
+void FSteamAudioModule::EndOfflineSession()
+{
+    FScopeLock Lock(&PIEInitCountMutex);
+
+    if (PIEInitCount <= 0)
+        return;
+
+    PIEInitCount--;
+
+    if (PIEInitCount == 0)
+    {
+        GetManager().ShutDownSteamAudio();
+    }
+}
+
 #if WITH_EDITOR
 void FSteamAudioModule::OnPIEStarted(bool bSimulating)
 {
@@ -147,7 +175,7 @@ void FSteamAudioModule::OnPIEStarted(bool bSimulating)
     {
         if (Manager)
         {
-            Manager->InitializeSteamAudio(EManagerInitReason::PLAYING);
+            Manager->InitializeSteamAudioAsync();
         }
     }
 
@@ -204,6 +232,9 @@ void FSteamAudioModule::RegisterAudioDevice(FAudioDevice* AudioDevice)
         if (Manager)
         {
             Manager->RegisterAudioPluginListener(AudioDevice);
+
+            // The sampling rate or frame size may have changed.
+            Manager->RebuildSettingsSnapshot();
         }
 
         AudioDevices.Add(AudioDevice);
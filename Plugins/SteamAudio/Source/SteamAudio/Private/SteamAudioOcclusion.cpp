@@ -15,13 +15,14 @@
 //
 
 #include "SteamAudioOcclusion.h"
-#include "Components/AudioComponent.h"
-#include "GameFramework/Actor.h"
 #include "HAL/UnrealMemory.h"
 #include "SteamAudioCommon.h"
 #include "SteamAudioManager.h"
 #include "SteamAudioOcclusionSettings.h"
-#include "SteamAudioSourceComponent.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Direct Params Cache Hits"), STAT_SteamAudioDirectParamsCacheHits, STATGROUP_SteamAudio);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Direct Params Cache Misses"), STAT_SteamAudioDirectParamsCacheMisses, STATGROUP_SteamAudio);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Direct Params Cache Hit Rate (%)"), STAT_SteamAudioDirectParamsCacheHitRate, STATGROUP_SteamAudio);
 
 namespace SteamAudio {
 
@@ -41,17 +42,25 @@ FSteamAudioOcclusionSource::FSteamAudioOcclusionSource()
     , DirectEffect(nullptr)
     , InBuffer()
     , OutBuffer()
-    , PrevNumChannels(0)
+    , bHasCachedParams(false)
+    , CachedParams()
+    , CachedSourceCoordinates()
+    , CachedListenerPosition()
+    , CachedEmitterRotation(0.0f, 0.0f, 0.0f, 0.0f)
+    , CachedEmitterAxes()
 {}
 
 FSteamAudioOcclusionSource::~FSteamAudioOcclusionSource()
 {
     IPLContext Context = FSteamAudioModule::GetManager().GetContext();
 
-    iplAudioBufferFree(Context, &InBuffer);
-    iplAudioBufferFree(Context, &OutBuffer);
+    for (FSteamAudioOcclusionLayout& Layout : Layouts)
+    {
+        iplAudioBufferFree(Context, &Layout.InBuffer);
+        iplAudioBufferFree(Context, &Layout.OutBuffer);
 
-    iplDirectEffectRelease(&DirectEffect);
+        iplDirectEffectRelease(&Layout.DirectEffect);
+    }
 }
 
 void FSteamAudioOcclusionSource::Reset()
@@ -61,6 +70,11 @@ void FSteamAudioOcclusionSource::Reset()
         iplDirectEffectReset(DirectEffect);
     }
 
+    // The settings or the sound may have changed, so don't reuse anything calculated before. A zero quaternion never
+    // matches a real rotation, so the emitter axes are recalculated for the next buffer.
+    bHasCachedParams = false;
+    CachedEmitterRotation = FQuat(0.0f, 0.0f, 0.0f, 0.0f);
+
     ClearBuffers();
 }
 
@@ -94,15 +108,24 @@ void FSteamAudioOcclusionPlugin::Initialize(const FAudioPluginInitializationPara
     AudioSettings.frameSize = InitializationParams.BufferLength;
 
     Sources.AddDefaulted(InitializationParams.NumSources);
+    FSteamAudioModule::GetManager().ReserveVoiceOutputs(InitializationParams.NumSources);
+
+    // None of this depends on the Steam Audio settings, so it can all be allocated now, for every channel count a
+    // voice may start with, rather than on the audio thread when each voice starts.
+    for (FSteamAudioOcclusionSource& Source : Sources)
+    {
+        for (int i = 0; i < NumSupportedLayouts; ++i)
+        {
+            PrepareLayout(Source.Layouts[i], SupportedNumChannels[i]);
+        }
+    }
 }
 
 void FSteamAudioOcclusionPlugin::OnInitSource(const uint32 SourceId, const FName& AudioComponentUserId, const uint32 NumChannels, UOcclusionPluginSourceSettingsBase* InSettings)
 {
-    // Make sure we're initialized, so real-time audio can work.
-    SteamAudio::RunInGameThread<void>([&]()
-    {
-        FSteamAudioModule::GetManager().InitializeSteamAudio(EManagerInitReason::PLAYING);
-    });
+    // Make sure initialization has started, so real-time audio can work. This only queues a request for the game
+    // thread, so the audio render thread never waits on it.
+    FSteamAudioModule::GetManager().RequestInitialization();
 
     FSteamAudioOcclusionSource& Source = Sources[SourceId];
 
@@ -117,54 +140,22 @@ void FSteamAudioOcclusionPlugin::OnInitSource(const uint32 SourceId, const FName
     Source.bApplyTransmission = (Settings) ? Settings->bApplyTransmission : false;
     Source.TransmissionType = (Settings) ? Settings->TransmissionType : ETransmissionType::FREQUENCY_DEPENDENT;
 
-    IPLContext Context = FSteamAudioModule::GetManager().GetContext();
-
-    if (!Source.DirectEffect || Source.PrevNumChannels != NumChannels)
+    // Only voices with an unusual number of channels need to allocate here.
+    int LayoutIndex = GetSupportedLayoutIndex(NumChannels);
+    if (LayoutIndex == INDEX_NONE)
     {
-        if (Source.DirectEffect)
-        {
-            iplDirectEffectRelease(&Source.DirectEffect);
-        }
-
-        IPLDirectEffectSettings DirectSettings{};
-        DirectSettings.numChannels = NumChannels;
+        LayoutIndex = NumSupportedLayouts;
 
-        IPLerror Status = iplDirectEffectCreate(Context, &AudioSettings, &DirectSettings, &Source.DirectEffect);
-        if (Status != IPL_STATUS_SUCCESS)
+        if (PrepareLayout(Source.Layouts[LayoutIndex], NumChannels))
         {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create direct effect. [%d]"), Status);
+            INC_DWORD_STAT(STAT_SteamAudioVoiceSlabMisses);
         }
     }
 
-    if (!Source.InBuffer.data || Source.InBuffer.numChannels != NumChannels)
-    {
-        if (Source.InBuffer.data)
-        {
-            iplAudioBufferFree(Context, &Source.InBuffer);
-        }
-
-        IPLerror Status = iplAudioBufferAllocate(Context, NumChannels, AudioSettings.frameSize, &Source.InBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create input buffer for occlusion effect. [%d]"), Status);
-        }
-    }
-
-    if (!Source.OutBuffer.data || Source.OutBuffer.numChannels != NumChannels)
-    {
-        if (Source.OutBuffer.data)
-        {
-            iplAudioBufferFree(Context, &Source.OutBuffer);
-        }
-
-        IPLerror Status = iplAudioBufferAllocate(Context, NumChannels, AudioSettings.frameSize, &Source.OutBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create output buffer for occlusion effect. [%d]"), Status);
-        }
-    }
-
-    Source.PrevNumChannels = NumChannels;
+    const FSteamAudioOcclusionLayout& Layout = Source.Layouts[LayoutIndex];
+    Source.DirectEffect = Layout.DirectEffect;
+    Source.InBuffer = Layout.InBuffer;
+    Source.OutBuffer = Layout.OutBuffer;
 
     Source.Reset();
 }
@@ -186,6 +177,8 @@ void FSteamAudioOcclusionPlugin::ProcessAudio(const FAudioPluginSourceInputData&
         return;
     }
 
+    FScopedNoAllocation NoAllocation;
+
     FSteamAudioOcclusionSource& Source = Sources[InputData.SourceId];
 
     float* InBufferData = InputData.AudioBuffer->GetData();
@@ -200,15 +193,19 @@ void FSteamAudioOcclusionPlugin::ProcessAudio(const FAudioPluginSourceInputData&
         // Deinterleave the input buffer.
         iplAudioBufferDeinterleave(Context, InBufferData, &Source.InBuffer);
 
-        // We are given the source's position and orientation.
-        IPLCoordinateSpace3 SourceCoordinates{};
-        SourceCoordinates.origin = SteamAudio::ConvertVector(InputData.SpatializationParams->EmitterWorldPosition);
-        SourceCoordinates.ahead = SteamAudio::ConvertVector(InputData.SpatializationParams->EmitterWorldRotation * FVector::ForwardVector, false);
-        SourceCoordinates.right = SteamAudio::ConvertVector(InputData.SpatializationParams->EmitterWorldRotation * FVector::RightVector, false);
-        SourceCoordinates.up = SteamAudio::ConvertVector(InputData.SpatializationParams->EmitterWorldRotation * FVector::UpVector, false);
+        FSteamAudioModule::GetManager().RefreshSettingsSnapshot(SettingsSnapshot, SettingsGeneration);
+        float UpdateDistance = (SettingsSnapshot) ? SettingsSnapshot->Settings.DirectParamsUpdateDistance : 0.0f;
+        float UpdateAngle = (SettingsSnapshot) ? SettingsSnapshot->Settings.DirectParamsUpdateAngle : 0.0f;
+
+        FSteamAudioSourceOutputs SourceOutputs;
+        bool bHasSourceOutputs = FSteamAudioModule::GetManager().GetSourceOutputs(InputData.SourceId, InputData.AudioComponentId, SourceOutputs);
 
-        // Get the listener's position and orientation from the global audio plugin listener.
-        IPLCoordinateSpace3 ListenerCoordinates = FSteamAudioModule::GetManager().GetListenerCoordinates();
+        IPLCoordinateSpace3 SourceCoordinates = GetSourceCoordinates(Source, InputData);
+
+        // Use the listener the source was simulated for, or the primary listener from the global audio plugin
+        // listener if the manager hasn't simulated the source yet.
+        IPLCoordinateSpace3 ListenerCoordinates = (bHasSourceOutputs && SourceOutputs.bHasListenerCoordinates) ?
+            SourceOutputs.ListenerCoordinates : FSteamAudioModule::GetManager().GetListenerCoordinates();
 
         IPLDirectEffectParams Params{};
 
@@ -224,13 +221,147 @@ void FSteamAudioOcclusionPlugin::ProcessAudio(const FAudioPluginSourceInputData&
         if (Source.bApplyTransmission)
             Params.flags = static_cast<IPLDirectEffectFlags>(Params.flags | IPL_DIRECTEFFECTFLAGS_APPLYTRANSMISSION);
 
+        // Distance attenuation, air absorption, and directivity only depend on the source and listener poses, so
+        // they can usually be reused from the previous buffer.
+        if (Source.bApplyDistanceAttenuation || Source.bApplyAirAbsorption || Source.bApplyDirectivity)
+        {
+            bool bHit = UpdateDirectParams(Source, SourceCoordinates, ListenerCoordinates.origin, UpdateDistance, UpdateAngle, Params);
+
+            uint64 NumLookups = NumDirectParamsLookups.fetch_add(1, std::memory_order_relaxed) + 1;
+            uint64 NumHits = NumDirectParamsHits.fetch_add(bHit ? 1 : 0, std::memory_order_relaxed) + (bHit ? 1 : 0);
+
+            if (bHit)
+            {
+                INC_DWORD_STAT(STAT_SteamAudioDirectParamsCacheHits);
+            }
+            else
+            {
+                INC_DWORD_STAT(STAT_SteamAudioDirectParamsCacheMisses);
+            }
+
+            SET_FLOAT_STAT(STAT_SteamAudioDirectParamsCacheHitRate, (100.0 * NumHits) / NumLookups);
+        }
+
+        // If enabled, retrieve occlusion (and optionally transmission) values published for the actor's Steam Audio
+        // Source component.
+        if (Source.bApplyOcclusion)
+        {
+            Params.occlusion = SourceOutputs.Occlusion;
+
+            if (Source.bApplyTransmission)
+            {
+                Params.transmissionType = static_cast<IPLTransmissionType>(Source.TransmissionType);
+
+                Params.transmission[0] = SourceOutputs.Transmission[0];
+                Params.transmission[1] = SourceOutputs.Transmission[1];
+                Params.transmission[2] = SourceOutputs.Transmission[2];
+            }
+        }
+
+        // Apply the direct effect.
+        iplDirectEffectApply(Source.DirectEffect, &Params, &Source.InBuffer, &Source.OutBuffer);
+
+        // Interleave the output buffer.
+        iplAudioBufferInterleave(Context, &Source.OutBuffer, OutBufferData);
+    }
+}
+
+bool FSteamAudioOcclusionPlugin::PrepareLayout(FSteamAudioOcclusionLayout& Layout, int NumChannels)
+{
+    if (Layout.DirectEffect && Layout.InBuffer.data && Layout.OutBuffer.data && Layout.InBuffer.numChannels == NumChannels)
+        return false;
+
+    IPLContext Context = FSteamAudioModule::GetManager().GetContext();
+
+    iplDirectEffectRelease(&Layout.DirectEffect);
+    iplAudioBufferFree(Context, &Layout.InBuffer);
+    iplAudioBufferFree(Context, &Layout.OutBuffer);
+
+    IPLDirectEffectSettings DirectSettings{};
+    DirectSettings.numChannels = NumChannels;
+
+    IPLerror Status = iplDirectEffectCreate(Context, &AudioSettings, &DirectSettings, &Layout.DirectEffect);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create direct effect. [%d]"), Status);
+    }
+
+    Status = iplAudioBufferAllocate(Context, NumChannels, AudioSettings.frameSize, &Layout.InBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create input buffer for occlusion effect. [%d]"), Status);
+    }
+
+    Status = iplAudioBufferAllocate(Context, NumChannels, AudioSettings.frameSize, &Layout.OutBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create output buffer for occlusion effect. [%d]"), Status);
+    }
+
+    return true;
+}
+
+IPLCoordinateSpace3 FSteamAudioOcclusionPlugin::GetSourceCoordinates(FSteamAudioOcclusionSource& Source,
+    const FAudioPluginSourceInputData& InputData)
+{
+    // The emitter transform is the Audio Component's, which may be attached to a socket or offset from the actor's
+    // root, so use it as given. Only rotate the axes when the rotation changes.
+    const FQuat& EmitterRotation = InputData.SpatializationParams->EmitterWorldRotation;
+    if (!EmitterRotation.Equals(Source.CachedEmitterRotation, 0.0f))
+    {
+        Source.CachedEmitterAxes.ahead = SteamAudio::ConvertVector(EmitterRotation * FVector::ForwardVector, false);
+        Source.CachedEmitterAxes.right = SteamAudio::ConvertVector(EmitterRotation * FVector::RightVector, false);
+        Source.CachedEmitterAxes.up = SteamAudio::ConvertVector(EmitterRotation * FVector::UpVector, false);
+        Source.CachedEmitterRotation = EmitterRotation;
+    }
+
+    IPLCoordinateSpace3 SourceCoordinates = Source.CachedEmitterAxes;
+    SourceCoordinates.origin = SteamAudio::ConvertVector(InputData.SpatializationParams->EmitterWorldPosition);
+    return SourceCoordinates;
+}
+
+/** Returns true if the two points are no further apart than the given distance. */
+static bool IsWithinDistance(const IPLVector3& A, const IPLVector3& B, float Distance)
+{
+    float DX = A.x - B.x;
+    float DY = A.y - B.y;
+    float DZ = A.z - B.z;
+    return (DX * DX + DY * DY + DZ * DZ) <= (Distance * Distance);
+}
+
+/** Returns true if the two unit vectors are no further apart than the given angle, in degrees. */
+static bool IsWithinAngle(const IPLVector3& A, const IPLVector3& B, float Angle)
+{
+    if (A.x == B.x && A.y == B.y && A.z == B.z)
+        return true;
+
+    return (A.x * B.x + A.y * B.y + A.z * B.z) >= FMath::Cos(FMath::DegreesToRadians(Angle));
+}
+
+bool FSteamAudioOcclusionPlugin::UpdateDirectParams(FSteamAudioOcclusionSource& Source, const IPLCoordinateSpace3& SourceCoordinates,
+    const IPLVector3& ListenerPosition, float UpdateDistance, float UpdateAngle, IPLDirectEffectParams& Params)
+{
+    bool bHit = Source.bHasCachedParams &&
+        Source.CachedParams.flags == Params.flags &&
+        IsWithinDistance(SourceCoordinates.origin, Source.CachedSourceCoordinates.origin, UpdateDistance) &&
+        IsWithinDistance(ListenerPosition, Source.CachedListenerPosition, UpdateDistance) &&
+        (!Source.bApplyDirectivity || IsWithinAngle(SourceCoordinates.ahead, Source.CachedSourceCoordinates.ahead, UpdateAngle));
+
+    if (!bHit)
+    {
+        IPLContext Context = FSteamAudioModule::GetManager().GetContext();
+
+        IPLDirectEffectParams& Cached = Source.CachedParams;
+        Cached = IPLDirectEffectParams{};
+        Cached.flags = Params.flags;
+
         // If enabled, calculate physics-based distance attenuation using the default model.
         if (Source.bApplyDistanceAttenuation)
         {
             IPLDistanceAttenuationModel DistanceAttenuationModel{};
             DistanceAttenuationModel.type = IPL_DISTANCEATTENUATIONTYPE_DEFAULT;
 
-            Params.distanceAttenuation = iplDistanceAttenuationCalculate(Context, SourceCoordinates.origin, ListenerCoordinates.origin, &DistanceAttenuationModel);
+            Cached.distanceAttenuation = iplDistanceAttenuationCalculate(Context, SourceCoordinates.origin, ListenerPosition, &DistanceAttenuationModel);
         }
 
         // If enabled, calculate frequency-dependent air absorption using the default model.
@@ -239,7 +370,7 @@ void FSteamAudioOcclusionPlugin::ProcessAudio(const FAudioPluginSourceInputData&
             IPLAirAbsorptionModel AirAbsorptionModel{};
             AirAbsorptionModel.type = IPL_AIRABSORPTIONTYPE_DEFAULT;
 
-            iplAirAbsorptionCalculate(Context, SourceCoordinates.origin, ListenerCoordinates.origin, &AirAbsorptionModel, Params.airAbsorption);
+            iplAirAbsorptionCalculate(Context, SourceCoordinates.origin, ListenerPosition, &AirAbsorptionModel, Cached.airAbsorption);
         }
 
         // If enabled, calculate directivity using the configured dipole model.
@@ -249,34 +380,21 @@ void FSteamAudioOcclusionPlugin::ProcessAudio(const FAudioPluginSourceInputData&
             DirectivityModel.dipoleWeight = Source.DipoleWeight;
             DirectivityModel.dipolePower = Source.DipolePower;
 
-            Params.directivity = iplDirectivityCalculate(Context, SourceCoordinates, ListenerCoordinates.origin, &DirectivityModel);
+            Cached.directivity = iplDirectivityCalculate(Context, SourceCoordinates, ListenerPosition, &DirectivityModel);
         }
 
-        // If enabled, retrieve occlusion (and optionally transmission) values from the actor's Steam Audio Source
-        // component.
-        if (Source.bApplyOcclusion)
-        {
-            UAudioComponent* AudioComponent = UAudioComponent::GetAudioComponentFromID(InputData.AudioComponentId);
-            USteamAudioSourceComponent* SteamAudioSourceComponent = (AudioComponent) ? AudioComponent->GetOwner()->FindComponentByClass<USteamAudioSourceComponent>() : nullptr;
-
-            Params.occlusion = (SteamAudioSourceComponent) ? SteamAudioSourceComponent->OcclusionValue : 1.0f;
-
-            if (Source.bApplyTransmission)
-            {
-                Params.transmissionType = static_cast<IPLTransmissionType>(Source.TransmissionType);
-
-                Params.transmission[0] = (SteamAudioSourceComponent) ? SteamAudioSourceComponent->TransmissionLowValue : 1.0f;
-                Params.transmission[1] = (SteamAudioSourceComponent) ? SteamAudioSourceComponent->TransmissionMidValue : 1.0f;
-                Params.transmission[2] = (SteamAudioSourceComponent) ? SteamAudioSourceComponent->TransmissionHighValue : 1.0f;
-            }
-        }
+        Source.CachedSourceCoordinates = SourceCoordinates;
+        Source.CachedListenerPosition = ListenerPosition;
+        Source.bHasCachedParams = true;
+    }
 
-        // Apply the direct effect.
-        iplDirectEffectApply(Source.DirectEffect, &Params, &Source.InBuffer, &Source.OutBuffer);
+    Params.distanceAttenuation = Source.CachedParams.distanceAttenuation;
+    Params.airAbsorption[0] = Source.CachedParams.airAbsorption[0];
+    Params.airAbsorption[1] = Source.CachedParams.airAbsorption[1];
+    Params.airAbsorption[2] = Source.CachedParams.airAbsorption[2];
+    Params.directivity = Source.CachedParams.directivity;
 
-        // Interleave the output buffer.
-        iplAudioBufferInterleave(Context, &Source.OutBuffer, OutBufferData);
-    }
+    return bHit;
 }
 
 
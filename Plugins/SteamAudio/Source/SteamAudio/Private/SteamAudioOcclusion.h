@@ -17,10 +17,30 @@
 #pragma once
 
 #include "SteamAudioModule.h"
+#include "SteamAudioManager.h"
 #include "SteamAudioOcclusionSettings.h"
 
 namespace SteamAudio {
 
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioOcclusionLayout
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * The direct effect and buffers for rendering a voice with a given number of channels.
+ */
+struct FSteamAudioOcclusionLayout
+{
+    IPLDirectEffect DirectEffect = nullptr;
+
+    /** Deinterleaved input buffer. */
+    IPLAudioBuffer InBuffer{};
+
+    /** Deinterleaved output buffer. */
+    IPLAudioBuffer OutBuffer{};
+};
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // FSteamAudioOcclusionSource
 // ---------------------------------------------------------------------------------------------------------------------
@@ -43,15 +63,31 @@ struct FSteamAudioOcclusionSource
     bool bApplyTransmission;
     ETransmissionType TransmissionType;
 
-    IPLDirectEffect DirectEffect;
+    /** Effects and buffers for each channel count in SupportedNumChannels, followed by one for whichever other
+        channel count a voice last started with. */
+    FSteamAudioOcclusionLayout Layouts[NumSupportedLayouts + 1];
 
-    /** Deinterleaved input buffer. */
+    /** The entries of the layout the voice started with, copied out of Layouts. Not owned. */
+    IPLDirectEffect DirectEffect;
     IPLAudioBuffer InBuffer;
-
-    /** Deinterleaved output buffer. */
     IPLAudioBuffer OutBuffer;
 
-    int PrevNumChannels;
+    /** True if CachedParams is valid. */
+    bool bHasCachedParams;
+
+    /** Distance attenuation, air absorption, and directivity from the last time they were calculated, along with the
+        flags that were used. Reused until the source or listener has moved far enough, or the flags change. */
+    IPLDirectEffectParams CachedParams;
+
+    /** The source's position and orientation when CachedParams was calculated. */
+    IPLCoordinateSpace3 CachedSourceCoordinates;
+
+    /** The listener's position when CachedParams was calculated. */
+    IPLVector3 CachedListenerPosition;
+
+    /** The emitter rotation last passed in by the audio engine, and the source coordinate axes calculated from it. */
+    FQuat CachedEmitterRotation;
+    IPLCoordinateSpace3 CachedEmitterAxes;
 
     void Reset();
 
@@ -89,8 +125,32 @@ private:
     /** Audio pipeline settings. */
     IPLAudioSettings AudioSettings;
 
-    /** Lazy-initialized state for as many sources as we can render simultaneously. */
+    /** State for as many sources as we can render simultaneously, allocated up front by Initialize for every supported
+        channel count. */
     TArray<FSteamAudioOcclusionSource> Sources;
+
+    /** The most recent settings snapshot seen by the audio thread. */
+    FSteamAudioSettingsSnapshotPtr SettingsSnapshot;
+
+    /** Settings generation that SettingsSnapshot was fetched for. */
+    uint32 SettingsGeneration = 0;
+
+    /** Number of times cached direct effect parameters were looked up, and how many of those could be reused. Used
+        to calculate the cache hit rate stat. */
+    std::atomic<uint64> NumDirectParamsLookups{ 0 };
+    std::atomic<uint64> NumDirectParamsHits{ 0 };
+
+    /** Allocates the direct effect and buffers for the given layout, unless it already has them for the given number
+        of channels. Returns true if anything was allocated. */
+    bool PrepareLayout(FSteamAudioOcclusionLayout& Layout, int NumChannels);
+
+    /** Returns the source's position and orientation, from the emitter transform passed in by the audio engine. */
+    static IPLCoordinateSpace3 GetSourceCoordinates(FSteamAudioOcclusionSource& Source, const FAudioPluginSourceInputData& InputData);
+
+    /** Fills in distance attenuation, air absorption, and directivity in Params, reusing the values cached on the
+        source if possible. Returns true if the cached values were reused. */
+    bool UpdateDirectParams(FSteamAudioOcclusionSource& Source, const IPLCoordinateSpace3& SourceCoordinates,
+        const IPLVector3& ListenerPosition, float UpdateDistance, float UpdateAngle, IPLDirectEffectParams& Params);
 };
 
 
@@ -23,6 +23,388 @@
 #include "SteamAudioScene.h"
 #include "SteamAudioSerializedObject.h"
 #include "SteamAudioStaticMeshActor.h"
+#include "UObject/StrongObjectPtr.h"
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Adaptive probe generation
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Probes whose floors differ in height by more than this (in meters) are treated as being in different rooms, e.g.
+    on either side of a step or a stairwell. */
+static const float AdaptiveFloorStepHeight = 0.5f;
+
+/** Number of line of sight tests run by each direct simulation. */
+static const int32 NumVisibilityTestsPerBatch = 64;
+
+/** Returns a coordinate space at the given position, facing down -z. */
+static IPLCoordinateSpace3 MakeCoordinateSpace(const IPLVector3& Origin)
+{
+    return IPLCoordinateSpace3{{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, Origin};
+}
+
+/** Returns the squared distance between two points, ignoring height. */
+static float GetHorizontalDistSquared(const IPLVector3& A, const IPLVector3& B)
+{
+    float DX = A.x - B.x;
+    float DZ = A.z - B.z;
+    return DX * DX + DZ * DZ;
+}
+
+/** Generates probes into a probe array, and returns the spheres of the generated probes. */
+static bool GenerateProbeSpheres(IPLContext Context, IPLScene Scene, IPLProbeGenerationParams& Params, TArray<IPLSphere>& OutProbes)
+{
+    IPLProbeArray ProbeArray = nullptr;
+    IPLerror Status = iplProbeArrayCreate(Context, &ProbeArray);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create probe array. [%d]"), Status);
+        return false;
+    }
+
+    iplProbeArrayGenerateProbes(ProbeArray, Scene, &Params);
+
+    int NumProbes = iplProbeArrayGetNumProbes(ProbeArray);
+    OutProbes.SetNumUninitialized(NumProbes);
+    for (int i = 0; i < NumProbes; ++i)
+    {
+        OutProbes[i] = iplProbeArrayGetProbe(ProbeArray, i);
+    }
+
+    iplProbeArrayRelease(&ProbeArray);
+    return true;
+}
+
+/**
+ * Buckets probes into a horizontal grid, so probes near a given point can be found without testing every probe.
+ */
+class FProbeGrid
+{
+public:
+    explicit FProbeGrid(float InCellSize)
+        : CellSize(FMath::Max(InCellSize, 0.01f))
+    {}
+
+    /** Adds the probe with the given index at the given position. */
+    void Add(int32 Index, const IPLVector3& Position)
+    {
+        Cells.FindOrAdd(GetCell(Position.x, Position.z)).Add(Index);
+    }
+
+    /** Calls the given function with the index of every probe in a cell within the given horizontal distance of the
+        given position. Callers must check the actual distance. */
+    template <typename TFunction>
+    void ForEachNear(const IPLVector3& Position, float Distance, TFunction&& Function) const
+    {
+        FIntPoint Min = GetCell(Position.x - Distance, Position.z - Distance);
+        FIntPoint Max = GetCell(Position.x + Distance, Position.z + Distance);
+
+        for (int32 X = Min.X; X <= Max.X; ++X)
+        {
+            for (int32 Z = Min.Y; Z <= Max.Y; ++Z)
+            {
+                if (const TArray<int32>* Indices = Cells.Find(FIntPoint(X, Z)))
+                {
+                    for (int32 Index : *Indices)
+                    {
+                        Function(Index);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    FIntPoint GetCell(float X, float Z) const
+    {
+        return FIntPoint(FMath::FloorToInt(X / CellSize), FMath::FloorToInt(Z / CellSize));
+    }
+
+    float CellSize;
+    TMap<FIntPoint, TArray<int32>> Cells;
+};
+
+/**
+ * Tests line of sight between points in a scene. The Steam Audio API doesn't expose ray casts, so each batch of tests
+ * is run as a direct simulation with raycast occlusion: the listener is placed at the origin and a source at each
+ * target, and a target is visible if its source is not occluded.
+ */
+class FProbeVisibilityTester
+{
+public:
+    FProbeVisibilityTester()
+        : Simulator(nullptr)
+    {}
+
+    ~FProbeVisibilityTester()
+    {
+        for (IPLSource& Source : Sources)
+        {
+            iplSourceRemove(Source, Simulator);
+            iplSourceRelease(&Source);
+        }
+
+        if (Simulator)
+        {
+            iplSimulatorRelease(&Simulator);
+        }
+    }
+
+    bool Initialize(IPLContext Context, IPLScene Scene, IPLSimulationSettings SimulationSettings)
+    {
+        // No audio is processed, but the simulator still needs a valid audio configuration.
+        if (SimulationSettings.samplingRate <= 0)
+        {
+            SimulationSettings.samplingRate = 48000;
+        }
+        if (SimulationSettings.frameSize <= 0)
+        {
+            SimulationSettings.frameSize = 1024;
+        }
+
+        IPLerror Status = iplSimulatorCreate(Context, &SimulationSettings, &Simulator);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create simulator. [%d]"), Status);
+            return false;
+        }
+
+        iplSimulatorSetScene(Simulator, Scene);
+
+        IPLSourceSettings SourceSettings{};
+        SourceSettings.flags = IPL_SIMULATIONFLAGS_DIRECT;
+
+        for (int32 i = 0; i < NumVisibilityTestsPerBatch; ++i)
+        {
+            IPLSource Source = nullptr;
+            Status = iplSourceCreate(Simulator, &SourceSettings, &Source);
+            if (Status != IPL_STATUS_SUCCESS)
+            {
+                UE_LOG(LogSteamAudio, Error, TEXT("Unable to create source. [%d]"), Status);
+                return false;
+            }
+
+            iplSourceAdd(Source, Simulator);
+            Sources.Add(Source);
+        }
+
+        iplSimulatorCommit(Simulator);
+        return true;
+    }
+
+    /** Returns, for each target, whether it can be seen from the origin. */
+    void Test(const IPLVector3& Origin, const TArray<IPLVector3>& Targets, TArray<bool>& OutVisible)
+    {
+        OutVisible.SetNumUninitialized(Targets.Num());
+
+        IPLSimulationSharedInputs SharedInputs{};
+        SharedInputs.listener = MakeCoordinateSpace(Origin);
+        iplSimulatorSetSharedInputs(Simulator, IPL_SIMULATIONFLAGS_DIRECT, &SharedInputs);
+
+        for (int32 First = 0; First < Targets.Num(); First += Sources.Num())
+        {
+            int32 Count = FMath::Min(Sources.Num(), Targets.Num() - First);
+
+            // Sources with no targets in this batch are parked at the origin with occlusion turned off.
+            for (int32 i = 0; i < Sources.Num(); ++i)
+            {
+                IPLSimulationInputs Inputs{};
+                Inputs.flags = IPL_SIMULATIONFLAGS_DIRECT;
+                Inputs.source = MakeCoordinateSpace((i < Count) ? Targets[First + i] : Origin);
+                if (i < Count)
+                {
+                    Inputs.directFlags = IPL_DIRECTSIMULATIONFLAGS_OCCLUSION;
+                    Inputs.occlusionType = IPL_OCCLUSIONTYPE_RAYCAST;
+                }
+
+                iplSourceSetInputs(Sources[i], IPL_SIMULATIONFLAGS_DIRECT, &Inputs);
+            }
+
+            iplSimulatorRunDirect(Simulator);
+
+            for (int32 i = 0; i < Count; ++i)
+            {
+                IPLSimulationOutputs Outputs{};
+                iplSourceGetOutputs(Sources[i], IPL_SIMULATIONFLAGS_DIRECT, &Outputs);
+                OutVisible[First + i] = (Outputs.direct.occlusion > 0.0f);
+            }
+        }
+    }
+
+private:
+    IPLSimulator Simulator;
+    TArray<IPLSource> Sources;
+};
+
+/**
+ * Places probes starting from a uniform floor layout, and adapts their density to the geometry:
+ *
+ * 1. Probes are generated at Spacing (coarse probes) and at MinSpacing (fine probes). Each fine probe is assigned to
+ *    the nearest coarse probe.
+ * 2. A coarse probe is replaced by its fine probes if any of them can't be seen from it (there is an occluder nearby),
+ *    or is on a floor at a different height (there is a room transition nearby). Fine probes with no coarse probe
+ *    nearby, in spaces too narrow for the coarse layout, are also kept.
+ * 3. The remaining coarse probes are in open areas. Each one is pruned if it can be seen from a coarse probe that has
+ *    already been kept within MaxSpacing, since both would bake nearly the same data. Kept probes have their radius
+ *    grown to MaxSpacing, to cover the probes pruned around them.
+ *
+ * Returns the generated probes, and the number of probes uniform generation places at Spacing.
+ */
+static bool GenerateAdaptiveProbes(IPLContext Context, IPLScene Scene, FProbeVisibilityTester& Visibility,
+    IPLProbeGenerationParams Params, float MinSpacing, float MaxSpacing, TArray<IPLSphere>& OutProbes, int32& OutNumUniformProbes)
+{
+    const float Spacing = Params.spacing;
+
+    TArray<IPLSphere> CoarseProbes;
+    if (!GenerateProbeSpheres(Context, Scene, Params, CoarseProbes))
+        return false;
+
+    OutNumUniformProbes = CoarseProbes.Num();
+
+    TArray<IPLSphere> FineProbes;
+    if (MinSpacing < Spacing)
+    {
+        Params.spacing = MinSpacing;
+        if (!GenerateProbeSpheres(Context, Scene, Params, FineProbes))
+            return false;
+    }
+
+    FProbeGrid CoarseGrid(Spacing);
+    for (int32 i = 0; i < CoarseProbes.Num(); ++i)
+    {
+        CoarseGrid.Add(i, CoarseProbes[i].center);
+    }
+
+    // Assign each fine probe to the nearest coarse probe within one spacing horizontally. Distance is measured in 3D,
+    // so probes on stacked floors are assigned to coarse probes on their own floor.
+    TArray<TArray<int32>> FineProbesByCoarseProbe;
+    FineProbesByCoarseProbe.SetNum(CoarseProbes.Num());
+
+    TArray<int32> UncoveredFineProbes;
+
+    for (int32 j = 0; j < FineProbes.Num(); ++j)
+    {
+        const IPLVector3& Position = FineProbes[j].center;
+
+        int32 Nearest = INDEX_NONE;
+        float NearestDistSquared = TNumericLimits<float>::Max();
+
+        CoarseGrid.ForEachNear(Position, Spacing, [&](int32 i)
+        {
+            const IPLVector3& CoarsePosition = CoarseProbes[i].center;
+            if (GetHorizontalDistSquared(Position, CoarsePosition) > Spacing * Spacing)
+                return;
+
+            float DY = Position.y - CoarsePosition.y;
+            float DistSquared = GetHorizontalDistSquared(Position, CoarsePosition) + DY * DY;
+            if (DistSquared < NearestDistSquared)
+            {
+                Nearest = i;
+                NearestDistSquared = DistSquared;
+            }
+        });
+
+        if (Nearest == INDEX_NONE)
+        {
+            UncoveredFineProbes.Add(j);
+        }
+        else
+        {
+            FineProbesByCoarseProbe[Nearest].Add(j);
+        }
+    }
+
+    // Subdivide around coarse probes near occluders or room transitions.
+    TArray<bool> Subdivided;
+    Subdivided.SetNumZeroed(CoarseProbes.Num());
+
+    TArray<IPLVector3> Targets;
+    TArray<bool> Visible;
+
+    for (int32 i = 0; i < CoarseProbes.Num(); ++i)
+    {
+        const IPLVector3& Position = CoarseProbes[i].center;
+
+        Targets.Reset();
+        bool bFloorStep = false;
+        for (int32 j : FineProbesByCoarseProbe[i])
+        {
+            if (FMath::Abs(FineProbes[j].center.y - Position.y) > AdaptiveFloorStepHeight)
+            {
+                bFloorStep = true;
+                break;
+            }
+
+            Targets.Add(FineProbes[j].center);
+        }
+
+        if (bFloorStep)
+        {
+            Subdivided[i] = true;
+        }
+        else if (Targets.Num() > 0)
+        {
+            Visibility.Test(Position, Targets, Visible);
+            Subdivided[i] = Visible.Contains(false);
+        }
+    }
+
+    OutProbes.Reset();
+
+    for (int32 i = 0; i < CoarseProbes.Num(); ++i)
+    {
+        if (Subdivided[i])
+        {
+            for (int32 j : FineProbesByCoarseProbe[i])
+            {
+                OutProbes.Add(FineProbes[j]);
+            }
+        }
+    }
+
+    for (int32 j : UncoveredFineProbes)
+    {
+        OutProbes.Add(FineProbes[j]);
+    }
+
+    // Prune coarse probes in open areas that can be seen from a nearby probe that is being kept.
+    FProbeGrid KeptGrid(MaxSpacing);
+
+    for (int32 i = 0; i < CoarseProbes.Num(); ++i)
+    {
+        if (Subdivided[i])
+            continue;
+
+        const IPLVector3& Position = CoarseProbes[i].center;
+
+        Targets.Reset();
+        KeptGrid.ForEachNear(Position, MaxSpacing, [&](int32 k)
+        {
+            const IPLVector3& KeptPosition = CoarseProbes[k].center;
+            if (GetHorizontalDistSquared(Position, KeptPosition) <= MaxSpacing * MaxSpacing &&
+                FMath::Abs(Position.y - KeptPosition.y) <= AdaptiveFloorStepHeight)
+            {
+                Targets.Add(KeptPosition);
+            }
+        });
+
+        if (Targets.Num() > 0)
+        {
+            Visibility.Test(Position, Targets, Visible);
+            if (Visible.Contains(true))
+                continue;
+        }
+
+        KeptGrid.Add(i, Position);
+
+        IPLSphere Probe = CoarseProbes[i];
+        Probe.radius = FMath::Max(Probe.radius, MaxSpacing);
+        OutProbes.Add(Probe);
+    }
+
+    return true;
+}
+
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -34,10 +416,17 @@ ASteamAudioProbeVolume::ASteamAudioProbeVolume()
 	, GenerationType(EProbeGenerationType::UNIFORM_FLOOR)
 	, HorizontalSpacing(3.0f)
 	, HeightAboveFloor(1.5f)
+	, bAdaptiveSpacing(false)
+	, MinHorizontalSpacing(1.0f)
+	, MaxHorizontalSpacing(9.0f)
 	, NumProbes(0)
+	, NumUniformProbes(0)
+	, BakedDataCompression(EBakedDataCompression::NONE)
 	, DataSize(0)
+	, CompressedDataSize(0)
 	, Simulator(nullptr)
 	, ProbeBatch(nullptr)
+	, ProbeBatchLoadRequest(0)
 {
 	UPrimitiveComponent* RootPrimitiveComponent = Cast<UPrimitiveComponent>(this->GetRootComponent());
 	if (RootPrimitiveComponent)
@@ -58,6 +447,12 @@ bool ASteamAudioProbeVolume::CanEditChange(const FProperty* InProperty) const
         return bParentVal && (GenerationType == EProbeGenerationType::UNIFORM_FLOOR);
     if (InProperty->GetFName() == GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, HeightAboveFloor))
         return bParentVal && (GenerationType == EProbeGenerationType::UNIFORM_FLOOR);
+    if (InProperty->GetFName() == GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, bAdaptiveSpacing))
+        return bParentVal && (GenerationType == EProbeGenerationType::UNIFORM_FLOOR);
+    if (InProperty->GetFName() == GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, MinHorizontalSpacing))
+        return bParentVal && (GenerationType == EProbeGenerationType::UNIFORM_FLOOR) && bAdaptiveSpacing;
+    if (InProperty->GetFName() == GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, MaxHorizontalSpacing))
+        return bParentVal && (GenerationType == EProbeGenerationType::UNIFORM_FLOOR) && bAdaptiveSpacing;
 
     return bParentVal;
 }
@@ -67,37 +462,94 @@ void ASteamAudioProbeVolume::BeginPlay()
 {
 	Super::BeginPlay();
 
-	SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
-
 	if (!Asset.IsAsset())
 		return;
 
-	// Make sure Steam Audio is initialized.
-	if (!Manager.InitializeSteamAudio(SteamAudio::EManagerInitReason::PLAYING))
+	// Initialization may still be running in the background, in which case loading waits for it to finish.
+	SteamAudio::FSteamAudioModule::GetManager().WhenInitialized(this, [this]()
+	{
+		OnSteamAudioInitialized();
+	});
+}
+
+void ASteamAudioProbeVolume::OnSteamAudioInitialized()
+{
+	if (!HasActorBegunPlay() && !IsActorBeginningPlay())
 		return;
 
+	SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+
     Simulator = iplSimulatorRetain(Manager.GetSimulator());
 	if (!Simulator)
 		return;
 
-    // Load the probe batch from the .uasset and add it to the simulator.
-    ProbeBatch = SteamAudio::LoadProbeBatchFromAsset(Asset, Manager.GetContext());
-	if (!ProbeBatch)
+	// Load the .uasset asynchronously. This only reads the object header; the baked data is read from disk and
+	// loaded into a probe batch on a worker thread, after which the probe batch is added to the simulator.
+	int32 RequestId = ++ProbeBatchLoadRequest;
+	TWeakObjectPtr<ASteamAudioProbeVolume> WeakThis(this);
+
+	Asset.LoadAsync(FLoadSoftObjectPathAsyncDelegate::CreateLambda([WeakThis, RequestId](const FSoftObjectPath& LoadedPath, UObject* LoadedObject)
 	{
-		iplSimulatorRelease(&Simulator);
-		return;
-	}
+		ASteamAudioProbeVolume* ProbeVolume = WeakThis.Get();
+		if (!ProbeVolume || ProbeVolume->ProbeBatchLoadRequest != RequestId || !ProbeVolume->Simulator)
+			return;
+
+		USteamAudioSerializedObject* AssetObject = Cast<USteamAudioSerializedObject>(LoadedObject);
+		if (!AssetObject)
+		{
+			UE_LOG(LogSteamAudio, Error, TEXT("Unable to load probe batch asset: %s"), *LoadedPath.ToString());
+			return;
+		}
+
+		TStrongObjectPtr<USteamAudioSerializedObject> AssetObjectRef(AssetObject);
+		IPLContext Context = iplContextRetain(SteamAudio::FSteamAudioModule::GetManager().GetContext());
 
-    iplProbeBatchCommit(ProbeBatch);
-    iplSimulatorAddProbeBatch(Simulator, ProbeBatch);
+		Async(EAsyncExecution::ThreadPool, [WeakThis, RequestId, AssetObjectRef = MoveTemp(AssetObjectRef), Context]() mutable
+		{
+			IPLProbeBatch LoadedProbeBatch = SteamAudio::LoadProbeBatchFromSerializedObject(AssetObjectRef.Get(), Context);
+			if (LoadedProbeBatch)
+			{
+				iplProbeBatchCommit(LoadedProbeBatch);
+			}
+
+			iplContextRelease(&Context);
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, RequestId, AssetObjectRef = MoveTemp(AssetObjectRef), LoadedProbeBatch]() mutable
+			{
+				AssetObjectRef.Reset();
+
+				if (!LoadedProbeBatch)
+					return;
+
+				ASteamAudioProbeVolume* ProbeVolume = WeakThis.Get();
+				if (!ProbeVolume || ProbeVolume->ProbeBatchLoadRequest != RequestId || !ProbeVolume->Simulator)
+				{
+					iplProbeBatchRelease(&LoadedProbeBatch);
+					return;
+				}
+
+				ProbeVolume->ProbeBatch = LoadedProbeBatch;
+				iplSimulatorAddProbeBatch(ProbeVolume->Simulator, ProbeVolume->ProbeBatch);
+				SteamAudio::FSteamAudioModule::GetManager().RequestSimulatorCommit();
+			});
+		});
+	}));
 }
 
 void ASteamAudioProbeVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	// Discard any load that is still in flight.
+	++ProbeBatchLoadRequest;
+
 	if (Simulator && ProbeBatch)
 	{
         iplSimulatorRemoveProbeBatch(Simulator, ProbeBatch);
+        SteamAudio::FSteamAudioModule::GetManager().RequestSimulatorCommit();
         iplProbeBatchRelease(&ProbeBatch);
+	}
+
+	if (Simulator)
+	{
         iplSimulatorRelease(&Simulator);
 	}
 
@@ -113,6 +565,20 @@ bool ASteamAudioProbeVolume::GenerateProbes(ASteamAudioStaticMeshActor* StaticMe
 
 	Async(EAsyncExecution::Thread, [this, StaticMeshActor, AssetName, &Promise]()
 	{
+        // If neither the geometry nor the probe settings have changed since the probes were last generated, keep the
+        // existing probes, along with any layers baked for them.
+        FString NewProbeContentHash = SteamAudio::RunInGameThread<FString>([&]()
+        {
+            USteamAudioSerializedObject* StaticMeshAsset = Cast<USteamAudioSerializedObject>(StaticMeshActor->Asset.TryLoad());
+            return CalcProbeContentHash(StaticMeshAsset ? StaticMeshAsset->ContentHash : FString());
+        });
+        if (!NewProbeContentHash.IsEmpty() && NewProbeContentHash == ProbeContentHash && Asset.GetAssetPathString() == AssetName)
+        {
+            UE_LOG(LogSteamAudio, Log, TEXT("Probes in %s are up to date, skipping generation."), *GetName());
+            Promise.SetValue(true);
+            return;
+        }
+
         // Make sure Steam Audio is initialized.
 		SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
         bool bInitializeSucceeded = SteamAudio::RunInGameThread<bool>([&]()
@@ -142,20 +608,21 @@ bool ASteamAudioProbeVolume::GenerateProbes(ASteamAudioStaticMeshActor* StaticMe
 		}
 
         iplStaticMeshAdd(StaticMesh, Scene);
-        iplSceneCommit(Scene);
 
-        // Create a probe array and generate probes in it.
-        IPLProbeArray ProbeArray = nullptr;
-        IPLerror Status = iplProbeArrayCreate(Context, &ProbeArray);
-        if (Status != IPL_STATUS_SUCCESS)
+        // Shared geometry is placed using instanced meshes, which are kept alive by the scene.
+        TArray<IPLInstancedMesh> InstancedMeshes;
+        SteamAudio::RunInGameThread<bool>([&]()
         {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create probe array. [%d]"), Status);
-            iplStaticMeshRelease(&StaticMesh);
-            Manager.ShutDownSteamAudio();
-            Promise.SetValue(false);
-            return;
+            return SteamAudio::LoadInstancedMeshesFromAsset(StaticMeshActor->Asset, Context, Scene, InstancedMeshes);
+        });
+        for (IPLInstancedMesh& InstancedMesh : InstancedMeshes)
+        {
+            iplInstancedMeshAdd(InstancedMesh, Scene);
+            iplInstancedMeshRelease(&InstancedMesh);
         }
 
+        iplSceneCommit(Scene);
+
         FTransform Transform = GetTransform();
         Transform.MultiplyScale3D(FVector(2)); // todo: why?
 
@@ -165,22 +632,53 @@ bool ASteamAudioProbeVolume::GenerateProbes(ASteamAudioStaticMeshActor* StaticMe
         ProbeGenerationParams.height = HeightAboveFloor;
         ProbeGenerationParams.transform = SteamAudio::ConvertTransform(Transform);
 
-        iplProbeArrayGenerateProbes(ProbeArray, Scene, &ProbeGenerationParams);
+        // Generate probes, either directly or adapted to the geometry.
+        TArray<IPLSphere> Probes;
+        int32 NewNumUniformProbes = 0;
+        bool bGenerated = false;
+
+        if (bAdaptiveSpacing && GenerationType == EProbeGenerationType::UNIFORM_FLOOR)
+        {
+            FProbeVisibilityTester Visibility;
+            bGenerated = Visibility.Initialize(Context, Scene, Manager.GetBakingSettings(IPL_SIMULATIONFLAGS_DIRECT)) &&
+                GenerateAdaptiveProbes(Context, Scene, Visibility, ProbeGenerationParams, FMath::Min(MinHorizontalSpacing, HorizontalSpacing),
+                    FMath::Max(MaxHorizontalSpacing, HorizontalSpacing), Probes, NewNumUniformProbes);
+
+            if (bGenerated)
+            {
+                UE_LOG(LogSteamAudio, Log, TEXT("Generated %d adaptive probes in %s (%d with uniform spacing)."), Probes.Num(), *GetName(), NewNumUniformProbes);
+            }
+        }
+        else
+        {
+            bGenerated = GenerateProbeSpheres(Context, Scene, ProbeGenerationParams, Probes);
+            NewNumUniformProbes = Probes.Num();
+        }
+
+        if (!bGenerated)
+        {
+            iplStaticMeshRelease(&StaticMesh);
+            Manager.ShutDownSteamAudio();
+            Promise.SetValue(false);
+            return;
+        }
 
         // Create a probe batch and add the generated probes to it.
         IPLProbeBatch GeneratedProbeBatch = nullptr;
-        Status = iplProbeBatchCreate(Context, &GeneratedProbeBatch);
+        IPLerror Status = iplProbeBatchCreate(Context, &GeneratedProbeBatch);
         if (Status != IPL_STATUS_SUCCESS)
         {
             UE_LOG(LogSteamAudio, Error, TEXT("Unable to create probe batch. [%d]"), Status);
-            iplProbeArrayRelease(&ProbeArray);
             iplStaticMeshRelease(&StaticMesh);
             Manager.ShutDownSteamAudio();
             Promise.SetValue(false);
             return;
         }
 
-        iplProbeBatchAddProbeArray(GeneratedProbeBatch, ProbeArray);
+        for (const IPLSphere& Probe : Probes)
+        {
+            iplProbeBatchAddProbe(GeneratedProbeBatch, Probe);
+        }
 
         IPLSerializedObjectSettings SerializedObjectSettings{};
 
@@ -191,7 +689,6 @@ bool ASteamAudioProbeVolume::GenerateProbes(ASteamAudioStaticMeshActor* StaticMe
         {
             UE_LOG(LogSteamAudio, Error, TEXT("Unable to create serialized object. [%d]"), Status);
             iplProbeBatchRelease(&GeneratedProbeBatch);
-            iplProbeArrayRelease(&ProbeArray);
             iplStaticMeshRelease(&StaticMesh);
             Manager.ShutDownSteamAudio();
             Promise.SetValue(false);
@@ -202,14 +699,13 @@ bool ASteamAudioProbeVolume::GenerateProbes(ASteamAudioStaticMeshActor* StaticMe
 
         USteamAudioSerializedObject* AssetObject = SteamAudio::RunInGameThread<USteamAudioSerializedObject*>([&]()
         {
-            return USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, AssetName);
+            return USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, AssetName, {}, {}, FString(), GetCompressionFormat());
         });
         if (!AssetObject)
         {
             UE_LOG(LogSteamAudio, Error, TEXT("Unable to serialize probe batch."));
             iplSerializedObjectRelease(&SerializedObject);
             iplProbeBatchRelease(&GeneratedProbeBatch);
-            iplProbeArrayRelease(&ProbeArray);
             iplStaticMeshRelease(&StaticMesh);
             Manager.ShutDownSteamAudio();
             Promise.SetValue(false);
@@ -220,9 +716,11 @@ bool ASteamAudioProbeVolume::GenerateProbes(ASteamAudioStaticMeshActor* StaticMe
         {
             // Update stats.
             Asset = AssetObject;
-            NumProbes = iplProbeArrayGetNumProbes(ProbeArray);
-            UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject));
+            NumProbes = Probes.Num();
+            NumUniformProbes = NewNumUniformProbes;
+            UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject), AssetObject->GetStoredDataSize());
             ResetLayers();
+            ProbeContentHash = NewProbeContentHash;
 
             // Update probe positions for visualization.
             {
@@ -234,7 +732,7 @@ bool ASteamAudioProbeVolume::GenerateProbes(ASteamAudioStaticMeshActor* StaticMe
 
                 for (int i = 0; i < NumProbes; ++i)
                 {
-                    ProbePositions[i] = SteamAudio::ConvertVectorInverse(iplProbeArrayGetProbe(ProbeArray, i).center);
+                    ProbePositions[i] = SteamAudio::ConvertVectorInverse(Probes[i].center);
                 }
             }
 
@@ -243,7 +741,6 @@ bool ASteamAudioProbeVolume::GenerateProbes(ASteamAudioStaticMeshActor* StaticMe
 
         iplSerializedObjectRelease(&SerializedObject);
         iplProbeBatchRelease(&GeneratedProbeBatch);
-        iplProbeArrayRelease(&ProbeArray);
         iplStaticMeshRelease(&StaticMesh);
 		Manager.ShutDownSteamAudio();
 		Promise.SetValue(true);
@@ -255,9 +752,33 @@ bool ASteamAudioProbeVolume::GenerateProbes(ASteamAudioStaticMeshActor* StaticMe
 	return Value.Get();
 }
 
-void ASteamAudioProbeVolume::UpdateTotalSize(int Size)
+void ASteamAudioProbeVolume::UpdateTotalSize(int Size, int CompressedSize)
 {
 	DataSize = Size;
+	CompressedDataSize = CompressedSize;
+}
+
+FName ASteamAudioProbeVolume::GetCompressionFormat() const
+{
+	switch (BakedDataCompression)
+	{
+	case EBakedDataCompression::FAST:
+		return NAME_LZ4;
+	case EBakedDataCompression::SMALL:
+		return NAME_Oodle;
+	default:
+		return NAME_None;
+	}
+}
+
+int ASteamAudioProbeVolume::GetCompressedLayerSize(int Index) const
+{
+	if (!DetailedStats.IsValidIndex(Index))
+		return 0;
+	if (DataSize <= 0 || CompressedDataSize <= 0)
+		return DetailedStats[Index].Size;
+
+	return static_cast<int>(static_cast<int64>(DetailedStats[Index].Size) * CompressedDataSize / DataSize);
 }
 
 void ASteamAudioProbeVolume::ResetLayers()
@@ -274,20 +795,20 @@ void ASteamAudioProbeVolume::RemoveLayer(const FString& Name)
 	}
 }
 
-void ASteamAudioProbeVolume::AddOrUpdateLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size)
+void ASteamAudioProbeVolume::AddOrUpdateLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size, const FString& ContentHash /* = FString() */, float BakeSeconds /* = 0.0f */)
 {
 	int Index = FindLayer(Name);
 	if (Index == INDEX_NONE)
 	{
-		AddLayer(Name, Identifier, Size);
+		AddLayer(Name, Identifier, Size, ContentHash, BakeSeconds);
 	}
 	else
 	{
-		UpdateLayer(Name, Size);
+		UpdateLayer(Name, Size, ContentHash, BakeSeconds);
 	}
 }
 
-void ASteamAudioProbeVolume::AddLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size)
+void ASteamAudioProbeVolume::AddLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size, const FString& ContentHash /* = FString() */, float BakeSeconds /* = 0.0f */)
 {
 	FSteamAudioBakedDataInfo Info;
 	Info.Name = Name;
@@ -296,17 +817,67 @@ void ASteamAudioProbeVolume::AddLayer(const FString& Name, IPLBakedDataIdentifie
 	Info.EndpointCenter = SteamAudio::ConvertVectorInverse(Identifier.endpointInfluence.center);
 	Info.EndpointRadius = Identifier.endpointInfluence.radius;
 	Info.Size = Size;
+	Info.ContentHash = ContentHash;
+	Info.BakeSeconds = BakeSeconds;
 
 	DetailedStats.Add(Info);
 }
 
-void ASteamAudioProbeVolume::UpdateLayer(const FString& Name, int Size)
+void ASteamAudioProbeVolume::UpdateLayer(const FString& Name, int Size, const FString& ContentHash /* = FString() */, float BakeSeconds /* = 0.0f */)
 {
 	int Index = FindLayer(Name);
 	if (Index != INDEX_NONE)
 	{
 		DetailedStats[Index].Size = Size;
+		DetailedStats[Index].ContentHash = ContentHash;
+		DetailedStats[Index].BakeSeconds = BakeSeconds;
+	}
+}
+
+FString ASteamAudioProbeVolume::GetLayerContentHash(const FString& Name)
+{
+	int Index = FindLayer(Name);
+	return (Index != INDEX_NONE) ? DetailedStats[Index].ContentHash : FString();
+}
+
+FString ASteamAudioProbeVolume::CalcProbeContentHash(const FString& StaticGeometryContentHash) const
+{
+	if (StaticGeometryContentHash.IsEmpty())
+		return FString();
+
+	SteamAudio::FContentHash Hash;
+	Hash.Update(StaticGeometryContentHash);
+	Hash.Update(GetTransform());
+	Hash.Update(GenerationType);
+	Hash.Update(HorizontalSpacing);
+	Hash.Update(HeightAboveFloor);
+	Hash.Update(bAdaptiveSpacing);
+	if (bAdaptiveSpacing)
+	{
+		Hash.Update(MinHorizontalSpacing);
+		Hash.Update(MaxHorizontalSpacing);
 	}
+
+	return Hash.Finalize();
+}
+
+float ASteamAudioProbeVolume::GetTotalBakeSeconds() const
+{
+	float TotalBakeSeconds = 0.0f;
+	for (const FSteamAudioBakedDataInfo& Info : DetailedStats)
+	{
+		TotalBakeSeconds += Info.BakeSeconds;
+	}
+
+	return TotalBakeSeconds;
+}
+
+float ASteamAudioProbeVolume::GetEstimatedBakeSecondsSaved() const
+{
+	if (NumProbes <= 0 || NumUniformProbes <= NumProbes)
+		return 0.0f;
+
+	return GetTotalBakeSeconds() * static_cast<float>(NumUniformProbes - NumProbes) / static_cast<float>(NumProbes);
 }
 
 int ASteamAudioProbeVolume::FindLayer(const FString& Name)
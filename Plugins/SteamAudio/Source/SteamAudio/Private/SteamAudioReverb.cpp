@@ -17,80 +17,154 @@
 #include "SteamAudioReverb.h"
 #include "AudioDevice.h"
 #include "AudioDeviceManager.h"
-#include "Components/AudioComponent.h"
-#include "GameFramework/Actor.h"
 #include "HAL/UnrealMemory.h"
 #include "Sound/SoundSubmix.h"
 #include "SteamAudioCommon.h"
 #include "SteamAudioManager.h"
+#include "SteamAudioMixKernels.h"
 #include "SteamAudioReverbSettings.h"
 #include "SteamAudioSettings.h"
-#include "SteamAudioSourceComponent.h"
 #include "SteamAudioUnrealAudioEngineInterface.h"
 
 #include "Misc/AssertionMacros.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Reflection Effect Pool Capacity"), STAT_SteamAudioReflectionEffectPoolCapacity, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled Reflection Effects"), STAT_SteamAudioPooledReflectionEffects, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Live Reflection Effects"), STAT_SteamAudioLiveReflectionEffects, STATGROUP_SteamAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Fallback Reflection Sources"), STAT_SteamAudioFallbackReflectionSources, STATGROUP_SteamAudio);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Reflection Effect Steals"), STAT_SteamAudioReflectionEffectSteals, STATGROUP_SteamAudio);
+DECLARE_MEMORY_STAT(TEXT("Pooled Reflection Effect Memory (Estimated)"), STAT_SteamAudioPooledReflectionEffectMemory, STATGROUP_SteamAudio);
+
 namespace SteamAudio {
 
+/** Per-buffer decay applied to a source's audibility, so it follows the signal level with a release of about a
+    second at typical buffer sizes. */
+static constexpr float AudibilityRelease = 0.98f;
+
+/** A source only takes over another source's reflection effect if it is at least this much more audible. This keeps
+    sources with similar levels from trading effects back and forth. */
+static constexpr float StealAudibilityRatio = 2.0f;
+
 // ---------------------------------------------------------------------------------------------------------------------
-// FSteamAudioReverbSource
+// FSteamAudioReverbEffects
 // ---------------------------------------------------------------------------------------------------------------------
 
-FSteamAudioReverbSource::FSteamAudioReverbSource()
-	: bApplyReflections(false)
-	, bApplyHRTFToReflections(false)
-	, ReflectionsMixLevel(1.0f)
-    , HRTF(nullptr)
-	, ReflectionEffect(nullptr)
-	, AmbisonicsDecodeEffect(nullptr)
-	, InBuffer()
+FSteamAudioReverbEffects::FSteamAudioReverbEffects()
+	: FallbackReflectionEffect(nullptr)
+	, AmbisonicsDecodeEffects()
 	, MonoBuffer()
 	, IndirectBuffer()
-	, OutBuffer()
-    , PrevReflectionEffectType(IPL_REFLECTIONEFFECTTYPE_CONVOLUTION)
-    , PrevDuration(0.0f)
-    , PrevOrder(-1)
+	, OutBuffers()
 {}
 
-FSteamAudioReverbSource::~FSteamAudioReverbSource()
+FSteamAudioReverbEffects::~FSteamAudioReverbEffects()
 {
 	IPLContext Context = FSteamAudioModule::GetManager().GetContext();
 
-	iplAudioBufferFree(Context, &InBuffer);
 	iplAudioBufferFree(Context, &MonoBuffer);
 	iplAudioBufferFree(Context, &IndirectBuffer);
-	iplAudioBufferFree(Context, &OutBuffer);
 
-	iplReflectionEffectRelease(&ReflectionEffect);
-	iplAmbisonicsDecodeEffectRelease(&AmbisonicsDecodeEffect);
-    iplHRTFRelease(&HRTF);
+    for (int i = 0; i < NumSupportedLayouts; ++i)
+    {
+        iplAudioBufferFree(Context, &OutBuffers[i]);
+        iplAmbisonicsDecodeEffectRelease(&AmbisonicsDecodeEffects[i]);
+    }
+
+	iplReflectionEffectRelease(&FallbackReflectionEffect);
 }
 
-void FSteamAudioReverbSource::Reset()
+void FSteamAudioReverbEffects::Reset()
 {
-	if (ReflectionEffect)
+	if (FallbackReflectionEffect)
 	{
-		iplReflectionEffectReset(ReflectionEffect);
+		iplReflectionEffectReset(FallbackReflectionEffect);
 	}
 
-	if (AmbisonicsDecodeEffect)
-	{
-		iplAmbisonicsDecodeEffectReset(AmbisonicsDecodeEffect);
-	}
+    for (int i = 0; i < NumSupportedLayouts; ++i)
+    {
+        if (AmbisonicsDecodeEffects[i])
+        {
+            iplAmbisonicsDecodeEffectReset(AmbisonicsDecodeEffects[i]);
+        }
+    }
 
 	ClearBuffers();
 }
 
-void FSteamAudioReverbSource::ClearBuffers()
+void FSteamAudioReverbEffects::ClearBuffers()
 {
-	if (InBuffer.data)
-	{
-		for (int i = 0; i < InBuffer.numChannels; ++i)
-		{
-			FMemory::Memzero(InBuffer.data[i], InBuffer.numSamples * sizeof(float));
-		}
-	}
+    if (MonoBuffer.data)
+    {
+        for (int i = 0; i < MonoBuffer.numChannels; ++i)
+        {
+            FMemory::Memzero(MonoBuffer.data[i], MonoBuffer.numSamples * sizeof(float));
+        }
+    }
+
+    if (IndirectBuffer.data)
+    {
+        for (int i = 0; i < IndirectBuffer.numChannels; ++i)
+        {
+            FMemory::Memzero(IndirectBuffer.data[i], IndirectBuffer.numSamples * sizeof(float));
+        }
+    }
 
+    for (IPLAudioBuffer& OutBuffer : OutBuffers)
+    {
+        if (OutBuffer.data)
+        {
+            for (int i = 0; i < OutBuffer.numChannels; ++i)
+            {
+                FMemory::Memzero(OutBuffer.data[i], OutBuffer.numSamples * sizeof(float));
+            }
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioReverbSubmixEffects
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioReverbSubmixEffects::FSteamAudioReverbSubmixEffects()
+	: ReflectionEffect(nullptr)
+	, AmbisonicsDecodeEffect(nullptr)
+	, MonoBuffer()
+	, ReverbBuffer()
+	, IndirectBuffer()
+	, OutBuffer()
+{}
+
+FSteamAudioReverbSubmixEffects::~FSteamAudioReverbSubmixEffects()
+{
+	IPLContext Context = FSteamAudioModule::GetManager().GetContext();
+
+    iplAudioBufferFree(Context, &MonoBuffer);
+    iplAudioBufferFree(Context, &ReverbBuffer);
+    iplAudioBufferFree(Context, &IndirectBuffer);
+    iplAudioBufferFree(Context, &OutBuffer);
+
+    iplAmbisonicsDecodeEffectRelease(&AmbisonicsDecodeEffect);
+    iplReflectionEffectRelease(&ReflectionEffect);
+}
+
+void FSteamAudioReverbSubmixEffects::Reset()
+{
+    if (ReflectionEffect)
+    {
+        iplReflectionEffectReset(ReflectionEffect);
+    }
+
+    if (AmbisonicsDecodeEffect)
+    {
+        iplAmbisonicsDecodeEffectReset(AmbisonicsDecodeEffect);
+    }
+
+    ClearBuffers();
+}
+
+void FSteamAudioReverbSubmixEffects::ClearBuffers()
+{
     if (MonoBuffer.data)
     {
         for (int i = 0; i < MonoBuffer.numChannels; ++i)
@@ -99,6 +173,14 @@ void FSteamAudioReverbSource::ClearBuffers()
         }
     }
 
+    if (ReverbBuffer.data)
+    {
+        for (int i = 0; i < ReverbBuffer.numChannels; ++i)
+        {
+            FMemory::Memzero(ReverbBuffer.data[i], ReverbBuffer.numSamples * sizeof(float));
+        }
+    }
+
     if (IndirectBuffer.data)
     {
         for (int i = 0; i < IndirectBuffer.numChannels; ++i)
@@ -118,73 +200,367 @@ void FSteamAudioReverbSource::ClearBuffers()
 
 
 // ---------------------------------------------------------------------------------------------------------------------
-// FSteamAudioReverbPlugin
+// FSteamAudioReflectionEffectPool
 // ---------------------------------------------------------------------------------------------------------------------
 
-FSteamAudioReverbPlugin::FSteamAudioReverbPlugin()
-	: ReverbSubmix(nullptr)
-	, ReverbSubmixEffect(nullptr)
-	, ReflectionMixer(nullptr)
-    , PrevReflectionEffectType(IPL_REFLECTIONEFFECTTYPE_CONVOLUTION)
-    , PrevDuration(0.0f)
-    , PrevOrder(-1)
+FSteamAudioReflectionEffectPool::FSteamAudioReflectionEffectPool()
+    : AudioSettings()
+    , EffectSettings()
 {}
 
-FSteamAudioReverbPlugin::~FSteamAudioReverbPlugin()
+FSteamAudioReflectionEffectPool::~FSteamAudioReflectionEffectPool()
 {
-    ShutDownMixer();
+    // Don't update the stats, since by now they describe the pool that replaced this one.
+    for (FSlot& Slot : Slots)
+    {
+        iplReflectionEffectRelease(&Slot.Effect);
+    }
 }
 
-void FSteamAudioReverbPlugin::Initialize(const FAudioPluginInitializationParams InitializationParams)
+void FSteamAudioReflectionEffectPool::Configure(const IPLAudioSettings& InAudioSettings, const IPLReflectionEffectSettings& InEffectSettings,
+    int32 MaxSources, int32 MemoryBudgetMB)
 {
-	AudioSettings.samplingRate = InitializationParams.SampleRate;
-	AudioSettings.frameSize = InitializationParams.BufferLength;
+    FScopeLock Lock(&CriticalSection);
 
-	Sources.AddDefaulted(InitializationParams.NumSources);
+    bool bSettingsChanged = AudioSettings.samplingRate != InAudioSettings.samplingRate ||
+        AudioSettings.frameSize != InAudioSettings.frameSize ||
+        EffectSettings.type != InEffectSettings.type ||
+        EffectSettings.irSize != InEffectSettings.irSize ||
+        EffectSettings.numChannels != InEffectSettings.numChannels;
+
+    if (bSettingsChanged)
+    {
+        for (FSlot& Slot : Slots)
+        {
+            iplReflectionEffectRelease(&Slot.Effect);
+        }
+
+        Slots.Reset();
+        SourceSlots.Reset();
+
+        AudioSettings = InAudioSettings;
+        EffectSettings = InEffectSettings;
+    }
+
+    int32 Capacity = MaxSources;
+    if (MemoryBudgetMB > 0)
+    {
+        uint64 EffectSize = FMath::Max<uint64>(EstimateEffectSize(AudioSettings, EffectSettings), 1);
+        uint64 Budget = static_cast<uint64>(MemoryBudgetMB) * 1024 * 1024;
+        Capacity = static_cast<int32>(FMath::Clamp<uint64>(Budget / EffectSize, 1, FMath::Max(MaxSources, 1)));
+    }
+
+    // If the budget went down, destroy the effects that no longer fit. Nobody is rendering, so this is safe even if
+    // they are in use.
+    for (int32 SlotIndex = Capacity; SlotIndex < Slots.Num(); ++SlotIndex)
+    {
+        FSlot& Slot = Slots[SlotIndex];
+        if (SourceSlots.IsValidIndex(Slot.Owner))
+        {
+            SourceSlots[Slot.Owner] = INDEX_NONE;
+        }
+
+        iplReflectionEffectRelease(&Slot.Effect);
+    }
+
+    Slots.SetNum(Capacity);
+
+    // Create all the effects now, so sources never have to wait for one to be created while rendering.
+    IPLContext Context = FSteamAudioModule::GetManager().GetContext();
+    for (FSlot& Slot : Slots)
+    {
+        if (Slot.Effect)
+            continue;
+
+        IPLerror Status = iplReflectionEffectCreate(Context, &AudioSettings, &EffectSettings, &Slot.Effect);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create reflection effect. [%d]"), Status);
+            break;
+        }
+    }
+
+    int32 PrevNumSources = SourceSlots.Num();
+    SourceSlots.SetNum(MaxSources);
+    for (int32 SourceId = PrevNumSources; SourceId < MaxSources; ++SourceId)
+    {
+        SourceSlots[SourceId] = INDEX_NONE;
+    }
+
+    UpdateStats();
 }
 
-void FSteamAudioReverbPlugin::LazyInitMixer()
+IPLReflectionEffect FSteamAudioReflectionEffectPool::Acquire(int32 SourceId, float Audibility)
 {
-    IPLContext Context = FSteamAudioModule::GetManager().GetContext();
-    IPLSimulationSettings SimulationSettings = FSteamAudioModule::GetManager().GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
+    FScopeLock Lock(&CriticalSection);
 
-    if (!ReflectionMixer || PrevReflectionEffectType != SimulationSettings.reflectionType ||
-        PrevDuration != SimulationSettings.maxDuration || PrevOrder != SimulationSettings.maxOrder)
+    if (!SourceSlots.IsValidIndex(SourceId))
+        return nullptr;
+
+    int32 SlotIndex = SourceSlots[SourceId];
+    if (SlotIndex != INDEX_NONE)
     {
-        if (ReflectionMixer)
+        // If a louder source has asked for our effect, hand it over now that we know we aren't rendering with it.
+        if (Slots[SlotIndex].PendingOwner != INDEX_NONE)
         {
-            iplReflectionMixerRelease(&ReflectionMixer);
+            UnassignSlot(SlotIndex);
+            return nullptr;
         }
 
-        IPLReflectionEffectSettings ReflectionSettings{};
-        ReflectionSettings.type = SimulationSettings.reflectionType;
-        ReflectionSettings.irSize = CalcIRSizeForDuration(SimulationSettings.maxDuration, AudioSettings.samplingRate);
-        ReflectionSettings.numChannels = CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder);
+        Slots[SlotIndex].OwnerAudibility = Audibility;
+        return Slots[SlotIndex].Effect;
+    }
 
-        IPLerror Status = iplReflectionMixerCreate(Context, &AudioSettings, &ReflectionSettings, &ReflectionMixer);
-        if (Status != IPL_STATUS_SUCCESS)
+    int32 FreeSlot = INDEX_NONE;
+    int32 PendingSlot = INDEX_NONE;
+    int32 QuietestSlot = INDEX_NONE;
+    for (int32 i = 0; i < Slots.Num(); ++i)
+    {
+        const FSlot& Slot = Slots[i];
+        if (Slot.Owner == INDEX_NONE)
+        {
+            if (FreeSlot == INDEX_NONE)
+            {
+                FreeSlot = i;
+            }
+        }
+        else if (Slot.PendingOwner == SourceId)
+        {
+            PendingSlot = i;
+        }
+        else if (Slot.PendingOwner == INDEX_NONE)
+        {
+            if (QuietestSlot == INDEX_NONE || Slot.OwnerAudibility < Slots[QuietestSlot].OwnerAudibility)
+            {
+                QuietestSlot = i;
+            }
+        }
+    }
+
+    if (FreeSlot != INDEX_NONE)
+    {
+        if (PendingSlot != INDEX_NONE)
+        {
+            Slots[PendingSlot].PendingOwner = INDEX_NONE;
+        }
+
+        if (!AssignSlot(FreeSlot, SourceId))
+            return nullptr;
+
+        Slots[FreeSlot].OwnerAudibility = Audibility;
+        return Slots[FreeSlot].Effect;
+    }
+
+    // Still waiting for another source to hand over its effect.
+    if (PendingSlot != INDEX_NONE)
+        return nullptr;
+
+    if (QuietestSlot != INDEX_NONE && Audibility > Slots[QuietestSlot].OwnerAudibility * StealAudibilityRatio)
+    {
+        Slots[QuietestSlot].PendingOwner = SourceId;
+        INC_DWORD_STAT(STAT_SteamAudioReflectionEffectSteals);
+    }
+
+    return nullptr;
+}
+
+void FSteamAudioReflectionEffectPool::Release(int32 SourceId)
+{
+    FScopeLock Lock(&CriticalSection);
+
+    if (!SourceSlots.IsValidIndex(SourceId))
+        return;
+
+    for (FSlot& Slot : Slots)
+    {
+        if (Slot.PendingOwner == SourceId)
         {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create reflection mixer. [%d]"), Status);
+            Slot.PendingOwner = INDEX_NONE;
         }
     }
 
-    PrevReflectionEffectType = SimulationSettings.reflectionType;
-    PrevDuration = SimulationSettings.maxDuration;
-    PrevOrder = SimulationSettings.maxOrder;
+    if (SourceSlots[SourceId] != INDEX_NONE)
+    {
+        UnassignSlot(SourceSlots[SourceId]);
+    }
+}
+
+void FSteamAudioReflectionEffectPool::Reset()
+{
+    FScopeLock Lock(&CriticalSection);
+
+    for (FSlot& Slot : Slots)
+    {
+        iplReflectionEffectRelease(&Slot.Effect);
+    }
+
+    Slots.Reset();
+    SourceSlots.Reset();
+
+    UpdateStats();
+}
+
+uint64 FSteamAudioReflectionEffectPool::EstimateEffectSize(const IPLAudioSettings& InAudioSettings, const IPLReflectionEffectSettings& InEffectSettings)
+{
+    uint64 NumChannels = FMath::Max(InEffectSettings.numChannels, 0);
+
+    switch (InEffectSettings.type)
+    {
+    case IPL_REFLECTIONEFFECTTYPE_CONVOLUTION:
+    case IPL_REFLECTIONEFFECTTYPE_HYBRID:
+        // Partitioned convolution stores the spectrum of the IR and a history of input spectra of the same length
+        // for every Ambisonic channel, both as complex numbers.
+        return static_cast<uint64>(FMath::Max(InEffectSettings.irSize, 0)) * NumChannels * sizeof(float) * 4;
+
+    default:
+        // Parametric reverb only keeps a few frames of state per channel, and TAN keeps its IRs on the GPU.
+        return static_cast<uint64>(FMath::Max(InAudioSettings.frameSize, 0)) * NumChannels * sizeof(float) * 4;
+    }
+}
+
+bool FSteamAudioReflectionEffectPool::AssignSlot(int32 SlotIndex, int32 SourceId)
+{
+    FSlot& Slot = Slots[SlotIndex];
+
+    // The effect couldn't be created when the pool was configured.
+    if (!Slot.Effect)
+        return false;
+
+    Slot.Owner = SourceId;
+    Slot.PendingOwner = INDEX_NONE;
+    Slot.OwnerAudibility = 0.0f;
+    SourceSlots[SourceId] = SlotIndex;
+
+    UpdateStats();
+    return true;
 }
 
-void FSteamAudioReverbPlugin::ShutDownMixer()
+void FSteamAudioReflectionEffectPool::UnassignSlot(int32 SlotIndex)
 {
+    FSlot& Slot = Slots[SlotIndex];
+
+    SourceSlots[Slot.Owner] = INDEX_NONE;
+
+    // Don't let the next owner hear the tail of the previous owner's reflections.
+    iplReflectionEffectReset(Slot.Effect);
+
+    int32 NewOwner = Slot.PendingOwner;
+    Slot.Owner = NewOwner;
+    Slot.PendingOwner = INDEX_NONE;
+    Slot.OwnerAudibility = 0.0f;
+
+    if (NewOwner != INDEX_NONE)
+    {
+        SourceSlots[NewOwner] = SlotIndex;
+    }
+
+    UpdateStats();
+}
+
+void FSteamAudioReflectionEffectPool::UpdateStats() const
+{
+    int32 NumPooled = 0;
+    int32 NumLive = 0;
+    for (const FSlot& Slot : Slots)
+    {
+        NumPooled += (Slot.Effect) ? 1 : 0;
+        NumLive += (Slot.Owner != INDEX_NONE) ? 1 : 0;
+    }
+
+    SET_DWORD_STAT(STAT_SteamAudioReflectionEffectPoolCapacity, Slots.Num());
+    SET_DWORD_STAT(STAT_SteamAudioPooledReflectionEffects, NumPooled);
+    SET_DWORD_STAT(STAT_SteamAudioLiveReflectionEffects, NumLive);
+    SET_MEMORY_STAT(STAT_SteamAudioPooledReflectionEffectMemory, NumPooled * EstimateEffectSize(AudioSettings, EffectSettings));
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioReverbSlab
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioReverbSlab::~FSteamAudioReverbSlab()
+{
+    // Release the effects before the HRTF they were created with.
+    Effects.Empty();
     iplReflectionMixerRelease(&ReflectionMixer);
+    iplHRTFRelease(&HRTF);
 }
 
-void FSteamAudioReverbPlugin::OnInitSource(const uint32 SourceId, const FName& AudioComponentUserId, const uint32 NumChannels, UReverbPluginSourceSettingsBase* InSettings)
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioReverbSource
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioReverbSource::FSteamAudioReverbSource()
+	: bApplyReflections(false)
+	, bApplyHRTFToReflections(false)
+	, ReflectionsMixLevel(1.0f)
+    , LayoutIndex(INDEX_NONE)
+    , Audibility(0.0f)
+    , bUsingFallback(false)
+    , Slab(nullptr)
+    , Effects(nullptr)
+{}
+
+void FSteamAudioReverbSource::Reset()
 {
-    // Make sure we're initialized, so real-time audio can work.
-    SteamAudio::RunInGameThread<void>([&]()
+    if (bUsingFallback)
     {
-        FSteamAudioModule::GetManager().InitializeSteamAudio(EManagerInitReason::PLAYING);
-    });
+        DEC_DWORD_STAT(STAT_SteamAudioFallbackReflectionSources);
+        bUsingFallback = false;
+    }
+
+    Audibility = 0.0f;
+
+    if (Effects)
+    {
+        Effects->Reset();
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioReverbPlugin
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioReverbPlugin::FSteamAudioReverbPlugin()
+	: ReverbSubmix(nullptr)
+	, ReverbSubmixEffect(nullptr)
+    , SettingsGeneration(0)
+{}
+
+FSteamAudioReverbPlugin::~FSteamAudioReverbPlugin()
+{
+    FSteamAudioModule::GetManager().OnSettingsSnapshotRebuilt.Remove(SettingsSnapshotRebuiltHandle);
+
+    // The submix plugin may outlive us, so make it unpin its slab before the slabs are freed.
+    if (ReverbSubmixEffect.IsValid())
+    {
+        StaticCastSharedPtr<FSteamAudioReverbSubmixPlugin, FSoundEffectSubmix>(ReverbSubmixEffect)->SetReverbPlugin(nullptr);
+    }
+
+    Slabs.Reset();
+}
+
+void FSteamAudioReverbPlugin::Initialize(const FAudioPluginInitializationParams InitializationParams)
+{
+	AudioSettings.samplingRate = InitializationParams.SampleRate;
+	AudioSettings.frameSize = InitializationParams.BufferLength;
+
+	Sources.AddDefaulted(InitializationParams.NumSources);
+	FSteamAudioModule::GetManager().ReserveVoiceOutputs(InitializationParams.NumSources);
+
+    // Build the slab once Steam Audio is initialized, and again whenever the settings change. If it already is
+    // initialized, build it now.
+    SettingsSnapshotRebuiltHandle = FSteamAudioModule::GetManager().OnSettingsSnapshotRebuilt.AddRaw(this, &FSteamAudioReverbPlugin::OnSettingsSnapshotRebuilt);
+    OnSettingsSnapshotRebuilt(FSteamAudioModule::GetManager().GetSettingsSnapshot());
+}
+
+void FSteamAudioReverbPlugin::OnInitSource(const uint32 SourceId, const FName& AudioComponentUserId, const uint32 NumChannels, UReverbPluginSourceSettingsBase* InSettings)
+{
+    // Make sure initialization has started, so real-time audio can work. This only queues a request for the game
+    // thread, so the audio render thread never waits on it.
+    FSteamAudioModule::GetManager().RequestInitialization();
 
 	FSteamAudioReverbSource& Source = Sources[SourceId];
 
@@ -194,119 +570,205 @@ void FSteamAudioReverbPlugin::OnInitSource(const uint32 SourceId, const FName& A
 	Source.bApplyHRTFToReflections = (Settings) ? Settings->bApplyHRTFToReflections : false;
 	Source.ReflectionsMixLevel = (Settings) ? Settings->ReflectionsMixLevel : 1.0f;
 
+    // The slab has output buffers for every supported number of channels. Voices with any other number of channels
+    // don't get reflections, rather than allocating here.
+    Source.LayoutIndex = GetSupportedLayoutIndex(NumChannels);
+
+    // If Steam Audio is still initializing, there is no slab yet, so the voice picks one up once it's published.
+    if (!PinSlab(SourceId) || Source.LayoutIndex == INDEX_NONE)
+    {
+        INC_DWORD_STAT(STAT_SteamAudioVoiceSlabMisses);
+    }
+}
+
+void FSteamAudioReverbPlugin::OnSettingsSnapshotRebuilt(const FSteamAudioSettingsSnapshotPtr& Snapshot)
+{
+    // Keep the current slab if Steam Audio has been shut down, since its effects don't depend on anything that was
+    // destroyed, and it can be reused if the settings are the same next time.
+    if (!Snapshot)
+        return;
+
+    IPLHRTF HRTF = FSteamAudioModule::GetManager().InitHRTF(AudioSettings) ? FSteamAudioModule::GetManager().GetHRTF() : nullptr;
+    const IPLSimulationSettings& SimulationSettings = Snapshot->RealTimeSettings;
+    int32 MemoryBudgetMB = Snapshot->Settings.ReflectionEffectMemoryBudget;
+
+    const FSteamAudioReverbSlab* Current = Slabs.GetPublished();
+    if (Current && Current->HRTF == HRTF && Current->MemoryBudgetMB == MemoryBudgetMB &&
+        Current->SimulationSettings.reflectionType == SimulationSettings.reflectionType &&
+        Current->SimulationSettings.maxDuration == SimulationSettings.maxDuration &&
+        Current->SimulationSettings.maxOrder == SimulationSettings.maxOrder)
+    {
+        iplHRTFRelease(&HRTF);
+        Slabs.CollectGarbage();
+        return;
+    }
+
     IPLContext Context = FSteamAudioModule::GetManager().GetContext();
 
-    if (!Source.HRTF)
+    TUniquePtr<FSteamAudioReverbSlab> Slab = MakeUnique<FSteamAudioReverbSlab>();
+    Slab->SimulationSettings = SimulationSettings;
+    Slab->HRTF = HRTF;
+    Slab->MemoryBudgetMB = MemoryBudgetMB;
+    Slab->Effects.SetNum(Sources.Num());
+
+    for (FSteamAudioReverbEffects& Effects : Slab->Effects)
+    {
+        PrepareEffects(Effects, HRTF, SimulationSettings);
+    }
+
+    IPLReflectionEffectSettings ReflectionSettings{};
+    ReflectionSettings.type = SimulationSettings.reflectionType;
+    ReflectionSettings.irSize = CalcIRSizeForDuration(SimulationSettings.maxDuration, AudioSettings.samplingRate);
+    ReflectionSettings.numChannels = CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder);
+
+    Slab->ReflectionEffectPool.Configure(AudioSettings, ReflectionSettings, Sources.Num(), MemoryBudgetMB);
+
+    IPLerror Status = iplReflectionMixerCreate(Context, &AudioSettings, &ReflectionSettings, &Slab->ReflectionMixer);
+    if (Status != IPL_STATUS_SUCCESS)
     {
-        if (FSteamAudioModule::GetManager().InitHRTF(AudioSettings))
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create reflection mixer. [%d]"), Status);
+    }
+
+    PrepareSubmixEffects(Slab->SubmixEffects, HRTF, SimulationSettings);
+
+    Slabs.Publish(MoveTemp(Slab));
+}
+
+bool FSteamAudioReverbPlugin::PinSlab(uint32 SourceId)
+{
+	FSteamAudioReverbSource& Source = Sources[SourceId];
+    if (Source.Slab)
+        return true;
+
+    Source.Slab = Slabs.Pin();
+    if (!Source.Slab)
+        return false;
+
+    Source.Effects = &Source.Slab->Effects[SourceId];
+    Source.Reset();
+    return true;
+}
+
+void FSteamAudioReverbPlugin::PrepareEffects(FSteamAudioReverbEffects& Effects, IPLHRTF HRTF, const IPLSimulationSettings& SimulationSettings)
+{
+    IPLContext Context = FSteamAudioModule::GetManager().GetContext();
+
+    IPLReflectionEffectSettings FallbackSettings{};
+    FallbackSettings.type = IPL_REFLECTIONEFFECTTYPE_PARAMETRIC;
+    FallbackSettings.irSize = CalcIRSizeForDuration(SimulationSettings.maxDuration, AudioSettings.samplingRate);
+    FallbackSettings.numChannels = CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder);
+
+    IPLerror Status = iplReflectionEffectCreate(Context, &AudioSettings, &FallbackSettings, &Effects.FallbackReflectionEffect);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create fallback reflection effect. [%d]"), Status);
+    }
+
+    Status = iplAudioBufferAllocate(Context, 1, AudioSettings.frameSize, &Effects.MonoBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create downmix buffer for reverb effect. [%d]"), Status);
+    }
+
+    Status = iplAudioBufferAllocate(Context, CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder), AudioSettings.frameSize, &Effects.IndirectBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create indirect buffer for reverb effect. [%d]"), Status);
+    }
+
+    // The decode effect's speaker layout depends on the number of channels, so there's one for each supported
+    // number of channels, along with its output buffer.
+    for (int i = 0; i < NumSupportedLayouts; ++i)
+    {
+        if (HRTF)
+        {
+            IPLAmbisonicsDecodeEffectSettings AmbisonicsDecodeSettings{};
+            AmbisonicsDecodeSettings.speakerLayout = GetSpeakerLayoutForNumChannels(SupportedNumChannels[i]);
+            AmbisonicsDecodeSettings.hrtf = HRTF;
+            AmbisonicsDecodeSettings.maxOrder = SimulationSettings.maxOrder;
+
+            Status = iplAmbisonicsDecodeEffectCreate(Context, &AudioSettings, &AmbisonicsDecodeSettings, &Effects.AmbisonicsDecodeEffects[i]);
+            if (Status != IPL_STATUS_SUCCESS)
+            {
+                UE_LOG(LogSteamAudio, Error, TEXT("Unable to create Ambisonics decode effect. [%d]"), Status);
+            }
+        }
+
+        Status = iplAudioBufferAllocate(Context, SupportedNumChannels[i], AudioSettings.frameSize, &Effects.OutBuffers[i]);
+        if (Status != IPL_STATUS_SUCCESS)
         {
-            Source.HRTF = iplHRTFRetain(FSteamAudioModule::GetManager().GetHRTF());
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create output buffer for reverb effect. [%d]"), Status);
         }
     }
+}
 
-    IPLSimulationSettings SimulationSettings = FSteamAudioModule::GetManager().GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
-
-    if (!Source.ReflectionEffect || Source.PrevReflectionEffectType != SimulationSettings.reflectionType ||
-        Source.PrevDuration != SimulationSettings.maxDuration || Source.PrevOrder != SimulationSettings.maxOrder)
-    {
-        if (Source.ReflectionEffect)
-        {
-            iplReflectionEffectRelease(&Source.ReflectionEffect);
-        }
+void FSteamAudioReverbPlugin::PrepareSubmixEffects(FSteamAudioReverbSubmixEffects& Effects, IPLHRTF HRTF, const IPLSimulationSettings& SimulationSettings)
+{
+    IPLContext Context = FSteamAudioModule::GetManager().GetContext();
 
-        IPLReflectionEffectSettings ReflectionSettings{};
-        ReflectionSettings.type = SimulationSettings.reflectionType;
-        ReflectionSettings.irSize = CalcIRSizeForDuration(SimulationSettings.maxDuration, AudioSettings.samplingRate);
-        ReflectionSettings.numChannels = CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder);
+    IPLReflectionEffectSettings ReflectionSettings{};
+    ReflectionSettings.type = SimulationSettings.reflectionType;
+    ReflectionSettings.irSize = CalcIRSizeForDuration(SimulationSettings.maxDuration, AudioSettings.samplingRate);
+    ReflectionSettings.numChannels = CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder);
 
-        IPLerror Status = iplReflectionEffectCreate(Context, &AudioSettings, &ReflectionSettings, &Source.ReflectionEffect);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create reflection effect. [%d]"), Status);
-        }
+    IPLerror Status = iplReflectionEffectCreate(Context, &AudioSettings, &ReflectionSettings, &Effects.ReflectionEffect);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create reflection effect. [%d]"), Status);
     }
 
-    if ((!Source.AmbisonicsDecodeEffect || Source.PrevOrder != SimulationSettings.maxOrder) && Source.HRTF)
+    if (HRTF)
     {
         IPLAmbisonicsDecodeEffectSettings AmbisonicsDecodeSettings{};
-        AmbisonicsDecodeSettings.speakerLayout = GetSpeakerLayoutForNumChannels(NumChannels);
-        AmbisonicsDecodeSettings.hrtf = Source.HRTF;
+        AmbisonicsDecodeSettings.speakerLayout = GetSpeakerLayoutForNumChannels(2);
+        AmbisonicsDecodeSettings.hrtf = HRTF;
         AmbisonicsDecodeSettings.maxOrder = SimulationSettings.maxOrder;
 
-        if (Source.AmbisonicsDecodeEffect)
-        {
-            iplAmbisonicsDecodeEffectRelease(&Source.AmbisonicsDecodeEffect);
-        }
-
-        IPLerror Status = iplAmbisonicsDecodeEffectCreate(Context, &AudioSettings, &AmbisonicsDecodeSettings, &Source.AmbisonicsDecodeEffect);
+        Status = iplAmbisonicsDecodeEffectCreate(Context, &AudioSettings, &AmbisonicsDecodeSettings, &Effects.AmbisonicsDecodeEffect);
         if (Status != IPL_STATUS_SUCCESS)
         {
             UE_LOG(LogSteamAudio, Error, TEXT("Unable to create Ambisonics decode effect. [%d]"), Status);
         }
     }
 
-    if (!Source.InBuffer.data || Source.InBuffer.numChannels != NumChannels)
+    Status = iplAudioBufferAllocate(Context, 1, AudioSettings.frameSize, &Effects.MonoBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
     {
-        if (Source.InBuffer.data)
-        {
-            iplAudioBufferFree(Context, &Source.InBuffer);
-        }
-
-        IPLerror Status = iplAudioBufferAllocate(Context, NumChannels, AudioSettings.frameSize, &Source.InBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create input buffer for reverb effect. [%d]"), Status);
-        }
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create downmix buffer for reverb effect. [%d]"), Status);
     }
 
-    if (!Source.MonoBuffer.data)
+    Status = iplAudioBufferAllocate(Context, CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder), AudioSettings.frameSize, &Effects.ReverbBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
     {
-        IPLerror Status = iplAudioBufferAllocate(Context, 1, AudioSettings.frameSize, &Source.MonoBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create downmix buffer for reverb effect. [%d]"), Status);
-        }
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create reverb buffer for reverb effect. [%d]"), Status);
     }
 
-    if (!Source.IndirectBuffer.data || PrevOrder != SimulationSettings.maxOrder)
+    Status = iplAudioBufferAllocate(Context, CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder), AudioSettings.frameSize, &Effects.IndirectBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
     {
-        if (Source.IndirectBuffer.data)
-        {
-            iplAudioBufferFree(Context, &Source.IndirectBuffer);
-        }
-
-        IPLerror Status = iplAudioBufferAllocate(Context, CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder), AudioSettings.frameSize, &Source.IndirectBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create indirect buffer for reverb effect. [%d]"), Status);
-        }
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create indirect buffer for reverb effect. [%d]"), Status);
     }
 
-    if (!Source.OutBuffer.data || Source.OutBuffer.numChannels != NumChannels)
+    Status = iplAudioBufferAllocate(Context, 2, AudioSettings.frameSize, &Effects.OutBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
     {
-        if (Source.OutBuffer.data)
-        {
-            iplAudioBufferFree(Context, &Source.OutBuffer);
-        }
-
-        IPLerror Status = iplAudioBufferAllocate(Context, NumChannels, AudioSettings.frameSize, &Source.OutBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create output buffer for reverb effect. [%d]"), Status);
-        }
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create output buffer for reverb effect. [%d]"), Status);
     }
-
-    Source.PrevReflectionEffectType = SimulationSettings.reflectionType;
-    Source.PrevDuration = SimulationSettings.maxDuration;
-    Source.PrevOrder = SimulationSettings.maxOrder;
-    Source.Reset();
 }
 
 void FSteamAudioReverbPlugin::OnReleaseSource(const uint32 SourceId)
 {
 	FSteamAudioReverbSource& Source = Sources[SourceId];
     Source.Reset();
-    iplHRTFRelease(&Source.HRTF);
+
+    if (Source.Slab)
+    {
+        Source.Slab->ReflectionEffectPool.Release(SourceId);
+    }
+
+    Slabs.Unpin(Source.Slab);
+    Source.Slab = nullptr;
+    Source.Effects = nullptr;
 }
 
 FSoundEffectSubmixPtr FSteamAudioReverbPlugin::GetEffectSubmix()
@@ -399,72 +861,119 @@ void FSteamAudioReverbPlugin::ProcessSourceAudio(const FAudioPluginSourceInputDa
     }
 
 	FSteamAudioReverbSource& Source = Sources[InputData.SourceId];
-    Source.ClearBuffers();
+    if (Source.Effects)
+    {
+        Source.Effects->ClearBuffers();
+    }
 
     if (!FSteamAudioModule::IsPlaying())
         return;
 
+    if (!PinSlab(InputData.SourceId) || Source.LayoutIndex == INDEX_NONE)
+        return;
+
+    FSteamAudioReverbEffects& Effects = *Source.Effects;
+    FSteamAudioReverbSlab& Slab = *Source.Slab;
+
     float* InBufferData = InputData.AudioBuffer->GetData();
     float* OutBufferData = OutputData.AudioBuffer.GetData();
 
+    FSteamAudioModule::GetManager().RefreshSettingsSnapshot(SettingsSnapshot, SettingsGeneration);
+    if (!SettingsSnapshot)
+        return;
+
     IPLContext Context = FSteamAudioModule::GetManager().GetContext();
-    IPLSimulationSettings SimulationSettings = FSteamAudioModule::GetManager().GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
 
-    // Apply reflections if requested.
-    if (Source.bApplyReflections && Source.HRTF && Source.ReflectionEffect && Source.AmbisonicsDecodeEffect &&
-        Source.InBuffer.data && Source.MonoBuffer.data && Source.IndirectBuffer.data && Source.OutBuffer.data)
-    {
-        // Deinterleave and downmix the input buffer.
-        iplAudioBufferDeinterleave(Context, InBufferData, &Source.InBuffer);
-        iplAudioBufferDownmix(Context, &Source.InBuffer, &Source.MonoBuffer);
+    // Render with the settings the slab was built for, since the effects can't handle anything else.
+    const IPLSimulationSettings& SimulationSettings = Slab.SimulationSettings;
 
-        UAudioComponent* AudioComponent = UAudioComponent::GetAudioComponentFromID(InputData.AudioComponentId);
-        USteamAudioSourceComponent* SteamAudioSourceComponent = (AudioComponent) ? AudioComponent->GetOwner()->FindComponentByClass<USteamAudioSourceComponent>() : nullptr;
+    IPLAmbisonicsDecodeEffect AmbisonicsDecodeEffect = Effects.AmbisonicsDecodeEffects[Source.LayoutIndex];
+    IPLAudioBuffer& OutBuffer = Effects.OutBuffers[Source.LayoutIndex];
 
-        if (SteamAudioSourceComponent)
+    FScopedNoAllocation NoAllocation;
+
+    // Apply reflections if requested.
+    if (Source.bApplyReflections && Slab.HRTF && AmbisonicsDecodeEffect &&
+        Effects.MonoBuffer.data && Effects.IndirectBuffer.data && OutBuffer.data)
+    {
+        FSteamAudioSourceOutputs SourceOutputs;
+        if (FSteamAudioModule::GetManager().GetSourceOutputs(InputData.SourceId, InputData.AudioComponentId, SourceOutputs) && SourceOutputs.bHasIndirectOutputs)
         {
-            // Apply reflection mix level to mono buffer.
-            for (int i = 0; i < Source.MonoBuffer.numSamples; ++i)
+            // Deinterleave and downmix the input buffer, and apply reflection mix level, in a single pass.
+            SteamAudio::DeinterleaveDownmixAndScale(InBufferData, InputData.NumChannels, Effects.MonoBuffer.numSamples,
+                Source.ReflectionsMixLevel, Effects.MonoBuffer.data[0]);
+
+            // Track how loud the signal going into the reflection effect is, so the loudest sources get effects from
+            // the pool.
+            float SumSquares = 0.0f;
+            for (int i = 0; i < Effects.MonoBuffer.numSamples; ++i)
             {
-                Source.MonoBuffer.data[0][i] *= Source.ReflectionsMixLevel;
+                SumSquares += Effects.MonoBuffer.data[0][i] * Effects.MonoBuffer.data[0][i];
             }
 
-            LazyInitMixer();
-
-            IPLSimulationOutputs Outputs = SteamAudioSourceComponent->GetOutputs(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
+            float Level = FMath::Sqrt(SumSquares / FMath::Max(Effects.MonoBuffer.numSamples, 1));
+            Source.Audibility = FMath::Max(Level, Source.Audibility * AudibilityRelease);
 
-            IPLReflectionEffectParams ReflectionParams = Outputs.reflections;
+            IPLReflectionEffectParams ReflectionParams = SourceOutputs.Reflections;
             ReflectionParams.type = SimulationSettings.reflectionType;
             ReflectionParams.numChannels = SteamAudio::CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder);
             ReflectionParams.irSize = SteamAudio::CalcIRSizeForDuration(SimulationSettings.maxDuration, AudioSettings.samplingRate);
-            ReflectionParams.tanDevice = SimulationSettings.tanDevice;
-
-            iplReflectionEffectApply(Source.ReflectionEffect, &ReflectionParams, &Source.MonoBuffer, &Source.IndirectBuffer, ReflectionMixer);
+            ReflectionParams.tanDevice = SettingsSnapshot->RealTimeSettings.tanDevice;
 
             // If we're not outputting to the mixer (i.e., the submix plugin), then spatialize the reflections here.
             // NOTE: This does not currently work given the signal flow in the audio engine plugins.
             bool bOutputToMixer = (SimulationSettings.reflectionType == IPL_REFLECTIONEFFECTTYPE_CONVOLUTION ||
                 SimulationSettings.reflectionType == IPL_REFLECTIONEFFECTTYPE_TAN);
 
+            // If there's no effect for us in the pool, render parametric reverb using the reverb times estimated by
+            // the simulator instead.
+            IPLReflectionEffect ReflectionEffect = Slab.ReflectionEffectPool.Acquire(InputData.SourceId, Source.Audibility);
+
+            bool bUseFallback = (ReflectionEffect == nullptr);
+            if (bUseFallback != Source.bUsingFallback)
+            {
+                if (bUseFallback)
+                {
+                    INC_DWORD_STAT(STAT_SteamAudioFallbackReflectionSources);
+                }
+                else
+                {
+                    DEC_DWORD_STAT(STAT_SteamAudioFallbackReflectionSources);
+                }
+
+                Source.bUsingFallback = bUseFallback;
+            }
+
+            if (bUseFallback)
+            {
+                ReflectionEffect = Effects.FallbackReflectionEffect;
+                ReflectionParams.type = IPL_REFLECTIONEFFECTTYPE_PARAMETRIC;
+                bOutputToMixer = false;
+            }
+
+            if (!ReflectionEffect)
+                return;
+
+            iplReflectionEffectApply(ReflectionEffect, &ReflectionParams, &Effects.MonoBuffer, &Effects.IndirectBuffer, (bUseFallback) ? nullptr : Slab.ReflectionMixer);
+
             if (!bOutputToMixer)
             {
                 bool bBinaural = (Source.bApplyReflections && Source.bApplyHRTFToReflections);
 
                 IPLAmbisonicsDecodeEffectParams AmbisonicsDecodeParams{};
                 AmbisonicsDecodeParams.order = SimulationSettings.maxOrder;
-                AmbisonicsDecodeParams.hrtf = Source.HRTF;
-                AmbisonicsDecodeParams.orientation = FSteamAudioModule::GetManager().GetListenerCoordinates();
+                AmbisonicsDecodeParams.hrtf = Slab.HRTF;
+                AmbisonicsDecodeParams.orientation = (SourceOutputs.bHasListenerCoordinates) ? SourceOutputs.ListenerCoordinates : FSteamAudioModule::GetManager().GetListenerCoordinates();
                 AmbisonicsDecodeParams.binaural = (bBinaural && !FUnrealAudioEngineState::IsHRTFDisabled()) ? IPL_TRUE : IPL_FALSE;
 
-                iplAmbisonicsDecodeEffectApply(Source.AmbisonicsDecodeEffect, &AmbisonicsDecodeParams, &Source.IndirectBuffer, &Source.OutBuffer);
+                iplAmbisonicsDecodeEffectApply(AmbisonicsDecodeEffect, &AmbisonicsDecodeParams, &Effects.IndirectBuffer, &OutBuffer);
 
-                iplAudioBufferInterleave(Context, &Source.OutBuffer, OutBufferData);
+                iplAudioBufferInterleave(Context, &OutBuffer, OutBufferData);
             }
         }
     }
 }
 
-
 // ---------------------------------------------------------------------------------------------------------------------
 // FSteamAudioReverbPluginFactory
 // ---------------------------------------------------------------------------------------------------------------------
@@ -507,18 +1016,8 @@ std::atomic<bool> FSteamAudioReverbSubmixPlugin::bNewReverbSourceWritten(false);
 
 FSteamAudioReverbSubmixPlugin::FSteamAudioReverbSubmixPlugin()
 	: ReverbPlugin(nullptr)
-	, Context(nullptr)
-    , HRTF(nullptr)
-	, ReflectionEffect(nullptr)
-	, AmbisonicsDecodeEffect(nullptr)
-	, InBuffer()
-	, MonoBuffer()
-	, ReverbBuffer()
-	, IndirectBuffer()
-	, OutBuffer()
-    , PrevReflectionEffectType(IPL_REFLECTIONEFFECTTYPE_CONVOLUTION)
-    , PrevDuration(0.0f)
-    , PrevOrder(-1)
+    , Slab(nullptr)
+    , SettingsGeneration(0)
 {}
 
 FSteamAudioReverbSubmixPlugin::~FSteamAudioReverbSubmixPlugin()
@@ -534,313 +1033,152 @@ uint32 FSteamAudioReverbSubmixPlugin::GetDesiredInputChannelCountOverride() cons
 
 void FSteamAudioReverbSubmixPlugin::SetReverbPlugin(SteamAudio::FSteamAudioReverbPlugin* Plugin)
 {
-	ReverbPlugin = Plugin;
-}
-
-void FSteamAudioReverbSubmixPlugin::LazyInit()
-{
-    if (!Context)
-    {
-        Context = iplContextRetain(SteamAudio::FSteamAudioModule::GetManager().GetContext());
-    }
-
-    if (!ReverbPlugin)
-    {
-        ReverbPlugin = StaticCast<SteamAudio::FSteamAudioReverbPlugin*>(GEngine->GetAudioDeviceManager()->GetMainAudioDeviceRaw()->ReverbPluginInterface.Get());
-    }
-
-    IPLAudioSettings AudioSettings = ReverbPlugin->GetAudioSettings();
-
-    if (!HRTF)
-    {
-        if (SteamAudio::FSteamAudioModule::GetManager().InitHRTF(AudioSettings))
-        {
-            HRTF = iplHRTFRetain(SteamAudio::FSteamAudioModule::GetManager().GetHRTF());
-        }
-    }
-
-    IPLSimulationSettings SimulationSettings = SteamAudio::FSteamAudioModule::GetManager().GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
-
-    if (!ReflectionEffect || PrevReflectionEffectType != SimulationSettings.reflectionType ||
-        PrevDuration != SimulationSettings.maxDuration || PrevOrder != SimulationSettings.maxOrder)
-    {
-        if (ReflectionEffect)
-        {
-            iplReflectionEffectRelease(&ReflectionEffect);
-        }
-
-        IPLReflectionEffectSettings ReflectionSettings{};
-        ReflectionSettings.type = SimulationSettings.reflectionType;
-        ReflectionSettings.irSize = SteamAudio::CalcIRSizeForDuration(SimulationSettings.maxDuration, AudioSettings.samplingRate);
-        ReflectionSettings.numChannels = SteamAudio::CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder);
-
-        IPLerror Status = iplReflectionEffectCreate(Context, &AudioSettings, &ReflectionSettings, &ReflectionEffect);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create reflection effect. [%d]"), Status);
-        }
-    }
-
-    if ((!AmbisonicsDecodeEffect || PrevOrder != SimulationSettings.maxOrder) && HRTF)
-    {
-        if (AmbisonicsDecodeEffect)
-        {
-            iplAmbisonicsDecodeEffectRelease(&AmbisonicsDecodeEffect);
-        }
-
-        IPLAmbisonicsDecodeEffectSettings AmbisonicsDecodeSettings{};
-        AmbisonicsDecodeSettings.speakerLayout = SteamAudio::GetSpeakerLayoutForNumChannels(2);
-        AmbisonicsDecodeSettings.hrtf = HRTF;
-        AmbisonicsDecodeSettings.maxOrder = SimulationSettings.maxOrder;
-
-        IPLerror Status = iplAmbisonicsDecodeEffectCreate(Context, &AudioSettings, &AmbisonicsDecodeSettings, &AmbisonicsDecodeEffect);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create Ambisonics decode effect. [%d]"), Status);
-        }
-    }
-
-    if (!InBuffer.data)
-    {
-        IPLerror Status = iplAudioBufferAllocate(Context, 2, AudioSettings.frameSize, &InBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create input buffer for reverb effect. [%d]"), Status);
-        }
-    }
-
-    if (!MonoBuffer.data)
-    {
-        IPLerror Status = iplAudioBufferAllocate(Context, 1, AudioSettings.frameSize, &MonoBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create downmix buffer for reverb effect. [%d]"), Status);
-        }
-    }
-
-    if (!ReverbBuffer.data || PrevOrder != SimulationSettings.maxOrder)
-    {
-        if (ReverbBuffer.data)
-        {
-            iplAudioBufferFree(Context, &ReverbBuffer);
-        }
-
-        IPLerror Status = iplAudioBufferAllocate(Context, SteamAudio::CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder), AudioSettings.frameSize, &ReverbBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create reverb buffer for reverb effect. [%d]"), Status);
-        }
-    }
-
-    if (!IndirectBuffer.data)
+    if (ReverbPlugin && Slab)
     {
-        if (IndirectBuffer.data)
-        {
-            iplAudioBufferFree(Context, &IndirectBuffer);
-        }
-
-        IPLerror Status = iplAudioBufferAllocate(Context, SteamAudio::CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder), AudioSettings.frameSize, &IndirectBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create indirect buffer for reverb effect. [%d]"), Status);
-        }
-    }
-
-    if (!OutBuffer.data)
-    {
-        IPLerror Status = iplAudioBufferAllocate(Context, 2, AudioSettings.frameSize, &OutBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create output buffer for reverb effect. [%d]"), Status);
-        }
+        ReverbPlugin->UnpinSlab(Slab);
     }
 
-    PrevReflectionEffectType = SimulationSettings.reflectionType;
-    PrevDuration = SimulationSettings.maxDuration;
-    PrevOrder = SimulationSettings.maxOrder;
+    Slab = nullptr;
+	ReverbPlugin = Plugin;
 }
 
 void FSteamAudioReverbSubmixPlugin::ShutDown()
 {
-    iplAudioBufferFree(Context, &InBuffer);
-    iplAudioBufferFree(Context, &MonoBuffer);
-    iplAudioBufferFree(Context, &ReverbBuffer);
-    iplAudioBufferFree(Context, &IndirectBuffer);
-    iplAudioBufferFree(Context, &OutBuffer);
-
-    iplSourceRelease(&ReverbSource[0]);
-    iplSourceRelease(&ReverbSource[1]);
-    bNewReverbSourceWritten = false;
-
-    iplAmbisonicsDecodeEffectRelease(&AmbisonicsDecodeEffect);
-    iplReflectionEffectRelease(&ReflectionEffect);
-    iplHRTFRelease(&HRTF);
-    iplContextRelease(&Context);
-}
-
-void FSteamAudioReverbSubmixPlugin::Reset()
-{
-    if (ReflectionEffect)
+    if (ReverbPlugin && Slab)
     {
-        iplReflectionEffectReset(ReflectionEffect);
+        ReverbPlugin->UnpinSlab(Slab);
     }
 
-    if (AmbisonicsDecodeEffect)
-    {
-        iplAmbisonicsDecodeEffectReset(AmbisonicsDecodeEffect);
-    }
+    Slab = nullptr;
 
-    ClearBuffers();
+    iplSourceRelease(&ReverbSource[0]);
+    iplSourceRelease(&ReverbSource[1]);
+    bNewReverbSourceWritten = false;
 }
 
-void FSteamAudioReverbSubmixPlugin::ClearBuffers()
+void FSteamAudioReverbSubmixPlugin::OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData)
 {
-    if (InBuffer.data)
-    {
-        for (int i = 0; i < InBuffer.numChannels; ++i)
-        {
-            FMemory::Memzero(InBuffer.data[i], InBuffer.numSamples * sizeof(float));
-        }
-    }
-
-    if (MonoBuffer.data)
+	// The submix plugin can keep running in the editor when not in play mode. So don't do anything if Steam Audio
+	// is not initialized.
+    if (!SteamAudio::FSteamAudioModule::IsPlaying())
     {
-        for (int i = 0; i < MonoBuffer.numChannels; ++i)
+        if (Slab)
         {
-            FMemory::Memzero(MonoBuffer.data[i], MonoBuffer.numSamples * sizeof(float));
+            ShutDown();
         }
-    }
 
-    if (ReverbBuffer.data)
-    {
-        for (int i = 0; i < ReverbBuffer.numChannels; ++i)
-        {
-            FMemory::Memzero(ReverbBuffer.data[i], ReverbBuffer.numSamples * sizeof(float));
-        }
+        return;
     }
 
-    if (IndirectBuffer.data)
+    if (!ReverbPlugin)
     {
-        for (int i = 0; i < IndirectBuffer.numChannels; ++i)
-        {
-            FMemory::Memzero(IndirectBuffer.data[i], IndirectBuffer.numSamples * sizeof(float));
-        }
+        ReverbPlugin = StaticCast<SteamAudio::FSteamAudioReverbPlugin*>(GEngine->GetAudioDeviceManager()->GetMainAudioDeviceRaw()->ReverbPluginInterface.Get());
     }
 
-    if (OutBuffer.data)
-    {
-        for (int i = 0; i < OutBuffer.numChannels; ++i)
-        {
-            FMemory::Memzero(OutBuffer.data[i], OutBuffer.numSamples * sizeof(float));
-        }
-    }
-}
+    if (!ReverbPlugin)
+        return;
 
-void FSteamAudioReverbSubmixPlugin::OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData)
-{
-	// The submix plugin can keep running in the editor when not in play mode. So don't do anything if Steam Audio
-	// is not initialized.
-    if (!SteamAudio::FSteamAudioModule::IsPlaying())
+    // Switch to the reverb plugin's latest slab, if it has published a new one since we last pinned.
+    if (!ReverbPlugin->IsSlabPublished(Slab))
     {
-        if (ReflectionEffect)
-        {
-            ShutDown();
-        }
+        ReverbPlugin->UnpinSlab(Slab);
+        Slab = ReverbPlugin->PinSlab();
 
-        if (ReverbPlugin && ReverbPlugin->GetReflectionMixer())
+        if (Slab)
         {
-            ReverbPlugin->ShutDownMixer();
+            Slab->SubmixEffects.Reset();
         }
+    }
 
+    if (!Slab)
         return;
-    }
 
 	float* InBufferData = InData.AudioBuffer->GetData();
 	float* OutBufferData = OutData.AudioBuffer->GetData();
 
-    ClearBuffers();
+    SteamAudio::FSteamAudioReverbSubmixEffects& Effects = Slab->SubmixEffects;
+    Effects.ClearBuffers();
 
-    IPLSimulationSettings SimulationSettings = SteamAudio::FSteamAudioModule::GetManager().GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
+    SteamAudio::FSteamAudioModule::GetManager().RefreshSettingsSnapshot(SettingsSnapshot, SettingsGeneration);
+    if (!SettingsSnapshot)
+        return;
 
-    LazyInit();
+    IPLContext Context = SteamAudio::FSteamAudioModule::GetManager().GetContext();
 
-    if (ReverbPlugin)
-	{
-        ReverbPlugin->LazyInitMixer();
+    // Render with the settings the slab was built for, since the effects can't handle anything else.
+    const IPLSimulationSettings& SimulationSettings = Slab->SimulationSettings;
 
-        bool bHasOutput = false;
+    SteamAudio::FScopedNoAllocation NoAllocation;
 
-		// Grab source-centric reflections from the mixer.
-		if (SimulationSettings.reflectionType == IPL_REFLECTIONEFFECTTYPE_CONVOLUTION || SimulationSettings.reflectionType == IPL_REFLECTIONEFFECTTYPE_TAN)
-		{
-            IPLReflectionMixer Mixer = ReverbPlugin->GetReflectionMixer();
+    bool bHasOutput = false;
 
-            if (Mixer && IndirectBuffer.data)
-            {
-                IPLReflectionEffectParams ReflectionParams{};
-                ReflectionParams.numChannels = SteamAudio::CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder);
-                ReflectionParams.tanDevice = SimulationSettings.tanDevice;
+	// Grab source-centric reflections from the mixer.
+	if (SimulationSettings.reflectionType == IPL_REFLECTIONEFFECTTYPE_CONVOLUTION || SimulationSettings.reflectionType == IPL_REFLECTIONEFFECTTYPE_TAN)
+	{
+        if (Slab->ReflectionMixer && Effects.IndirectBuffer.data)
+        {
+            IPLReflectionEffectParams ReflectionParams{};
+            ReflectionParams.numChannels = SteamAudio::CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder);
+            ReflectionParams.tanDevice = SettingsSnapshot->RealTimeSettings.tanDevice;
 
-                iplReflectionMixerApply(Mixer, &ReflectionParams, &IndirectBuffer);
+            iplReflectionMixerApply(Slab->ReflectionMixer, &ReflectionParams, &Effects.IndirectBuffer);
 
-                bHasOutput = true;
-            }
-		}
+            bHasOutput = true;
+        }
+	}
 
-		// If requested, apply reverb to the input.
-		USteamAudioReverbSubmixPluginPreset* ReverbPreset = Cast<USteamAudioReverbSubmixPluginPreset>(GetPreset());
-		if (ReverbPreset && ReverbPreset->Settings.bApplyReverb)
+	// If requested, apply reverb to the input.
+	USteamAudioReverbSubmixPluginPreset* ReverbPreset = Cast<USteamAudioReverbSubmixPluginPreset>(GetPreset());
+	if (ReverbPreset && ReverbPreset->Settings.bApplyReverb)
+	{
+        // If a Steam Audio Listener component has not set the current reverb source, stop.
+        IPLSource CurrentReverbSource = GetReverbSource();
+		if (CurrentReverbSource && Effects.ReflectionEffect &&
+            Effects.MonoBuffer.data && Effects.ReverbBuffer.data && Effects.IndirectBuffer.data)
 		{
-            // If a Steam Audio Listener component has not set the current reverb source, stop.
-            IPLSource CurrentReverbSource = GetReverbSource();
-			if (CurrentReverbSource && ReflectionEffect &&
-                InBuffer.data && MonoBuffer.data && ReverbBuffer.data && IndirectBuffer.data)
+			SteamAudio::DeinterleaveDownmixAndScale(InBufferData, InData.NumChannels, Effects.MonoBuffer.numSamples, 1.0f, Effects.MonoBuffer.data[0]);
+
+			IPLSimulationOutputs Outputs{};
+			iplSourceGetOutputs(CurrentReverbSource, IPL_SIMULATIONFLAGS_REFLECTIONS, &Outputs);
+
+			IPLReflectionEffectParams ReverbParams = Outputs.reflections;
+			ReverbParams.type = SimulationSettings.reflectionType;
+			ReverbParams.numChannels = SteamAudio::CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder);
+			ReverbParams.irSize = SteamAudio::CalcIRSizeForDuration(SimulationSettings.maxDuration, SimulationSettings.samplingRate);
+			ReverbParams.tanDevice = SettingsSnapshot->RealTimeSettings.tanDevice;
+
+			if (SimulationSettings.reflectionType == IPL_REFLECTIONEFFECTTYPE_CONVOLUTION || SimulationSettings.reflectionType == IPL_REFLECTIONEFFECTTYPE_TAN)
+			{
+				// We might have mixed source-centric reflections, so render listener-centric reverb into a temp
+				// buffer and mix it into the source-centric reflections.
+				iplReflectionEffectApply(Effects.ReflectionEffect, &ReverbParams, &Effects.MonoBuffer, &Effects.ReverbBuffer, nullptr);
+				iplAudioBufferMix(Context, &Effects.ReverbBuffer, &Effects.IndirectBuffer);
+			}
+			else
 			{
-				iplAudioBufferDeinterleave(Context, InBufferData, &InBuffer);
-				iplAudioBufferDownmix(Context, &InBuffer, &MonoBuffer);
-
-				IPLSimulationOutputs Outputs{};
-				iplSourceGetOutputs(CurrentReverbSource, IPL_SIMULATIONFLAGS_REFLECTIONS, &Outputs);
-
-				IPLReflectionEffectParams ReverbParams = Outputs.reflections;
-				ReverbParams.type = SimulationSettings.reflectionType;
-				ReverbParams.numChannels = SteamAudio::CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder);
-				ReverbParams.irSize = SteamAudio::CalcIRSizeForDuration(SimulationSettings.maxDuration, SimulationSettings.samplingRate);
-				ReverbParams.tanDevice = SimulationSettings.tanDevice;
-
-				if (SimulationSettings.reflectionType == IPL_REFLECTIONEFFECTTYPE_CONVOLUTION || SimulationSettings.reflectionType == IPL_REFLECTIONEFFECTTYPE_TAN)
-				{
-					// We might have mixed source-centric reflections, so render listener-centric reverb into a temp
-					// buffer and mix it into the source-centric reflections.
-					iplReflectionEffectApply(ReflectionEffect, &ReverbParams, &MonoBuffer, &ReverbBuffer, nullptr);
-					iplAudioBufferMix(Context, &ReverbBuffer, &IndirectBuffer);
-				}
-				else
-				{
-					// We don't have source-centric reflections, so just render the listener-centric reverb into the buffer
-					// that we'll spatialize in the next step.
-					iplReflectionEffectApply(ReflectionEffect, &ReverbParams, &MonoBuffer, &IndirectBuffer, nullptr);
-				}
-
-                bHasOutput = true;
+				// We don't have source-centric reflections, so just render the listener-centric reverb into the buffer
+				// that we'll spatialize in the next step.
+				iplReflectionEffectApply(Effects.ReflectionEffect, &ReverbParams, &Effects.MonoBuffer, &Effects.IndirectBuffer, nullptr);
 			}
+
+            bHasOutput = true;
 		}
+	}
 
-        if (bHasOutput && HRTF && AmbisonicsDecodeEffect && IndirectBuffer.data && OutBuffer.data)
-        {
-            USteamAudioReverbSubmixPluginPreset* CurrentPreset = Cast<USteamAudioReverbSubmixPluginPreset>(GetPreset());
+    if (bHasOutput && Slab->HRTF && Effects.AmbisonicsDecodeEffect && Effects.IndirectBuffer.data && Effects.OutBuffer.data)
+    {
+        USteamAudioReverbSubmixPluginPreset* CurrentPreset = Cast<USteamAudioReverbSubmixPluginPreset>(GetPreset());
 
-            IPLAmbisonicsDecodeEffectParams AmbisonicsDecodeParams{};
-            AmbisonicsDecodeParams.order = SimulationSettings.maxOrder;
-            AmbisonicsDecodeParams.hrtf = HRTF;
-            AmbisonicsDecodeParams.orientation = SteamAudio::FSteamAudioModule::GetManager().GetListenerCoordinates();
-            AmbisonicsDecodeParams.binaural = (CurrentPreset && CurrentPreset->Settings.bApplyHRTF && !SteamAudio::FUnrealAudioEngineState::IsHRTFDisabled()) ? IPL_TRUE : IPL_FALSE;
+        IPLAmbisonicsDecodeEffectParams AmbisonicsDecodeParams{};
+        AmbisonicsDecodeParams.order = SimulationSettings.maxOrder;
+        AmbisonicsDecodeParams.hrtf = Slab->HRTF;
+        AmbisonicsDecodeParams.orientation = SteamAudio::FSteamAudioModule::GetManager().GetListenerCoordinates();
+        AmbisonicsDecodeParams.binaural = (CurrentPreset && CurrentPreset->Settings.bApplyHRTF && !SteamAudio::FUnrealAudioEngineState::IsHRTFDisabled()) ? IPL_TRUE : IPL_FALSE;
 
-            iplAmbisonicsDecodeEffectApply(AmbisonicsDecodeEffect, &AmbisonicsDecodeParams, &IndirectBuffer, &OutBuffer);
+        iplAmbisonicsDecodeEffectApply(Effects.AmbisonicsDecodeEffect, &AmbisonicsDecodeParams, &Effects.IndirectBuffer, &Effects.OutBuffer);
 
-            iplAudioBufferInterleave(Context, &OutBuffer, OutBufferData);
-        }
-	}
+        iplAudioBufferInterleave(Context, &Effects.OutBuffer, OutBufferData);
+    }
 }
 
 IPLSource FSteamAudioReverbSubmixPlugin::GetReverbSource()
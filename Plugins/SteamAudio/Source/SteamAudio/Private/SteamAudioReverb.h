@@ -17,6 +17,7 @@
 #pragma once
 
 #include "SteamAudioModule.h"
+#include "SteamAudioManager.h"
 #include "Sound/SoundEffectSubmix.h"
 #include "Sound/SoundEffectPreset.h"
 #include "SteamAudioReverb.generated.h"
@@ -24,53 +25,226 @@
 namespace SteamAudio {
 
 // ---------------------------------------------------------------------------------------------------------------------
-// FSteamAudioReverbSource
+// FSteamAudioReverbEffects
 // ---------------------------------------------------------------------------------------------------------------------
 
 /**
- * Rendering state for a single reverb voice.
+ * Effects and buffers for a single reverb voice.
  */
-struct FSteamAudioReverbSource
+struct FSteamAudioReverbEffects
 {
-	FSteamAudioReverbSource();
+	FSteamAudioReverbEffects();
 
-	~FSteamAudioReverbSource();
+	~FSteamAudioReverbEffects();
 
-	bool bApplyReflections;
-	bool bApplyHRTFToReflections;
-	float ReflectionsMixLevel;
+	/** Parametric reflection effect used when bApplyReflections is true, but the source doesn't have a reflection
+	    effect from the pool. */
+	IPLReflectionEffect FallbackReflectionEffect;
 
-	/** Retained reference to the HRTF. */
-	IPLHRTF HRTF;
+    /** Used when bApplyReflections is true, one for each channel count in SupportedNumChannels. */
+	IPLAmbisonicsDecodeEffect AmbisonicsDecodeEffects[NumSupportedLayouts];
 
-	/** Used when bApplyReflections is true. */
-	IPLReflectionEffect ReflectionEffect;
+	/** Downmixed input buffer. */
+	IPLAudioBuffer MonoBuffer;
+
+	/** Ambisonic buffer with reflections applied. */
+	IPLAudioBuffer IndirectBuffer;
+
+	/** Spatialized reflections for output, one for each channel count in SupportedNumChannels. */
+	IPLAudioBuffer OutBuffers[NumSupportedLayouts];
 
-    /** Used when bApplyReflections is true. */
-	IPLAmbisonicsDecodeEffect AmbisonicsDecodeEffect;
+	void Reset();
+
+	void ClearBuffers();
+};
 
-	/** Deinterleaved input buffer. */
-	IPLAudioBuffer InBuffer;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioReverbSubmixEffects
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Effects and buffers for the submix plugin.
+ */
+struct FSteamAudioReverbSubmixEffects
+{
+	FSteamAudioReverbSubmixEffects();
+
+	~FSteamAudioReverbSubmixEffects();
+
+	/** Used for rendering reverb. */
+	IPLReflectionEffect ReflectionEffect;
+
+    /** Used for rendering reverb. */
+    IPLAmbisonicsDecodeEffect AmbisonicsDecodeEffect;
 
 	/** Downmixed input buffer. */
 	IPLAudioBuffer MonoBuffer;
 
-	/** Ambisonic buffer with reflections applied. */
+	/** Buffer containing Ambisonic reverb. */
+	IPLAudioBuffer ReverbBuffer;
+
+	/** Buffer containing Ambisonic source-centric reflections. */
 	IPLAudioBuffer IndirectBuffer;
 
-	/** Spatialized reflections for output. */
+	/** Spatialized output buffer. */
 	IPLAudioBuffer OutBuffer;
 
-    IPLReflectionEffectType PrevReflectionEffectType;
-    float PrevDuration;
-    int PrevOrder;
-
 	void Reset();
 
 	void ClearBuffers();
 };
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioReflectionEffectPool
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * A bounded set of reflection effects shared between reverb sources. All effects are created up front when the pool is
+ * configured, up to a limit derived from the memory budget. Once they are all in use, a louder source can take over the
+ * effect of the quietest source. Since the quiet source may be in the middle of rendering with it, the effect is only
+ * handed over the next time the quiet source asks for it. Thread-safe.
+ */
+class FSteamAudioReflectionEffectPool
+{
+public:
+    FSteamAudioReflectionEffectPool();
+
+    ~FSteamAudioReflectionEffectPool();
+
+    /**
+     * Sets the settings that effects are created with, and the maximum number of effects, and creates any effects that
+     * don't exist yet. If the reflection effect settings have changed, all existing effects are destroyed first. Must
+     * not be called while any source is rendering.
+     */
+    void Configure(const IPLAudioSettings& AudioSettings, const IPLReflectionEffectSettings& EffectSettings, int32 MaxSources, int32 MemoryBudgetMB);
+
+    /**
+     * Returns the effect assigned to the given source, assigning or stealing one if possible. Returns nullptr if the
+     * source has no effect for this buffer, in which case it should use a fallback.
+     */
+    IPLReflectionEffect Acquire(int32 SourceId, float Audibility);
+
+    /** Returns the effect assigned to the given source (if any) to the pool. */
+    void Release(int32 SourceId);
+
+    /** Destroys all effects. */
+    void Reset();
+
+    /** Returns the estimated memory used by a single reflection effect with the given settings. */
+    static uint64 EstimateEffectSize(const IPLAudioSettings& AudioSettings, const IPLReflectionEffectSettings& EffectSettings);
+
+private:
+    /** A single pooled effect. */
+    struct FSlot
+    {
+        /** Created when the pool is configured. */
+        IPLReflectionEffect Effect = nullptr;
+
+        /** The source using the effect, or INDEX_NONE. */
+        int32 Owner = INDEX_NONE;
+
+        /** The source that will get the effect when Owner next asks for it, or INDEX_NONE. */
+        int32 PendingOwner = INDEX_NONE;
+
+        /** Audibility of Owner as of the last time it asked for the effect. */
+        float OwnerAudibility = 0.0f;
+    };
+
+    /** Assigns the slot to the given source. Returns false if the slot has no effect. */
+    bool AssignSlot(int32 SlotIndex, int32 SourceId);
+
+    /** Hands the slot over to its pending owner (if any), or marks it as free. */
+    void UnassignSlot(int32 SlotIndex);
+
+    /** Updates the stats for pooled and live effects. */
+    void UpdateStats() const;
+
+    IPLAudioSettings AudioSettings;
+    IPLReflectionEffectSettings EffectSettings;
+
+    TArray<FSlot> Slots;
+
+    /** The slot assigned to each source, or INDEX_NONE. */
+    TArray<int32> SourceSlots;
+
+    /** Guards all of the above. */
+    mutable FCriticalSection CriticalSection;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioReverbSlab
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Effects and buffers for every reverb voice, along with the reflection effect pool and the reflection mixer, built on
+ * the game thread for a given set of settings.
+ */
+struct FSteamAudioReverbSlab : public FSteamAudioSlab
+{
+    virtual ~FSteamAudioReverbSlab();
+
+    /** Simulation settings the effects were created with. */
+    IPLSimulationSettings SimulationSettings{};
+
+    /** Retained reference to the HRTF the effects were created with. */
+    IPLHRTF HRTF = nullptr;
+
+    /** Memory budget the pool was configured with. */
+    int32 MemoryBudgetMB = 0;
+
+    /** Indexed by source id. */
+    TArray<FSteamAudioReverbEffects> Effects;
+
+    /** Reflection effects shared between all sources rendering with this slab. */
+    FSteamAudioReflectionEffectPool ReflectionEffectPool;
+
+    /** The reflection mixer that sources rendering with this slab mix into, and the submix plugin reads from. */
+    IPLReflectionMixer ReflectionMixer = nullptr;
+
+    /** Effects and buffers for the submix plugin. */
+    FSteamAudioReverbSubmixEffects SubmixEffects;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioReverbSource
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Rendering state for a single reverb voice.
+ */
+struct FSteamAudioReverbSource
+{
+	FSteamAudioReverbSource();
+
+	bool bApplyReflections;
+	bool bApplyHRTFToReflections;
+	float ReflectionsMixLevel;
+
+    /** Index into SupportedNumChannels of the voice's number of channels, or INDEX_NONE if it isn't supported. */
+    int LayoutIndex;
+
+    /** Level of the signal sent to the reflection effect, with a slow release. Used to decide which sources get a
+        reflection effect from the pool. */
+    float Audibility;
+
+    /** True if the fallback effect was used for the most recent buffer. */
+    bool bUsingFallback;
+
+    /** The slab the voice renders with, pinned from when the voice starts until it stops. Null if no slab had been
+        published yet. */
+    FSteamAudioReverbSlab* Slab;
+
+    /** The voice's entry in Slab. */
+    FSteamAudioReverbEffects* Effects;
+
+	void Reset();
+};
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // FSteamAudioReverbPlugin
 // ---------------------------------------------------------------------------------------------------------------------
@@ -108,33 +282,55 @@ public:
 	virtual void ProcessSourceAudio(const FAudioPluginSourceInputData& InputData, FAudioPluginSourceOutputData& OutputData) override;
 
 	IPLAudioSettings GetAudioSettings() { return AudioSettings; }
-	IPLReflectionMixer GetReflectionMixer() { return ReflectionMixer; }
 
-	/** Ensures that the reflection mixer is initialized. */
-	void LazyInitMixer();
+	/** Pins and returns the published slab, or returns nullptr if there is none. Used by the submix plugin to find
+	    the reflection mixer. Lock-free. */
+	FSteamAudioReverbSlab* PinSlab() { return Slabs.Pin(); }
+
+	/** Unpins a slab returned by PinSlab. Lock-free. */
+	void UnpinSlab(FSteamAudioReverbSlab* Slab) { Slabs.Unpin(Slab); }
 
-	/** Destroys the reflection mixer. */
-	void ShutDownMixer();
+	/** Returns true if the given slab is the published one, without dereferencing it. Lock-free. */
+	bool IsSlabPublished(const FSteamAudioReverbSlab* Slab) const { return Slab == Slabs.GetPublished(); }
 
 private:
+    /** Builds and publishes a new slab if the settings that the effects depend on have changed. Called on the game
+        thread whenever the settings snapshot is rebuilt. */
+    void OnSettingsSnapshotRebuilt(const FSteamAudioSettingsSnapshotPtr& Snapshot);
+
+    /** Allocates the effects and buffers for a single voice, for every supported number of input channels. */
+    void PrepareEffects(FSteamAudioReverbEffects& Effects, IPLHRTF HRTF, const IPLSimulationSettings& SimulationSettings);
+
+    /** Allocates the effects and buffers for the submix plugin. */
+    void PrepareSubmixEffects(FSteamAudioReverbSubmixEffects& Effects, IPLHRTF HRTF, const IPLSimulationSettings& SimulationSettings);
+
+    /** Pins the published slab for the given source, if it doesn't have one yet. Returns false if there is none. */
+    bool PinSlab(uint32 SourceId);
+
     /** Audio pipeline settings. */
 	IPLAudioSettings AudioSettings;
 
-    /** Lazy-initialized state for as many sources as we can render simultaneously. */
+    /** State for as many sources as we can render simultaneously, allocated up front by Initialize. */
 	TArray<FSteamAudioReverbSource> Sources;
 
+    /** Effects and buffers for every source, built whenever the settings change, so starting a voice doesn't need to
+        allocate. */
+    TSteamAudioSlabs<FSteamAudioReverbSlab> Slabs;
+
+    /** Handle for our OnSettingsSnapshotRebuilt binding. */
+    FDelegateHandle SettingsSnapshotRebuiltHandle;
+
 	/** The submix node containing the submix plugin. */
 	TWeakObjectPtr<USoundSubmix> ReverbSubmix;
 
 	/** The submix plugin. */
 	FSoundEffectSubmixPtr ReverbSubmixEffect;
 
-	/** The reflection mixer object used by the submix plugin. */
-	IPLReflectionMixer ReflectionMixer;
+	/** The most recent settings snapshot seen by the audio thread. */
+	FSteamAudioSettingsSnapshotPtr SettingsSnapshot;
 
-	IPLReflectionEffectType PrevReflectionEffectType;
-	float PrevDuration;
-	int PrevOrder;
+	/** Settings generation that SettingsSnapshot was fetched for. */
+	uint32 SettingsGeneration;
 };
 
 
@@ -193,7 +389,7 @@ public:
 	/** Processes the audio flowing through the submix. */
 	virtual void OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData) override;
 
-	/** Called to specify the singleton reverb plugin instance. */
+	/** Called to specify the singleton reverb plugin instance. Unpins the slab pinned from the previous one. */
 	void SetReverbPlugin(SteamAudio::FSteamAudioReverbPlugin* Plugin);
 
 	/** Returns the Steam Audio simulation source used for listener-centric reverb. */
@@ -206,36 +402,9 @@ private:
 	/** The singleton reverb plugin. */
 	SteamAudio::FSteamAudioReverbPlugin* ReverbPlugin;
 
-	/** Retained reference to the Steam Audio context. */
-	IPLContext Context;
-
-	/** Retained reference to the HRTF. */
-	IPLHRTF HRTF;
-
-	/** Used for rendering reverb. */
-	IPLReflectionEffect ReflectionEffect;
-
-    /** Used for rendering reverb. */
-    IPLAmbisonicsDecodeEffect AmbisonicsDecodeEffect;
-
-	/** Deinterleaved input buffer. */
-	IPLAudioBuffer InBuffer;
-
-	/** Downmixed input buffer. */
-	IPLAudioBuffer MonoBuffer;
-
-	/** Buffer containing Ambisonic reverb. */
-	IPLAudioBuffer ReverbBuffer;
-
-	/** Buffer containing Ambisonic source-centric reflections. */
-	IPLAudioBuffer IndirectBuffer;
-
-	/** Spatialized output buffer. */
-	IPLAudioBuffer OutBuffer;
-
-    IPLReflectionEffectType PrevReflectionEffectType;
-    float PrevDuration;
-    int PrevOrder;
+	/** The reverb plugin's slab that we render with, containing our effects and the reflection mixer. Pinned while
+	    we're playing, and re-pinned when the reverb plugin publishes a new one. */
+	SteamAudio::FSteamAudioReverbSlab* Slab;
 
 	/** Double-buffered reference to the Steam Audio simulation source. */
 	static IPLSource ReverbSource[2];
@@ -243,15 +412,14 @@ private:
 	/** True if the double buffers need to be swapped. */
 	static std::atomic<bool> bNewReverbSourceWritten;
 
-	/** Ensures that the Steam Audio effects are initialized. */
-	void LazyInit();
-
-	/** Destroys Steam Audio effects. */
-	void ShutDown();
+	/** The most recent settings snapshot seen by the audio thread. */
+	SteamAudio::FSteamAudioSettingsSnapshotPtr SettingsSnapshot;
 
-	void Reset();
+	/** Settings generation that SettingsSnapshot was fetched for. */
+	uint32 SettingsGeneration;
 
-	void ClearBuffers();
+	/** Unpins the slab and releases the simulation source. */
+	void ShutDown();
 };
 
 
@@ -22,9 +22,11 @@
 #include "LandscapeInfo.h"
 #include "Model.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "Engine/SimpleConstructionScript.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/StaticMeshActor.h"
+#include "Misc/ScopeExit.h"
 #include "SteamAudioCommon.h"
 #include "SteamAudioDynamicObjectComponent.h"
 #include "SteamAudioGeometryComponent.h"
@@ -40,6 +42,16 @@
 #include "Editor/UnrealEd/Public/Kismet2/BlueprintEditorUtils.h"
 #endif
 
+DECLARE_CYCLE_STAT(TEXT("Gather Static Mesh Components"), STAT_SteamAudioGatherStaticMeshComponents, STATGROUP_SteamAudio);
+DECLARE_CYCLE_STAT(TEXT("Extract Static Mesh Components"), STAT_SteamAudioExtractStaticMeshComponents, STATGROUP_SteamAudio);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Static Geometry Chunks"), STAT_SteamAudioStaticGeometryChunks, STATGROUP_SteamAudio);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Static Geometry Chunks Rebuilt"), STAT_SteamAudioStaticGeometryChunksRebuilt, STATGROUP_SteamAudio);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Static Geometry Gather Time (ms)"), STAT_SteamAudioStaticGeometryGatherTime, STATGROUP_SteamAudio);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Static Geometry Build Time (ms)"), STAT_SteamAudioStaticGeometryBuildTime, STATGROUP_SteamAudio);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Serialized Objects Loaded"), STAT_SteamAudioSerializedObjectsLoaded, STATGROUP_SteamAudio);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Serialized Object Load Time (ms)"), STAT_SteamAudioSerializedObjectLoadTime, STATGROUP_SteamAudio);
+DECLARE_MEMORY_STAT(TEXT("Serialized Object Payload"), STAT_SteamAudioSerializedObjectPayload, STATGROUP_SteamAudio);
+
 namespace SteamAudio {
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -63,6 +75,23 @@ static FSoftObjectPath GetMaterialAssetForActor(AActor* Actor)
     return nullptr;
 }
 
+/**
+ * Converts a Steam Audio Material asset to a Steam Audio material.
+ */
+static IPLMaterial ConvertMaterial(const USteamAudioMaterial* Material)
+{
+    IPLMaterial SteamAudioMaterial{};
+    SteamAudioMaterial.absorption[0] = Material->AbsorptionLow;
+    SteamAudioMaterial.absorption[1] = Material->AbsorptionMid;
+    SteamAudioMaterial.absorption[2] = Material->AbsorptionHigh;
+    SteamAudioMaterial.scattering = Material->Scattering;
+    SteamAudioMaterial.transmission[0] = Material->TransmissionLow;
+    SteamAudioMaterial.transmission[1] = Material->TransmissionMid;
+    SteamAudioMaterial.transmission[2] = Material->TransmissionHigh;
+
+    return SteamAudioMaterial;
+}
+
 /**
  * Adds a Steam Audio Material asset to the material data being prepared for export.
  */
@@ -86,27 +115,114 @@ static bool ExportMaterial(FSoftObjectPath MaterialAsset, TArray<IPLMaterial>& M
         return false;
     }
 
-    IPLMaterial SteamAudioMaterial{};
-    SteamAudioMaterial.absorption[0] = Material->AbsorptionLow;
-    SteamAudioMaterial.absorption[1] = Material->AbsorptionMid;
-    SteamAudioMaterial.absorption[2] = Material->AbsorptionHigh;
-    SteamAudioMaterial.scattering = Material->Scattering;
-    SteamAudioMaterial.transmission[0] = Material->TransmissionLow;
-    SteamAudioMaterial.transmission[1] = Material->TransmissionMid;
-    SteamAudioMaterial.transmission[2] = Material->TransmissionHigh;
-
-    Materials.Add(SteamAudioMaterial);
+    Materials.Add(ConvertMaterial(Material));
     MaterialIndexForAsset.Add(MaterialAsset.ToString(), Materials.Num() - 1);
 
     return true;
 }
 
 /**
- * Exports a single Static Mesh component.
+ * Returns the index of the LOD to export for a given Static Mesh component.
  */
-static bool ExportStaticMeshComponent(UStaticMeshComponent* StaticMeshComponent, TArray<IPLVector3>& Vertices,
-    TArray<IPLTriangle>& Triangles, TArray<int>& MaterialIndices, TArray<IPLMaterial>& Materials,
-    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions = true)
+static int32 GetExportLODIndex(UStaticMeshComponent* StaticMeshComponent, const USteamAudioSettings* SteamAudioSettings)
+{
+    int32 MinLODForExport = SteamAudioSettings->MinLODForExport;
+    auto StaticMeshRenderData = StaticMeshComponent->GetStaticMesh()->GetRenderData();
+    return StaticMeshRenderData->LODResources.Num() - 1 >= MinLODForExport ? MinLODForExport : StaticMeshRenderData->LODResources.Num() - 1;
+}
+
+/**
+ * Returns a reference to the Steam Audio Material asset to use for a given Static Mesh component. ActorMaterialAsset
+ * is the result of GetMaterialAssetForActor for the component's owner.
+ */
+static FSoftObjectPath GetMaterialAssetForComponent(UStaticMeshComponent* StaticMeshComponent,
+    const FSoftObjectPath& ActorMaterialAsset, const USteamAudioSettings* SteamAudioSettings)
+{
+    if (ActorMaterialAsset.IsValid())
+        return ActorMaterialAsset;
+
+    auto BodyInstance = StaticMeshComponent->GetBodyInstance();
+    auto PhysicsMappedMaterial = BodyInstance ? SteamAudioSettings->PhysMatToSteamAudioMatTable.Find(BodyInstance->GetSimplePhysicalMaterial()) : nullptr;
+    return PhysicsMappedMaterial ? PhysicsMappedMaterial->SteamAudioMaterial : SteamAudioSettings->DefaultMeshMaterial;
+}
+
+/**
+ * Everything needed to extract the geometry of a single Static Mesh component. Gathered on the game thread, so that
+ * the extraction itself doesn't touch any UObjects and can run in parallel across components.
+ */
+struct FStaticMeshComponentExport
+{
+    const FStaticMeshLODResources* LODModel;
+
+    /** Maps mesh-space positions directly to Steam Audio coordinates, including the component transform if the
+        positions are exported in world space. Row vector convention. */
+    float Transform[4][4];
+
+    int MaterialIndex;
+    int32 NumVertices;
+    int32 NumTriangles;
+
+    /** Offsets into the output arrays, assigned just before extraction. */
+    int32 FirstVertex;
+    int32 FirstTriangle;
+};
+
+/**
+ * Fills in the matrix that maps mesh-space positions of the given component to Steam Audio coordinates.
+ */
+static void GetExportTransform(UStaticMeshComponent* StaticMeshComponent, bool bRelativePositions, float (&Transform)[4][4])
+{
+    // The same axis swap and unit scale as ConvertVector, as a matrix.
+    IPLVector3 AxisX = ConvertVector(FVector(1.0, 0.0, 0.0));
+    IPLVector3 AxisY = ConvertVector(FVector(0.0, 1.0, 0.0));
+    IPLVector3 AxisZ = ConvertVector(FVector(0.0, 0.0, 1.0));
+    FMatrix Matrix(FPlane(AxisX.x, AxisX.y, AxisX.z, 0.0), FPlane(AxisY.x, AxisY.y, AxisY.z, 0.0),
+        FPlane(AxisZ.x, AxisZ.y, AxisZ.z, 0.0), FPlane(0.0, 0.0, 0.0, 1.0));
+
+    if (bRelativePositions)
+    {
+        Matrix = StaticMeshComponent->GetComponentTransform().ToMatrixWithScale() * Matrix;
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+        {
+            Transform[i][j] = static_cast<float>(Matrix.M[i][j]);
+        }
+    }
+}
+
+/**
+ * Transforms every position in a vertex buffer, using one SIMD multiply-add per matrix row.
+ */
+static void TransformVertexPositions(const FPositionVertexBuffer& VertexBuffer, const float (&Transform)[4][4],
+    IPLVector3* OutVertices)
+{
+    const VectorRegister4Float Row0 = VectorLoad(Transform[0]);
+    const VectorRegister4Float Row1 = VectorLoad(Transform[1]);
+    const VectorRegister4Float Row2 = VectorLoad(Transform[2]);
+    const VectorRegister4Float Row3 = VectorLoad(Transform[3]);
+
+    const uint32 NumVertices = VertexBuffer.GetNumVertices();
+    for (uint32 i = 0; i < NumVertices; ++i)
+    {
+        const auto& Position = VertexBuffer.VertexPosition(i);
+
+        VectorRegister4Float Result = VectorMultiplyAdd(VectorSetFloat1(Position.X), Row0, Row3);
+        Result = VectorMultiplyAdd(VectorSetFloat1(Position.Y), Row1, Result);
+        Result = VectorMultiplyAdd(VectorSetFloat1(Position.Z), Row2, Result);
+
+        VectorStoreFloat3(Result, &OutVertices[i].x);
+    }
+}
+
+/**
+ * Gathers the data needed to extract the geometry of a single Static Mesh component, using a material that has already
+ * been added to the material data being prepared for export. Must be called from the game thread.
+ */
+static void GatherStaticMeshGeometry(UStaticMeshComponent* StaticMeshComponent, int MaterialIndex,
+    const USteamAudioSettings* SteamAudioSettings, bool bRelativePositions, TArray<FStaticMeshComponentExport>& Exports)
 {
     check(StaticMeshComponent);
     check(StaticMeshComponent->GetStaticMesh());
@@ -115,34 +231,53 @@ static bool ExportStaticMeshComponent(UStaticMeshComponent* StaticMeshComponent,
 #if WITH_EDITOR
     StaticMeshComponent->GetStaticMesh()->bAllowCPUAccess = true; // Used to update iplStaticMesh in Runime in the build
 #endif
-    int32 MinLODForExport = GetDefault<USteamAudioSettings>()->MinLODForExport;
     auto StaticMeshRenderData = StaticMeshComponent->GetStaticMesh()->GetRenderData();
-    int32 ResultLODIndex = StaticMeshRenderData->LODResources.Num() - 1 >= MinLODForExport ? MinLODForExport : StaticMeshRenderData->LODResources.Num() - 1;
-    FStaticMeshLODResources& LODModel = StaticMeshRenderData->LODResources[ResultLODIndex];
+    const FStaticMeshLODResources& LODModel = StaticMeshRenderData->LODResources[GetExportLODIndex(StaticMeshComponent, SteamAudioSettings)];
     check(LODModel.GetNumVertices() > 0 && LODModel.GetNumTriangles() > 0);
 
-    int StartVertexIndex = Vertices.Num();
-
-    const FPositionVertexBuffer& VertexBuffer = LODModel.VertexBuffers.PositionVertexBuffer;
-    for (int i = 0; i < LODModel.GetNumVertices(); ++i)
+    FStaticMeshComponentExport& Export = Exports.AddDefaulted_GetRef();
+    Export.LODModel = &LODModel;
+    GetExportTransform(StaticMeshComponent, bRelativePositions, Export.Transform);
+    Export.MaterialIndex = MaterialIndex;
+    Export.NumVertices = LODModel.GetNumVertices();
+    Export.NumTriangles = 0;
+    for (const FStaticMeshSection& Section : LODModel.Sections)
     {
-#if ((ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 0) || (ENGINE_MAJOR_VERSION > 5))
-        FVector Vertex{};
-        Vertex.X = VertexBuffer.VertexPosition(i).X;
-        Vertex.Y = VertexBuffer.VertexPosition(i).Y;
-        Vertex.Z = VertexBuffer.VertexPosition(i).Z;
-#else
-        FVector Vertex = VertexBuffer.VertexPosition(i);
-#endif
+        Export.NumTriangles += Section.NumTriangles;
+    }
+}
 
-        if (bRelativePositions)
-        {
-            Vertex = StaticMeshComponent->GetComponentTransform().TransformPosition(Vertex);
-        }
+/**
+ * Gathers the data needed to export a single Static Mesh component, and adds its material to the material data being
+ * prepared for export. Must be called from the game thread.
+ */
+static bool GatherStaticMeshComponent(UStaticMeshComponent* StaticMeshComponent, const FSoftObjectPath& ActorMaterialAsset,
+    bool bWantToChangeMaterialAtRuntime, const USteamAudioSettings* SteamAudioSettings, TArray<IPLMaterial>& Materials,
+    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions, TArray<FStaticMeshComponentExport>& Exports)
+{
+    FSoftObjectPath MaterialAsset = GetMaterialAssetForComponent(StaticMeshComponent, ActorMaterialAsset, SteamAudioSettings);
+    if (!ExportMaterial(MaterialAsset, Materials, MaterialIndexForAsset, bWantToChangeMaterialAtRuntime))
+        return false;
 
-        Vertices.Add(SteamAudio::ConvertVector(Vertex));
-    }
+    check(MaterialIndexForAsset.Contains(MaterialAsset.ToString()));
+
+    GatherStaticMeshGeometry(StaticMeshComponent, MaterialIndexForAsset[MaterialAsset.ToString()], SteamAudioSettings,
+        bRelativePositions, Exports);
+
+    return true;
+}
+
+/**
+ * Extracts the geometry of a single Static Mesh component into its slice of the output arrays.
+ */
+static void ExtractStaticMeshComponent(const FStaticMeshComponentExport& Export, IPLVector3* Vertices,
+    IPLTriangle* Triangles, int* MaterialIndices)
+{
+    const FStaticMeshLODResources& LODModel = *Export.LODModel;
+
+    TransformVertexPositions(LODModel.VertexBuffers.PositionVertexBuffer, Export.Transform, Vertices + Export.FirstVertex);
 
+    IPLTriangle* Triangle = Triangles + Export.FirstTriangle;
     FIndexArrayView Indices = LODModel.IndexBuffer.GetArrayView();
     for (const FStaticMeshSection& Section : LODModel.Sections)
     {
@@ -151,49 +286,154 @@ static bool ExportStaticMeshComponent(UStaticMeshComponent* StaticMeshComponent,
             int BaseIndex = Section.FirstIndex + i * 3;
 
             // todo: clarify why the triangle order is flipped here
-            IPLTriangle Triangle{};
-            Triangle.indices[0] = StartVertexIndex + Indices[BaseIndex + 0];
-            Triangle.indices[1] = StartVertexIndex + Indices[BaseIndex + 2];
-            Triangle.indices[2] = StartVertexIndex + Indices[BaseIndex + 1];
-
-            Triangles.Add(Triangle);
+            Triangle->indices[0] = Export.FirstVertex + Indices[BaseIndex + 0];
+            Triangle->indices[1] = Export.FirstVertex + Indices[BaseIndex + 2];
+            Triangle->indices[2] = Export.FirstVertex + Indices[BaseIndex + 1];
+            ++Triangle;
         }
     }
 
-    FSoftObjectPath MaterialAsset = GetMaterialAssetForActor(StaticMeshComponent->GetOwner());
-    if (!MaterialAsset.IsValid())
+    int* MaterialIndex = MaterialIndices + Export.FirstTriangle;
+    for (int32 i = 0; i < Export.NumTriangles; ++i)
     {
-        auto SteamAudioSettings = GetDefault<USteamAudioSettings>();
-        auto BodyInstance = StaticMeshComponent->GetBodyInstance();
-        auto PhysicsMappedMaterial = BodyInstance ? SteamAudioSettings->PhysMatToSteamAudioMatTable.Find(BodyInstance->GetSimplePhysicalMaterial()) : nullptr;
-        MaterialAsset = PhysicsMappedMaterial ? PhysicsMappedMaterial->SteamAudioMaterial : SteamAudioSettings->DefaultMeshMaterial;
+        MaterialIndex[i] = Export.MaterialIndex;
     }
+}
 
-    USteamAudioGeometryComponent* GeometryComponent = StaticMeshComponent->GetOwner()->FindComponentByClass<USteamAudioGeometryComponent>();
-    if (!ExportMaterial(MaterialAsset, Materials, MaterialIndexForAsset, GeometryComponent ? GeometryComponent->bWantToChangeMaterialAtRuntime : false))
-        return false;
+/**
+ * Appends the geometry of every gathered Static Mesh component to the output arrays. The arrays are sized once up
+ * front, and each component then fills in its own slice in parallel (or one after another, if bParallel is false).
+ */
+static void ExtractStaticMeshComponents(TArrayView<FStaticMeshComponentExport> Exports, TArray<IPLVector3>& Vertices,
+    TArray<IPLTriangle>& Triangles, TArray<int>& MaterialIndices, bool bParallel = true)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SteamAudioExtractStaticMeshComponents);
 
-    check(MaterialIndexForAsset.Contains(MaterialAsset.ToString()));
-    int MaterialIndex = MaterialIndexForAsset[MaterialAsset.ToString()];
-    for (int i = 0; i < LODModel.GetNumTriangles(); ++i)
+    check(Triangles.Num() == MaterialIndices.Num());
+
+    int32 NumVertices = Vertices.Num();
+    int32 NumTriangles = Triangles.Num();
+    for (FStaticMeshComponentExport& Export : Exports)
     {
-        MaterialIndices.Add(MaterialIndex);
+        Export.FirstVertex = NumVertices;
+        Export.FirstTriangle = NumTriangles;
+        NumVertices += Export.NumVertices;
+        NumTriangles += Export.NumTriangles;
     }
 
-    return true;
+    Vertices.AddUninitialized(NumVertices - Vertices.Num());
+    Triangles.AddUninitialized(NumTriangles - Triangles.Num());
+    MaterialIndices.AddUninitialized(NumTriangles - MaterialIndices.Num());
+
+    IPLVector3* VertexData = Vertices.GetData();
+    IPLTriangle* TriangleData = Triangles.GetData();
+    int* MaterialIndexData = MaterialIndices.GetData();
+
+    ParallelFor(Exports.Num(), [&](int32 Index)
+    {
+        ExtractStaticMeshComponent(Exports[Index], VertexData, TriangleData, MaterialIndexData);
+    }, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+/**
+ * Geometry for a Static Mesh that is used several times in a level. Exported once in local space, and placed using one
+ * instance per use.
+ */
+struct FSharedStaticMeshExport
+{
+    TArray<IPLVector3> Vertices;
+    TArray<IPLTriangle> Triangles;
+    TArray<int> MaterialIndices;
+    TArray<IPLMaterial> Materials;
+    TArray<FTransform> InstanceTransforms;
+};
+
+/** Identifies geometry that can be shared: the same mesh, exported at the same LOD, with the same material. */
+typedef TTuple<UStaticMesh*, int32, FString> FSharedStaticMeshKey;
+
+/**
+ * Tracks Static Mesh components that use the same geometry while a list of actors is being exported.
+ */
+struct FStaticMeshInstancing
+{
+    /** Geometry used at least this many times is shared. */
+    int32 MinInstances;
+
+    /** Number of components using each piece of geometry. */
+    TMap<FSharedStaticMeshKey, int32> NumUses;
+
+    /** Index into SharedMeshes for each piece of geometry that has been gathered so far. */
+    TMap<FSharedStaticMeshKey, int32> SharedMeshIndices;
+
+    TArray<FSharedStaticMeshExport> SharedMeshes;
+
+    /** One entry per element of SharedMeshes. */
+    TArray<FStaticMeshComponentExport> Exports;
+};
+
+/**
+ * Returns the key used to detect Static Mesh components that can share geometry.
+ */
+static FSharedStaticMeshKey GetSharedStaticMeshKey(UStaticMeshComponent* StaticMeshComponent,
+    const FSoftObjectPath& ActorMaterialAsset, const USteamAudioSettings* SteamAudioSettings)
+{
+    return MakeTuple(StaticMeshComponent->GetStaticMesh(), GetExportLODIndex(StaticMeshComponent, SteamAudioSettings),
+        GetMaterialAssetForComponent(StaticMeshComponent, ActorMaterialAsset, SteamAudioSettings).ToString());
+}
+
+/**
+ * Counts the uses of each piece of geometry in the given list of actors. Actors whose material can change at runtime
+ * are left out, since they need their own entry in the level's material list.
+ */
+static void CountStaticMeshUses(const TArray<AActor*>& Actors, FStaticMeshInstancing& Instancing)
+{
+    const USteamAudioSettings* SteamAudioSettings = GetDefault<USteamAudioSettings>();
+
+    for (AActor* Actor : Actors)
+    {
+        AStaticMeshActor* StaticMeshActor = Cast<AStaticMeshActor>(Actor);
+        if (!StaticMeshActor)
+            continue;
+
+        USteamAudioGeometryComponent* GeometryComponent = Actor->FindComponentByClass<USteamAudioGeometryComponent>();
+        if (GeometryComponent && GeometryComponent->bWantToChangeMaterialAtRuntime)
+            continue;
+
+        FSoftObjectPath ActorMaterialAsset = GetMaterialAssetForActor(Actor);
+
+        TInlineComponentArray<UStaticMeshComponent*> StaticMeshComponents;
+        StaticMeshActor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
+
+        for (UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+        {
+            UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
+            if (!StaticMesh || !StaticMesh->HasValidRenderData())
+                continue;
+
+            Instancing.NumUses.FindOrAdd(GetSharedStaticMeshKey(StaticMeshComponent, ActorMaterialAsset, SteamAudioSettings))++;
+        }
+    }
 }
 
 /**
- * Exports a single Static Mesh actor.
+ * Gathers the data needed to export every Static Mesh component of a single Static Mesh actor. If Instancing is not
+ * null, components whose geometry is used often enough are added to the shared geometry instead.
  *
  * todo: what if static mesh components are attached to arbitrary actors (instead of static mesh actors)?
  */
-static bool ExportStaticMeshComponentsForActor(AStaticMeshActor* StaticMeshActor, TArray<IPLVector3>& Vertices,
-    TArray<IPLTriangle>& Triangles, TArray<int>& MaterialIndices, TArray<IPLMaterial>& Materials,
-    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions = true)
+static bool GatherStaticMeshComponentsForActor(AStaticMeshActor* StaticMeshActor,
+    USteamAudioGeometryComponent* GeometryComponent, TArray<IPLMaterial>& Materials,
+    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions, TArray<FStaticMeshComponentExport>& Exports,
+    FStaticMeshInstancing* Instancing = nullptr)
 {
     check(StaticMeshActor);
 
+    SCOPE_CYCLE_COUNTER(STAT_SteamAudioGatherStaticMeshComponents);
+
+    const USteamAudioSettings* SteamAudioSettings = GetDefault<USteamAudioSettings>();
+    FSoftObjectPath ActorMaterialAsset = GetMaterialAssetForActor(StaticMeshActor);
+    bool bWantToChangeMaterialAtRuntime = GeometryComponent ? GeometryComponent->bWantToChangeMaterialAtRuntime : false;
+
     TInlineComponentArray<UStaticMeshComponent*> StaticMeshComponents;
     StaticMeshActor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
 
@@ -203,8 +443,35 @@ static bool ExportStaticMeshComponentsForActor(AStaticMeshActor* StaticMeshActor
         if (!StaticMesh || !StaticMesh->HasValidRenderData())
             return false;
 
-        if (!ExportStaticMeshComponent(StaticMeshComponent, Vertices, Triangles, MaterialIndices, Materials, MaterialIndexForAsset, bRelativePositions))
+        if (Instancing && !bWantToChangeMaterialAtRuntime)
+        {
+            FSharedStaticMeshKey Key = GetSharedStaticMeshKey(StaticMeshComponent, ActorMaterialAsset, SteamAudioSettings);
+            if (Instancing->NumUses.FindRef(Key) >= Instancing->MinInstances)
+            {
+                int32* SharedMeshIndex = Instancing->SharedMeshIndices.Find(Key);
+                if (!SharedMeshIndex)
+                {
+                    FSharedStaticMeshExport& SharedMesh = Instancing->SharedMeshes.AddDefaulted_GetRef();
+                    TMap<FString, int> SharedMaterialIndexForAsset;
+                    if (!GatherStaticMeshComponent(StaticMeshComponent, ActorMaterialAsset, false, SteamAudioSettings,
+                        SharedMesh.Materials, SharedMaterialIndexForAsset, false, Instancing->Exports))
+                    {
+                        return false;
+                    }
+
+                    SharedMeshIndex = &Instancing->SharedMeshIndices.Add(Key, Instancing->SharedMeshes.Num() - 1);
+                }
+
+                Instancing->SharedMeshes[*SharedMeshIndex].InstanceTransforms.Add(StaticMeshComponent->GetComponentTransform());
+                continue;
+            }
+        }
+
+        if (!GatherStaticMeshComponent(StaticMeshComponent, ActorMaterialAsset, bWantToChangeMaterialAtRuntime,
+            SteamAudioSettings, Materials, MaterialIndexForAsset, bRelativePositions, Exports))
+        {
             return false;
+        }
     }
 
     return true;
@@ -280,26 +547,40 @@ static bool ExportLandscapeActor(ALandscape* LandscapeActor, TArray<IPLVector3>&
 #endif
 
 /**
- * Exports every actor in the given list of actors.
+ * Exports every actor in the given list of actors. If SharedMeshes is not null, Static Mesh geometry that is used
+ * often enough (see MinInstancesForSharedGeometry) is exported to it once, instead of once per use.
  *
  * todo: is it safe to assume that only static mesh actors and landscape actors will be exported? what about random
  *       actors with static mesh components?
  */
 static bool ExportActors(const TArray<AActor*>& Actors, TArray<IPLVector3>& Vertices,
     TArray<IPLTriangle>& Triangles, TArray<int>& MaterialIndices, TArray<IPLMaterial>& Materials,
-    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions = true)
+    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions = true,
+    TArray<FSharedStaticMeshExport>* SharedMeshes = nullptr)
 {
+    TArray<FStaticMeshComponentExport> StaticMeshExports;
+
+    TOptional<FStaticMeshInstancing> Instancing;
+    int32 MinInstancesForSharedGeometry = GetDefault<USteamAudioSettings>()->MinInstancesForSharedGeometry;
+    if (SharedMeshes && MinInstancesForSharedGeometry > 0)
+    {
+        Instancing.Emplace();
+        Instancing->MinInstances = MinInstancesForSharedGeometry;
+        CountStaticMeshUses(Actors, *Instancing);
+    }
+
     for (AActor* Actor : Actors)
     {
         if (Actor->IsA<AStaticMeshActor>())
         {
-            if (!ExportStaticMeshComponentsForActor(Cast<AStaticMeshActor>(Actor), Vertices, Triangles, MaterialIndices,
-                Materials, MaterialIndexForAsset, bRelativePositions))
+            USteamAudioGeometryComponent* GeometryComponent = Actor->FindComponentByClass<USteamAudioGeometryComponent>();
+
+            if (!GatherStaticMeshComponentsForActor(Cast<AStaticMeshActor>(Actor), GeometryComponent, Materials,
+                MaterialIndexForAsset, bRelativePositions, StaticMeshExports, Instancing.GetPtrOrNull()))
             {
                 return false;
             }
 
-            USteamAudioGeometryComponent* GeometryComponent = Actor->FindComponentByClass<USteamAudioGeometryComponent>();
             if (GeometryComponent)
             {
                 GeometryComponent->SetExportIndex(Materials.Num() - 1);
@@ -317,6 +598,20 @@ static bool ExportActors(const TArray<AActor*>& Actors, TArray<IPLVector3>& Vert
         }
     }
 
+    ExtractStaticMeshComponents(StaticMeshExports, Vertices, Triangles, MaterialIndices);
+
+    if (Instancing)
+    {
+        ParallelFor(Instancing->SharedMeshes.Num(), [&](int32 Index)
+        {
+            FSharedStaticMeshExport& SharedMesh = Instancing->SharedMeshes[Index];
+            ExtractStaticMeshComponents(MakeArrayView(&Instancing->Exports[Index], 1), SharedMesh.Vertices,
+                SharedMesh.Triangles, SharedMesh.MaterialIndices);
+        });
+
+        *SharedMeshes = MoveTemp(Instancing->SharedMeshes);
+    }
+
     return true;
 }
 
@@ -472,6 +767,84 @@ static void GetActorsForStaticGeometryExport(UWorld* World, ULevel* Level, TArra
     }
 }
 
+bool RunStaticGeometryExportBenchmark(UWorld* World, ULevel* Level, int32 NumRuns, FStaticGeometryExportBenchmarkResult& OutResult)
+{
+    check(IsInGameThread());
+    check(World);
+    check(Level);
+
+    OutResult = FStaticGeometryExportBenchmarkResult();
+    OutResult.GatherTime = TNumericLimits<double>::Max();
+    OutResult.SerialExtractTime = TNumericLimits<double>::Max();
+    OutResult.ParallelExtractTime = TNumericLimits<double>::Max();
+
+    TArray<AActor*> Actors;
+    GetActorsForStaticGeometryExport(World, Level, Actors);
+
+    TArray<IPLVector3> SerialVertices;
+    TArray<IPLTriangle> SerialTriangles;
+    TArray<int> SerialMaterialIndices;
+
+    // Keep the best time of each, so a one-off stall doesn't skew the comparison.
+    for (int32 Run = 0; Run < FMath::Max(NumRuns, 1); ++Run)
+    {
+        for (bool bParallel : { false, true })
+        {
+            TArray<IPLMaterial> Materials;
+            TMap<FString, int> MaterialIndexForAsset;
+            TArray<FStaticMeshComponentExport> Exports;
+
+            double GatherStartTime = FPlatformTime::Seconds();
+
+            for (AActor* Actor : Actors)
+            {
+                AStaticMeshActor* StaticMeshActor = Cast<AStaticMeshActor>(Actor);
+                if (!StaticMeshActor)
+                    continue;
+
+                if (!GatherStaticMeshComponentsForActor(StaticMeshActor,
+                    Actor->FindComponentByClass<USteamAudioGeometryComponent>(), Materials, MaterialIndexForAsset,
+                    true, Exports))
+                {
+                    return false;
+                }
+            }
+
+            double ExtractStartTime = FPlatformTime::Seconds();
+
+            TArray<IPLVector3> Vertices;
+            TArray<IPLTriangle> Triangles;
+            TArray<int> MaterialIndices;
+            ExtractStaticMeshComponents(Exports, Vertices, Triangles, MaterialIndices, bParallel);
+
+            double EndTime = FPlatformTime::Seconds();
+
+            OutResult.GatherTime = FMath::Min(OutResult.GatherTime, (ExtractStartTime - GatherStartTime) * 1000.0);
+            double& ExtractTime = bParallel ? OutResult.ParallelExtractTime : OutResult.SerialExtractTime;
+            ExtractTime = FMath::Min(ExtractTime, (EndTime - ExtractStartTime) * 1000.0);
+
+            OutResult.NumComponents = Exports.Num();
+            OutResult.NumTriangles = Triangles.Num();
+
+            if (!bParallel)
+            {
+                SerialVertices = MoveTemp(Vertices);
+                SerialTriangles = MoveTemp(Triangles);
+                SerialMaterialIndices = MoveTemp(MaterialIndices);
+            }
+            else if (Vertices.Num() != SerialVertices.Num() || Triangles.Num() != SerialTriangles.Num() ||
+                FMemory::Memcmp(Vertices.GetData(), SerialVertices.GetData(), Vertices.Num() * sizeof(IPLVector3)) != 0 ||
+                FMemory::Memcmp(Triangles.GetData(), SerialTriangles.GetData(), Triangles.Num() * sizeof(IPLTriangle)) != 0 ||
+                FMemory::Memcmp(MaterialIndices.GetData(), SerialMaterialIndices.GetData(), MaterialIndices.Num() * sizeof(int)) != 0)
+            {
+                OutResult.bOutputsMatch = false;
+            }
+        }
+    }
+
+    return true;
+}
+
 #if WITH_EDITOR
 
 /**
@@ -501,6 +874,49 @@ static bool DoesDynamicObjectContainActor(USteamAudioDynamicObjectComponent* Dyn
     return false;
 }
 
+/**
+ * Creates a Static Mesh object from a piece of shared geometry, and serializes it.
+ */
+static bool SerializeSharedStaticMesh(IPLContext Context, IPLScene Scene, FSharedStaticMeshExport& SharedMesh, TArray<uint8>& Data)
+{
+    IPLStaticMeshSettings StaticMeshSettings{};
+    StaticMeshSettings.numVertices = SharedMesh.Vertices.Num();
+    StaticMeshSettings.numTriangles = SharedMesh.Triangles.Num();
+    StaticMeshSettings.numMaterials = SharedMesh.Materials.Num();
+    StaticMeshSettings.vertices = SharedMesh.Vertices.GetData();
+    StaticMeshSettings.triangles = SharedMesh.Triangles.GetData();
+    StaticMeshSettings.materialIndices = SharedMesh.MaterialIndices.GetData();
+    StaticMeshSettings.materials = SharedMesh.Materials.GetData();
+
+    IPLStaticMesh StaticMesh = nullptr;
+    IPLerror Status = iplStaticMeshCreate(Scene, &StaticMeshSettings, &StaticMesh);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create static mesh. [%d]"), Status);
+        return false;
+    }
+
+    IPLSerializedObjectSettings SerializedObjectSettings{};
+
+    IPLSerializedObject SerializedObject = nullptr;
+    Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create serialized object. [%d]"), Status);
+        iplStaticMeshRelease(&StaticMesh);
+        return false;
+    }
+
+    iplStaticMeshSave(StaticMesh, SerializedObject);
+
+    Data.SetNum(iplSerializedObjectGetSize(SerializedObject));
+    FMemory::Memcpy(Data.GetData(), iplSerializedObjectGetData(SerializedObject), Data.Num());
+
+    iplSerializedObjectRelease(&SerializedObject);
+    iplStaticMeshRelease(&StaticMesh);
+    return true;
+}
+
 bool DoesLevelHaveStaticGeometryForExport(UWorld* World, ULevel* Level)
 {
     check(World);
@@ -530,6 +946,34 @@ bool DoesLevelHaveStaticGeometryForExport(UWorld* World, ULevel* Level)
     return false;
 }
 
+/** Returns a hash of all the data exported for a level's static geometry. */
+static FString CalcStaticGeometryContentHash(const TArray<IPLVector3>& Vertices, const TArray<IPLTriangle>& Triangles,
+    const TArray<int>& MaterialIndices, const TArray<IPLMaterial>& Materials, const TArray<FSharedStaticMeshExport>& SharedMeshes)
+{
+    FContentHash Hash;
+    Hash.Update(Vertices);
+    Hash.Update(Triangles);
+    Hash.Update(MaterialIndices);
+    Hash.Update(Materials);
+
+    Hash.Update(SharedMeshes.Num());
+    for (const FSharedStaticMeshExport& SharedMesh : SharedMeshes)
+    {
+        Hash.Update(SharedMesh.Vertices);
+        Hash.Update(SharedMesh.Triangles);
+        Hash.Update(SharedMesh.MaterialIndices);
+        Hash.Update(SharedMesh.Materials);
+
+        Hash.Update(SharedMesh.InstanceTransforms.Num());
+        for (const FTransform& InstanceTransform : SharedMesh.InstanceTransforms)
+        {
+            Hash.Update(InstanceTransform);
+        }
+    }
+
+    return Hash.Finalize();
+}
+
 bool ExportStaticGeometryForLevel(UWorld* World, ULevel* Level, FString FileName, bool bExportOBJ /* = false */)
 {
     check(World);
@@ -548,20 +992,43 @@ bool ExportStaticGeometryForLevel(UWorld* World, ULevel* Level, FString FileName
         TArray<IPLMaterial> Materials;
         TMap<FString, int> MaterialIndexForAsset;
         TArray<AActor*> Actors;
-        bool bExportSucceeded = RunInGameThread<bool>([&]()
+        TArray<FSharedStaticMeshExport> SharedMeshes;
+        double ExportStartTime = FPlatformTime::Seconds();
+        auto ExportLevelGeometry = [&](TArray<FSharedStaticMeshExport>* OutSharedMeshes)
         {
-            GetActorsForStaticGeometryExport(World, Level, Actors);
-            if (!ExportActors(Actors, Vertices, Triangles, MaterialIndices, Materials, MaterialIndexForAsset))
-                return false;
-
-            if (GetDefault<USteamAudioSettings>()->bExportBSPGeometry)
+            return RunInGameThread<bool>([&]()
             {
-                if (!ExportBSPGeometry(World, Level, Vertices, Triangles, MaterialIndices, Materials, MaterialIndexForAsset))
+                GetActorsForStaticGeometryExport(World, Level, Actors);
+                if (!ExportActors(Actors, Vertices, Triangles, MaterialIndices, Materials, MaterialIndexForAsset, true, OutSharedMeshes))
                     return false;
-            }
 
-            return true;
-        });
+                if (GetDefault<USteamAudioSettings>()->bExportBSPGeometry)
+                {
+                    if (!ExportBSPGeometry(World, Level, Vertices, Triangles, MaterialIndices, Materials, MaterialIndexForAsset))
+                        return false;
+                }
+
+                return true;
+            });
+        };
+
+        // Instancing only applies to .uasset exports, since a .obj file can only hold flat geometry.
+        bool bExportSucceeded = ExportLevelGeometry(bExportOBJ ? nullptr : &SharedMeshes);
+
+        // Everything that loads level geometry expects at least one triangle outside of the shared meshes, so if all
+        // of the geometry ended up shared, export it without instancing instead.
+        if (bExportSucceeded && Triangles.Num() <= 0 && SharedMeshes.Num() > 0)
+        {
+            Vertices.Empty();
+            MaterialIndices.Empty();
+            Materials.Empty();
+            MaterialIndexForAsset.Empty();
+            Actors.Empty();
+            SharedMeshes.Empty();
+
+            bExportSucceeded = ExportLevelGeometry(nullptr);
+        }
+
         if (!bExportSucceeded)
         {
             Promise.SetValue(false);
@@ -576,6 +1043,39 @@ bool ExportStaticGeometryForLevel(UWorld* World, ULevel* Level, FString FileName
             return;
         }
 
+        int32 NumInstances = 0;
+        for (const FSharedStaticMeshExport& SharedMesh : SharedMeshes)
+        {
+            NumInstances += SharedMesh.InstanceTransforms.Num();
+        }
+
+        UE_LOG(LogSteamAudio, Log, TEXT("Exported static geometry for level %s: %d actors, %d vertices, %d triangles, %d materials, %d shared meshes with %d instances in %.2f ms."),
+            *Level->GetOutermostObject()->GetName(), Actors.Num(), Vertices.Num(), Triangles.Num(), Materials.Num(),
+            SharedMeshes.Num(), NumInstances, (FPlatformTime::Seconds() - ExportStartTime) * 1000.0);
+
+        // If the existing asset was exported from exactly the same geometry, and the level already points to it, there
+        // is nothing to do. Skipping the save also leaves the hashes of probes and baked data that depend on it valid.
+        FString ContentHash;
+        if (!bExportOBJ)
+        {
+            ContentHash = CalcStaticGeometryContentHash(Vertices, Triangles, MaterialIndices, Materials, SharedMeshes);
+
+            bool bUpToDate = RunInGameThread<bool>([&]()
+            {
+                USteamAudioSerializedObject* ExistingAsset = Cast<USteamAudioSerializedObject>(FSoftObjectPath(FileName).TryLoad());
+                ASteamAudioStaticMeshActor* SteamAudioStaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
+
+                return ExistingAsset && ExistingAsset->ContentHash == ContentHash
+                    && SteamAudioStaticMeshActor && SteamAudioStaticMeshActor->Asset == FSoftObjectPath(ExistingAsset);
+            });
+            if (bUpToDate)
+            {
+                UE_LOG(LogSteamAudio, Log, TEXT("Static geometry for level %s is up to date, skipping export."), *Level->GetOutermostObject()->GetName());
+                Promise.SetValue(true);
+                return;
+            }
+        }
+
         FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
         bool bInitializeSucceeded = RunInGameThread<bool>([&]()
         {
@@ -639,10 +1139,34 @@ bool ExportStaticGeometryForLevel(UWorld* World, ULevel* Level, FString FileName
 
             iplStaticMeshSave(StaticMesh, SerializedObject);
 
+            // Serialize each shared mesh, and record where each of its instances is placed.
+            TArray<FSteamAudioSerializedMesh> SerializedSharedMeshes;
+            TArray<FSteamAudioMeshInstance> Instances;
+            for (int32 i = 0; i < SharedMeshes.Num(); ++i)
+            {
+                FSteamAudioSerializedMesh& SerializedSharedMesh = SerializedSharedMeshes.AddDefaulted_GetRef();
+                if (!SerializeSharedStaticMesh(Context, Scene, SharedMeshes[i], SerializedSharedMesh.Data))
+                {
+                    UE_LOG(LogSteamAudio, Error, TEXT("Unable to serialize shared mesh data for level: %s"), *Level->GetOutermostObject()->GetName());
+                    iplSerializedObjectRelease(&SerializedObject);
+                    iplStaticMeshRelease(&StaticMesh);
+                    Manager.ShutDownSteamAudio();
+                    Promise.SetValue(false);
+                    return;
+                }
+
+                for (const FTransform& InstanceTransform : SharedMeshes[i].InstanceTransforms)
+                {
+                    FSteamAudioMeshInstance& Instance = Instances.AddDefaulted_GetRef();
+                    Instance.MeshIndex = i;
+                    Instance.Transform = InstanceTransform;
+                }
+            }
+
             // Save the data in the IPLSerializedObject to the appropriate .uasset file.
             USteamAudioSerializedObject* Asset = RunInGameThread<USteamAudioSerializedObject*>([&]()
             {
-                return USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, FileName);
+                return USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, FileName, SerializedSharedMeshes, Instances, ContentHash);
             });
             if (!Asset)
             {
@@ -920,135 +1444,88 @@ void ExportDynamicObjectRuntime(USteamAudioDynamicObjectComponent* DynamicObject
 // Scene Load/Unload
 // ---------------------------------------------------------------------------------------------------------------------
 
-void UpdateStaticGeometryForLevel(UWorld* World, ULevel* Level, IPLStaticMesh& OldStaticMesh)
+bool GetRuntimeMaterialChange(AActor* RefreshableActor, FSoftObjectPath& OutMaterialAsset, int32& OutExportIndex)
 {
-    check(World);
-    check(Level);
+    check(IsInGameThread());
 
-    Async(EAsyncExecution::Thread, [World, Level, &OldStaticMesh]()
-        {
-            // Start by collecting geometry and material information from the level.
-            TArray<IPLVector3> Vertices;
-            TArray<IPLTriangle> Triangles;
-            TArray<int> MaterialIndices;
-            TArray<IPLMaterial> Materials;
-            TMap<FString, int> MaterialIndexForAsset;
-            TArray<AActor*> Actors;
-            bool bExportSucceeded = RunInGameThread<bool>([&]()
-                {
-                    GetActorsForStaticGeometryExport(World, Level, Actors, true);
-                    if (!ExportActors(Actors, Vertices, Triangles, MaterialIndices, Materials, MaterialIndexForAsset))
-                        return false;
+    if (!RefreshableActor || !RefreshableActor->IsA<AStaticMeshActor>() || !IsSteamAudioGeometry(RefreshableActor) || IsSteamAudioDynamicObject(RefreshableActor))
+        return false;
 
-                    if (GetDefault<USteamAudioSettings>()->bExportBSPGeometry)
-                    {
-                        if (!ExportBSPGeometry(World, Level, Vertices, Triangles, MaterialIndices, Materials, MaterialIndexForAsset))
-                            return false;
-                    }
+    USteamAudioGeometryComponent* GeometryComponent = RefreshableActor->FindComponentByClass<USteamAudioGeometryComponent>();
+    if (!GeometryComponent || !GeometryComponent->bWantToChangeMaterialAtRuntime)
+        return false;
 
-                    return true;
-                });
+    UStaticMeshComponent* StaticMeshComponent = Cast<AStaticMeshActor>(RefreshableActor)->GetStaticMeshComponent();
+    if (!StaticMeshComponent)
+        return false;
 
-            if (!bExportSucceeded)
-                return;
+    OutExportIndex = GeometryComponent->ExportIndex;
 
-            // If we didn't find anything, stop here.
-            if (Vertices.Num() <= 0 || Triangles.Num() <= 0 || MaterialIndices.Num() <= 0 || Materials.Num() <= 0)
-            {
-                UE_LOG(LogSteamAudio, Log, TEXT("No static geometry specified for level: %s"), *Level->GetOutermostObject()->GetName());
-                return;
-            }
+    // Resolved the same way as at export, and in SetMaterials, so a component whose material comes from its physical
+    // material mapping doesn't get the default material instead.
+    OutMaterialAsset = GetMaterialAssetForComponent(StaticMeshComponent, GetMaterialAssetForActor(RefreshableActor),
+        GetDefault<USteamAudioSettings>());
 
-            FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
+    return OutMaterialAsset.IsValid();
+}
 
-            IPLContext Context = Manager.GetContext();
-            IPLScene Scene = Manager.GetScene();
+/**
+ * Copies the data out of a serialized object asset into a temporary buffer, and wraps it in an IPLSerializedObject.
+ * The buffer is freed when the scope ends, so the data is only resident while Steam Audio is loading from it.
+ */
+class FSerializedObjectLoadScope
+{
+public:
+    explicit FSerializedObjectLoadScope(USteamAudioSerializedObject* InAssetObject)
+        : AssetObject(InAssetObject)
+        , StartTime(FPlatformTime::Seconds())
+    {
+        check(AssetObject);
+    }
 
-            // Create a static mesh using all the data gathered from the level.
-            IPLStaticMeshSettings StaticMeshSettings{};
-            StaticMeshSettings.numVertices = Vertices.Num();
-            StaticMeshSettings.numTriangles = Triangles.Num();
-            StaticMeshSettings.numMaterials = Materials.Num();
-            StaticMeshSettings.vertices = Vertices.GetData();
-            StaticMeshSettings.triangles = Triangles.GetData();
-            StaticMeshSettings.materialIndices = MaterialIndices.GetData();
-            StaticMeshSettings.materials = Materials.GetData();
+    ~FSerializedObjectLoadScope()
+    {
+        double LoadTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
 
-            IPLStaticMesh StaticMesh = nullptr;
-            IPLerror Status = iplStaticMeshCreate(Scene, &StaticMeshSettings, &StaticMesh);
-            if (Status != IPL_STATUS_SUCCESS)
-            {
-                UE_LOG(LogSteamAudio, Error, TEXT("Unable to create Steam Audio static mesh for level: %s [%i]"), *Level->GetOutermostObject()->GetName(), Status);
-                Manager.ShutDownSteamAudio();
-                return;
-            }
+        UE_LOG(LogSteamAudio, Log, TEXT("Loaded %s: %lld bytes in %.2f ms."), *AssetObject->GetPathName(), (int64) Buffer.Num(), LoadTime);
 
-            iplStaticMeshAdd(StaticMesh, Scene);
-            iplSceneCommit(Scene);
+        INC_DWORD_STAT(STAT_SteamAudioSerializedObjectsLoaded);
+        INC_FLOAT_STAT_BY(STAT_SteamAudioSerializedObjectLoadTime, (float) LoadTime);
+        DEC_MEMORY_STAT_BY(STAT_SteamAudioSerializedObjectPayload, Buffer.GetAllocatedSize());
+    }
 
-            iplStaticMeshRemove(OldStaticMesh, Scene);
-            iplSceneCommit(Scene);
-            OldStaticMesh = StaticMesh;
-        });
-}
+    /** Reads the data and creates a serialized object from it. The caller must release the serialized object before
+        the scope ends. */
+    IPLSerializedObject Create(IPLContext Context)
+    {
+        if (!AssetObject->CopyData(Buffer))
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to read data from %s."), *AssetObject->GetPathName());
+            return nullptr;
+        }
 
-void UpdateStaticMeshMaterial(UWorld* World, ULevel* Level, IPLStaticMesh StaticMesh, AActor* RefreshableActor)
-{
-    check(World);
-    check(Level);
+        INC_MEMORY_STAT_BY(STAT_SteamAudioSerializedObjectPayload, Buffer.GetAllocatedSize());
 
-    Async(EAsyncExecution::Thread, [World, Level, StaticMesh, RefreshableActor]()
-        {
-            IPLMaterial SteamAudioMaterial;
-            int32 ExportIndex;
-            TArray<AActor*> Actors;
-            bool bExportSucceeded = RunInGameThread<bool>([&]()
-                {
-                    if (RefreshableActor->IsA<AStaticMeshActor>() && !(!IsSteamAudioGeometry(RefreshableActor) || IsSteamAudioDynamicObject(RefreshableActor)))
-                    {
-                        USteamAudioGeometryComponent* GeometryComponent = RefreshableActor->FindComponentByClass<USteamAudioGeometryComponent>();
-                        if (GeometryComponent)
-                        {
-                            if (!GeometryComponent->bWantToChangeMaterialAtRuntime)
-                                return false;
-
-                            ExportIndex = GeometryComponent->ExportIndex;
-                        }
-
-                        FSoftObjectPath MaterialAsset = GetMaterialAssetForActor(RefreshableActor);
-                        if (!MaterialAsset.IsValid())
-                        {
-                            MaterialAsset = GetDefault<USteamAudioSettings>()->DefaultMeshMaterial;
-                        }
-
-                        USteamAudioMaterial* Material = Cast<USteamAudioMaterial>(MaterialAsset.TryLoad());
-                        if (!Material)
-                        {
-                            return false;
-                        }
-
-                        SteamAudioMaterial.absorption[0] = Material->AbsorptionLow;
-                        SteamAudioMaterial.absorption[1] = Material->AbsorptionMid;
-                        SteamAudioMaterial.absorption[2] = Material->AbsorptionHigh;
-                        SteamAudioMaterial.scattering = Material->Scattering;
-                        SteamAudioMaterial.transmission[0] = Material->TransmissionLow;
-                        SteamAudioMaterial.transmission[1] = Material->TransmissionMid;
-                        SteamAudioMaterial.transmission[2] = Material->TransmissionHigh;
-
-                        return true;
-                    }
+        IPLSerializedObjectSettings SerializedObjectSettings{};
+        SerializedObjectSettings.size = Buffer.Num();
+        SerializedObjectSettings.data = Buffer.GetData();
 
-                    return false;
-                });
+        IPLSerializedObject SerializedObject = nullptr;
+        IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create serialized object. [%d]"), Status);
+            return nullptr;
+        }
 
-            if (!bExportSucceeded)
-                return;
+        return SerializedObject;
+    }
 
-            FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
-            iplStaticMeshSetMaterial(StaticMesh, Manager.GetScene(), &SteamAudioMaterial, ExportIndex);
-            iplSceneCommit(Manager.GetScene());
-        });
-}
+private:
+    USteamAudioSerializedObject* AssetObject;
+    TArray<uint8> Buffer;
+    double StartTime;
+};
 
 IPLStaticMesh LoadStaticMeshFromAsset(FSoftObjectPath Asset, IPLContext Context, IPLScene Scene)
 {
@@ -1060,20 +1537,23 @@ IPLStaticMesh LoadStaticMeshFromAsset(FSoftObjectPath Asset, IPLContext Context,
     if (!AssetObject)
         return nullptr;
 
-    IPLSerializedObjectSettings SerializedObjectSettings{};
-    SerializedObjectSettings.size = AssetObject->Data.Num();
-    SerializedObjectSettings.data = AssetObject->Data.GetData();
+    return LoadStaticMeshFromSerializedObject(AssetObject, Context, Scene);
+}
 
-    IPLSerializedObject SerializedObject = nullptr;
-    IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
-    if (Status != IPL_STATUS_SUCCESS)
-    {
-        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create serialized object. [%d]"), Status);
+IPLStaticMesh LoadStaticMeshFromSerializedObject(USteamAudioSerializedObject* AssetObject, IPLContext Context, IPLScene Scene)
+{
+    check(AssetObject);
+    check(Context);
+    check(Scene);
+
+    FSerializedObjectLoadScope LoadScope(AssetObject);
+
+    IPLSerializedObject SerializedObject = LoadScope.Create(Context);
+    if (!SerializedObject)
         return nullptr;
-    }
 
     IPLStaticMesh StaticMesh = nullptr;
-    Status = iplStaticMeshLoad(Scene, SerializedObject, nullptr, nullptr, &StaticMesh);
+    IPLerror Status = iplStaticMeshLoad(Scene, SerializedObject, nullptr, nullptr, &StaticMesh);
     if (Status != IPL_STATUS_SUCCESS)
     {
         UE_LOG(LogSteamAudio, Error, TEXT("Unable to load static mesh from serialized object. [%d]"), Status);
@@ -1085,34 +1565,1213 @@ IPLStaticMesh LoadStaticMeshFromAsset(FSoftObjectPath Asset, IPLContext Context,
     return StaticMesh;
 }
 
+bool LoadInstancedMeshesFromAsset(FSoftObjectPath Asset, IPLContext Context, IPLScene Scene, TArray<IPLInstancedMesh>& InstancedMeshes)
+{
+    check(Asset.IsAsset());
+    check(Context);
+    check(Scene);
+
+    USteamAudioSerializedObject* AssetObject = Cast<USteamAudioSerializedObject>(Asset.TryLoad());
+    if (!AssetObject)
+        return false;
+
+    return LoadInstancedMeshesFromSerializedObject(AssetObject, Context, Scene, InstancedMeshes);
+}
+
+bool LoadInstancedMeshesFromSerializedObject(USteamAudioSerializedObject* AssetObject, IPLContext Context, IPLScene Scene, TArray<IPLInstancedMesh>& InstancedMeshes)
+{
+    check(AssetObject);
+    check(Context);
+    check(Scene);
+
+    FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
+    bool bSucceeded = true;
+
+    // Load each shared mesh into its own sub-scene, the same way dynamic objects are loaded.
+    TArray<IPLScene> SubScenes;
+    for (const FSteamAudioSerializedMesh& SharedMesh : AssetObject->SharedMeshes)
+    {
+        IPLScene SubScene = nullptr;
+        if (!Manager.CreateEmptyScene(SubScene))
+        {
+            bSucceeded = false;
+            break;
+        }
+
+        SubScenes.Add(SubScene);
+
+        IPLSerializedObjectSettings SerializedObjectSettings{};
+        SerializedObjectSettings.size = SharedMesh.Data.Num();
+        SerializedObjectSettings.data = const_cast<uint8*>(SharedMesh.Data.GetData());
+
+        IPLSerializedObject SerializedObject = nullptr;
+        IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create serialized object. [%d]"), Status);
+            bSucceeded = false;
+            break;
+        }
+
+        IPLStaticMesh StaticMesh = nullptr;
+        Status = iplStaticMeshLoad(SubScene, SerializedObject, nullptr, nullptr, &StaticMesh);
+        iplSerializedObjectRelease(&SerializedObject);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to load static mesh from serialized object. [%d]"), Status);
+            bSucceeded = false;
+            break;
+        }
+
+        iplStaticMeshAdd(StaticMesh, SubScene);
+        iplSceneCommit(SubScene);
+        iplStaticMeshRelease(&StaticMesh);
+    }
+
+    TArray<IPLInstancedMesh> LoadedInstancedMeshes;
+    if (bSucceeded)
+    {
+        for (const FSteamAudioMeshInstance& Instance : AssetObject->Instances)
+        {
+            if (!SubScenes.IsValidIndex(Instance.MeshIndex))
+                continue;
+
+            IPLInstancedMeshSettings InstancedMeshSettings{};
+            InstancedMeshSettings.subScene = SubScenes[Instance.MeshIndex];
+            InstancedMeshSettings.transform = ConvertTransform(Instance.Transform);
+
+            IPLInstancedMesh InstancedMesh = nullptr;
+            IPLerror Status = iplInstancedMeshCreate(Scene, &InstancedMeshSettings, &InstancedMesh);
+            if (Status != IPL_STATUS_SUCCESS)
+            {
+                UE_LOG(LogSteamAudio, Error, TEXT("Unable to create instanced mesh. [%d]"), Status);
+                bSucceeded = false;
+                break;
+            }
+
+            LoadedInstancedMeshes.Add(InstancedMesh);
+        }
+    }
+
+    // Each instanced mesh holds its own reference to its sub-scene.
+    for (IPLScene& SubScene : SubScenes)
+    {
+        iplSceneRelease(&SubScene);
+    }
+
+    if (!bSucceeded)
+    {
+        for (IPLInstancedMesh& InstancedMesh : LoadedInstancedMeshes)
+        {
+            iplInstancedMeshRelease(&InstancedMesh);
+        }
+
+        return false;
+    }
+
+    InstancedMeshes.Append(LoadedInstancedMeshes);
+    return true;
+}
+
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Baked Data Load/Unload
+// FStaticGeometryCache
 // ---------------------------------------------------------------------------------------------------------------------
 
-IPLProbeBatch LoadProbeBatchFromAsset(FSoftObjectPath Asset, IPLContext Context)
+FStaticGeometryCache::FStaticGeometryCache(UWorld* InWorld, ULevel* InLevel, IPLScene InScene, IPLStaticMesh InLevelStaticMesh,
+    TArray<IPLInstancedMesh>&& InLevelInstancedMeshes)
+    : World(InWorld)
+    , Level(InLevel)
+    , Scene(iplSceneRetain(InScene))
+    , LevelStaticMesh(InLevelStaticMesh)
+    , LevelInstancedMeshes(MoveTemp(InLevelInstancedMeshes))
+    , bBaseDirty(false)
+    , bUpdateInFlight(false)
+    , bUpdatePending(false)
 {
-    check(Asset.IsValid());
-    check(Context);
+    check(IsInGameThread());
+    check(InWorld);
+    check(InLevel);
+    check(InScene);
 
-    USteamAudioSerializedObject* AssetObject = Cast<USteamAudioSerializedObject>(Asset.TryLoad());
-    if (!AssetObject)
-        return nullptr;
+    FMaterialCache& MaterialCache = FSteamAudioModule::GetManager().GetMaterialCache();
+    const USteamAudioSettings* SteamAudioSettings = GetDefault<USteamAudioSettings>();
 
-    IPLSerializedObjectSettings SerializedObjectSettings{};
-    SerializedObjectSettings.size = AssetObject->Data.Num();
-    SerializedObjectSettings.data = AssetObject->Data.GetData();
+    // Record the state that the level was exported in, so that later changes can be told apart from it. This is the
+    // only time the whole level is scanned; after this, components are only looked at when they are touched.
+    TArray<AActor*> Actors;
+    GetActorsForStaticGeometryExport(InWorld, InLevel, Actors, true);
 
-    IPLSerializedObject SerializedObject = nullptr;
-    IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
-    if (Status != IPL_STATUS_SUCCESS)
+    for (AActor* Actor : Actors)
     {
-        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create serialized object. [%d]"), Status);
-        return nullptr;
+        AStaticMeshActor* StaticMeshActor = Cast<AStaticMeshActor>(Actor);
+        if (!StaticMeshActor)
+            continue;
+
+        TInlineComponentArray<UStaticMeshComponent*> StaticMeshComponents;
+        StaticMeshActor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
+
+        for (UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+        {
+            FComponentState State;
+            if (!GetComponentState(InWorld, StaticMeshComponent, State))
+                continue;
+
+            BaseComponents.Add(StaticMeshComponent, State);
+            TrackComponent(StaticMeshComponent);
+
+            // Start loading the materials needed to rebuild the base now, so that the first change doesn't wait.
+            MaterialCache.Preload(State.MaterialAsset);
+        }
+    }
+
+    MaterialCache.Preload(SteamAudioSettings->DefaultBSPMaterial);
+    MaterialCache.Preload(SteamAudioSettings->DefaultLandscapeMaterial);
+
+    RenderStateDirtyHandle = UActorComponent::MarkRenderStateDirtyEvent.AddRaw(this, &FStaticGeometryCache::OnRenderStateDirty);
+    ActorSpawnedHandle = InWorld->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FStaticGeometryCache::OnActorSpawnedOrDestroyed));
+    ActorDestroyedHandle = InWorld->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateRaw(this, &FStaticGeometryCache::OnActorSpawnedOrDestroyed));
+}
+
+FStaticGeometryCache::~FStaticGeometryCache()
+{
+    UActorComponent::MarkRenderStateDirtyEvent.Remove(RenderStateDirtyHandle);
+
+    UWorld* CurrentWorld = World.Get();
+    if (CurrentWorld)
+    {
+        CurrentWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        CurrentWorld->RemoveOnActorDestroyededHandler(ActorDestroyedHandle); // sic
+    }
+
+    for (const TPair<FComponentKey, FDelegateHandle>& Pair : TransformUpdatedHandles)
+    {
+        UStaticMeshComponent* Component = Pair.Key.ResolveObjectPtr();
+        if (Component)
+        {
+            Component->TransformUpdated.Remove(Pair.Value);
+        }
+    }
+
+    if (MaterialLoadHandle)
+    {
+        MaterialLoadHandle->CancelHandle();
+    }
+
+    // The chunks may still be in use by a simulation, so hand them over to the Steam Audio Manager, which removes
+    // them at its next safe point.
+    TArray<FChunk> ChunksToRemove;
+    Chunks.GenerateValueArray(ChunksToRemove);
+    ChunksToRemove.Add(Base);
+
+    IPLScene TargetScene = Scene;
+    IPLStaticMesh MeshToRemove = LevelStaticMesh;
+    TArray<IPLInstancedMesh> InstancedMeshesToRemove = MoveTemp(LevelInstancedMeshes);
+    FSteamAudioModule::GetManager().EnqueueSceneUpdate([ChunksToRemove, TargetScene, MeshToRemove, InstancedMeshesToRemove]() mutable
+    {
+        for (FChunk& Chunk : ChunksToRemove)
+        {
+            RemoveChunk(Chunk, TargetScene);
+        }
+
+        if (MeshToRemove)
+        {
+            iplStaticMeshRemove(MeshToRemove, TargetScene);
+            iplStaticMeshRelease(&MeshToRemove);
+        }
+
+        for (IPLInstancedMesh& InstancedMesh : InstancedMeshesToRemove)
+        {
+            iplInstancedMeshRemove(InstancedMesh, TargetScene);
+            iplInstancedMeshRelease(&InstancedMesh);
+        }
+
+        iplSceneRelease(&TargetScene);
+    });
+}
+
+void FStaticGeometryCache::Update()
+{
+    check(IsInGameThread());
+
+    if (bUpdateInFlight)
+    {
+        bUpdatePending = true;
+        return;
     }
 
+    if (DirtyComponents.Num() == 0 && !bBaseDirty)
+        return;
+
+    UWorld* CurrentWorld = World.Get();
+    if (!CurrentWorld || !Level.IsValid())
+        return;
+
+    double StartTime = FPlatformTime::Seconds();
+
+    FMaterialCache& MaterialCache = FSteamAudioModule::GetManager().GetMaterialCache();
+    const USteamAudioSettings* SteamAudioSettings = GetDefault<USteamAudioSettings>();
+
+    TSharedPtr<FUpdateBatch, ESPMode::ThreadSafe> Batch = MakeShared<FUpdateBatch, ESPMode::ThreadSafe>();
+    TArray<FSoftObjectPath> LoadingMaterials;
+
+    // One entry per element of Batch->Builds.
+    TArray<FStaticMeshComponentExport> BuildExports;
+
+    TSet<FComponentKey> StillDirty;
+    for (const FComponentKey& Key : DirtyComponents)
+    {
+        UStaticMeshComponent* Component = Key.ResolveObjectPtr();
+
+        FComponentState State;
+        bool bExported = GetComponentState(CurrentWorld, Component, State);
+
+        FComponentState* BaseState = BaseComponents.Find(Key);
+        if (BaseState && bExported && BaseState->Equals(State))
+            continue;
+
+        FChunk* Chunk = Chunks.Find(Key);
+
+        const IPLMaterial* Material = nullptr;
+        if (bExported)
+        {
+            Material = MaterialCache.Find(State.MaterialAsset);
+            if (!Material && MaterialCache.IsLoading(State.MaterialAsset))
+            {
+                // Nothing is split out of the base until its new chunk can be built.
+                LoadingMaterials.Add(State.MaterialAsset);
+                StillDirty.Add(Key);
+                continue;
+            }
+        }
+
+        if (BaseState)
+        {
+            // First change to this component, so its geometry moves out of the base and into its own chunk.
+            BaseComponents.Remove(Key);
+            bBaseDirty = true;
+            ++Batch->NumSplit;
+        }
+        else if (Chunk)
+        {
+            if (!bExported)
+            {
+                Batch->Removals.Add(Key);
+            }
+            else if (Chunk->State.Mesh == State.Mesh && Chunk->State.LODIndex == State.LODIndex)
+            {
+                if (!Chunk->State.Transform.Equals(State.Transform))
+                {
+                    Batch->Moves.Add(TPair<FComponentKey, FTransform>(Key, State.Transform));
+                }
+
+                if (Chunk->State.MaterialAsset != State.MaterialAsset)
+                {
+                    if (Material)
+                    {
+                        Batch->Rematerials.Add(MakeTuple(Key, State.MaterialAsset, *Material));
+                    }
+                    else
+                    {
+                        ++Batch->NumGatherFailures;
+                    }
+                }
+
+                continue;
+            }
+        }
+
+        if (!bExported)
+        {
+            UntrackComponent(Key);
+            continue;
+        }
+
+        if (!Material)
+        {
+            // The material asset can't be loaded.
+            ++Batch->NumGatherFailures;
+            continue;
+        }
+
+        // Export the geometry in local space, and place it using the instanced mesh transform.
+        FChunkBuild& Build = Batch->Builds.AddDefaulted_GetRef();
+        Build.Key = Key;
+        Build.State = State;
+        Build.Materials.Add(*Material);
+        GatherStaticMeshGeometry(Component, 0, SteamAudioSettings, false, BuildExports);
+
+        TrackComponent(Component);
+    }
+
+    DirtyComponents = MoveTemp(StillDirty);
+
+    ParallelFor(BuildExports.Num(), [&](int32 Index)
+    {
+        FChunkBuild& Build = Batch->Builds[Index];
+        ExtractStaticMeshComponents(MakeArrayView(&BuildExports[Index], 1), Build.Vertices, Build.Triangles, Build.MaterialIndices);
+    });
+
+    if (bBaseDirty && GatherBase(*Batch, LoadingMaterials))
+    {
+        bBaseDirty = false;
+    }
+
+    Batch->GatherTime = FPlatformTime::Seconds() - StartTime;
+
+    if (LoadingMaterials.Num() > 0)
+    {
+        // Update again once the materials have loaded, for the changes that had to wait for them.
+        if (MaterialLoadHandle)
+        {
+            MaterialLoadHandle->CancelHandle();
+        }
+
+        TWeakPtr<FStaticGeometryCache, ESPMode::ThreadSafe> WeakCache = AsShared();
+        MaterialLoadHandle = MaterialCache.WhenLoaded(MoveTemp(LoadingMaterials), FStreamableDelegate::CreateLambda([WeakCache]()
+        {
+            TSharedPtr<FStaticGeometryCache, ESPMode::ThreadSafe> Cache = WeakCache.Pin();
+            if (Cache)
+            {
+                Cache->Update();
+            }
+        }));
+    }
+
+    if (Batch->IsEmpty())
+        return;
+
+    bUpdateInFlight = true;
+
+    IPLScene TargetScene = iplSceneRetain(Scene);
+    TWeakPtr<FStaticGeometryCache, ESPMode::ThreadSafe> WeakCache = AsShared();
+    Async(EAsyncExecution::ThreadPool, [WeakCache, Batch, TargetScene]()
+    {
+        double BuildStartTime = FPlatformTime::Seconds();
+
+        for (FChunkBuild& Build : Batch->Builds)
+        {
+            Build.Build(TargetScene);
+        }
+
+        if (Batch->Base && Batch->Base->Triangles.Num() > 0)
+        {
+            Batch->Base->Build(TargetScene);
+        }
+
+        Batch->BuildTime = FPlatformTime::Seconds() - BuildStartTime;
+
+        FSteamAudioModule::GetManager().EnqueueSceneUpdate([WeakCache, Batch, TargetScene]() mutable
+        {
+            TSharedPtr<FStaticGeometryCache, ESPMode::ThreadSafe> Cache = WeakCache.Pin();
+            if (Cache)
+            {
+                Cache->ApplyUpdate(*Batch);
+            }
+            else
+            {
+                for (FChunkBuild& Build : Batch->Builds)
+                {
+                    Build.Release();
+                }
+
+                if (Batch->Base)
+                {
+                    Batch->Base->Release();
+                }
+            }
+
+            iplSceneRelease(&TargetScene);
+        });
+    });
+}
+
+void FStaticGeometryCache::SetMaterials(TArrayView<const FStaticMeshMaterialChange> Changes)
+{
+    check(IsInGameThread());
+
+    const USteamAudioSettings* SteamAudioSettings = GetDefault<USteamAudioSettings>();
+
+    // Retained mesh, its scene, the new material, and the index of the material to replace, for each mesh to update.
+    TArray<TTuple<IPLStaticMesh, IPLScene, IPLMaterial, int32>> Rematerials;
+
+    for (const FStaticMeshMaterialChange& Change : Changes)
+    {
+        if (!Change.Actor)
+            continue;
+
+        FSoftObjectPath ActorMaterialAsset = GetMaterialAssetForActor(Change.Actor);
+
+        TInlineComponentArray<UStaticMeshComponent*> StaticMeshComponents;
+        Change.Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
+
+        bool bInBase = false;
+        for (UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+        {
+            UStaticMesh* Mesh = StaticMeshComponent->GetStaticMesh();
+            if (!Mesh || !Mesh->HasValidRenderData())
+                continue;
+
+            // Components whose material comes from somewhere else, like their physical material, keep it.
+            if (GetMaterialAssetForComponent(StaticMeshComponent, ActorMaterialAsset, SteamAudioSettings) != Change.MaterialAsset)
+                continue;
+
+            FComponentKey Key(StaticMeshComponent);
+
+            // The new material isn't a change to the base's geometry, so the component stays in the base.
+            FComponentState* BaseState = BaseComponents.Find(Key);
+            if (BaseState)
+            {
+                BaseState->MaterialAsset = Change.MaterialAsset;
+                bInBase = true;
+                continue;
+            }
+
+            FChunk* Chunk = Chunks.Find(Key);
+            if (!Chunk || !Chunk->StaticMesh)
+                continue;
+
+            // Every chunk has a single material.
+            Rematerials.Add(MakeTuple(iplStaticMeshRetain(Chunk->StaticMesh), iplSceneRetain(Chunk->SubScene), Change.Material, 0));
+            Chunk->State.MaterialAsset = Change.MaterialAsset;
+        }
+
+        if (!bInBase)
+            continue;
+
+        // Remembered so that it can be applied to the base again whenever the base is rebuilt.
+        BaseMaterials.Add(Change.Actor, Change.Material);
+
+        if (LevelStaticMesh)
+        {
+            Rematerials.Add(MakeTuple(iplStaticMeshRetain(LevelStaticMesh), iplSceneRetain(Scene), Change.Material, Change.ExportIndex));
+        }
+        else if (Base.StaticMesh)
+        {
+            const int32* MaterialIndex = BaseMaterialIndices.Find(Change.Actor);
+            if (MaterialIndex)
+            {
+                Rematerials.Add(MakeTuple(iplStaticMeshRetain(Base.StaticMesh), iplSceneRetain(Base.SubScene), Change.Material, *MaterialIndex));
+            }
+        }
+    }
+
+    if (Rematerials.Num() == 0)
+        return;
+
+    // Materials are read straight from the mesh, so the sub-scenes don't need committing. The manager commits the main
+    // scene once after running this update.
+    FSteamAudioModule::GetManager().EnqueueSceneUpdate([Rematerials = MoveTemp(Rematerials)]() mutable
+    {
+        for (TTuple<IPLStaticMesh, IPLScene, IPLMaterial, int32>& Rematerial : Rematerials)
+        {
+            iplStaticMeshSetMaterial(Rematerial.Get<0>(), Rematerial.Get<1>(), &Rematerial.Get<2>(), Rematerial.Get<3>());
+            iplStaticMeshRelease(&Rematerial.Get<0>());
+            iplSceneRelease(&Rematerial.Get<1>());
+        }
+    });
+}
+
+bool FStaticGeometryCache::FComponentState::Equals(const FComponentState& Other) const
+{
+    return Mesh == Other.Mesh && LODIndex == Other.LODIndex && Transform.Equals(Other.Transform) && MaterialAsset == Other.MaterialAsset;
+}
+
+bool FStaticGeometryCache::GetComponentState(UWorld* InWorld, UStaticMeshComponent* Component, FComponentState& OutState)
+{
+    if (!IsValid(Component) || !Component->IsRegistered() || Component->GetWorld() != InWorld)
+        return false;
+
+    // The same components that GetActorsForStaticGeometryExport picks at runtime.
+    AStaticMeshActor* StaticMeshActor = Cast<AStaticMeshActor>(Component->GetOwner());
+    if (!IsValid(StaticMeshActor) || StaticMeshActor->IsActorBeingDestroyed())
+        return false;
+
+    if (!IsSteamAudioGeometry(StaticMeshActor) || IsSteamAudioDynamicObject(StaticMeshActor))
+        return false;
+
+    UStaticMeshComponent* RootComponent = StaticMeshActor->GetStaticMeshComponent();
+    if (!RootComponent || RootComponent->Mobility == EComponentMobility::Movable)
+        return false;
+
+    UStaticMesh* Mesh = Component->GetStaticMesh();
+    if (!Mesh || !Mesh->HasValidRenderData())
+        return false;
+
+    const USteamAudioSettings* SteamAudioSettings = GetDefault<USteamAudioSettings>();
+
+    OutState.Mesh = Mesh;
+    OutState.LODIndex = GetExportLODIndex(Component, SteamAudioSettings);
+    OutState.Transform = Component->GetComponentTransform();
+    OutState.MaterialAsset = GetMaterialAssetForComponent(Component, GetMaterialAssetForActor(StaticMeshActor), SteamAudioSettings);
+
+    return true;
+}
+
+bool FStaticGeometryCache::GatherBase(FUpdateBatch& Batch, TArray<FSoftObjectPath>& LoadingMaterials)
+{
+    UWorld* CurrentWorld = World.Get();
+    ULevel* CurrentLevel = Level.Get();
+
+    FMaterialCache& MaterialCache = FSteamAudioModule::GetManager().GetMaterialCache();
+    const USteamAudioSettings* SteamAudioSettings = GetDefault<USteamAudioSettings>();
+
+    // BSP and landscape geometry are exported with a default material, which must already be loaded so that exporting
+    // them doesn't block on the load.
+    TArray<FSoftObjectPath> DefaultMaterialAssets;
+    if (SteamAudioSettings->bExportBSPGeometry)
+    {
+        DefaultMaterialAssets.Add(SteamAudioSettings->DefaultBSPMaterial);
+    }
+
+#if WITH_EDITOR
+    TArray<AActor*> Landscapes;
+    if (SteamAudioSettings->bExportLandscapeGeometry)
+    {
+        for (TActorIterator<ALandscape> It(CurrentWorld); It; ++It)
+        {
+            if (It->GetLevel() == CurrentLevel && IsSteamAudioGeometry(*It) && !IsSteamAudioDynamicObject(*It))
+            {
+                Landscapes.Add(*It);
+            }
+        }
+    }
+
+    if (Landscapes.Num() > 0)
+    {
+        DefaultMaterialAssets.Add(SteamAudioSettings->DefaultLandscapeMaterial);
+    }
+#endif
+
+    bool bMaterialsReady = true;
+    for (const FSoftObjectPath& MaterialAsset : DefaultMaterialAssets)
+    {
+        if (!MaterialCache.Find(MaterialAsset))
+        {
+            if (MaterialCache.IsLoading(MaterialAsset))
+            {
+                LoadingMaterials.Add(MaterialAsset);
+            }
+
+            bMaterialsReady = false;
+        }
+    }
+
+    FChunkBuild Build;
+    TMap<FString, int> MaterialIndexForAsset;
+    TArray<FStaticMeshComponentExport> Exports;
+
+    for (const TPair<FComponentKey, FComponentState>& Pair : BaseComponents)
+    {
+        UStaticMeshComponent* Component = Pair.Key.ResolveObjectPtr();
+
+        // Removed components are dirty, and are dropped from the base by the next update.
+        FComponentState State;
+        if (!GetComponentState(CurrentWorld, Component, State))
+            continue;
+
+        const IPLMaterial* Material = MaterialCache.Find(State.MaterialAsset);
+        if (!Material)
+        {
+            if (MaterialCache.IsLoading(State.MaterialAsset))
+            {
+                LoadingMaterials.Add(State.MaterialAsset);
+            }
+
+            bMaterialsReady = false;
+            continue;
+        }
+
+        if (!bMaterialsReady)
+            continue;
+
+        AActor* Actor = Component->GetOwner();
+        USteamAudioGeometryComponent* GeometryComponent = Actor->FindComponentByClass<USteamAudioGeometryComponent>();
+
+        int MaterialIndex = 0;
+        if (GeometryComponent && GeometryComponent->bWantToChangeMaterialAtRuntime)
+        {
+            // The actor gets its own material, so that changing it doesn't affect anything else.
+            int32* ActorMaterialIndex = Batch.BaseMaterialIndices.Find(Actor);
+            if (!ActorMaterialIndex)
+            {
+                const IPLMaterial* BaseMaterial = BaseMaterials.Find(Actor);
+                Build.Materials.Add(BaseMaterial ? *BaseMaterial : *Material);
+                ActorMaterialIndex = &Batch.BaseMaterialIndices.Add(Actor, Build.Materials.Num() - 1);
+            }
+
+            MaterialIndex = *ActorMaterialIndex;
+        }
+        else
+        {
+            int* AssetMaterialIndex = MaterialIndexForAsset.Find(State.MaterialAsset.ToString());
+            if (!AssetMaterialIndex)
+            {
+                Build.Materials.Add(*Material);
+                AssetMaterialIndex = &MaterialIndexForAsset.Add(State.MaterialAsset.ToString(), Build.Materials.Num() - 1);
+            }
+
+            MaterialIndex = *AssetMaterialIndex;
+        }
+
+        GatherStaticMeshGeometry(Component, MaterialIndex, SteamAudioSettings, true, Exports);
+    }
+
+    if (!bMaterialsReady)
+        return false;
+
+#if WITH_EDITOR
+    if (!ExportActors(Landscapes, Build.Vertices, Build.Triangles, Build.MaterialIndices, Build.Materials, MaterialIndexForAsset))
+        return false;
+#endif
+
+    if (SteamAudioSettings->bExportBSPGeometry)
+    {
+        if (!ExportBSPGeometry(CurrentWorld, CurrentLevel, Build.Vertices, Build.Triangles, Build.MaterialIndices, Build.Materials, MaterialIndexForAsset))
+            return false;
+    }
+
+    ExtractStaticMeshComponents(Exports, Build.Vertices, Build.Triangles, Build.MaterialIndices);
+
+    Batch.Base.Emplace(MoveTemp(Build));
+    return true;
+}
+
+void FStaticGeometryCache::ApplyUpdate(FUpdateBatch& Batch)
+{
+    for (const FComponentKey& Key : Batch.Removals)
+    {
+        FChunk Chunk;
+        if (Chunks.RemoveAndCopyValue(Key, Chunk))
+        {
+            RemoveChunk(Chunk, Scene);
+        }
+    }
+
+    int32 NumRebuilt = 0;
+    int32 NumFailed = Batch.NumGatherFailures;
+    for (FChunkBuild& Build : Batch.Builds)
+    {
+        if (!Build.InstancedMesh)
+        {
+            // Failed builds have no chunk, so they are tried again on the next update.
+            DirtyComponents.Add(Build.Key);
+            ++NumFailed;
+            continue;
+        }
+
+        FChunk& Chunk = Chunks.FindOrAdd(Build.Key);
+        RemoveChunk(Chunk, Scene);
+
+        Chunk.State = Build.State;
+        Chunk.SubScene = Build.SubScene;
+        Chunk.StaticMesh = Build.StaticMesh;
+        Chunk.InstancedMesh = Build.InstancedMesh;
+
+        Build.SubScene = nullptr;
+        Build.StaticMesh = nullptr;
+        Build.InstancedMesh = nullptr;
+
+        iplInstancedMeshAdd(Chunk.InstancedMesh, Scene);
+        ++NumRebuilt;
+    }
+
+    for (const TPair<FComponentKey, FTransform>& Move : Batch.Moves)
+    {
+        FChunk* Chunk = Chunks.Find(Move.Key);
+        if (Chunk)
+        {
+            iplInstancedMeshUpdateTransform(Chunk->InstancedMesh, Scene, ConvertTransform(Move.Value));
+            Chunk->State.Transform = Move.Value;
+        }
+    }
+
+    for (TTuple<FComponentKey, FSoftObjectPath, IPLMaterial>& Rematerial : Batch.Rematerials)
+    {
+        FChunk* Chunk = Chunks.Find(Rematerial.Get<0>());
+        if (Chunk)
+        {
+            // Every chunk has a single material.
+            iplStaticMeshSetMaterial(Chunk->StaticMesh, Chunk->SubScene, &Rematerial.Get<2>(), 0);
+            Chunk->State.MaterialAsset = Rematerial.Get<1>();
+        }
+    }
+
+    if (Batch.Base)
+    {
+        FChunkBuild& NewBase = *Batch.Base;
+        if (NewBase.InstancedMesh || NewBase.Triangles.Num() == 0)
+        {
+            // The new base no longer has the geometry of the components that were split out of it.
+            RemoveChunk(Base, Scene);
+
+            if (LevelStaticMesh)
+            {
+                iplStaticMeshRemove(LevelStaticMesh, Scene);
+                iplStaticMeshRelease(&LevelStaticMesh);
+            }
+
+            for (IPLInstancedMesh& InstancedMesh : LevelInstancedMeshes)
+            {
+                iplInstancedMeshRemove(InstancedMesh, Scene);
+                iplInstancedMeshRelease(&InstancedMesh);
+            }
+
+            LevelInstancedMeshes.Empty();
+
+            Base.SubScene = NewBase.SubScene;
+            Base.StaticMesh = NewBase.StaticMesh;
+            Base.InstancedMesh = NewBase.InstancedMesh;
+
+            NewBase.SubScene = nullptr;
+            NewBase.StaticMesh = nullptr;
+            NewBase.InstancedMesh = nullptr;
+
+            if (Base.InstancedMesh)
+            {
+                iplInstancedMeshAdd(Base.InstancedMesh, Scene);
+            }
+
+            BaseMaterialIndices = MoveTemp(Batch.BaseMaterialIndices);
+        }
+        else
+        {
+            // Keep the previous base, which still has the split-out components' old geometry, until it can be rebuilt.
+            UE_LOG(LogSteamAudio, Warning, TEXT("Unable to rebuild the static geometry base; keeping the previous one until the next update."));
+            bBaseDirty = true;
+        }
+    }
+
+    bUpdateInFlight = false;
+
+    SET_DWORD_STAT(STAT_SteamAudioStaticGeometryChunks, Chunks.Num());
+    SET_DWORD_STAT(STAT_SteamAudioStaticGeometryChunksRebuilt, NumRebuilt);
+    SET_FLOAT_STAT(STAT_SteamAudioStaticGeometryGatherTime, Batch.GatherTime * 1000.0);
+    SET_FLOAT_STAT(STAT_SteamAudioStaticGeometryBuildTime, Batch.BuildTime * 1000.0);
+
+    UE_LOG(LogSteamAudio, Log, TEXT("Static geometry update: %d chunks, %d split from the base, %d rebuilt, %d failed, %d moved, %d rematerialed, %d removed, %s, gather %.2f ms, build %.2f ms."),
+        Chunks.Num(), Batch.NumSplit, NumRebuilt, NumFailed, Batch.Moves.Num(), Batch.Rematerials.Num(), Batch.Removals.Num(),
+        Batch.Base ? TEXT("base rebuilt") : TEXT("base unchanged"), Batch.GatherTime * 1000.0, Batch.BuildTime * 1000.0);
+
+    // Scene updates may be applied off the game thread during shutdown, so re-run deferred updates from there.
+    if (bUpdatePending)
+    {
+        bUpdatePending = false;
+
+        TWeakPtr<FStaticGeometryCache, ESPMode::ThreadSafe> WeakCache = AsShared();
+        AsyncTask(ENamedThreads::GameThread, [WeakCache]()
+        {
+            TSharedPtr<FStaticGeometryCache, ESPMode::ThreadSafe> Cache = WeakCache.Pin();
+            if (Cache)
+            {
+                Cache->Update();
+            }
+        });
+    }
+}
+
+void FStaticGeometryCache::RemoveChunk(FChunk& Chunk, IPLScene TargetScene)
+{
+    if (Chunk.InstancedMesh)
+    {
+        iplInstancedMeshRemove(Chunk.InstancedMesh, TargetScene);
+        iplInstancedMeshRelease(&Chunk.InstancedMesh);
+    }
+
+    if (Chunk.StaticMesh)
+    {
+        iplStaticMeshRelease(&Chunk.StaticMesh);
+    }
+
+    if (Chunk.SubScene)
+    {
+        iplSceneRelease(&Chunk.SubScene);
+    }
+}
+
+void FStaticGeometryCache::TrackComponent(UStaticMeshComponent* Component)
+{
+    FComponentKey Key(Component);
+    if (!TransformUpdatedHandles.Contains(Key))
+    {
+        TransformUpdatedHandles.Add(Key, Component->TransformUpdated.AddRaw(this, &FStaticGeometryCache::OnTransformUpdated));
+    }
+}
+
+void FStaticGeometryCache::UntrackComponent(const FComponentKey& Key)
+{
+    FDelegateHandle Handle;
+    if (TransformUpdatedHandles.RemoveAndCopyValue(Key, Handle))
+    {
+        UStaticMeshComponent* Component = Key.ResolveObjectPtr();
+        if (Component)
+        {
+            Component->TransformUpdated.Remove(Handle);
+        }
+    }
+}
+
+void FStaticGeometryCache::MarkDirty(UActorComponent* Component)
+{
+    UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Component);
+    if (!StaticMeshComponent || StaticMeshComponent->GetWorld() != World.Get())
+        return;
+
+    // Components of other actors can never be exported as static geometry.
+    FComponentKey Key(StaticMeshComponent);
+    if (!TransformUpdatedHandles.Contains(Key) && !Cast<AStaticMeshActor>(StaticMeshComponent->GetOwner()))
+        return;
+
+    DirtyComponents.Add(Key);
+}
+
+void FStaticGeometryCache::OnTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    MarkDirty(Component);
+}
+
+void FStaticGeometryCache::OnRenderStateDirty(UActorComponent& Component)
+{
+    // Sent when the mesh or the render materials of a component change, among other things.
+    MarkDirty(&Component);
+}
+
+void FStaticGeometryCache::OnActorSpawnedOrDestroyed(AActor* Actor)
+{
+    AStaticMeshActor* StaticMeshActor = Cast<AStaticMeshActor>(Actor);
+    if (!StaticMeshActor)
+        return;
+
+    TInlineComponentArray<UStaticMeshComponent*> StaticMeshComponents;
+    StaticMeshActor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
+
+    for (UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+    {
+        MarkDirty(StaticMeshComponent);
+    }
+}
+
+bool FStaticGeometryCache::RunRebuildBenchmark(UWorld* InWorld, ULevel* InLevel, int32 NumChanged, FRebuildBenchmarkResult& OutResult)
+{
+    check(IsInGameThread());
+    check(InWorld);
+    check(InLevel);
+
+    OutResult = FRebuildBenchmarkResult();
+
+    const USteamAudioSettings* SteamAudioSettings = GetDefault<USteamAudioSettings>();
+
+    TArray<AActor*> Actors;
+    GetActorsForStaticGeometryExport(InWorld, InLevel, Actors);
+
+    TArray<UStaticMeshComponent*> Components;
+    for (AActor* Actor : Actors)
+    {
+        AStaticMeshActor* StaticMeshActor = Cast<AStaticMeshActor>(Actor);
+        if (!StaticMeshActor)
+            continue;
+
+        TInlineComponentArray<UStaticMeshComponent*> StaticMeshComponents;
+        StaticMeshActor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
+
+        for (UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+        {
+            UStaticMesh* Mesh = StaticMeshComponent->GetStaticMesh();
+            if (Mesh && Mesh->HasValidRenderData())
+            {
+                Components.Add(StaticMeshComponent);
+            }
+        }
+    }
+
+    OutResult.NumComponents = Components.Num();
+    OutResult.NumChanged = FMath::Clamp(NumChanged, 0, Components.Num());
+
+    IPLScene TargetScene = nullptr;
+    if (!FSteamAudioModule::GetManager().CreateEmptyScene(TargetScene))
+        return false;
+
+    ON_SCOPE_EXIT
+    {
+        iplSceneRelease(&TargetScene);
+    };
+
+    // The first run isn't timed, so that material assets are loaded and the mesh data is warm for both.
+    for (int32 Run = 0; Run < 2; ++Run)
+    {
+        double StartTime = FPlatformTime::Seconds();
+
+        FChunkBuild Full;
+        TMap<FString, int> MaterialIndexForAsset;
+        if (!ExportActors(Actors, Full.Vertices, Full.Triangles, Full.MaterialIndices, Full.Materials, MaterialIndexForAsset))
+            return false;
+
+        if (SteamAudioSettings->bExportBSPGeometry &&
+            !ExportBSPGeometry(InWorld, InLevel, Full.Vertices, Full.Triangles, Full.MaterialIndices, Full.Materials, MaterialIndexForAsset))
+        {
+            return false;
+        }
+
+        double GatherEndTime = FPlatformTime::Seconds();
+
+        bool bBuilt = Full.Triangles.Num() == 0 || Full.Build(TargetScene);
+        Full.Release();
+        if (!bBuilt)
+            return false;
+
+        OutResult.FullGatherTime = (GatherEndTime - StartTime) * 1000.0;
+        OutResult.FullBuildTime = (FPlatformTime::Seconds() - GatherEndTime) * 1000.0;
+    }
+
+    // The same steps as Update takes for components that have already been split out of the base.
+    double StartTime = FPlatformTime::Seconds();
+
+    TArray<FChunkBuild> Builds;
+    Builds.SetNum(OutResult.NumChanged);
+
+    // One entry per element of Builds.
+    TArray<FStaticMeshComponentExport> BuildExports;
+
+    for (int32 i = 0; i < OutResult.NumChanged; ++i)
+    {
+        UStaticMeshComponent* Component = Components[i];
+
+        TMap<FString, int> MaterialIndexForAsset;
+        if (!GatherStaticMeshComponent(Component, GetMaterialAssetForActor(Component->GetOwner()), false, SteamAudioSettings,
+            Builds[i].Materials, MaterialIndexForAsset, false, BuildExports))
+        {
+            return false;
+        }
+
+        Builds[i].State.Transform = Component->GetComponentTransform();
+    }
+
+    ParallelFor(BuildExports.Num(), [&](int32 Index)
+    {
+        FChunkBuild& Build = Builds[Index];
+        ExtractStaticMeshComponents(MakeArrayView(&BuildExports[Index], 1), Build.Vertices, Build.Triangles, Build.MaterialIndices);
+    });
+
+    double GatherEndTime = FPlatformTime::Seconds();
+
+    bool bBuilt = true;
+    for (FChunkBuild& Build : Builds)
+    {
+        bBuilt &= Build.Build(TargetScene);
+    }
+
+    OutResult.IncrementalGatherTime = (GatherEndTime - StartTime) * 1000.0;
+    OutResult.IncrementalBuildTime = (FPlatformTime::Seconds() - GatherEndTime) * 1000.0;
+
+    for (FChunkBuild& Build : Builds)
+    {
+        Build.Release();
+    }
+
+    return bBuilt;
+}
+
+bool FStaticGeometryCache::FChunkBuild::Build(IPLScene Scene)
+{
+    FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
+    if (!Manager.CreateEmptyScene(SubScene))
+        return false;
+
+    IPLStaticMeshSettings StaticMeshSettings{};
+    StaticMeshSettings.numVertices = Vertices.Num();
+    StaticMeshSettings.numTriangles = Triangles.Num();
+    StaticMeshSettings.numMaterials = Materials.Num();
+    StaticMeshSettings.vertices = Vertices.GetData();
+    StaticMeshSettings.triangles = Triangles.GetData();
+    StaticMeshSettings.materialIndices = MaterialIndices.GetData();
+    StaticMeshSettings.materials = Materials.GetData();
+
+    IPLerror Status = iplStaticMeshCreate(SubScene, &StaticMeshSettings, &StaticMesh);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create static mesh. [%d]"), Status);
+        Release();
+        return false;
+    }
+
+    iplStaticMeshAdd(StaticMesh, SubScene);
+    iplSceneCommit(SubScene);
+
+    IPLInstancedMeshSettings InstancedMeshSettings{};
+    InstancedMeshSettings.subScene = SubScene;
+    InstancedMeshSettings.transform = ConvertTransform(State.Transform);
+
+    Status = iplInstancedMeshCreate(Scene, &InstancedMeshSettings, &InstancedMesh);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create instanced mesh. [%d]"), Status);
+        Release();
+        return false;
+    }
+
+    // The geometry is now owned by the sub-scene.
+    Vertices.Empty();
+    Triangles.Empty();
+    MaterialIndices.Empty();
+    Materials.Empty();
+
+    return true;
+}
+
+void FStaticGeometryCache::FChunkBuild::Release()
+{
+    if (InstancedMesh)
+    {
+        iplInstancedMeshRelease(&InstancedMesh);
+    }
+
+    if (StaticMesh)
+    {
+        iplStaticMeshRelease(&StaticMesh);
+    }
+
+    if (SubScene)
+    {
+        iplSceneRelease(&SubScene);
+    }
+}
+
+bool FStaticGeometryCache::FUpdateBatch::IsEmpty() const
+{
+    return Builds.Num() == 0 && Removals.Num() == 0 && Moves.Num() == 0 && Rematerials.Num() == 0 && !Base.IsSet();
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FMaterialCache
+// ---------------------------------------------------------------------------------------------------------------------
+
+const IPLMaterial* FMaterialCache::Find(const FSoftObjectPath& MaterialAsset)
+{
+    check(IsInGameThread());
+
+    const IPLMaterial* Material = Materials.Find(MaterialAsset);
+    if (Material)
+        return Material;
+
+    if (Loads.Contains(MaterialAsset))
+        return AddIfLoaded(MaterialAsset);
+
+    Preload(MaterialAsset);
+    return Materials.Find(MaterialAsset);
+}
+
+void FMaterialCache::Preload(const FSoftObjectPath& MaterialAsset)
+{
+    check(IsInGameThread());
+
+    if (!MaterialAsset.IsValid() || Materials.Contains(MaterialAsset) || Loads.Contains(MaterialAsset) || FailedAssets.Contains(MaterialAsset))
+        return;
+
+    // Assets that are already in memory don't need to be loaded.
+    if (AddIfLoaded(MaterialAsset))
+        return;
+
+    TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(MaterialAsset);
+    if (Handle)
+    {
+        Loads.Add(MaterialAsset, Handle);
+    }
+    else
+    {
+        UE_LOG(LogSteamAudio, Warning, TEXT("Unable to load material asset: %s."), *MaterialAsset.ToString());
+        FailedAssets.Add(MaterialAsset);
+    }
+}
+
+bool FMaterialCache::IsLoading(const FSoftObjectPath& MaterialAsset) const
+{
+    const TSharedPtr<FStreamableHandle>* Handle = Loads.Find(MaterialAsset);
+    return Handle && (*Handle)->IsLoadingInProgress();
+}
+
+TSharedPtr<FStreamableHandle> FMaterialCache::WhenLoaded(TArray<FSoftObjectPath> MaterialAssets, FStreamableDelegate Callback)
+{
+    check(IsInGameThread());
+
+    return StreamableManager.RequestAsyncLoad(MoveTemp(MaterialAssets), MoveTemp(Callback));
+}
+
+void FMaterialCache::Reset()
+{
+    for (TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& Load : Loads)
+    {
+        Load.Value->CancelHandle();
+    }
+
+    Materials.Empty();
+    Loads.Empty();
+    FailedAssets.Empty();
+}
+
+const IPLMaterial* FMaterialCache::AddIfLoaded(const FSoftObjectPath& MaterialAsset)
+{
+    TSharedPtr<FStreamableHandle> Handle;
+    Loads.RemoveAndCopyValue(MaterialAsset, Handle);
+
+    if (Handle && Handle->IsLoadingInProgress())
+    {
+        Loads.Add(MaterialAsset, Handle);
+        return nullptr;
+    }
+
+    USteamAudioMaterial* Material = Cast<USteamAudioMaterial>(MaterialAsset.ResolveObject());
+    if (!Material)
+    {
+        // Only a finished load means the asset can't be loaded; otherwise it simply hasn't been requested yet.
+        if (Handle)
+        {
+            UE_LOG(LogSteamAudio, Warning, TEXT("Unable to load material asset: %s."), *MaterialAsset.ToString());
+            FailedAssets.Add(MaterialAsset);
+        }
+
+        return nullptr;
+    }
+
+    // The values are copied, so the asset doesn't need to stay loaded.
+    if (Handle)
+    {
+        Handle->ReleaseHandle();
+    }
+
+    return &Materials.Add(MaterialAsset, ConvertMaterial(Material));
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Baked Data Load/Unload
+// ---------------------------------------------------------------------------------------------------------------------
+
+IPLProbeBatch LoadProbeBatchFromAsset(FSoftObjectPath Asset, IPLContext Context)
+{
+    check(Asset.IsValid());
+    check(Context);
+
+    USteamAudioSerializedObject* AssetObject = Cast<USteamAudioSerializedObject>(Asset.TryLoad());
+    if (!AssetObject)
+        return nullptr;
+
+    return LoadProbeBatchFromSerializedObject(AssetObject, Context);
+}
+
+IPLProbeBatch LoadProbeBatchFromSerializedObject(USteamAudioSerializedObject* AssetObject, IPLContext Context)
+{
+    check(AssetObject);
+    check(Context);
+
+    FSerializedObjectLoadScope LoadScope(AssetObject);
+
+    IPLSerializedObject SerializedObject = LoadScope.Create(Context);
+    if (!SerializedObject)
+        return nullptr;
+
     IPLProbeBatch ProbeBatch = nullptr;
-    Status = iplProbeBatchLoad(Context, SerializedObject, &ProbeBatch);
+    IPLerror Status = iplProbeBatchLoad(Context, SerializedObject, &ProbeBatch);
     if (Status != IPL_STATUS_SUCCESS)
     {
         UE_LOG(LogSteamAudio, Error, TEXT("Unable to load probe batch from serialized object. [%d]"), Status);
@@ -17,11 +17,17 @@
 #pragma once
 
 #include "SteamAudioModule.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/ObjectKey.h"
 
+class UStaticMesh;
 class USteamAudioDynamicObjectComponent;
+class USteamAudioSerializedObject;
 
 namespace SteamAudio {
 
+struct FStaticMeshMaterialChange;
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Scene Export
 // ---------------------------------------------------------------------------------------------------------------------
@@ -52,24 +58,310 @@ bool STEAMAUDIO_API ExportDynamicObject(USteamAudioDynamicObjectComponent* Dynam
   */
 void STEAMAUDIO_API ExportDynamicObjectRuntime(USteamAudioDynamicObjectComponent* DynamicObject, IPLScene& Scene, IPLInstancedMesh& InstancedMesh);
 
+/** Time taken to export the Static Mesh geometry of a level, in milliseconds. */
+struct FStaticGeometryExportBenchmarkResult
+{
+    int32 NumComponents = 0;
+    int32 NumTriangles = 0;
+
+    /** Gathering the Static Mesh components on the game thread. */
+    double GatherTime = 0.0;
+
+    /** Extracting and transforming the geometry of every component, on one thread and on the task graph. */
+    double SerialExtractTime = 0.0;
+    double ParallelExtractTime = 0.0;
+
+    /** True if the serial and parallel exports produced exactly the same geometry. */
+    bool bOutputsMatch = true;
+};
+
+/**
+ * Exports the Static Mesh geometry of the given (sub)level NumRuns times with extraction running serially, and as many
+ * times with it running in parallel, and reports the best time of each. Nothing is written. Must be called from the
+ * game thread.
+ */
+bool STEAMAUDIO_API RunStaticGeometryExportBenchmark(UWorld* World, ULevel* Level, int32 NumRuns, FStaticGeometryExportBenchmarkResult& OutResult);
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Scene Load/Unload
 // ---------------------------------------------------------------------------------------------------------------------
 
 /**
- * Loads the geometry and material data in the active iplStaticMesh object.
+ * Finds the Steam Audio Material asset that the given actor's static geometry should now use, and the index of the
+ * material in the level's exported static mesh. Returns false if the actor is not static geometry whose material can
+ * be changed at runtime.
  */
-void STEAMAUDIO_API UpdateStaticGeometryForLevel(UWorld* World, ULevel* Level, IPLStaticMesh& OldStaticMesh);
+bool STEAMAUDIO_API GetRuntimeMaterialChange(AActor* RefreshableActor, FSoftObjectPath& OutMaterialAsset, int32& OutExportIndex);
 
 /**
- * Loads the material data of specified StaticMeshActor in the iplStaticMesh object.
+ * Loads the geometry and material data in the given .uasset and creates a Static Mesh object from it.
  */
-void STEAMAUDIO_API UpdateStaticMeshMaterial(UWorld* World, ULevel* Level, IPLStaticMesh StaticMesh, AActor* RefreshableActor);
+IPLStaticMesh STEAMAUDIO_API LoadStaticMeshFromAsset(FSoftObjectPath Asset, IPLContext Context, IPLScene Scene);
 
 /**
- * Loads the geometry and material data in the given .uasset and creates a Static Mesh object from it.
+ * Creates a Static Mesh object from an already-loaded .uasset. Reads the geometry data from disk if needed, so this
+ * should be called from a worker thread when loading at runtime.
  */
-IPLStaticMesh STEAMAUDIO_API LoadStaticMeshFromAsset(FSoftObjectPath Asset, IPLContext Context, IPLScene Scene);
+IPLStaticMesh STEAMAUDIO_API LoadStaticMeshFromSerializedObject(USteamAudioSerializedObject* AssetObject, IPLContext Context, IPLScene Scene);
+
+/**
+ * Loads the shared geometry in the given .uasset, and creates an Instanced Mesh object for every instance of it. The
+ * Instanced Mesh objects are not added to the scene.
+ */
+bool STEAMAUDIO_API LoadInstancedMeshesFromAsset(FSoftObjectPath Asset, IPLContext Context, IPLScene Scene, TArray<IPLInstancedMesh>& InstancedMeshes);
+
+/**
+ * Creates Instanced Mesh objects from an already-loaded .uasset. Can be called from a worker thread.
+ */
+bool STEAMAUDIO_API LoadInstancedMeshesFromSerializedObject(USteamAudioSerializedObject* AssetObject, IPLContext Context, IPLScene Scene, TArray<IPLInstancedMesh>& InstancedMeshes);
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FStaticGeometryCache
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Runtime copy of the static geometry of a level. The geometry loaded from the level's exported asset stays in the
+ * scene as the base, and only Static Mesh components that change at runtime are split out of it, each into its own
+ * chunk: an instanced mesh whose sub-scene holds the component's geometry in local space. Changes are found through
+ * transform, render state, and actor spawn/destroy notifications, so an update only looks at the components that were
+ * touched since the last one.
+ *
+ * The first time a component changes, the base is rebuilt without it on a worker thread. After that, moving,
+ * re-materialing, or swapping the mesh of the component only touches its own chunk.
+ */
+class STEAMAUDIO_API FStaticGeometryCache : public TSharedFromThis<FStaticGeometryCache, ESPMode::ThreadSafe>
+{
+public:
+    /** LevelStaticMesh and LevelInstancedMeshes are the geometry loaded from the level's exported asset, already added
+        to (or queued to be added to) the scene. The cache takes ownership of them. The exportable components of the
+        level are assumed to be in the state they were exported in. Must be called from the game thread. */
+    FStaticGeometryCache(UWorld* InWorld, ULevel* InLevel, IPLScene InScene, IPLStaticMesh InLevelStaticMesh,
+        TArray<IPLInstancedMesh>&& InLevelInstancedMeshes);
+
+    ~FStaticGeometryCache();
+
+    /** Rebuilds the geometry of the components that have changed since the last update. Geometry is gathered on the
+        game thread, Steam Audio objects are created on a worker thread, and the results are applied to the scene at
+        the Steam Audio Manager's next safe point. Must be called from the game thread. */
+    void Update();
+
+    /** Applies new materials to the geometry of the given actors, whether it is still part of the base or has been
+        split out into chunks, at the Steam Audio Manager's next safe point. Doesn't gather or rebuild any geometry.
+        Must be called from the game thread. */
+    void SetMaterials(TArrayView<const FStaticMeshMaterialChange> Changes);
+
+    /** Time taken to rebuild the static geometry of a level, in milliseconds. */
+    struct FRebuildBenchmarkResult
+    {
+        int32 NumComponents = 0;
+        int32 NumChanged = 0;
+
+        /** Every component, plus BSP and landscape geometry, as a single world-space mesh. */
+        double FullGatherTime = 0.0;
+        double FullBuildTime = 0.0;
+
+        /** One chunk for each changed component. */
+        double IncrementalGatherTime = 0.0;
+        double IncrementalBuildTime = 0.0;
+    };
+
+    /** Rebuilds the static geometry of the given level once in full, and once incrementally for the first NumChanged
+        exportable components, and times both. Nothing is added to the main scene. Steam Audio must be initialized.
+        Must be called from the game thread. */
+    static bool RunRebuildBenchmark(UWorld* InWorld, ULevel* InLevel, int32 NumChanged, FRebuildBenchmarkResult& OutResult);
+
+private:
+    typedef TObjectKey<UStaticMeshComponent> FComponentKey;
+
+    /** Everything about a Static Mesh component that affects its exported geometry. */
+    struct FComponentState
+    {
+        TWeakObjectPtr<UStaticMesh> Mesh;
+        int32 LODIndex = INDEX_NONE;
+        FTransform Transform;
+        FSoftObjectPath MaterialAsset;
+
+        bool Equals(const FComponentState& Other) const;
+    };
+
+    /** Geometry that has been added to the scene: a component that has been split out of the base, or the rebuilt
+        base itself. */
+    struct FChunk
+    {
+        FComponentState State;
+
+        IPLScene SubScene = nullptr;
+        IPLStaticMesh StaticMesh = nullptr;
+        IPLInstancedMesh InstancedMesh = nullptr;
+    };
+
+    /** A chunk whose geometry must be (re)built. Geometry is gathered on the game thread, the Steam Audio objects are
+        created on a worker thread. */
+    struct FChunkBuild
+    {
+        FComponentKey Key;
+        FComponentState State;
+
+        TArray<IPLVector3> Vertices;
+        TArray<IPLTriangle> Triangles;
+        TArray<int> MaterialIndices;
+        TArray<IPLMaterial> Materials;
+
+        IPLScene SubScene = nullptr;
+        IPLStaticMesh StaticMesh = nullptr;
+        IPLInstancedMesh InstancedMesh = nullptr;
+
+        bool Build(IPLScene Scene);
+        void Release();
+    };
+
+    /** All the changes found by a single call to Update. */
+    struct FUpdateBatch
+    {
+        TArray<FChunkBuild> Builds;
+        TArray<FComponentKey> Removals;
+        TArray<TPair<FComponentKey, FTransform>> Moves;
+        TArray<TTuple<FComponentKey, FSoftObjectPath, IPLMaterial>> Rematerials;
+
+        /** The base without the components that have been split out of it, if it is rebuilt by this batch. */
+        TOptional<FChunkBuild> Base;
+
+        /** Index of the material of each actor whose material can change at runtime, in the rebuilt base. */
+        TMap<TObjectKey<AActor>, int32> BaseMaterialIndices;
+
+        /** Number of components split out of the base by this batch. */
+        int32 NumSplit = 0;
+
+        /** Number of components whose geometry could not be gathered. */
+        int32 NumGatherFailures = 0;
+
+        double GatherTime = 0.0;
+        double BuildTime = 0.0;
+
+        bool IsEmpty() const;
+    };
+
+    /** Fills in the state of the given component. Returns false if it isn't exported as static geometry (anymore). */
+    static bool GetComponentState(UWorld* InWorld, UStaticMeshComponent* Component, FComponentState& OutState);
+
+    /** Adds the base geometry (BSP, landscape, and every component that hasn't been split out) to the given batch, as
+        a single world-space chunk. Returns false if it could not be gathered, including if any material it needs is
+        still loading, in which case the asset is added to LoadingMaterials. */
+    bool GatherBase(FUpdateBatch& Batch, TArray<FSoftObjectPath>& LoadingMaterials);
+
+    /** Applies the changes in the given batch to the scene. Called by the Steam Audio Manager at a safe point. */
+    void ApplyUpdate(FUpdateBatch& Batch);
+
+    static void RemoveChunk(FChunk& Chunk, IPLScene TargetScene);
+
+    /** Starts listening for transform changes of the given component. */
+    void TrackComponent(UStaticMeshComponent* Component);
+
+    /** Stops listening for transform changes of the given component. */
+    void UntrackComponent(const FComponentKey& Key);
+
+    /** Marks a component as changed if it is (or could be) exported as static geometry. */
+    void MarkDirty(UActorComponent* Component);
+
+    void OnTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+    void OnRenderStateDirty(UActorComponent& Component);
+    void OnActorSpawnedOrDestroyed(AActor* Actor);
+
+    TWeakObjectPtr<UWorld> World;
+    TWeakObjectPtr<ULevel> Level;
+
+    /** Retained reference to the main scene. */
+    IPLScene Scene;
+
+    /** Geometry loaded from the level's exported asset, until the base is first rebuilt. */
+    IPLStaticMesh LevelStaticMesh;
+    TArray<IPLInstancedMesh> LevelInstancedMeshes;
+
+    /** The rebuilt base, once it has replaced the geometry loaded from the level's exported asset. */
+    FChunk Base;
+
+    /** Index of the material of each actor whose material can change at runtime, in the rebuilt base. Actors in the
+        geometry loaded from the asset use the index it was exported with instead. */
+    TMap<TObjectKey<AActor>, int32> BaseMaterialIndices;
+
+    /** The latest runtime material of each actor whose geometry is in the base, applied again whenever it is rebuilt. */
+    TMap<TObjectKey<AActor>, IPLMaterial> BaseMaterials;
+
+    /** Components whose geometry is still part of the base, in the state it was built from. */
+    TMap<FComponentKey, FComponentState> BaseComponents;
+
+    /** Components that have been split out of the base. */
+    TMap<FComponentKey, FChunk> Chunks;
+
+    /** Components that may have changed since the last update. */
+    TSet<FComponentKey> DirtyComponents;
+
+    /** Transform change notifications, for every component in BaseComponents or Chunks. */
+    TMap<FComponentKey, FDelegateHandle> TransformUpdatedHandles;
+
+    FDelegateHandle RenderStateDirtyHandle;
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+
+    /** Load of the materials that the last update had to wait for. Runs another update when it finishes. */
+    TSharedPtr<FStreamableHandle> MaterialLoadHandle;
+
+    /** True if components have been split out of the base since it was last built. */
+    bool bBaseDirty;
+
+    /** True while a batch is being built or waiting to be applied. */
+    bool bUpdateInFlight;
+
+    /** True if Update was called while a batch was in flight. */
+    bool bUpdatePending;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FMaterialCache
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Steam Audio Material assets used by runtime material changes, converted to Steam Audio materials and cached by soft
+ * path. Assets that aren't in memory yet are loaded asynchronously, so a material change never blocks the game thread
+ * on a load. Must only be used from the game thread.
+ */
+class STEAMAUDIO_API FMaterialCache
+{
+public:
+    /** Returns the material for the given asset if it has been loaded. Otherwise, starts loading it (if it isn't
+        already loading) and returns null. */
+    const IPLMaterial* Find(const FSoftObjectPath& MaterialAsset);
+
+    /** Starts loading the given asset, so that it is ready by the time a material change needs it. */
+    void Preload(const FSoftObjectPath& MaterialAsset);
+
+    /** Returns true if the given asset is still being loaded. */
+    bool IsLoading(const FSoftObjectPath& MaterialAsset) const;
+
+    /** Calls the given delegate on the game thread once all of the given assets have finished loading, whether or not
+        they could be loaded. Cancel the returned handle to stop the delegate from being called. */
+    TSharedPtr<FStreamableHandle> WhenLoaded(TArray<FSoftObjectPath> MaterialAssets, FStreamableDelegate Callback);
+
+    /** Forgets all cached materials, and cancels any loads in progress. */
+    void Reset();
+
+private:
+    /** Converts the asset to a Steam Audio material and caches it, if it has been loaded. */
+    const IPLMaterial* AddIfLoaded(const FSoftObjectPath& MaterialAsset);
+
+    FStreamableManager StreamableManager;
+
+    /** Materials converted so far. */
+    TMap<FSoftObjectPath, IPLMaterial> Materials;
+
+    /** Loads in progress. */
+    TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> Loads;
+
+    /** Assets that could not be loaded, so they are only reported once. */
+    TSet<FSoftObjectPath> FailedAssets;
+};
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -81,4 +373,10 @@ IPLStaticMesh STEAMAUDIO_API LoadStaticMeshFromAsset(FSoftObjectPath Asset, IPLC
  */
 IPLProbeBatch STEAMAUDIO_API LoadProbeBatchFromAsset(FSoftObjectPath Asset, IPLContext Context);
 
+/**
+ * Creates a Probe Batch object from an already-loaded .uasset. Reads the baked data from disk if needed, so this should
+ * be called from a worker thread when loading at runtime.
+ */
+IPLProbeBatch STEAMAUDIO_API LoadProbeBatchFromSerializedObject(USteamAudioSerializedObject* AssetObject, IPLContext Context);
+
 }
@@ -20,12 +20,46 @@
 #include "UObject/SavePackage.h"
 #endif
 #include "UObject/UObjectGlobals.h"
+#include "Misc/Compression.h"
+#include "Serialization/CustomVersion.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSerializedObjectVersion
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Custom version for the layout of USteamAudioSerializedObject.
+ */
+struct FSteamAudioSerializedObjectVersion
+{
+    enum Type
+    {
+        /** Data stored inline in the Data property. */
+        InitialVersion = 0,
+
+        /** Data stored as bulk data, after the object's properties. */
+        BulkDataPayload = 1,
+
+        VersionPlusOne,
+        LatestVersion = VersionPlusOne - 1
+    };
+
+    static const FGuid GUID;
+};
+
+const FGuid FSteamAudioSerializedObjectVersion::GUID(0x5A3E7C21, 0x9B8D4F06, 0xA1C2E3F4, 0x6D7B8C90);
+
+static FCustomVersionRegistration GRegisterSteamAudioSerializedObjectVersion(FSteamAudioSerializedObjectVersion::GUID,
+    FSteamAudioSerializedObjectVersion::LatestVersion, TEXT("SteamAudioSerializedObjectVer"));
 
 // ---------------------------------------------------------------------------------------------------------------------
 // USteamAudioSerializedObject
 // ---------------------------------------------------------------------------------------------------------------------
 
-USteamAudioSerializedObject* USteamAudioSerializedObject::SerializeObjectToPackage(IPLSerializedObject SerializedObject, const FString& AssetName)
+USteamAudioSerializedObject* USteamAudioSerializedObject::SerializeObjectToPackage(IPLSerializedObject SerializedObject, const FString& AssetName,
+    const TArray<FSteamAudioSerializedMesh>& SharedMeshes /* = TArray<FSteamAudioSerializedMesh>() */,
+    const TArray<FSteamAudioMeshInstance>& Instances /* = TArray<FSteamAudioMeshInstance>() */,
+    const FString& ContentHash /* = FString() */, FName InCompressionFormat /* = NAME_None */)
 {
     int DataSize = iplSerializedObjectGetSize(SerializedObject);
     uint8* DataBuffer = iplSerializedObjectGetData(SerializedObject);
@@ -48,8 +82,10 @@ USteamAudioSerializedObject* USteamAudioSerializedObject::SerializeObjectToPacka
         return nullptr;
 
     // Copy the data into the UObject.
-    Object->Data.SetNum(DataSize);
-    FMemory::Memcpy(Object->Data.GetData(), DataBuffer, DataSize);
+    Object->SetData(DataBuffer, DataSize, InCompressionFormat);
+    Object->SharedMeshes = SharedMeshes;
+    Object->Instances = Instances;
+    Object->ContentHash = ContentHash;
 
     // Save the package.
     Package->MarkPackageDirty();
@@ -67,3 +103,133 @@ USteamAudioSerializedObject* USteamAudioSerializedObject::SerializeObjectToPacka
 
     return Object;
 }
+
+int64 USteamAudioSerializedObject::GetDataSize() const
+{
+    return CompressionFormat.IsNone() ? BulkData.GetBulkDataSize() : UncompressedDataSize;
+}
+
+int64 USteamAudioSerializedObject::GetStoredDataSize() const
+{
+    return BulkData.GetBulkDataSize();
+}
+
+bool USteamAudioSerializedObject::CopyData(TArray<uint8>& OutData)
+{
+    FScopeLock Lock(&BulkDataCriticalSection);
+
+    int64 Size = BulkData.GetBulkDataSize();
+    if (Size <= 0)
+        return false;
+
+    // TArray<uint8> can't hold more than MAX_int32 bytes.
+    if (Size > MAX_int32 || UncompressedDataSize > MAX_int32)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Data in %s is too large to load."), *GetPathName());
+        return false;
+    }
+
+    if (CompressionFormat.IsNone())
+    {
+        OutData.SetNumUninitialized(static_cast<int32>(Size));
+        void* Dest = OutData.GetData();
+        BulkData.GetCopy(&Dest, true);
+
+        return true;
+    }
+
+    TArray<uint8> CompressedData;
+    CompressedData.SetNumUninitialized(static_cast<int32>(Size));
+    void* Dest = CompressedData.GetData();
+    BulkData.GetCopy(&Dest, true);
+
+    OutData.SetNumUninitialized(static_cast<int32>(UncompressedDataSize));
+    if (!FCompression::UncompressMemory(CompressionFormat, OutData.GetData(), OutData.Num(), CompressedData.GetData(), CompressedData.Num()))
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to decompress data in %s."), *GetPathName());
+        OutData.Empty();
+        return false;
+    }
+
+    return true;
+}
+
+void USteamAudioSerializedObject::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+
+    Ar.UsingCustomVersion(FSteamAudioSerializedObjectVersion::GUID);
+
+    if (Ar.CustomVer(FSteamAudioSerializedObjectVersion::GUID) >= FSteamAudioSerializedObjectVersion::BulkDataPayload)
+    {
+        BulkData.Serialize(Ar, this);
+    }
+}
+
+void USteamAudioSerializedObject::PostLoad()
+{
+    Super::PostLoad();
+
+    if (Data.Num() > 0)
+    {
+        SetData(Data.GetData(), Data.Num());
+        Data.Empty();
+    }
+}
+
+void USteamAudioSerializedObject::SetData(const uint8* InData, int64 Size, FName InCompressionFormat /* = NAME_None */)
+{
+    FScopeLock Lock(&BulkDataCriticalSection);
+
+    // Compress the data, and check that it decompresses to exactly the original data before keeping it. If it
+    // doesn't, or compression doesn't save any space, the data is stored as-is.
+    TArray<uint8> CompressedData;
+    if (!InCompressionFormat.IsNone() && Size > 0 && Size <= MAX_int32)
+    {
+        int32 CompressedSize = FCompression::GetMaximumCompressedSize(InCompressionFormat, static_cast<int32>(Size));
+        CompressedData.SetNumUninitialized(CompressedSize);
+
+        bool bCompressed = FCompression::CompressMemory(InCompressionFormat, CompressedData.GetData(), CompressedSize, InData, static_cast<int32>(Size));
+        if (bCompressed && CompressedSize < Size)
+        {
+            CompressedData.SetNum(CompressedSize);
+
+            TArray<uint8> RoundTripData;
+            RoundTripData.SetNumUninitialized(static_cast<int32>(Size));
+            bCompressed = FCompression::UncompressMemory(InCompressionFormat, RoundTripData.GetData(), RoundTripData.Num(), CompressedData.GetData(), CompressedData.Num()) &&
+                FMemory::Memcmp(RoundTripData.GetData(), InData, Size) == 0;
+
+            if (!bCompressed)
+            {
+                UE_LOG(LogSteamAudio, Warning, TEXT("Data in %s did not survive compression with %s, storing it uncompressed."), *GetPathName(), *InCompressionFormat.ToString());
+            }
+        }
+        else
+        {
+            bCompressed = false;
+        }
+
+        if (!bCompressed)
+        {
+            CompressedData.Empty();
+        }
+    }
+
+    // Keep the data out of the object's export, so that it is only read from disk when needed.
+    BulkData.SetBulkDataFlags(BULKDATA_Force_NOT_InlinePayload);
+
+    BulkData.Lock(LOCK_READ_WRITE);
+    if (CompressedData.Num() > 0)
+    {
+        FMemory::Memcpy(BulkData.Realloc(CompressedData.Num()), CompressedData.GetData(), CompressedData.Num());
+        CompressionFormat = InCompressionFormat;
+        UncompressedDataSize = Size;
+    }
+    else
+    {
+        FMemory::Memcpy(BulkData.Realloc(Size), InData, Size);
+        CompressionFormat = NAME_None;
+        UncompressedDataSize = 0;
+    }
+    BulkData.Unlock();
+}
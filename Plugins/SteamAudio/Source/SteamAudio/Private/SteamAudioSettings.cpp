@@ -27,6 +27,7 @@ USteamAudioSettings::USteamAudioSettings()
     , bExportLandscapeGeometry(true)
     , bExportBSPGeometry(true)
     , MinLODForExport(0)
+    , MinInstancesForSharedGeometry(4)
     , DefaultMeshMaterial("/SteamAudio/Materials/Default.Default")
     , DefaultLandscapeMaterial("/SteamAudio/Materials/Default.Default")
     , DefaultBSPMaterial("/SteamAudio/Materials/Default.Default")
@@ -55,7 +56,18 @@ USteamAudioSettings::USteamAudioSettings()
     , BakingPathRange(1000.0f)
     , BakedPathingCPUCoresPercentage(50)
     , SimulationUpdateInterval(0.1f)
+    , DirectParamsUpdateDistance(0.05f)
+    , DirectParamsUpdateAngle(2.0f)
+    , bEnableSimulationLOD(false)
+    , SimulationLODMaxFullRateSources(32)
+    , SimulationLODMaxIndirectSources(16)
+    , SimulationLODOcclusionSampleBudget(0)
+    , SimulationLODDecimationDistance(30.0f)
+    , SimulationLODCullDistance(100.0f)
+    , SimulationLODDecimatedUpdateInterval(4)
+    , SimulationLODDecimatedSampleFraction(0.25f)
     , ReflectionEffectType(EReflectionEffectType::CONVOLUTION)
+    , ReflectionEffectMemoryBudget(256)
     , HybridReverbTransitionTime(1.0f)
     , HybridReverbOverlapPercent(25)
     , DeviceType(EOpenCLDeviceType::ANY)
@@ -78,6 +90,7 @@ FSteamAudioSettings USteamAudioSettings::GetSettings() const
     Settings.bExportLandscapeGeometry = bExportLandscapeGeometry;
     Settings.bExportBSPGeometry = bExportBSPGeometry;
     Settings.MinLODForExport = MinLODForExport;
+    Settings.MinInstancesForSharedGeometry = MinInstancesForSharedGeometry;
     Settings.DefaultMeshMaterial = GetMaterialForAsset(DefaultMeshMaterial);
     Settings.DefaultLandscapeMaterial = GetMaterialForAsset(DefaultLandscapeMaterial);
     Settings.DefaultBSPMaterial = GetMaterialForAsset(DefaultBSPMaterial);
@@ -107,7 +120,18 @@ FSteamAudioSettings USteamAudioSettings::GetSettings() const
     Settings.BakingPathRange = BakingPathRange;
     Settings.BakedPathingCPUCoresPercentage = BakedPathingCPUCoresPercentage;
     Settings.SimulationUpdateInterval = SimulationUpdateInterval;
+    Settings.DirectParamsUpdateDistance = DirectParamsUpdateDistance;
+    Settings.DirectParamsUpdateAngle = DirectParamsUpdateAngle;
+    Settings.bEnableSimulationLOD = bEnableSimulationLOD;
+    Settings.SimulationLODMaxFullRateSources = SimulationLODMaxFullRateSources;
+    Settings.SimulationLODMaxIndirectSources = SimulationLODMaxIndirectSources;
+    Settings.SimulationLODOcclusionSampleBudget = SimulationLODOcclusionSampleBudget;
+    Settings.SimulationLODDecimationDistance = SimulationLODDecimationDistance;
+    Settings.SimulationLODCullDistance = SimulationLODCullDistance;
+    Settings.SimulationLODDecimatedUpdateInterval = SimulationLODDecimatedUpdateInterval;
+    Settings.SimulationLODDecimatedSampleFraction = SimulationLODDecimatedSampleFraction;
     Settings.ReflectionEffectType = static_cast<IPLReflectionEffectType>(ReflectionEffectType);
+    Settings.ReflectionEffectMemoryBudget = ReflectionEffectMemoryBudget;
     Settings.HybridReverbTransitionTime = HybridReverbTransitionTime;
     Settings.HybridReverbOverlapPercent = HybridReverbOverlapPercent;
     Settings.OpenCLDeviceType = static_cast<IPLOpenCLDeviceType>(DeviceType);
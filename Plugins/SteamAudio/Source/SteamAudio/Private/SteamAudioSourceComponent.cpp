@@ -15,6 +15,7 @@
 //
 
 #include "SteamAudioSourceComponent.h"
+#include "Components/AudioComponent.h"
 #include "SteamAudioAudioEngineInterface.h"
 #include "SteamAudioBakedListenerComponent.h"
 #include "SteamAudioBakedSourceComponent.h"
@@ -46,9 +47,11 @@ USteamAudioSourceComponent::USteamAudioSourceComponent()
     , PathingProbeBatch(nullptr)
     , bPathValidation(true)
     , bFindAlternatePaths(true)
+    , SimulationPriority(1.0f)
     , Source(nullptr)
     , Simulator(nullptr)
     , AudioEngineSource(nullptr)
+    , OutputSlot(INDEX_NONE)
 {
     bAutoActivate = true;
     PrimaryComponentTick.bCanEverTick = true;
@@ -61,7 +64,16 @@ void USteamAudioSourceComponent::SetInputs(IPLSimulationFlags Flags)
         return;
 
     IPLSimulationInputs Inputs{};
+    GetInputs(Inputs, Manager.GetSteamAudioSettings());
 
+    Inputs.source = SteamAudio::ConvertCoordinateSpace(GetOwner()->GetTransform());
+    Inputs.bakedDataIdentifier = GetBakedDataIdentifier();
+
+    iplSourceSetInputs(Source, Flags, &Inputs);
+}
+
+void USteamAudioSourceComponent::GetInputs(IPLSimulationInputs& Inputs, const FSteamAudioSettings& SteamAudioSettings) const
+{
     Inputs.flags = IPL_SIMULATIONFLAGS_DIRECT;
     if (bSimulateReflections)
     {
@@ -81,12 +93,6 @@ void USteamAudioSourceComponent::SetInputs(IPLSimulationFlags Flags)
         }
     }
 
-    const FTransform& SourceTransform = GetOwner()->GetTransform();
-    Inputs.source.origin = SteamAudio::ConvertVector(SourceTransform.GetLocation());
-    Inputs.source.ahead = SteamAudio::ConvertVector(SourceTransform.GetUnitAxis(EAxis::X), false);
-    Inputs.source.up = SteamAudio::ConvertVector(SourceTransform.GetUnitAxis(EAxis::Z), false);
-    Inputs.source.right = SteamAudio::ConvertVector(SourceTransform.GetUnitAxis(EAxis::Y), false);
-
     Inputs.occlusionType = static_cast<IPLOcclusionType>(OcclusionType);
     Inputs.occlusionRadius = OcclusionRadius;
     Inputs.numOcclusionSamples = OcclusionSamples;
@@ -94,13 +100,13 @@ void USteamAudioSourceComponent::SetInputs(IPLSimulationFlags Flags)
     Inputs.reverbScale[0] = 1.0f;
     Inputs.reverbScale[1] = 1.0f;
     Inputs.reverbScale[2] = 1.0f;
-    Inputs.hybridReverbTransitionTime = Manager.GetSteamAudioSettings().HybridReverbTransitionTime;
-    Inputs.hybridReverbOverlapPercent = Manager.GetSteamAudioSettings().HybridReverbOverlapPercent / 100.0f;
+    Inputs.hybridReverbTransitionTime = SteamAudioSettings.HybridReverbTransitionTime;
+    Inputs.hybridReverbOverlapPercent = SteamAudioSettings.HybridReverbOverlapPercent / 100.0f;
     Inputs.baked = (ReflectionsType != EReflectionSimulationType::REALTIME) ? IPL_TRUE : IPL_FALSE;
-    Inputs.visRadius = Manager.GetSteamAudioSettings().BakingVisibilityRadius;
-    Inputs.visThreshold = Manager.GetSteamAudioSettings().BakingVisibilityThreshold;
-    Inputs.visRange = Manager.GetSteamAudioSettings().BakingVisibilityRange;
-    Inputs.pathingOrder = Manager.GetSteamAudioSettings().BakingAmbisonicOrder;
+    Inputs.visRadius = SteamAudioSettings.BakingVisibilityRadius;
+    Inputs.visThreshold = SteamAudioSettings.BakingVisibilityThreshold;
+    Inputs.visRange = SteamAudioSettings.BakingVisibilityRange;
+    Inputs.pathingOrder = SteamAudioSettings.BakingAmbisonicOrder;
     Inputs.enableValidation = bPathValidation ? IPL_TRUE : IPL_FALSE;
     Inputs.findAlternatePaths = bFindAlternatePaths ? IPL_TRUE : IPL_FALSE;
 
@@ -108,10 +114,6 @@ void USteamAudioSourceComponent::SetInputs(IPLSimulationFlags Flags)
     {
         Inputs.pathingProbes = PathingProbeBatch->GetProbeBatch();
     }
-
-    Inputs.bakedDataIdentifier = GetBakedDataIdentifier();
-
-    iplSourceSetInputs(Source, Flags, &Inputs);
 }
 
 IPLSimulationOutputs USteamAudioSourceComponent::GetOutputs(IPLSimulationFlags Flags)
@@ -195,6 +197,32 @@ IPLBakedDataIdentifier USteamAudioSourceComponent::GetBakedDataIdentifier() cons
     return Identifier;
 }
 
+float USteamAudioSourceComponent::GetAudibility() const
+{
+    UAudioComponent* Audio = AudioComponent.Get();
+    if (!Audio)
+        return 1.0f;
+
+    if (!Audio->IsPlaying())
+        return 0.0f;
+
+    return FMath::Clamp(Audio->VolumeMultiplier, 0.0f, 1.0f);
+}
+
+int32 USteamAudioSourceComponent::GetOcclusionSampleCount() const
+{
+    if (!bSimulateOcclusion)
+        return 0;
+
+    int32 NumSamples = (OcclusionType == EOcclusionType::VOLUMETRIC) ? OcclusionSamples : 1;
+    if (bSimulateTransmission)
+    {
+        NumSamples += MaxTransmissionSurfaces;
+    }
+
+    return NumSamples;
+}
+
 #if WITH_EDITOR
 bool USteamAudioSourceComponent::CanEditChange(const FProperty* InProperty) const
 {
@@ -235,10 +263,20 @@ void USteamAudioSourceComponent::BeginPlay()
 {
     Super::BeginPlay();
 
-    SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
-    if (!Manager.InitializeSteamAudio(SteamAudio::EManagerInitReason::PLAYING))
+    // Initialization may still be running in the background, in which case registration waits for it to finish.
+    SteamAudio::FSteamAudioModule::GetManager().WhenInitialized(this, [this]()
+    {
+        OnSteamAudioInitialized();
+    });
+}
+
+void USteamAudioSourceComponent::OnSteamAudioInitialized()
+{
+    if (!HasBegunPlay())
         return;
 
+    SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+
     Simulator = iplSimulatorRetain(Manager.GetSimulator());
     if (!Simulator)
         return;
@@ -255,6 +293,8 @@ void USteamAudioSourceComponent::BeginPlay()
     }
 
     iplSourceAdd(Source, Simulator);
+
+    AudioComponent = GetOwner()->FindComponentByClass<UAudioComponent>();
     Manager.AddSource(this);
 
     SteamAudio::IAudioEngineState* AudioEngineState = SteamAudio::FSteamAudioModule::GetAudioEngineState();
@@ -15,30 +15,21 @@
 //
 
 #include "SteamAudioSpatialization.h"
-#include "Components/AudioComponent.h"
-#include "GameFramework/Actor.h"
 #include "HAL/UnrealMemory.h"
 #include "SteamAudioCommon.h"
 #include "SteamAudioManager.h"
-#include "SteamAudioSourceComponent.h"
+#include "SteamAudioMixKernels.h"
 #include "SteamAudioSpatializationSettings.h"
 #include "SteamAudioUnrealAudioEngineInterface.h"
 
 namespace SteamAudio {
 
 // ---------------------------------------------------------------------------------------------------------------------
-// FSteamAudioSpatializationSource
+// FSteamAudioSpatializationEffects
 // ---------------------------------------------------------------------------------------------------------------------
 
-FSteamAudioSpatializationSource::FSteamAudioSpatializationSource()
-    : bBinaural(true)
-    , Interpolation(EHRTFInterpolation::NEAREST)
-    , bApplyPathing(false)
-    , bApplyHRTFToPathing(false)
-    , PathingMixLevel(1.0f)
-    , bNormalizePathingEQ(false)
-    , HRTF(nullptr)
-    , PanningEffect(nullptr)
+FSteamAudioSpatializationEffects::FSteamAudioSpatializationEffects()
+    : PanningEffect(nullptr)
     , BinauralEffect(nullptr)
     , PathEffect(nullptr)
     , AmbisonicsDecodeEffect(nullptr)
@@ -46,12 +37,9 @@ FSteamAudioSpatializationSource::FSteamAudioSpatializationSource()
     , PathingBuffer()
     , SpatializedPathingBuffer()
     , OutBuffer()
-    , PrevOrder(-1)
-{
-    PathingCoeffs.Reserve(16);
-}
+{}
 
-FSteamAudioSpatializationSource::~FSteamAudioSpatializationSource()
+FSteamAudioSpatializationEffects::~FSteamAudioSpatializationEffects()
 {
     IPLContext Context = FSteamAudioModule::GetManager().GetContext();
 
@@ -64,10 +52,9 @@ FSteamAudioSpatializationSource::~FSteamAudioSpatializationSource()
     iplPathEffectRelease(&PathEffect);
     iplBinauralEffectRelease(&BinauralEffect);
     iplPanningEffectRelease(&PanningEffect);
-    iplHRTFRelease(&HRTF);
 }
 
-void FSteamAudioSpatializationSource::Reset()
+void FSteamAudioSpatializationEffects::Reset()
 {
     if (PanningEffect)
     {
@@ -92,7 +79,7 @@ void FSteamAudioSpatializationSource::Reset()
     ClearBuffers();
 }
 
-void FSteamAudioSpatializationSource::ClearBuffers()
+void FSteamAudioSpatializationEffects::ClearBuffers()
 {
     if (PathingInputBuffer.data)
     {
@@ -128,16 +115,59 @@ void FSteamAudioSpatializationSource::ClearBuffers()
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSpatializationSlab
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioSpatializationSlab::~FSteamAudioSpatializationSlab()
+{
+    // Release the effects before the HRTF they were created with.
+    Effects.Empty();
+    iplHRTFRelease(&HRTF);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSpatializationSource
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioSpatializationSource::FSteamAudioSpatializationSource()
+    : bBinaural(true)
+    , Interpolation(EHRTFInterpolation::NEAREST)
+    , bApplyPathing(false)
+    , bApplyHRTFToPathing(false)
+    , PathingMixLevel(1.0f)
+    , bNormalizePathingEQ(false)
+    , Slab(nullptr)
+    , Effects(nullptr)
+{}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // FSteamAudioSpatializationPlugin
 // ---------------------------------------------------------------------------------------------------------------------
 
+FSteamAudioSpatializationPlugin::~FSteamAudioSpatializationPlugin()
+{
+    FSteamAudioModule::GetManager().OnSettingsSnapshotRebuilt.Remove(SettingsSnapshotRebuiltHandle);
+    Slabs.Reset();
+}
+
 void FSteamAudioSpatializationPlugin::Initialize(const FAudioPluginInitializationParams InitializationParams)
 {
     AudioSettings.samplingRate = InitializationParams.SampleRate;
     AudioSettings.frameSize = InitializationParams.BufferLength;
 
     Sources.AddDefaulted(InitializationParams.NumSources);
+    FSteamAudioModule::GetManager().ReserveVoiceOutputs(InitializationParams.NumSources);
+
+    // Start building the HRTF now, so it's ready by the time the first voice needs it.
+    FSteamAudioModule::GetManager().PrewarmHRTF(AudioSettings);
+
+    // Build the slab once Steam Audio is initialized, and again whenever the settings change. If it already is
+    // initialized, build it now.
+    SettingsSnapshotRebuiltHandle = FSteamAudioModule::GetManager().OnSettingsSnapshotRebuilt.AddRaw(this, &FSteamAudioSpatializationPlugin::OnSettingsSnapshotRebuilt);
+    OnSettingsSnapshotRebuilt(FSteamAudioModule::GetManager().GetSettingsSnapshot());
 }
 
 bool FSteamAudioSpatializationPlugin::IsSpatializationEffectInitialized() const
@@ -147,11 +177,9 @@ bool FSteamAudioSpatializationPlugin::IsSpatializationEffectInitialized() const
 
 void FSteamAudioSpatializationPlugin::OnInitSource(const uint32 SourceId, const FName& AudioComponentUserId, USpatializationPluginSourceSettingsBase* InSettings)
 {
-    // Make sure we're initialized, so real-time audio can work.
-    SteamAudio::RunInGameThread<void>([&]()
-    {
-        FSteamAudioModule::GetManager().InitializeSteamAudio(EManagerInitReason::PLAYING);
-    });
+    // Make sure initialization has started, so real-time audio can work. This only queues a request for the game
+    // thread, so the audio render thread never waits on it.
+    FSteamAudioModule::GetManager().RequestInitialization();
 
     FSteamAudioSpatializationSource& Source = Sources[SourceId];
 
@@ -164,133 +192,148 @@ void FSteamAudioSpatializationPlugin::OnInitSource(const uint32 SourceId, const
     Source.PathingMixLevel = (Settings) ? Settings->PathingMixLevel : 1.0f;
     Source.bNormalizePathingEQ = (Settings) ? Settings->bNormalizePathingEQ : false;
 
-    IPLContext Context = FSteamAudioModule::GetManager().GetContext();
+    // If Steam Audio is still initializing, there is no slab yet, so the voice picks one up once it's published.
+    if (!PinSlab(SourceId))
+    {
+        INC_DWORD_STAT(STAT_SteamAudioVoiceSlabMisses);
+    }
+}
+
+void FSteamAudioSpatializationPlugin::OnSettingsSnapshotRebuilt(const FSteamAudioSettingsSnapshotPtr& Snapshot)
+{
+    // Keep the current slab if Steam Audio has been shut down, since its effects don't depend on anything that was
+    // destroyed, and it can be reused if the settings are the same next time.
+    if (!Snapshot)
+        return;
 
-    if (!Source.HRTF)
+    IPLHRTF HRTF = FSteamAudioModule::GetManager().InitHRTF(AudioSettings) ? FSteamAudioModule::GetManager().GetHRTF() : nullptr;
+    const IPLSimulationSettings& SimulationSettings = Snapshot->RealTimeSettings;
+
+    const FSteamAudioSpatializationSlab* Current = Slabs.GetPublished();
+    if (Current && Current->HRTF == HRTF && Current->Order == SimulationSettings.maxOrder)
     {
-        if (FSteamAudioModule::GetManager().InitHRTF(AudioSettings))
-        {
-            Source.HRTF = iplHRTFRetain(FSteamAudioModule::GetManager().GetHRTF());
-        }
+        iplHRTFRelease(&HRTF);
+        Slabs.CollectGarbage();
+        return;
     }
 
-    if (!Source.PanningEffect)
+    TUniquePtr<FSteamAudioSpatializationSlab> Slab = MakeUnique<FSteamAudioSpatializationSlab>();
+    Slab->HRTF = HRTF;
+    Slab->Order = SimulationSettings.maxOrder;
+    Slab->Effects.SetNum(Sources.Num());
+
+    for (FSteamAudioSpatializationEffects& Effects : Slab->Effects)
     {
-        IPLPanningEffectSettings PanningSettings{};
-        PanningSettings.speakerLayout.type = IPL_SPEAKERLAYOUTTYPE_STEREO;
+        PrepareEffects(Effects, HRTF, SimulationSettings);
+    }
 
-        IPLerror Status = iplPanningEffectCreate(Context, &AudioSettings, &PanningSettings, &Source.PanningEffect);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create panning effect. [%d]"), Status);
-        }
+    Slabs.Publish(MoveTemp(Slab));
+}
+
+bool FSteamAudioSpatializationPlugin::PinSlab(uint32 SourceId)
+{
+    FSteamAudioSpatializationSource& Source = Sources[SourceId];
+    if (Source.Slab)
+        return true;
+
+    Source.Slab = Slabs.Pin();
+    if (!Source.Slab)
+        return false;
+
+    Source.Effects = &Source.Slab->Effects[SourceId];
+    Source.Effects->Reset();
+    return true;
+}
+
+void FSteamAudioSpatializationPlugin::PrepareEffects(FSteamAudioSpatializationEffects& Effects, IPLHRTF HRTF, const IPLSimulationSettings& SimulationSettings)
+{
+    IPLContext Context = FSteamAudioModule::GetManager().GetContext();
+
+    IPLPanningEffectSettings PanningSettings{};
+    PanningSettings.speakerLayout.type = IPL_SPEAKERLAYOUTTYPE_STEREO;
+
+    IPLerror Status = iplPanningEffectCreate(Context, &AudioSettings, &PanningSettings, &Effects.PanningEffect);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create panning effect. [%d]"), Status);
     }
 
-    if (!Source.BinauralEffect && Source.HRTF)
+    if (HRTF)
     {
         IPLBinauralEffectSettings BinauralSettings{};
-        BinauralSettings.hrtf = Source.HRTF;
+        BinauralSettings.hrtf = HRTF;
 
-        IPLerror Status = iplBinauralEffectCreate(Context, &AudioSettings, &BinauralSettings, &Source.BinauralEffect);
+        Status = iplBinauralEffectCreate(Context, &AudioSettings, &BinauralSettings, &Effects.BinauralEffect);
         if (Status != IPL_STATUS_SUCCESS)
         {
             UE_LOG(LogSteamAudio, Error, TEXT("Unable to create binaural effect. [%d]"), Status);
         }
     }
 
-    IPLSimulationSettings SimulationSettings = FSteamAudioModule::GetManager().GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
+    IPLPathEffectSettings PathingSettings{};
+    PathingSettings.maxOrder = SimulationSettings.maxOrder;
+    PathingSettings.spatialize = IPL_TRUE;
+    PathingSettings.speakerLayout.type = IPL_SPEAKERLAYOUTTYPE_STEREO;
+    PathingSettings.hrtf = HRTF;
 
-    if (!Source.PathEffect || Source.PrevOrder != SimulationSettings.maxOrder)
+    Status = iplPathEffectCreate(Context, &AudioSettings, &PathingSettings, &Effects.PathEffect);
+    if (Status != IPL_STATUS_SUCCESS)
     {
-        if (Source.PathEffect)
-        {
-            iplPathEffectRelease(&Source.PathEffect);
-        }
-
-        IPLPathEffectSettings PathingSettings{};
-        PathingSettings.maxOrder = SimulationSettings.maxOrder;
-        PathingSettings.spatialize = IPL_TRUE;
-        PathingSettings.speakerLayout.type = IPL_SPEAKERLAYOUTTYPE_STEREO;
-        PathingSettings.hrtf = Source.HRTF;
-
-        IPLerror Status = iplPathEffectCreate(Context, &AudioSettings, &PathingSettings, &Source.PathEffect);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create pathing effect. [%d]"), Status);
-        }
-
-        Source.PathingCoeffs.SetNumZeroed(CalcNumChannelsForAmbisonicOrder(PathingSettings.maxOrder));
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create pathing effect. [%d]"), Status);
     }
 
-    if ((!Source.AmbisonicsDecodeEffect || Source.PrevOrder != SimulationSettings.maxOrder) && Source.HRTF)
-    {
-        if (Source.AmbisonicsDecodeEffect)
-        {
-            iplAmbisonicsDecodeEffectRelease(&Source.AmbisonicsDecodeEffect);
-        }
+    Effects.PathingCoeffs.SetNumZeroed(CalcNumChannelsForAmbisonicOrder(PathingSettings.maxOrder));
 
+    if (HRTF)
+    {
         IPLAmbisonicsDecodeEffectSettings AmbisonicsDecodeSettings{};
         AmbisonicsDecodeSettings.speakerLayout.type = IPL_SPEAKERLAYOUTTYPE_STEREO;
-        AmbisonicsDecodeSettings.hrtf = Source.HRTF;
+        AmbisonicsDecodeSettings.hrtf = HRTF;
         AmbisonicsDecodeSettings.maxOrder = SimulationSettings.maxOrder;
 
-        IPLerror Status = iplAmbisonicsDecodeEffectCreate(Context, &AudioSettings, &AmbisonicsDecodeSettings, &Source.AmbisonicsDecodeEffect);
+        Status = iplAmbisonicsDecodeEffectCreate(Context, &AudioSettings, &AmbisonicsDecodeSettings, &Effects.AmbisonicsDecodeEffect);
         if (Status != IPL_STATUS_SUCCESS)
         {
             UE_LOG(LogSteamAudio, Error, TEXT("Unable to create Ambisonics decode effect. [%d]"), Status);
         }
     }
 
-    if (!Source.PathingInputBuffer.data)
+    Status = iplAudioBufferAllocate(Context, 1, AudioSettings.frameSize, &Effects.PathingInputBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
     {
-        IPLerror Status = iplAudioBufferAllocate(Context, 1, AudioSettings.frameSize, &Source.PathingInputBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create pathing input buffer for spatialization effect. [%d]"), Status);
-        }
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create pathing input buffer for spatialization effect. [%d]"), Status);
     }
 
-    if (!Source.PathingBuffer.data || Source.PrevOrder != SimulationSettings.maxOrder)
+    Status = iplAudioBufferAllocate(Context, CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder), AudioSettings.frameSize, &Effects.PathingBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
     {
-        if (Source.PathingBuffer.data)
-        {
-            iplAudioBufferFree(Context, &Source.PathingBuffer);
-        }
-
-        IPLerror Status = iplAudioBufferAllocate(Context, CalcNumChannelsForAmbisonicOrder(SimulationSettings.maxOrder), AudioSettings.frameSize, &Source.PathingBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create pathing buffer for spatialization effect. [%d]"), Status);
-        }
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create pathing buffer for spatialization effect. [%d]"), Status);
     }
 
-    if (!Source.SpatializedPathingBuffer.data)
+    Status = iplAudioBufferAllocate(Context, 2, AudioSettings.frameSize, &Effects.SpatializedPathingBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
     {
-        IPLerror Status = iplAudioBufferAllocate(Context, 2, AudioSettings.frameSize, &Source.SpatializedPathingBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create spatialized pathing buffer for spatialization effect. [%d]"), Status);
-        }
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create spatialized pathing buffer for spatialization effect. [%d]"), Status);
     }
 
-    if (!Source.OutBuffer.data)
+    Status = iplAudioBufferAllocate(Context, 2, AudioSettings.frameSize, &Effects.OutBuffer);
+    if (Status != IPL_STATUS_SUCCESS)
     {
-        IPLerror Status = iplAudioBufferAllocate(Context, 2, AudioSettings.frameSize, &Source.OutBuffer);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create output buffer for spatialization effect. [%d]"), Status);
-        }
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create output buffer for spatialization effect. [%d]"), Status);
     }
-
-    Source.PrevOrder = SimulationSettings.maxOrder;
-    Source.Reset();
 }
 
 void FSteamAudioSpatializationPlugin::OnReleaseSource(const uint32 SourceId)
 {
     FSteamAudioSpatializationSource& Source = Sources[SourceId];
-    Source.Reset();
-    iplHRTFRelease(&Source.HRTF);
+    if (Source.Effects)
+    {
+        Source.Effects->Reset();
+    }
+
+    Slabs.Unpin(Source.Slab);
+    Source.Slab = nullptr;
+    Source.Effects = nullptr;
 }
 
 void FSteamAudioSpatializationPlugin::ProcessAudio(const FAudioPluginSourceInputData& InputData, FAudioPluginSourceOutputData& OutputData)
@@ -304,14 +347,23 @@ void FSteamAudioSpatializationPlugin::ProcessAudio(const FAudioPluginSourceInput
         return;
     }
 
+    FScopedNoAllocation NoAllocation;
+
     FSteamAudioSpatializationSource& Source = Sources[InputData.SourceId];
 
+    // A voice that started before Steam Audio was initialized picks up the slab as soon as it's published.
+    if (!PinSlab(InputData.SourceId))
+        return;
+
+    FSteamAudioSpatializationEffects& Effects = *Source.Effects;
+    IPLHRTF HRTF = Source.Slab->HRTF;
+
     float* InBufferData = InputData.AudioBuffer->GetData();
     float* OutBufferData = OutputData.AudioBuffer.GetData();
 
     IPLContext Context = FSteamAudioModule::GetManager().GetContext();
 
-    Source.ClearBuffers();
+    Effects.ClearBuffers();
 
     // The input buffer is always mono, so we don't need to deinterleave it into a temporary buffer.
     IPLAudioBuffer InBuffer{};
@@ -319,7 +371,7 @@ void FSteamAudioSpatializationPlugin::ProcessAudio(const FAudioPluginSourceInput
     InBuffer.numSamples = AudioSettings.frameSize;
     InBuffer.data = &InBufferData;
 
-    if (Source.HRTF && Source.PanningEffect && Source.BinauralEffect && Source.OutBuffer.data)
+    if (HRTF && Effects.PanningEffect && Effects.BinauralEffect && Effects.OutBuffer.data)
     {
         // Workaround. The directions passed to spatializer is not consistent with the coordinate system of UE4, therefore
         // special tranformation is performed here. Review this change if further changes are made to the direction passed
@@ -336,67 +388,67 @@ void FSteamAudioSpatializationPlugin::ProcessAudio(const FAudioPluginSourceInput
             Params.direction = RelativeDirection;
             Params.interpolation = static_cast<IPLHRTFInterpolation>(Source.Interpolation);
             Params.spatialBlend = 1.0f;
-            Params.hrtf = Source.HRTF;
+            Params.hrtf = HRTF;
 
-            iplBinauralEffectApply(Source.BinauralEffect, &Params, &InBuffer, &Source.OutBuffer);
+            iplBinauralEffectApply(Effects.BinauralEffect, &Params, &InBuffer, &Effects.OutBuffer);
         }
         else
         {
             IPLPanningEffectParams Params{};
             Params.direction = RelativeDirection;
 
-            iplPanningEffectApply(Source.PanningEffect, &Params, &InBuffer, &Source.OutBuffer);
+            iplPanningEffectApply(Effects.PanningEffect, &Params, &InBuffer, &Effects.OutBuffer);
         }
     }
 
     // Apply pathing if specified.
-    if (Source.bApplyPathing && Source.HRTF && Source.PathEffect && Source.AmbisonicsDecodeEffect &&
-        Source.PathingInputBuffer.data && Source.PathingBuffer.data && Source.SpatializedPathingBuffer.data && Source.OutBuffer.data)
+    if (Source.bApplyPathing && HRTF && Effects.PathEffect && Effects.AmbisonicsDecodeEffect &&
+        Effects.PathingInputBuffer.data && Effects.PathingBuffer.data && Effects.SpatializedPathingBuffer.data && Effects.OutBuffer.data)
     {
         // FIXME: Unreal 4.27 does not pass the audio component id correctly to the spatializer plugin. It does this
         // correctly for the occlusion and reverb plugins.
-        UAudioComponent* AudioComponent = UAudioComponent::GetAudioComponentFromID(InputData.AudioComponentId);
-        USteamAudioSourceComponent* SteamAudioSourceComponent = AudioComponent && AudioComponent->GetOwner() ? AudioComponent->GetOwner()->FindComponentByClass<USteamAudioSourceComponent>() : nullptr;
+        FSteamAudioSourceOutputs SourceOutputs;
 
-        if (SteamAudioSourceComponent && FSteamAudioModule::IsPlaying())
+        bool bIsPlaying = FSteamAudioModule::IsPlaying();
+        if (bIsPlaying)
         {
-            IPLSimulationSettings SimulationSettings = FSteamAudioModule::GetManager().GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
+            FSteamAudioModule::GetManager().RefreshSettingsSnapshot(SettingsSnapshot, SettingsGeneration);
+        }
 
-            IPLSimulationOutputs Outputs = SteamAudioSourceComponent->GetOutputs(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
+        if (bIsPlaying && SettingsSnapshot && FSteamAudioModule::GetManager().GetSourceOutputs(InputData.SourceId, InputData.AudioComponentId, SourceOutputs) && SourceOutputs.bHasIndirectOutputs)
+        {
+            const IPLSimulationSettings& SimulationSettings = SettingsSnapshot->RealTimeSettings;
 
-            if (Outputs.pathing.shCoeffs)
+            if (SourceOutputs.NumPathingCoeffs > 0)
             {
-                FMemory::Memcpy(Source.PathingCoeffs.GetData(), Outputs.pathing.shCoeffs, Source.PathingCoeffs.Num() * sizeof(float));
+                FMemory::Memcpy(Effects.PathingCoeffs.GetData(), SourceOutputs.PathingCoeffs, FMath::Min(Effects.PathingCoeffs.Num(), SourceOutputs.NumPathingCoeffs) * sizeof(float));
             }
 
-            for (int i = 0; i < InBuffer.numSamples; ++i)
-            {
-                Source.PathingInputBuffer.data[0][i] = Source.PathingMixLevel * InBuffer.data[0][i];
-            }
+            SteamAudio::CopyAndScale(InBuffer.data[0], InBuffer.numSamples, Source.PathingMixLevel, Effects.PathingInputBuffer.data[0]);
 
-            IPLPathEffectParams PathingParams = Outputs.pathing;
+            IPLPathEffectParams PathingParams = SourceOutputs.Pathing;
             PathingParams.order = SimulationSettings.maxOrder;
             PathingParams.binaural = (Source.bApplyHRTFToPathing && !FUnrealAudioEngineState::IsHRTFDisabled()) ? IPL_TRUE : IPL_FALSE;
-            PathingParams.hrtf = Source.HRTF;
-            PathingParams.listener = FSteamAudioModule::GetManager().GetListenerCoordinates();
+            PathingParams.hrtf = HRTF;
+            PathingParams.listener = (SourceOutputs.bHasListenerCoordinates) ? SourceOutputs.ListenerCoordinates : FSteamAudioModule::GetManager().GetListenerCoordinates();
             PathingParams.normalizeEQ = Source.bNormalizePathingEQ ? IPL_TRUE : IPL_FALSE;
 
-            PathingParams.shCoeffs = Source.PathingCoeffs.GetData();
+            PathingParams.shCoeffs = Effects.PathingCoeffs.GetData();
             for (int i = 0; i < 3; i++)
             {
                 PathingParams.eqCoeffs[i] = FMath::Max(PathingParams.eqCoeffs[i], 0.1f);
             }
 
-            iplPathEffectApply(Source.PathEffect, &PathingParams, &Source.PathingInputBuffer, &Source.SpatializedPathingBuffer);
+            iplPathEffectApply(Effects.PathEffect, &PathingParams, &Effects.PathingInputBuffer, &Effects.SpatializedPathingBuffer);
 
-            iplAudioBufferMix(Context, &Source.SpatializedPathingBuffer, &Source.OutBuffer);
+            iplAudioBufferMix(Context, &Effects.SpatializedPathingBuffer, &Effects.OutBuffer);
         }
     }
 
     // Interleave OutBuffer into the actual output buffer.
-    if (Source.OutBuffer.data)
+    if (Effects.OutBuffer.data)
     {
-        iplAudioBufferInterleave(Context, &Source.OutBuffer, OutBufferData);
+        iplAudioBufferInterleave(Context, &Effects.OutBuffer, OutBufferData);
     }
 }
 
@@ -17,32 +17,23 @@
 #pragma once
 
 #include "SteamAudioModule.h"
+#include "SteamAudioManager.h"
 #include "SteamAudioSpatializationSettings.h"
 
 namespace SteamAudio {
 
 // ---------------------------------------------------------------------------------------------------------------------
-// FSteamAudioSpatializationSource
+// FSteamAudioSpatializationEffects
 // ---------------------------------------------------------------------------------------------------------------------
 
 /**
- * Rendering state for a single spatialized source voice.
+ * Effects and buffers for a single spatialized source voice.
  */
-struct FSteamAudioSpatializationSource
+struct FSteamAudioSpatializationEffects
 {
-    FSteamAudioSpatializationSource();
-
-    ~FSteamAudioSpatializationSource();
-
-    bool bBinaural;
-    EHRTFInterpolation Interpolation;
-    bool bApplyPathing;
-    bool bApplyHRTFToPathing;
-    float PathingMixLevel;
-    bool bNormalizePathingEQ;
+    FSteamAudioSpatializationEffects();
 
-    /** Retained reference to the HRTF. */
-    IPLHRTF HRTF;
+    ~FSteamAudioSpatializationEffects();
 
     /** Used when bBinaural is false. */
     IPLPanningEffect PanningEffect;
@@ -68,8 +59,6 @@ struct FSteamAudioSpatializationSource
     /** Spatialized output, in deinterleaved format. */
     IPLAudioBuffer OutBuffer;
 
-    int PrevOrder;
-
     TArray<float> PathingCoeffs;
 
     void Reset();
@@ -78,6 +67,55 @@ struct FSteamAudioSpatializationSource
 };
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSpatializationSlab
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Effects and buffers for every source voice, built on the game thread for a given HRTF and Ambisonic order.
+ */
+struct FSteamAudioSpatializationSlab : public FSteamAudioSlab
+{
+    virtual ~FSteamAudioSpatializationSlab();
+
+    /** Retained reference to the HRTF the effects were created with. */
+    IPLHRTF HRTF = nullptr;
+
+    /** Ambisonic order the pathing effects were created with. */
+    int Order = -1;
+
+    /** Indexed by source id. */
+    TArray<FSteamAudioSpatializationEffects> Effects;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSpatializationSource
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Rendering state for a single spatialized source voice.
+ */
+struct FSteamAudioSpatializationSource
+{
+    FSteamAudioSpatializationSource();
+
+    bool bBinaural;
+    EHRTFInterpolation Interpolation;
+    bool bApplyPathing;
+    bool bApplyHRTFToPathing;
+    float PathingMixLevel;
+    bool bNormalizePathingEQ;
+
+    /** The slab the voice renders with, pinned from when the voice starts until it stops. Null if no slab had been
+        published yet. */
+    FSteamAudioSpatializationSlab* Slab;
+
+    /** The voice's entry in Slab. */
+    FSteamAudioSpatializationEffects* Effects;
+};
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // FSteamAudioSpatializationPlugin
 // ---------------------------------------------------------------------------------------------------------------------
@@ -88,6 +126,8 @@ struct FSteamAudioSpatializationSource
 class FSteamAudioSpatializationPlugin : public IAudioSpatialization
 {
 public:
+    virtual ~FSteamAudioSpatializationPlugin();
+
     /**
      * Inherited from IAudioSpatialization
      */
@@ -108,11 +148,34 @@ public:
     virtual void ProcessAudio(const FAudioPluginSourceInputData& InputData, FAudioPluginSourceOutputData& OutputData) override;
 
 private:
+    /** Builds and publishes a new slab if the HRTF or the Ambisonic order has changed. Called on the game thread
+        whenever the settings snapshot is rebuilt. */
+    void OnSettingsSnapshotRebuilt(const FSteamAudioSettingsSnapshotPtr& Snapshot);
+
+    /** Allocates the effects and buffers for a single voice. */
+    void PrepareEffects(FSteamAudioSpatializationEffects& Effects, IPLHRTF HRTF, const IPLSimulationSettings& SimulationSettings);
+
+    /** Pins the published slab for the given source, if it doesn't have one yet. Returns false if there is none. */
+    bool PinSlab(uint32 SourceId);
+
     /** Audio pipeline settings. */
     IPLAudioSettings AudioSettings;
 
-    /** Lazy-initialized state for as many sources as we can render simultaneously. */
+    /** State for as many sources as we can render simultaneously, allocated up front by Initialize. */
     TArray<FSteamAudioSpatializationSource> Sources;
+
+    /** Effects and buffers for every source, built whenever the settings change, so starting a voice doesn't need to
+        allocate. */
+    TSteamAudioSlabs<FSteamAudioSpatializationSlab> Slabs;
+
+    /** Handle for our OnSettingsSnapshotRebuilt binding. */
+    FDelegateHandle SettingsSnapshotRebuiltHandle;
+
+    /** The most recent settings snapshot seen by the audio thread. */
+    FSteamAudioSettingsSnapshotPtr SettingsSnapshot;
+
+    /** Settings generation that SettingsSnapshot was fetched for. */
+    uint32 SettingsGeneration = 0;
 };
 
 
@@ -15,9 +15,12 @@
 //
 
 #include "SteamAudioStaticMeshActor.h"
+#include "Async/Async.h"
 #include "EngineUtils.h"
 #include "SteamAudioManager.h"
 #include "SteamAudioScene.h"
+#include "SteamAudioSerializedObject.h"
+#include "UObject/StrongObjectPtr.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 // ASteamAudioStaticMeshActor
@@ -26,44 +29,125 @@
 ASteamAudioStaticMeshActor::ASteamAudioStaticMeshActor()
     : Asset()
     , Scene(nullptr)
-    , StaticMesh(nullptr)
+    , StaticMeshLoadRequest(0)
 {}
 
 void ASteamAudioStaticMeshActor::BeginPlay()
 {
     Super::BeginPlay();
 
-    SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
-
     // If an asset isn't specified, then we haven't yet exported this dynamic object, so do nothing.
     if (!Asset.IsAsset())
         return;
 
-    if (!Manager.InitializeSteamAudio(SteamAudio::EManagerInitReason::PLAYING))
+    // Initialization may still be running in the background, in which case loading waits for it to finish.
+    SteamAudio::FSteamAudioModule::GetManager().WhenInitialized(this, [this]()
+    {
+        OnSteamAudioInitialized();
+    });
+}
+
+void ASteamAudioStaticMeshActor::OnSteamAudioInitialized()
+{
+    if (!HasActorBegunPlay() && !IsActorBeginningPlay())
         return;
 
+    SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+
     Scene = iplSceneRetain(Manager.GetScene());
     if (!Scene)
         return;
 
-    StaticMesh = SteamAudio::LoadStaticMeshFromAsset(Asset, Manager.GetContext(), Scene);
-    if (!StaticMesh)
-    {
-        iplSceneRelease(&Scene);
-        return;
-    }
+    // Load the .uasset asynchronously. This only reads the object header; the geometry is read from disk and loaded
+    // into Static Mesh and Instanced Mesh objects on a worker thread, after which they are added to the scene.
+    int32 RequestId = ++StaticMeshLoadRequest;
+    TWeakObjectPtr<ASteamAudioStaticMeshActor> WeakThis(this);
 
-    iplStaticMeshAdd(StaticMesh, Scene);
+    Asset.LoadAsync(FLoadSoftObjectPathAsyncDelegate::CreateLambda([WeakThis, RequestId](const FSoftObjectPath& LoadedPath, UObject* LoadedObject)
+    {
+        ASteamAudioStaticMeshActor* StaticMeshActor = WeakThis.Get();
+        if (!StaticMeshActor || StaticMeshActor->StaticMeshLoadRequest != RequestId || !StaticMeshActor->Scene)
+            return;
+
+        USteamAudioSerializedObject* AssetObject = Cast<USteamAudioSerializedObject>(LoadedObject);
+        if (!AssetObject)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to load static geometry asset: %s"), *LoadedPath.ToString());
+            return;
+        }
+
+        TStrongObjectPtr<USteamAudioSerializedObject> AssetObjectRef(AssetObject);
+        IPLContext Context = iplContextRetain(SteamAudio::FSteamAudioModule::GetManager().GetContext());
+        IPLScene TargetScene = iplSceneRetain(StaticMeshActor->Scene);
+
+        Async(EAsyncExecution::ThreadPool, [WeakThis, RequestId, AssetObjectRef = MoveTemp(AssetObjectRef), Context, TargetScene]() mutable
+        {
+            TArray<IPLInstancedMesh> LoadedInstancedMeshes;
+            IPLStaticMesh LoadedStaticMesh = SteamAudio::LoadStaticMeshFromSerializedObject(AssetObjectRef.Get(), Context, TargetScene);
+            if (LoadedStaticMesh)
+            {
+                SteamAudio::LoadInstancedMeshesFromSerializedObject(AssetObjectRef.Get(), Context, TargetScene, LoadedInstancedMeshes);
+            }
+
+            iplContextRelease(&Context);
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, RequestId, AssetObjectRef = MoveTemp(AssetObjectRef), TargetScene, LoadedStaticMesh, LoadedInstancedMeshes = MoveTemp(LoadedInstancedMeshes)]() mutable
+            {
+                AssetObjectRef.Reset();
+
+                ASteamAudioStaticMeshActor* StaticMeshActor = WeakThis.Get();
+                if (!LoadedStaticMesh || !StaticMeshActor || StaticMeshActor->StaticMeshLoadRequest != RequestId || StaticMeshActor->Scene != TargetScene)
+                {
+                    iplStaticMeshRelease(&LoadedStaticMesh);
+                    for (IPLInstancedMesh& InstancedMesh : LoadedInstancedMeshes)
+                    {
+                        iplInstancedMeshRelease(&InstancedMesh);
+                    }
+
+                    iplSceneRelease(&TargetScene);
+                    return;
+                }
+
+                IPLStaticMesh MeshToAdd = iplStaticMeshRetain(LoadedStaticMesh);
+                TArray<IPLInstancedMesh> InstancedMeshesToAdd;
+                for (IPLInstancedMesh InstancedMesh : LoadedInstancedMeshes)
+                {
+                    InstancedMeshesToAdd.Add(iplInstancedMeshRetain(InstancedMesh));
+                }
+
+                // Ownership of the retained scene moves to the scene update.
+                SteamAudio::FSteamAudioModule::GetManager().EnqueueSceneUpdate([MeshToAdd, InstancedMeshesToAdd, TargetScene]() mutable
+                {
+                    iplStaticMeshAdd(MeshToAdd, TargetScene);
+                    iplStaticMeshRelease(&MeshToAdd);
+
+                    for (IPLInstancedMesh& InstancedMesh : InstancedMeshesToAdd)
+                    {
+                        iplInstancedMeshAdd(InstancedMesh, TargetScene);
+                        iplInstancedMeshRelease(&InstancedMesh);
+                    }
+
+                    iplSceneRelease(&TargetScene);
+                });
+
+                // The geometry cache takes over the loaded geometry, and starts watching the level for changes to it.
+                StaticMeshActor->GeometryCache = MakeShared<SteamAudio::FStaticGeometryCache, ESPMode::ThreadSafe>(StaticMeshActor->GetWorld(),
+                    StaticMeshActor->GetLevel(), StaticMeshActor->Scene, LoadedStaticMesh, MoveTemp(LoadedInstancedMeshes));
+            });
+        });
+    }));
 }
 
 void ASteamAudioStaticMeshActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+    // Discard any load that is still in flight.
+    ++StaticMeshLoadRequest;
+
+    // The geometry cache removes its chunks and the geometry loaded from the asset when destroyed.
+    GeometryCache.Reset();
 
-    if (Scene && StaticMesh)
+    if (Scene)
     {
-        iplStaticMeshRemove(StaticMesh, Scene);
-        iplStaticMeshRelease(&StaticMesh);
         iplSceneRelease(&Scene);
     }
 
@@ -72,21 +156,17 @@ void ASteamAudioStaticMeshActor::EndPlay(const EEndPlayReason::Type EndPlayReaso
 
 void ASteamAudioStaticMeshActor::UpdateStaticMesh()
 {
-    if (Scene && StaticMesh)
+    if (GeometryCache)
     {
-        UWorld* World = GEngine->GetCurrentPlayWorld();
-        ULevel* Level = World->GetCurrentLevel();
-        SteamAudio::UpdateStaticGeometryForLevel(World, Level, StaticMesh);
+        GeometryCache->Update();
     }
 }
 
-void ASteamAudioStaticMeshActor::UpdateStaticMeshMaterial(AActor* RefreshableActor)
+void ASteamAudioStaticMeshActor::UpdateStaticMeshMaterials(TArrayView<const SteamAudio::FStaticMeshMaterialChange> Changes)
 {
-    if (Scene && StaticMesh)
+    if (GeometryCache && Changes.Num() > 0)
     {
-        UWorld* World = GEngine->GetCurrentPlayWorld();
-        ULevel* Level = World->GetCurrentLevel();
-        SteamAudio::UpdateStaticMeshMaterial(World, Level, StaticMesh, RefreshableActor);
+        GeometryCache->SetMaterials(Changes);
     }
 }
 
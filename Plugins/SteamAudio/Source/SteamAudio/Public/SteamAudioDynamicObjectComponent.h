@@ -54,6 +54,10 @@ public:
 
     FSoftObjectPath GetAssetToLoad();
 
+    /** Applies the owning actor's current transform to the Instanced Mesh object. Called by the Steam Audio Manager
+        when it is safe to modify the scene. */
+    void UpdateTransform();
+
 protected:
     /**
      * Inherited from UActorComponent
@@ -62,6 +66,9 @@ protected:
     /** Called when the component has been initialized. */
     virtual void BeginPlay() override;
 
+    /** Called when the component stops playing. */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     /** Called when the component is going to be destroyed. */
     virtual void BeginDestroy() override;
 
@@ -72,6 +79,10 @@ private:
     /** The Instanced Mesh object. */
     IPLInstancedMesh InstancedMesh;
 
+    /** Center of the owning actor's bounding box, relative to its root component. Computed once at BeginPlay, since
+        the bounding box is expensive to compute and doesn't change relative to the root component as the actor moves. */
+    FVector PivotOffset;
+
 #if WITH_EDITOR
     /** Equal true if the asset is not deleted */
     bool bIsAssetActive = true;
@@ -80,4 +91,7 @@ private:
 #endif
 
     void OnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+    /** Loads the dynamic object and adds it to the scene, once Steam Audio is initialized. */
+    void OnSteamAudioInitialized();
 };
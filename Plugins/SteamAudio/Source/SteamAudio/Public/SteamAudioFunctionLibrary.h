@@ -22,6 +22,7 @@
 
 class USteamAudioDynamicObjectComponent;
 class USteamAudioListenerComponent;
+class USteamAudioMaterial;
 class USteamAudioSourceComponent;
 class AStaticMeshActor;
 
@@ -47,10 +48,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category="SteamAudio")
 	static void UpdateStaticMesh();
 
-	/** Updates the iplStaticMesh material data on specified StaticMeshActor. */
+	/** Updates the iplStaticMesh material data on specified StaticMeshActor. Changes made during the same frame are
+		applied together, once their Steam Audio Material assets have loaded. */
 	UFUNCTION(BlueprintCallable, Category="SteamAudio")
 	static void UpdateStaticMeshMaterial(AStaticMeshActor* StaticMeshActor);
 
+	/** Starts loading the given Steam Audio Material assets in the background, so that changing geometry to them with
+		UpdateStaticMeshMaterial takes effect without waiting for a load. */
+	UFUNCTION(BlueprintCallable, Category="SteamAudio")
+	static void PreloadMaterials(const TArray<TSoftObjectPtr<USteamAudioMaterial>>& Materials);
+
 	/** Shuts down the global Steam Audio state. */
 	UFUNCTION(BlueprintCallable, Category="SteamAudio")
 	static void ShutDownSteamAudio(bool bResetFlags = true);
@@ -68,6 +75,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category="SteamAudio")
 	static void RemoveSource(USteamAudioSourceComponent* Source);
 
+	/** Returns the registered Steam Audio Source components within the given distance of a location, as of the last
+		simulation update. */
+	UFUNCTION(BlueprintCallable, Category="SteamAudio")
+	static TArray<USteamAudioSourceComponent*> GetSourcesInRadius(FVector Location, float Radius);
+
+	/** Returns up to Count registered Steam Audio Source components closest to a location, closest first, as of the
+		last simulation update. */
+	UFUNCTION(BlueprintCallable, Category="SteamAudio")
+	static TArray<USteamAudioSourceComponent*> GetNearestSources(FVector Location, int32 Count);
+
 	/** Registers a Steam Audio Listener component for simulation. */
 	UFUNCTION(BlueprintCallable, Category="SteamAudio")
 	static void AddListener(USteamAudioListenerComponent* Listener);
@@ -65,9 +65,15 @@ public:
 
 	USteamAudioListenerComponent();
 
+    /** Returns the Steam Audio source object used for listener-centric reverb. */
+    IPLSource GetSource() const { return Source; }
+
     /** Sets simulation inputs. */
 	void SetInputs();
 
+    /** Fills in reverb simulation inputs based on the listener position and component properties. */
+    void GetInputs(IPLSimulationInputs& Inputs) const;
+
     /** Retrieves simulation outputs. */
 	IPLSimulationOutputs GetOutputs();
 
@@ -112,4 +118,7 @@ private:
 
 	/** The current listener. */
 	static USteamAudioListenerComponent* CurrentListener;
+
+	/** Creates the reverb source and registers the listener for simulation, once Steam Audio is initialized. */
+	void OnSteamAudioInitialized();
 };
@@ -94,6 +94,14 @@ public:
     /** Returns true if we're currently playing (i.e., in a standalone game or in play-in-editor mode. */
     static bool IsPlaying();
 
+    /** Initializes Steam Audio for gameplay and counts as a play session until EndOfflineSession is called, so the
+        audio plugins can be driven directly (e.g., by a benchmark) without a game, PIE session, or audio device.
+        Returns false if initialization failed. */
+    static STEAMAUDIO_API bool BeginOfflineSession();
+
+    /** Ends a session started with BeginOfflineSession, shutting down Steam Audio if nothing else is playing. */
+    static STEAMAUDIO_API void EndOfflineSession();
+
     /** Returns the audio engine interface. */
     static IAudioEngineState* GetAudioEngineState();
 
@@ -37,6 +37,18 @@ enum class EProbeGenerationType : uint8
     UNIFORM_FLOOR   UMETA(DisplayName = "Uniform Floor"),
 };
 
+/**
+ * How baked data is compressed when it is saved. Compression is lossless; data is decompressed when the probe batch
+ * is loaded.
+ */
+UENUM(BlueprintType)
+enum class EBakedDataCompression : uint8
+{
+    NONE    UMETA(DisplayName = "None"),
+    FAST    UMETA(DisplayName = "Fast (LZ4)"),
+    SMALL   UMETA(DisplayName = "Small (Oodle)"),
+};
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // FSteamAudioBakedDataInfo
@@ -73,6 +85,14 @@ struct FSteamAudioBakedDataInfo
     /** Size (in bytes) of the baked data in this layer. */
     UPROPERTY()
     int Size = 0;
+
+    /** Hash of the probes, geometry, and settings this layer was baked with. Empty if unknown. */
+    UPROPERTY()
+    FString ContentHash;
+
+    /** Time (in seconds) taken to bake this layer. 0 if unknown. */
+    UPROPERTY()
+    float BakeSeconds = 0.0f;
 };
 
 
@@ -105,18 +125,52 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProbeBatchSettings)
     float HeightAboveFloor;
 
+    /** If true, probes are placed more densely near occluders and changes in floor height, and more sparsely in open
+        areas, starting from a uniform floor layout at Horizontal Spacing. Only when using uniform floor probe
+        generation. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProbeBatchSettings)
+    bool bAdaptiveSpacing;
+
+    /** Horizontal spacing (in meters) between probes near occluders and changes in floor height. Only when using
+        adaptive spacing. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProbeBatchSettings, meta = (ClampMin = "0.25"))
+    float MinHorizontalSpacing;
+
+    /** Largest horizontal spacing (in meters) between probes in open areas. Only when using adaptive spacing. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProbeBatchSettings, meta = (ClampMin = "0.25"))
+    float MaxHorizontalSpacing;
+
     /** Number of probes generated. */
     UPROPERTY(VisibleAnywhere, Category = ProbeBatchSettings, meta = (DisplayName = "Probes"))
     int32 NumProbes;
 
+    /** Number of probes uniform floor generation places at Horizontal Spacing. Compared against the number of probes
+        generated to report the savings from adaptive spacing. */
+    UPROPERTY(VisibleAnywhere, Category = ProbeBatchSettings, meta = (DisplayName = "Uniform Probes"))
+    int32 NumUniformProbes;
+
+    /** How to compress the probe data when it is saved. Takes effect the next time probes are generated, or baked
+        data is added or removed. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProbeBatchSettings)
+    EBakedDataCompression BakedDataCompression;
+
     /** Size (in bytes) of the probe data. */
     UPROPERTY(VisibleAnywhere, Category = ProbeBatchSettings)
     int32 DataSize;
 
+    /** Size (in bytes) of the probe data as stored on disk, after compression. */
+    UPROPERTY(VisibleAnywhere, Category = ProbeBatchSettings)
+    int32 CompressedDataSize;
+
     /** Detailed size information about each layer of baked data in this probe volume. */
     UPROPERTY(VisibleAnywhere, Category = ProbeBatchSettings)
     TArray<FSteamAudioBakedDataInfo> DetailedStats;
 
+    /** Hash of the static geometry, volume transform, and generation settings the probes were generated with. Empty
+        if unknown. */
+    UPROPERTY()
+    FString ProbeContentHash;
+
     /** Component containing probe data for in-editor visualization. */
     UPROPERTY()
     USteamAudioProbeComponent* ProbeComponent;
@@ -137,8 +191,15 @@ public:
     /** Generates probes. */
     bool GenerateProbes(ASteamAudioStaticMeshActor* StaticMeshActor, FString AssetName);
 
-    /** Sets the total size of baked data (for stats display). */
-    void UpdateTotalSize(int Size);
+    /** Sets the total size of baked data, before and after compression (for stats display). */
+    void UpdateTotalSize(int Size, int CompressedSize);
+
+    /** Returns the compression format (see FCompression) to save the probe data with, or NAME_None. */
+    FName GetCompressionFormat() const;
+
+    /** Returns the size (in bytes) of the given layer after compression. Layers are compressed together, so this
+        assumes every layer compresses as well as the probe data as a whole. */
+    int GetCompressedLayerSize(int Index) const;
 
     /** Resets detailed stats. Called when probes are generated. */
     void ResetLayers();
@@ -147,13 +208,29 @@ public:
     void RemoveLayer(const FString& Name);
 
     /** Adds (if missing) or updates stats for the given layer. Called when the layer is baked. */
-    void AddOrUpdateLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size);
+    void AddOrUpdateLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size, const FString& ContentHash = FString(), float BakeSeconds = 0.0f);
 
     /** Adds stats for the given layer. */
-    void AddLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size);
+    void AddLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size, const FString& ContentHash = FString(), float BakeSeconds = 0.0f);
 
     /** Updates stats for the given layer. */
-    void UpdateLayer(const FString& Name, int Size);
+    void UpdateLayer(const FString& Name, int Size, const FString& ContentHash = FString(), float BakeSeconds = 0.0f);
+
+    /** Returns the hash of the inputs to the most recent bake of the given layer, or an empty string if the layer has not
+        been baked. */
+    FString GetLayerContentHash(const FString& Name);
+
+    /** Returns the hash of the inputs to probe generation: the static geometry, the volume's transform, and the
+        generation settings. Returns an empty string if the static geometry's hash is unknown. */
+    FString CalcProbeContentHash(const FString& StaticGeometryContentHash) const;
+
+    /** Returns the total time (in seconds) taken to bake every layer in this probe volume. */
+    float GetTotalBakeSeconds() const;
+
+    /** Returns an estimate of the time (in seconds) adaptive spacing saved when baking the layers in this probe
+        volume, compared to baking them with uniform spacing. Bake time grows roughly linearly with the number of
+        probes, so this scales the measured bake times by the number of probes removed. */
+    float GetEstimatedBakeSecondsSaved() const;
 
     /** Returns the index of the given layer in the stats array. */
     int FindLayer(const FString& Name);
@@ -175,4 +252,10 @@ private:
 
     /** The Probe Batch object. */
     IPLProbeBatch ProbeBatch;
+
+    /** Incremented whenever a probe batch load is started or abandoned, so stale loads can be discarded. */
+    int32 ProbeBatchLoadRequest;
+
+    /** Starts loading the probe batch, once Steam Audio is initialized. */
+    void OnSteamAudioInitialized();
 };
@@ -17,14 +17,59 @@
 #pragma once
 
 #include "SteamAudioModule.h"
+#include "Serialization/BulkData.h"
 #include "SteamAudioSerializedObject.generated.h"
 
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSerializedMesh
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Geometry shared by several instances in a level's static geometry.
+ */
+USTRUCT()
+struct STEAMAUDIO_API FSteamAudioSerializedMesh
+{
+    GENERATED_BODY()
+
+    /** Data from an IPLSerializedObject containing a single Static Mesh, in local space. */
+    UPROPERTY()
+    TArray<uint8> Data;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioMeshInstance
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * A single placement of a shared mesh.
+ */
+USTRUCT()
+struct STEAMAUDIO_API FSteamAudioMeshInstance
+{
+    GENERATED_BODY()
+
+    /** Index of the mesh in SharedMeshes. */
+    UPROPERTY()
+    int32 MeshIndex = INDEX_NONE;
+
+    /** Transform from the mesh's local space to world space. */
+    UPROPERTY()
+    FTransform Transform;
+};
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // USteamAudioSerializedObject
 // ---------------------------------------------------------------------------------------------------------------------
 
 /**
  * An object containing data from an IPLSerializedObject that can be serialized to a .uasset file.
+ *
+ * The data itself is stored as bulk data that is not inlined with the rest of the object, so loading the asset only
+ * reads the (small) object header. The data is read from disk when it is copied out using CopyData, typically from a
+ * worker thread.
  */
 UCLASS()
 class STEAMAUDIO_API USteamAudioSerializedObject : public UObject
@@ -32,11 +77,68 @@ class STEAMAUDIO_API USteamAudioSerializedObject : public UObject
     GENERATED_BODY()
 
 public:
-    /** The data to serialize. */
+    /** The data to serialize, in assets saved before the data was moved to bulk data. Moved to the bulk data when
+        loaded. */
     UPROPERTY()
     TArray<uint8> Data;
 
+    /** For static geometry, meshes that are used several times in the level. Not included in Data. */
+    UPROPERTY()
+    TArray<FSteamAudioSerializedMesh> SharedMeshes;
+
+    /** For static geometry, every placement of the meshes in SharedMeshes. */
+    UPROPERTY()
+    TArray<FSteamAudioMeshInstance> Instances;
+
+    /** Hash of the inputs the data was created from (see FContentHash). Empty if unknown. */
+    UPROPERTY()
+    FString ContentHash;
+
+    /** Compression format the bulk data is stored in (see FCompression), or NAME_None if it is not compressed. */
+    UPROPERTY()
+    FName CompressionFormat;
+
+    /** Size (in bytes) of the data before compression. Only valid if the data is compressed. */
+    UPROPERTY()
+    int64 UncompressedDataSize = 0;
+
     /** Serializes the binary data in the provided IPLSerializedObject to a .uasset. The asset is specified using an
-        Unreal asset path of the form /Path/To/PackageName.ObjectName. */
-    static USteamAudioSerializedObject* SerializeObjectToPackage(IPLSerializedObject SerializedObject, const FString& AssetName);
+        Unreal asset path of the form /Path/To/PackageName.ObjectName. Shared meshes and instances, if any, are saved
+        along with it. If a compression format is given, the data is compressed with it, unless that doesn't make it
+        smaller. */
+    static USteamAudioSerializedObject* SerializeObjectToPackage(IPLSerializedObject SerializedObject, const FString& AssetName,
+        const TArray<FSteamAudioSerializedMesh>& SharedMeshes = TArray<FSteamAudioSerializedMesh>(),
+        const TArray<FSteamAudioMeshInstance>& Instances = TArray<FSteamAudioMeshInstance>(),
+        const FString& ContentHash = FString(), FName InCompressionFormat = NAME_None);
+
+    /** Returns the size (in bytes) of the data. */
+    int64 GetDataSize() const;
+
+    /** Returns the size (in bytes) of the data as stored on disk, after compression. */
+    int64 GetStoredDataSize() const;
+
+    /** Copies the data into the given buffer, reading it from disk and decompressing it if needed. Any copy held by
+        the bulk data is then discarded, so the data is only resident while the caller needs it. Can be called from any
+        thread. */
+    bool CopyData(TArray<uint8>& OutData);
+
+    /**
+     * Inherited from UObject
+     */
+
+    /** Serializes the object, including the bulk data. */
+    virtual void Serialize(FArchive& Ar) override;
+
+    /** Moves data from assets saved in the old format to the bulk data. */
+    virtual void PostLoad() override;
+
+private:
+    /** Replaces the contents of the bulk data, compressing it with the given format if that makes it smaller. */
+    void SetData(const uint8* InData, int64 Size, FName InCompressionFormat = NAME_None);
+
+    /** The data. */
+    FByteBulkData BulkData;
+
+    /** Serializes access to the bulk data. */
+    FCriticalSection BulkDataCriticalSection;
 };
@@ -107,6 +107,7 @@ struct FSteamAudioSettings
     bool bExportLandscapeGeometry;
     bool bExportBSPGeometry;
     int32 MinLODForExport;
+    int32 MinInstancesForSharedGeometry;
     IPLMaterial DefaultMeshMaterial;
     IPLMaterial DefaultLandscapeMaterial;
     IPLMaterial DefaultBSPMaterial;
@@ -136,7 +137,18 @@ struct FSteamAudioSettings
     float BakingPathRange;
     int BakedPathingCPUCoresPercentage;
     float SimulationUpdateInterval;
+    float DirectParamsUpdateDistance;
+    float DirectParamsUpdateAngle;
+    bool bEnableSimulationLOD;
+    int SimulationLODMaxFullRateSources;
+    int SimulationLODMaxIndirectSources;
+    int SimulationLODOcclusionSampleBudget;
+    float SimulationLODDecimationDistance;
+    float SimulationLODCullDistance;
+    int SimulationLODDecimatedUpdateInterval;
+    float SimulationLODDecimatedSampleFraction;
     IPLReflectionEffectType ReflectionEffectType;
+    int ReflectionEffectMemoryBudget;
     float HybridReverbTransitionTime;
     int HybridReverbOverlapPercent;
     IPLOpenCLDeviceType OpenCLDeviceType;
@@ -182,6 +194,11 @@ public:
     UPROPERTY(GlobalConfig, EditAnywhere, Category = SceneExportSettings, meta = (ClampMin = "0", DisplayName = "Minimum LOD For Export Geometry"))
     int32 MinLODForExport;
 
+    /** If a Static Mesh is used at least this many times in a level (with the same LOD and material), its geometry
+        is exported once and each use is placed as an instance. 0 exports every use as separate geometry. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SceneExportSettings, meta = (ClampMin = "0", DisplayName = "Minimum Instances For Shared Geometry"))
+    int32 MinInstancesForSharedGeometry;
+
     /** Reference to the Steam Audio Material asset to use as the default material for Static Mesh actors. */
 	UPROPERTY(GlobalConfig, EditAnywhere, Category = SceneExportSettings, meta = (AllowedClasses = "/Script/SteamAudio.SteamAudioMaterial"))
 	FSoftObjectPath DefaultMeshMaterial;
@@ -273,9 +290,60 @@ public:
     UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationUpdateSettings, meta = (UIMin = 0.1f, UIMax = 1.0f))
     float SimulationUpdateInterval;
 
+    /** Distance attenuation, air absorption, and directivity for a source are only recalculated once the source or
+        the listener has moved further than this distance (in meters) since they were last calculated. If 0, they are
+        recalculated whenever anything moves. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationUpdateSettings, meta = (ClampMin = 0.0f, UIMax = 1.0f))
+    float DirectParamsUpdateDistance;
+
+    /** Directivity for a source is also recalculated once the source has turned by more than this angle (in degrees)
+        since it was last calculated. If 0, it is recalculated whenever the source turns. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationUpdateSettings, meta = (ClampMin = 0.0f, UIMax = 10.0f))
+    float DirectParamsUpdateAngle;
+
+    /** If true, sources are simulated at a level of detail based on their distance to the listener, audibility, and
+        priority, so that the per-tick simulation cost stays within the budgets below. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationLODSettings, meta = (DisplayName = "Enable Simulation LOD"))
+    bool bEnableSimulationLOD;
+
+    /** The maximum number of sources whose direct simulation runs every tick with full settings. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationLODSettings, meta = (UIMin = 1, UIMax = 256, DisplayName = "Max Full Rate Sources"))
+    int SimulationLODMaxFullRateSources;
+
+    /** The maximum number of sources included in each reflections and pathing update. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationLODSettings, meta = (UIMin = 1, UIMax = 128, DisplayName = "Max Indirect Sources"))
+    int SimulationLODMaxIndirectSources;
+
+    /** The maximum number of occlusion samples traced across all sources in a single tick. 0 means no limit. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationLODSettings, meta = (UIMin = 0, UIMax = 4096, DisplayName = "Occlusion Sample Budget"))
+    int SimulationLODOcclusionSampleBudget;
+
+    /** Sources farther than this distance (in meters) from the listener are always decimated. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationLODSettings, meta = (UIMin = 0.0f, UIMax = 1000.0f, DisplayName = "Decimation Distance"))
+    float SimulationLODDecimationDistance;
+
+    /** Sources farther than this distance (in meters) from the listener are not simulated. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationLODSettings, meta = (UIMin = 0.0f, UIMax = 1000.0f, DisplayName = "Cull Distance"))
+    float SimulationLODCullDistance;
+
+    /** Decimated sources are simulated once every this many ticks. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationLODSettings, meta = (UIMin = 1, UIMax = 16, DisplayName = "Decimated Update Interval"))
+    int SimulationLODDecimatedUpdateInterval;
+
+    /** Fraction of the occlusion samples and transmission rays specified on the source to use for decimated
+        sources. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationLODSettings, meta = (UIMin = 0.0f, UIMax = 1.0f, DisplayName = "Decimated Sample Fraction"))
+    float SimulationLODDecimatedSampleFraction;
+
     UPROPERTY(GlobalConfig, EditAnywhere, Category = ReflectionEffectSettings)
     EReflectionEffectType ReflectionEffectType;
 
+    /** The maximum amount of memory (in MB) to use for the reflection effects of all sources combined. Reflection
+        effects are shared between sources, with the most audible sources getting one first; the remaining sources
+        fall back to parametric reverb. If 0, every source can have its own reflection effect. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = ReflectionEffectSettings, meta = (ClampMin = 0, UIMax = 1024, DisplayName = "Reflection Effect Memory Budget (MB)"))
+    int32 ReflectionEffectMemoryBudget;
+
 	UPROPERTY(GlobalConfig, EditAnywhere, Category = HybridReverbSettings, meta = (UIMin = 0.1f, UIMax = 2.0f))
 	float HybridReverbTransitionTime;
 
@@ -21,7 +21,9 @@
 #include "SteamAudioSourceComponent.generated.h"
 
 class ASteamAudioProbeVolume;
+class UAudioComponent;
 class USteamAudioBakedSourceComponent;
+struct FSteamAudioSettings;
 
 namespace SteamAudio {
 
@@ -138,6 +140,11 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = PathingSettings)
     bool bFindAlternatePaths;
 
+    /** Relative importance of this source when simulation LOD is enabled. Sources with higher priority are
+        simulated at full detail before sources with lower priority at the same distance. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SimulationLODSettings, meta = (UIMin = "0.0", UIMax = "10.0"))
+    float SimulationPriority;
+
     USteamAudioSourceComponent();
 
     IPLSource GetSource() { return Source; }
@@ -145,6 +152,10 @@ public:
     /** Sets simulation inputs for the given type of simulation. */
     void SetInputs(IPLSimulationFlags Flags);
 
+    /** Fills in simulation inputs based on component properties. The source coordinates and baked data identifier
+        are left for the caller to fill in. Only reads from the component, so it may be called from worker threads. */
+    void GetInputs(IPLSimulationInputs& Inputs, const FSteamAudioSettings& SteamAudioSettings) const;
+
     /** Retrieves simulation outputs for the given type of simulation. */
     IPLSimulationOutputs GetOutputs(IPLSimulationFlags Flags);
 
@@ -154,6 +165,19 @@ public:
     /** Returns the baked data identifier for this source. */
     IPLBakedDataIdentifier GetBakedDataIdentifier() const;
 
+    /** Returns how loud this source currently is, between 0 (silent or not playing) and 1. Sources without an Audio
+        Component are treated as fully audible. */
+    float GetAudibility() const;
+
+    /** Returns the number of occlusion samples traced for this source by a direct simulation. */
+    int32 GetOcclusionSampleCount() const;
+
+    /** Returns the index of this source in the simulation outputs published by the manager. */
+    int32 GetOutputSlot() const { return OutputSlot; }
+
+    /** Called by the manager when this source is registered or unregistered. */
+    void SetOutputSlot(int32 Slot) { OutputSlot = Slot; }
+
     /**
      * Inherited from UActorComponent
      */
@@ -185,4 +209,13 @@ private:
 
     /** Interface for communicating with the spatializer effect instance. */
     TSharedPtr<SteamAudio::IAudioEngineSource> AudioEngineSource;
+
+    /** The Audio Component on the owning actor, if any. */
+    TWeakObjectPtr<UAudioComponent> AudioComponent;
+
+    /** Creates the source and registers it for simulation, once Steam Audio is initialized. */
+    void OnSteamAudioInitialized();
+
+    /** Index of this source in the simulation outputs published by the manager, or INDEX_NONE if not registered. */
+    int32 OutputSlot;
 };
@@ -20,6 +20,28 @@
 #include "GameFramework/Actor.h"
 #include "SteamAudioStaticMeshActor.generated.h"
 
+namespace SteamAudio {
+class FStaticGeometryCache;
+
+/**
+ * A new material for the static geometry exported from one actor.
+ */
+struct FStaticMeshMaterialChange
+{
+    /** The actor whose material changed. */
+    AActor* Actor = nullptr;
+
+    /** Index of the actor's material in the level's exported static mesh. */
+    int32 ExportIndex = 0;
+
+    /** The Steam Audio Material asset that Material was converted from. */
+    FSoftObjectPath MaterialAsset;
+
+    /** The new material. */
+    IPLMaterial Material{};
+};
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // ASteamAudioStaticMeshActor
 // ---------------------------------------------------------------------------------------------------------------------
@@ -41,9 +63,12 @@ public:
 
     static ASteamAudioStaticMeshActor* FindInLevel(UWorld* World, ULevel* Level);
 
+    /** Rebuilds the static geometry of components in the level that have changed since the last call. */
     void UpdateStaticMesh();
 
-    void UpdateStaticMeshMaterial(AActor* RefreshableActor);
+    /** Applies new materials to the geometry of actors in this actor's level. All the changes are applied together,
+        followed by a single scene commit, at the Steam Audio Manager's next safe point. */
+    void UpdateStaticMeshMaterials(TArrayView<const SteamAudio::FStaticMeshMaterialChange> Changes);
 
 protected:
     /**
@@ -60,6 +85,13 @@ private:
     /** Retained reference to the main scene used by the Steam Audio Manager for simulation. */
     IPLScene Scene;
 
-    /** The Static Mesh object. */
-    IPLStaticMesh StaticMesh;
+    /** The level's static geometry, created once the asset has been loaded. Owns the Static Mesh and Instanced Mesh
+        objects loaded from the asset. */
+    TSharedPtr<SteamAudio::FStaticGeometryCache, ESPMode::ThreadSafe> GeometryCache;
+
+    /** Incremented whenever a static geometry load is started or abandoned, so stale loads can be discarded. */
+    int32 StaticMeshLoadRequest;
+
+    /** Starts loading the static geometry, once Steam Audio is initialized. */
+    void OnSteamAudioInitialized();
 };
@@ -0,0 +1,551 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioBakeCommandlet.h"
+#include "EngineUtils.h"
+#include "FileHelpers.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Engine/LevelStreaming.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "SteamAudioBakedListenerComponent.h"
+#include "SteamAudioBakedSourceComponent.h"
+#include "SteamAudioBaking.h"
+#include "SteamAudioCommandletHelpers.h"
+#include "SteamAudioProbeVolume.h"
+#include "SteamAudioScene.h"
+#include "SteamAudioSerializedObject.h"
+#include "SteamAudioStaticMeshActor.h"
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Runs the given function on a worker thread, while processing game thread tasks on the calling thread until it
+ * completes. Export, probe generation, and baking all block while running work on the game thread, so they cannot be
+ * called from the game thread directly when there is no editor loop ticking it.
+ */
+template <typename ReturnType>
+static ReturnType RunWhilePumpingGameThread(TUniqueFunction<ReturnType()> Function)
+{
+    check(IsInGameThread());
+
+    TFuture<ReturnType> Future = Async(EAsyncExecution::Thread, MoveTemp(Function));
+    while (!Future.IsReady())
+    {
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        FPlatformProcess::Sleep(0.01f);
+    }
+
+    return Future.Get();
+}
+
+static bool ShouldSkipLevel(ULevel* Level)
+{
+#if ((ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 0) || (ENGINE_MAJOR_VERSION > 5))
+    return Level->IsInstancedLevel();
+#else
+    return false;
+#endif
+}
+
+/** Returns a path for a new asset named after the given level, in the same folder as the level. */
+static FString GetDefaultAssetName(ULevel* Level, const FString& Suffix)
+{
+    FString LevelPackageName = Level->GetOutermost()->GetName();
+    FString AssetName = FPackageName::GetShortName(LevelPackageName) + Suffix;
+
+    return FPackageName::GetLongPackagePath(LevelPackageName) / AssetName + TEXT(".") + AssetName;
+}
+
+static int64 GetAssetDataSize(const FSoftObjectPath& Asset)
+{
+    if (!Asset.IsValid())
+        return 0;
+
+    USteamAudioSerializedObject* AssetObject = Cast<USteamAudioSerializedObject>(Asset.TryLoad());
+    return AssetObject ? AssetObject->GetDataSize() : 0;
+}
+
+/** Returns the level whose static geometry should be used for baking: the persistent level if it has static geometry,
+    otherwise the first sublevel that does. */
+static ULevel* FindBakeLevel(UWorld* World)
+{
+    ASteamAudioStaticMeshActor* StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, World->PersistentLevel);
+    if (StaticMeshActor && StaticMeshActor->Asset.IsValid())
+        return World->PersistentLevel;
+
+    for (ULevel* Level : World->GetLevels())
+    {
+        StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
+        if (StaticMeshActor && StaticMeshActor->Asset.IsValid())
+            return Level;
+    }
+
+    return nullptr;
+}
+
+/** Returns every layer that can be baked in the given world, in the same way as the bake window lists them. */
+static TArray<SteamAudio::FBakeTask> GatherBakeTasks(UWorld* World)
+{
+    TArray<SteamAudio::FBakeTask> Tasks;
+
+    SteamAudio::FBakeTask ReverbTask{};
+    ReverbTask.Type = SteamAudio::EBakeTaskType::REVERB;
+    Tasks.Add(ReverbTask);
+
+    for (TObjectIterator<USteamAudioBakedSourceComponent> It; It; ++It)
+    {
+        if (It->GetWorld() != World)
+            continue;
+
+        SteamAudio::FBakeTask Task{};
+        Task.Type = SteamAudio::EBakeTaskType::STATIC_SOURCE_REFLECTIONS;
+        Task.BakedSource = *It;
+        Tasks.Add(Task);
+    }
+
+    for (TObjectIterator<USteamAudioBakedListenerComponent> It; It; ++It)
+    {
+        if (It->GetWorld() != World)
+            continue;
+
+        SteamAudio::FBakeTask Task{};
+        Task.Type = SteamAudio::EBakeTaskType::STATIC_LISTENER_REFLECTIONS;
+        Task.BakedListener = *It;
+        Tasks.Add(Task);
+    }
+
+    for (TActorIterator<ASteamAudioProbeVolume> It(World); It; ++It)
+    {
+        SteamAudio::FBakeTask Task{};
+        Task.Type = SteamAudio::EBakeTaskType::PATHING;
+        Task.PathingProbeVolume = *It;
+        Tasks.Add(Task);
+    }
+
+    return Tasks;
+}
+
+static const TCHAR* GetBakeResultName(SteamAudio::EBakeResult Result)
+{
+    switch (Result)
+    {
+    case SteamAudio::EBakeResult::SUCCESS:
+        return TEXT("Success");
+    case SteamAudio::EBakeResult::PARTIAL_SUCCESS:
+        return TEXT("PartialSuccess");
+    default:
+        return TEXT("Failure");
+    }
+}
+
+static TSharedPtr<FJsonObject> MakeFailedMapReport(const FString& MapName, const FString& Error)
+{
+    TSharedPtr<FJsonObject> MapReport = MakeShared<FJsonObject>();
+    MapReport->SetStringField(TEXT("map"), MapName);
+    MapReport->SetBoolField(TEXT("succeeded"), false);
+    MapReport->SetStringField(TEXT("error"), Error);
+    return MapReport;
+}
+
+static bool WriteReport(const TSharedPtr<FJsonObject>& Report, const FString& FileName)
+{
+    FString Contents;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Contents);
+    if (!FJsonSerializer::Serialize(Report.ToSharedRef(), Writer))
+        return false;
+
+    return FFileHelper::SaveStringToFile(Contents, *FileName);
+}
+
+static TSharedPtr<FJsonObject> ReadReport(const FString& FileName)
+{
+    FString Contents;
+    if (!FFileHelper::LoadFileToString(Contents, *FileName))
+        return nullptr;
+
+    TSharedPtr<FJsonObject> Report;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Contents);
+    if (!FJsonSerializer::Deserialize(Reader, Report))
+        return nullptr;
+
+    return Report;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioBakeCommandlet
+// ---------------------------------------------------------------------------------------------------------------------
+
+USteamAudioBakeCommandlet::USteamAudioBakeCommandlet()
+    : bExport(true)
+    , bGenerateProbes(true)
+    , bBake(true)
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 USteamAudioBakeCommandlet::Main(const FString& Params)
+{
+    FString MapList;
+    if (!FParse::Value(*Params, TEXT("Maps="), MapList) || MapList.IsEmpty())
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("No maps specified. Usage: -run=SteamAudioBake -Maps=/Game/Maps/A+/Game/Maps/B [-NoExport] [-NoProbes] [-NoBake] [-Report=<file>] [-Jobs=<n>] [-MemoryPerJobMB=<n>]"));
+        return 1;
+    }
+
+    TArray<FString> MapNames;
+    MapList.ParseIntoArray(MapNames, TEXT("+"), true);
+
+    bExport = !FParse::Param(*Params, TEXT("NoExport"));
+    bGenerateProbes = !FParse::Param(*Params, TEXT("NoProbes"));
+    bBake = !FParse::Param(*Params, TEXT("NoBake"));
+
+    FString ReportFileName;
+    FParse::Value(*Params, TEXT("Report="), ReportFileName);
+
+    int32 NumJobs = 1;
+    FParse::Value(*Params, TEXT("Jobs="), NumJobs);
+
+    // Each map is processed in its own editor process, so only run as many as will fit in memory.
+    int32 MemoryPerJobMB = 8192;
+    FParse::Value(*Params, TEXT("MemoryPerJobMB="), MemoryPerJobMB);
+    if (NumJobs > 1 && MemoryPerJobMB > 0)
+    {
+        uint64 AvailableMemory = FPlatformMemory::GetStats().AvailablePhysical;
+        int32 MaxJobsForMemory = FMath::Max(1, static_cast<int32>(AvailableMemory / (static_cast<uint64>(MemoryPerJobMB) * 1024 * 1024)));
+        if (NumJobs > MaxJobsForMemory)
+        {
+            UE_LOG(LogSteamAudioEditor, Display, TEXT("Limiting to %d jobs to fit in %llu MB of available memory."), MaxJobsForMemory, AvailableMemory / (1024 * 1024));
+            NumJobs = MaxJobsForMemory;
+        }
+    }
+
+    NumJobs = FMath::Clamp(NumJobs, 1, MapNames.Num());
+
+    double StartTime = FPlatformTime::Seconds();
+
+    TArray<TSharedPtr<FJsonObject>> MapReports;
+    if (NumJobs > 1)
+    {
+        MapReports = ProcessMapsInChildProcesses(MapNames, NumJobs, ReportFileName);
+    }
+    else
+    {
+        for (const FString& MapName : MapNames)
+        {
+            MapReports.Add(ProcessMap(MapName));
+        }
+    }
+
+    double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+    bool bAllSucceeded = true;
+    TArray<TSharedPtr<FJsonValue>> MapReportValues;
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("Steam Audio bake summary (%d jobs, %.1f s total):"), NumJobs, TotalSeconds);
+    for (const TSharedPtr<FJsonObject>& MapReport : MapReports)
+    {
+        bool bSucceeded = MapReport->GetBoolField(TEXT("succeeded"));
+        bAllSucceeded &= bSucceeded;
+
+        double Seconds = 0.0;
+        MapReport->TryGetNumberField(TEXT("seconds"), Seconds);
+
+        UE_LOG(LogSteamAudioEditor, Display, TEXT("  %-64s %-8s %10.1f s"), *MapReport->GetStringField(TEXT("map")), bSucceeded ? TEXT("OK") : TEXT("FAILED"), Seconds);
+
+        MapReportValues.Add(MakeShared<FJsonValueObject>(MapReport));
+    }
+
+    if (!ReportFileName.IsEmpty())
+    {
+        TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+        Report->SetNumberField(TEXT("jobs"), NumJobs);
+        Report->SetNumberField(TEXT("seconds"), TotalSeconds);
+        Report->SetBoolField(TEXT("succeeded"), bAllSucceeded);
+        Report->SetArrayField(TEXT("maps"), MapReportValues);
+
+        if (!WriteReport(Report, ReportFileName))
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to write report: %s"), *ReportFileName);
+            return 1;
+        }
+    }
+
+    return bAllSucceeded ? 0 : 1;
+}
+
+TSharedPtr<FJsonObject> USteamAudioBakeCommandlet::ProcessMap(const FString& MapName)
+{
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("Processing map %s..."), *MapName);
+
+    double MapStartTime = FPlatformTime::Seconds();
+
+    UWorld* World = SteamAudio::LoadWorld(MapName);
+    if (!World)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to load map: %s"), *MapName);
+        return MakeFailedMapReport(MapName, TEXT("Unable to load map."));
+    }
+
+    TSharedPtr<FJsonObject> MapReport = MakeShared<FJsonObject>();
+    MapReport->SetStringField(TEXT("map"), MapName);
+    MapReport->SetNumberField(TEXT("loadSeconds"), FPlatformTime::Seconds() - MapStartTime);
+
+    bool bSucceeded = true;
+
+    if (bExport)
+    {
+        TArray<TSharedPtr<FJsonValue>> ExportReports;
+
+        for (ULevel* Level : World->GetLevels())
+        {
+            if (ShouldSkipLevel(Level) || !SteamAudio::DoesLevelHaveStaticGeometryForExport(World, Level))
+                continue;
+
+            ASteamAudioStaticMeshActor* StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
+            FString AssetName = (StaticMeshActor && StaticMeshActor->Asset.IsValid()) ? StaticMeshActor->Asset.GetAssetPathString() : GetDefaultAssetName(Level, TEXT("_StaticGeometry"));
+
+            double StartTime = FPlatformTime::Seconds();
+            bool bExported = RunWhilePumpingGameThread<bool>([World, Level, AssetName]()
+            {
+                return SteamAudio::ExportStaticGeometryForLevel(World, Level, AssetName);
+            });
+            double Seconds = FPlatformTime::Seconds() - StartTime;
+
+            StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
+
+            TSharedPtr<FJsonObject> ExportReport = MakeShared<FJsonObject>();
+            ExportReport->SetStringField(TEXT("level"), Level->GetOutermost()->GetName());
+            ExportReport->SetStringField(TEXT("asset"), AssetName);
+            ExportReport->SetNumberField(TEXT("seconds"), Seconds);
+            ExportReport->SetNumberField(TEXT("bytes"), StaticMeshActor ? GetAssetDataSize(StaticMeshActor->Asset) : 0);
+            ExportReport->SetBoolField(TEXT("succeeded"), bExported);
+            ExportReports.Add(MakeShared<FJsonValueObject>(ExportReport));
+
+            if (!bExported)
+            {
+                UE_LOG(LogSteamAudioEditor, Error, TEXT("Failed to export static geometry for level %s."), *Level->GetOutermost()->GetName());
+                bSucceeded = false;
+            }
+        }
+
+        MapReport->SetArrayField(TEXT("export"), ExportReports);
+    }
+
+    if (bGenerateProbes)
+    {
+        TArray<TSharedPtr<FJsonValue>> ProbeReports;
+
+        for (TActorIterator<ASteamAudioProbeVolume> It(World); It; ++It)
+        {
+            ASteamAudioProbeVolume* ProbeVolume = *It;
+            ASteamAudioStaticMeshActor* StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, ProbeVolume->GetLevel());
+            FString AssetName = ProbeVolume->Asset.IsValid() ? ProbeVolume->Asset.GetAssetPathString() : GetDefaultAssetName(ProbeVolume->GetLevel(), TEXT("_") + ProbeVolume->GetName());
+
+            double StartTime = FPlatformTime::Seconds();
+            bool bGenerated = false;
+            if (StaticMeshActor && StaticMeshActor->Asset.IsAsset())
+            {
+                bGenerated = RunWhilePumpingGameThread<bool>([ProbeVolume, StaticMeshActor, AssetName]()
+                {
+                    return ProbeVolume->GenerateProbes(StaticMeshActor, AssetName);
+                });
+            }
+            else
+            {
+                UE_LOG(LogSteamAudioEditor, Error, TEXT("No static geometry in the level containing probe volume %s."), *ProbeVolume->GetName());
+            }
+            double Seconds = FPlatformTime::Seconds() - StartTime;
+
+            TSharedPtr<FJsonObject> ProbeReport = MakeShared<FJsonObject>();
+            ProbeReport->SetStringField(TEXT("probeVolume"), ProbeVolume->GetName());
+            ProbeReport->SetStringField(TEXT("asset"), AssetName);
+            ProbeReport->SetNumberField(TEXT("seconds"), Seconds);
+            ProbeReport->SetNumberField(TEXT("probes"), bGenerated ? ProbeVolume->NumProbes : 0);
+            ProbeReport->SetNumberField(TEXT("bytes"), bGenerated ? ProbeVolume->DataSize : 0);
+            ProbeReport->SetNumberField(TEXT("compressedBytes"), bGenerated ? ProbeVolume->CompressedDataSize : 0);
+            ProbeReport->SetBoolField(TEXT("succeeded"), bGenerated);
+            ProbeReports.Add(MakeShared<FJsonValueObject>(ProbeReport));
+
+            bSucceeded &= bGenerated;
+        }
+
+        MapReport->SetArrayField(TEXT("probes"), ProbeReports);
+    }
+
+    if (bBake)
+    {
+        TSharedPtr<FJsonObject> BakeReport = MakeShared<FJsonObject>();
+
+        ULevel* BakeLevel = FindBakeLevel(World);
+        if (BakeLevel)
+        {
+            TArray<SteamAudio::FBakeTask> Tasks = GatherBakeTasks(World);
+            TArray<SteamAudio::FBakeTaskTiming> Timings;
+
+            double StartTime = FPlatformTime::Seconds();
+            SteamAudio::EBakeResult BakeResult = RunWhilePumpingGameThread<SteamAudio::EBakeResult>([World, BakeLevel, &Tasks, &Timings]()
+            {
+                return SteamAudio::BakeAndWait(World, BakeLevel, Tasks, &Timings);
+            });
+
+            TArray<TSharedPtr<FJsonValue>> TaskReports;
+            for (const SteamAudio::FBakeTaskTiming& Timing : Timings)
+            {
+                TSharedPtr<FJsonObject> TaskReport = MakeShared<FJsonObject>();
+                TaskReport->SetStringField(TEXT("probeVolume"), Timing.ProbeVolumeName);
+                TaskReport->SetStringField(TEXT("layer"), Timing.LayerName);
+                TaskReport->SetStringField(TEXT("type"), SteamAudio::GetBakeTaskTypeName(Timing.Type));
+                TaskReport->SetNumberField(TEXT("seconds"), Timing.Seconds);
+                TaskReport->SetNumberField(TEXT("bytes"), Timing.DataSize);
+                TaskReport->SetBoolField(TEXT("succeeded"), Timing.bSucceeded);
+                TaskReport->SetBoolField(TEXT("skipped"), Timing.bSkipped);
+                TaskReports.Add(MakeShared<FJsonValueObject>(TaskReport));
+            }
+
+            BakeReport->SetNumberField(TEXT("seconds"), FPlatformTime::Seconds() - StartTime);
+            BakeReport->SetStringField(TEXT("result"), GetBakeResultName(BakeResult));
+            BakeReport->SetArrayField(TEXT("tasks"), TaskReports);
+
+            bSucceeded &= (BakeResult == SteamAudio::EBakeResult::SUCCESS);
+        }
+        else
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("No static geometry to bake against in map %s."), *MapName);
+            BakeReport->SetStringField(TEXT("result"), GetBakeResultName(SteamAudio::EBakeResult::FAILURE));
+            bSucceeded = false;
+        }
+
+        MapReport->SetObjectField(TEXT("bake"), BakeReport);
+    }
+
+    // Export and probe generation point actors in the map at new assets, so save the map too.
+    bool bSaved = UEditorLoadingAndSavingUtils::SaveDirtyPackages(true, true);
+    if (!bSaved)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to save packages modified while processing map %s."), *MapName);
+        bSucceeded = false;
+    }
+
+    SteamAudio::UnloadWorld(World);
+
+    MapReport->SetBoolField(TEXT("saved"), bSaved);
+    MapReport->SetBoolField(TEXT("succeeded"), bSucceeded);
+    MapReport->SetNumberField(TEXT("seconds"), FPlatformTime::Seconds() - MapStartTime);
+
+    return MapReport;
+}
+
+TArray<TSharedPtr<FJsonObject>> USteamAudioBakeCommandlet::ProcessMapsInChildProcesses(const TArray<FString>& MapNames, int32 NumJobs, const FString& ReportFileName)
+{
+    struct FChildProcess
+    {
+        FProcHandle Handle;
+        int32 MapIndex;
+        FString ReportFileName;
+    };
+
+    FString Executable = FPlatformProcess::ExecutablePath();
+    FString ProjectFile = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+    FString ReportDirectory = ReportFileName.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("SteamAudio") : FPaths::GetPath(ReportFileName);
+
+    FString Options;
+    Options += bExport ? TEXT("") : TEXT(" -NoExport");
+    Options += bGenerateProbes ? TEXT("") : TEXT(" -NoProbes");
+    Options += bBake ? TEXT("") : TEXT(" -NoBake");
+
+    TArray<TSharedPtr<FJsonObject>> MapReports;
+    MapReports.SetNum(MapNames.Num());
+
+    TArray<FChildProcess> Running;
+    int32 NextMapIndex = 0;
+
+    while (NextMapIndex < MapNames.Num() || Running.Num() > 0)
+    {
+        while (Running.Num() < NumJobs && NextMapIndex < MapNames.Num())
+        {
+            const FString& MapName = MapNames[NextMapIndex];
+            FString ChildReportFileName = FPaths::CreateTempFilename(*ReportDirectory, TEXT("SteamAudioBake-"), TEXT(".json"));
+
+            FString ChildParams = FString::Printf(TEXT("\"%s\" -run=SteamAudioBake -Maps=%s -Report=\"%s\" -Jobs=1%s -unattended -nopause -nullrhi"),
+                *ProjectFile, *MapName, *ChildReportFileName, *Options);
+
+            UE_LOG(LogSteamAudioEditor, Display, TEXT("Starting child process for map %s."), *MapName);
+
+            FProcHandle Handle = FPlatformProcess::CreateProc(*Executable, *ChildParams, false, true, true, nullptr, 0, nullptr, nullptr);
+            if (Handle.IsValid())
+            {
+                Running.Add({Handle, NextMapIndex, ChildReportFileName});
+            }
+            else
+            {
+                UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to start child process for map %s."), *MapName);
+                MapReports[NextMapIndex] = MakeFailedMapReport(MapName, TEXT("Unable to start child process."));
+            }
+
+            NextMapIndex++;
+        }
+
+        for (int32 i = Running.Num() - 1; i >= 0; --i)
+        {
+            FChildProcess& Child = Running[i];
+            if (FPlatformProcess::IsProcRunning(Child.Handle))
+                continue;
+
+            int32 ReturnCode = 0;
+            FPlatformProcess::GetProcReturnCode(Child.Handle, &ReturnCode);
+            FPlatformProcess::CloseProc(Child.Handle);
+
+            const FString& MapName = MapNames[Child.MapIndex];
+
+            // The child writes a report containing just its own map.
+            TSharedPtr<FJsonObject> MapReport;
+            TSharedPtr<FJsonObject> ChildReport = ReadReport(Child.ReportFileName);
+            const TArray<TSharedPtr<FJsonValue>>* ChildMapReports = nullptr;
+            if (ChildReport && ChildReport->TryGetArrayField(TEXT("maps"), ChildMapReports) && ChildMapReports->Num() > 0)
+            {
+                MapReport = (*ChildMapReports)[0]->AsObject();
+            }
+
+            if (!MapReport)
+            {
+                MapReport = MakeFailedMapReport(MapName, FString::Printf(TEXT("Child process exited with code %d without writing a report."), ReturnCode));
+            }
+
+            UE_LOG(LogSteamAudioEditor, Display, TEXT("Child process for map %s exited with code %d."), *MapName, ReturnCode);
+
+            MapReports[Child.MapIndex] = MapReport;
+            IFileManager::Get().Delete(*Child.ReportFileName);
+            Running.RemoveAtSwap(i);
+        }
+
+        FPlatformProcess::Sleep(1.0f);
+    }
+
+    return MapReports;
+}
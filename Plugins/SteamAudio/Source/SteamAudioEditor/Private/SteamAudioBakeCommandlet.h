@@ -0,0 +1,70 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SteamAudioBakeCommandlet.generated.h"
+
+class FJsonObject;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioBakeCommandlet
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Exports static geometry, generates probes, and bakes all layers for one or more maps, without any editor UI.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=SteamAudioBake -Maps=/Game/Maps/A+/Game/Maps/B [options]
+ *
+ * Options:
+ *   -NoExport          Don't export static geometry.
+ *   -NoProbes          Don't generate probes.
+ *   -NoBake            Don't bake.
+ *   -Report=<file>     Write a JSON report with the time taken and data size for each step.
+ *   -Jobs=<n>          Process up to n maps at the same time, each in its own process.
+ *   -MemoryPerJobMB=<n>  Expected peak memory used by each process; limits -Jobs to what fits in available memory.
+ */
+UCLASS()
+class USteamAudioBakeCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USteamAudioBakeCommandlet();
+
+    /**
+     * Inherited from UCommandlet
+     */
+
+    /** Runs the commandlet. */
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    /** Exports, generates probes, and bakes a single map in this process. Returns the report for the map. */
+    TSharedPtr<FJsonObject> ProcessMap(const FString& MapName);
+
+    /** Processes each map in a separate child process, running up to NumJobs at once. Returns the reports for
+        each map. */
+    TArray<TSharedPtr<FJsonObject>> ProcessMapsInChildProcesses(const TArray<FString>& MapNames, int32 NumJobs, const FString& ReportFileName);
+
+    bool bExport;
+    bool bGenerateProbes;
+    bool bBake;
+};
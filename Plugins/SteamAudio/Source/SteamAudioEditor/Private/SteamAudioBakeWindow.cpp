@@ -84,16 +84,21 @@ TSharedRef<SDockTab> FBakeWindow::SpawnTab(const FSpawnTabArgs& SpawnTabArgs)
         SNew(SHeaderRow)
         + SHeaderRow::Column("Actor")
         .DefaultLabel(FText::FromString(TEXT("Actor")))
-        .FillWidth(0.35f)
+        .FillWidth(0.3f)
         + SHeaderRow::Column("Level")
         .DefaultLabel(FText::FromString(TEXT("Level")))
-        .FillWidth(0.3f)
+        .FillWidth(0.25f)
         + SHeaderRow::Column("Type")
         .DefaultLabel(FText::FromString(TEXT("Type")))
-        .FillWidth(0.2f)
+        .FillWidth(0.15f)
         + SHeaderRow::Column("Data Size")
         .DefaultLabel(FText::FromString(TEXT("Data Size")))
-        .FillWidth(0.15f)
+        .FillWidth(0.12f)
+        + SHeaderRow::Column("Compressed Size")
+        .DefaultLabel(FText::FromString(TEXT("Compressed Size")))
+        .DefaultTooltip(NSLOCTEXT("SteamAudio", "CompressedSizeTooltip", "Size on disk after compression, and as a percentage of the uncompressed size. "
+            "Compression is lossless, and each probe batch is checked to decompress to exactly the baked data when it is saved, so the error is always 0."))
+        .FillWidth(0.18f)
         );
 
     return SNew(SDockTab)
@@ -154,13 +159,17 @@ TSharedRef<ITableRow> FBakeWindow::OnGenerateRow(TSharedPtr<FBakeWindowRow> Item
         break;
     }
 
+    FText CompressedSize = (Item->Size > 0) ?
+        FText::Format(NSLOCTEXT("SteamAudio", "CompressedSizeFormat", "{0} ({1})"), FText::AsMemory(Item->CompressedSize), FText::AsPercent(static_cast<float>(Item->CompressedSize) / Item->Size)) :
+        FText::AsMemory(0);
+
     return SNew(STableRow<TSharedPtr<FString>>, OwnerTable)
         .Padding(4)
         [
             SNew(SHorizontalBox)
             + SHorizontalBox::Slot()
         .HAlign(HAlign_Left)
-        .FillWidth(0.35f)
+        .FillWidth(0.3f)
         [
             SNew(STextBlock)
             .Text(Item->Actor ? FText::FromString(Item->Actor->GetName()) : FText::FromString("N/A"))
@@ -168,7 +177,7 @@ TSharedRef<ITableRow> FBakeWindow::OnGenerateRow(TSharedPtr<FBakeWindowRow> Item
         ]
     + SHorizontalBox::Slot()
         .HAlign(HAlign_Left)
-        .FillWidth(0.3f)
+        .FillWidth(0.25f)
         [
             SNew(STextBlock)
             .Text(Item->Actor ? FText::FromString(Item->Actor->GetLevel()->GetName()) : FText::FromString("N/A"))
@@ -176,7 +185,7 @@ TSharedRef<ITableRow> FBakeWindow::OnGenerateRow(TSharedPtr<FBakeWindowRow> Item
         ]
     + SHorizontalBox::Slot()
         .HAlign(HAlign_Left)
-        .FillWidth(0.2f)
+        .FillWidth(0.15f)
         [
             SNew(STextBlock)
             .Text(FText::FromString(Type))
@@ -184,12 +193,20 @@ TSharedRef<ITableRow> FBakeWindow::OnGenerateRow(TSharedPtr<FBakeWindowRow> Item
         ]
     + SHorizontalBox::Slot()
         .HAlign(HAlign_Right)
-        .FillWidth(0.15f)
+        .FillWidth(0.12f)
         [
             SNew(STextBlock)
             .Text(FText::AsMemory(Item->Size))
         .Font(IDetailLayoutBuilder::GetDetailFont())
         ]
+    + SHorizontalBox::Slot()
+        .HAlign(HAlign_Right)
+        .FillWidth(0.18f)
+        [
+            SNew(STextBlock)
+            .Text(CompressedSize)
+        .Font(IDetailLayoutBuilder::GetDetailFont())
+        ]
         ];
 }
 
@@ -257,6 +274,7 @@ void FBakeWindow::RefreshBakeTasks()
         Row->Type = EBakeTaskType::REVERB;
         Row->Actor = nullptr;
         Row->Size = 0;
+        Row->CompressedSize = 0;
 
         for (AActor* Actor : ProbeVolumes)
         {
@@ -267,6 +285,7 @@ void FBakeWindow::RefreshBakeTasks()
                 if (LayerIndex >= 0)
                 {
                     Row->Size += ProbeVolume->DetailedStats[LayerIndex].Size;
+                    Row->CompressedSize += ProbeVolume->GetCompressedLayerSize(LayerIndex);
                 }
             }
         }
@@ -283,6 +302,7 @@ void FBakeWindow::RefreshBakeTasks()
         Row->Type = EBakeTaskType::STATIC_SOURCE_REFLECTIONS;
         Row->Actor = It->GetOwner();
         Row->Size = 0;
+        Row->CompressedSize = 0;
 
         for (AActor* Actor : ProbeVolumes)
         {
@@ -293,6 +313,7 @@ void FBakeWindow::RefreshBakeTasks()
                 if (LayerIndex >= 0)
                 {
                     Row->Size += ProbeVolume->DetailedStats[LayerIndex].Size;
+                    Row->CompressedSize += ProbeVolume->GetCompressedLayerSize(LayerIndex);
                 }
             }
         }
@@ -309,6 +330,7 @@ void FBakeWindow::RefreshBakeTasks()
         Row->Type = EBakeTaskType::STATIC_LISTENER_REFLECTIONS;
         Row->Actor = It->GetOwner();
         Row->Size = 0;
+        Row->CompressedSize = 0;
 
         for (AActor* Actor : ProbeVolumes)
         {
@@ -319,6 +341,7 @@ void FBakeWindow::RefreshBakeTasks()
                 if (LayerIndex >= 0)
                 {
                     Row->Size += ProbeVolume->DetailedStats[LayerIndex].Size;
+                    Row->CompressedSize += ProbeVolume->GetCompressedLayerSize(LayerIndex);
                 }
             }
         }
@@ -338,6 +361,7 @@ void FBakeWindow::RefreshBakeTasks()
                 Row->Type = EBakeTaskType::PATHING;
                 Row->Actor = Actor;
                 Row->Size = ProbeVolume->DetailedStats[LayerIndex].Size;
+                Row->CompressedSize = ProbeVolume->GetCompressedLayerSize(LayerIndex);
 
                 BakeWindowRows.Add(Row);
             }
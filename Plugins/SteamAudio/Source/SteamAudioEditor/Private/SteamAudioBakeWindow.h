@@ -31,6 +31,7 @@ struct FBakeWindowRow
     EBakeTaskType Type;
     AActor* Actor;
     int Size;
+    int CompressedSize;
 };
 
 class FBakeWindow : public TSharedFromThis<FBakeWindow>
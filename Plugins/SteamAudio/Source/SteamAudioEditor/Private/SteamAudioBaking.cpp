@@ -16,7 +16,9 @@
 
 #include "SteamAudioBaking.h"
 #include "EngineUtils.h"
+#include "FileHelpers.h"
 #include "Async/Async.h"
+#include "Misc/PackageName.h"
 #include "Kismet/GameplayStatics.h"
 #include "SteamAudioBakedListenerComponent.h"
 #include "SteamAudioBakedSourceComponent.h"
@@ -57,9 +59,7 @@ FString FBakeTask::GetLayerName() const
 
 std::atomic<bool> GIsBaking(false);
 static int GNumBakeTasks = 0;
-static int GCurrentBakeTask = 0;
-static int GNumProbeVolumes = 0;
-static int GCurrentProbeVolume = 0;
+static std::atomic<int> GNumBakeTasksCompleted(0);
 
 static void CancelBake()
 {
@@ -73,19 +73,322 @@ static void CancelBake()
 
 static void STDCALL BakeProgressCallback(float Progress, void* UserData)
 {
-    FSteamAudioEditorModule::NotifyUpdate(FText::FormatOrdered(NSLOCTEXT("SteamAudio", "BakeProgress", "Probe Volume {0}/{1}\nTask {2}/{3}\nBaking ({4})..."),
-        FText::AsNumber(GCurrentProbeVolume), FText::AsNumber(GNumProbeVolumes),
-        FText::AsNumber(GCurrentBakeTask), FText::AsNumber(GNumBakeTasks),
-        FText::AsPercent(Progress)));
+    int NumBakeTasksCompleted = GNumBakeTasksCompleted;
+
+    FSteamAudioEditorModule::NotifyUpdate(FText::FormatOrdered(NSLOCTEXT("SteamAudio", "BakeProgress", "Task {0}/{1}\nBaking ({2})..."),
+        FText::AsNumber(FMath::Min(NumBakeTasksCompleted + 1, GNumBakeTasks)), FText::AsNumber(GNumBakeTasks),
+        FText::AsPercent((NumBakeTasksCompleted + Progress) / FMath::Max(GNumBakeTasks, 1))));
+}
+
+const TCHAR* GetBakeTaskTypeName(EBakeTaskType Type)
+{
+    switch (Type)
+    {
+    case EBakeTaskType::STATIC_SOURCE_REFLECTIONS:
+        return TEXT("Static Source");
+    case EBakeTaskType::STATIC_LISTENER_REFLECTIONS:
+        return TEXT("Static Listener");
+    case EBakeTaskType::REVERB:
+        return TEXT("Reverb");
+    case EBakeTaskType::PATHING:
+        return TEXT("Pathing");
+    default:
+        return TEXT("(unknown)");
+    }
+}
+
+/** Returns the identifier of the baked data layer written by the given task. */
+static IPLBakedDataIdentifier GetBakedDataIdentifier(const FBakeTask& Task)
+{
+    IPLBakedDataIdentifier Identifier{};
+
+    if (Task.Type == EBakeTaskType::PATHING)
+    {
+        Identifier.type = IPL_BAKEDDATATYPE_PATHING;
+        Identifier.variation = IPL_BAKEDDATAVARIATION_DYNAMIC;
+    }
+    else
+    {
+        Identifier.type = IPL_BAKEDDATATYPE_REFLECTIONS;
+        if (Task.Type == EBakeTaskType::STATIC_SOURCE_REFLECTIONS)
+        {
+            Identifier.variation = IPL_BAKEDDATAVARIATION_STATICSOURCE;
+
+            if (Task.BakedSource)
+            {
+                Identifier.endpointInfluence.center = SteamAudio::ConvertVector(Task.BakedSource->GetOwner()->GetTransform().GetLocation());
+                Identifier.endpointInfluence.radius = Task.BakedSource->InfluenceRadius;
+            }
+        }
+        else if (Task.Type == EBakeTaskType::STATIC_LISTENER_REFLECTIONS)
+        {
+            Identifier.variation = IPL_BAKEDDATAVARIATION_STATICLISTENER;
+
+            if (Task.BakedListener)
+            {
+                Identifier.endpointInfluence.center = SteamAudio::ConvertVector(Task.BakedListener->GetOwner()->GetTransform().GetLocation());
+                Identifier.endpointInfluence.radius = Task.BakedListener->InfluenceRadius;
+            }
+        }
+        else if (Task.Type == EBakeTaskType::REVERB)
+        {
+            Identifier.variation = IPL_BAKEDDATAVARIATION_REVERB;
+        }
+    }
+
+    return Identifier;
+}
+
+/** Saves the probe batch to the probe volume's asset, and the probe volume's package along with it, so the layers
+    baked so far are kept even if the bake is cancelled or the editor exits before the bake completes. Both need to be
+    saved, since the list of layers (and their content hashes) is stored on the probe volume. */
+static bool SaveProbeBatch(IPLContext Context, ASteamAudioProbeVolume* ProbeVolume, IPLProbeBatch ProbeBatch)
+{
+    IPLSerializedObjectSettings SerializedObjectSettings{};
+
+    IPLSerializedObject SerializedObject = nullptr;
+    IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to create serialized object. [%d]"), Status);
+        return false;
+    }
+
+    iplProbeBatchSave(ProbeBatch, SerializedObject);
+
+    SteamAudio::RunInGameThread<void>([&]()
+    {
+        USteamAudioSerializedObject* AssetObject = USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, ProbeVolume->Asset.GetAssetPathString(),
+            {}, {}, FString(), ProbeVolume->GetCompressionFormat());
+        ProbeVolume->Asset = AssetObject;
+        ProbeVolume->UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject), AssetObject ? AssetObject->GetStoredDataSize() : 0);
+        ProbeVolume->MarkPackageDirty();
+
+        // With one file per actor, this is just the probe volume's own package; otherwise it's the level. Levels
+        // that have never been saved have nowhere to save to, so their layers are only kept in memory.
+        UPackage* Package = ProbeVolume->GetPackage();
+        if (Package && !FPackageName::IsTempPackage(Package->GetName()))
+        {
+            if (!UEditorLoadingAndSavingUtils::SavePackages({Package}, true))
+            {
+                UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to save package: %s"), *Package->GetName());
+            }
+        }
+    });
+
+    iplSerializedObjectRelease(&SerializedObject);
+    return true;
 }
 
-static EBakeResult BakeInternal(ASteamAudioStaticMeshActor* StaticMeshActor, const TArray<AActor*>& ProbeVolumes, const TArray<FBakeTask>& Tasks)
+/** The tasks to bake for a single probe volume. Tasks for the same probe volume write to the same probe batch. */
+struct FProbeVolumeBakeJob
+{
+    ASteamAudioProbeVolume* ProbeVolume;
+    TArray<const FBakeTask*> Tasks;
+    TArray<FString> TaskContentHashes;
+    TArray<FBakeTaskTiming> Timings;
+    int NumBakesSucceeded;
+};
+
+/** Returns a hash of everything that affects the data baked by the given task: the probes, the geometry they are baked
+    against, the layer's identifier, and the settings used for this type of bake. Returns an empty string if the hash
+    of the probes or geometry is unknown. */
+static FString CalcBakeTaskContentHash(const FBakeTask& Task, const IPLBakedDataIdentifier& Identifier, const FString& ProbeContentHash,
+    const FString& StaticGeometryContentHash, const FSteamAudioSettings& Settings)
 {
+    if (ProbeContentHash.IsEmpty() || StaticGeometryContentHash.IsEmpty())
+        return FString();
+
+    FContentHash Hash;
+    Hash.Update(ProbeContentHash);
+    Hash.Update(StaticGeometryContentHash);
+    Hash.Update(Identifier);
+    Hash.Update(Settings.SceneType);
+
+    if (Task.Type == EBakeTaskType::PATHING)
+    {
+        Hash.Update(Settings.BakingVisibilitySamples);
+        Hash.Update(Settings.BakingVisibilityRadius);
+        Hash.Update(Settings.BakingVisibilityThreshold);
+        Hash.Update(Settings.BakingVisibilityRange);
+        Hash.Update(Settings.BakingPathRange);
+    }
+    else
+    {
+        Hash.Update(Settings.bBakeConvolution);
+        Hash.Update(Settings.bBakeParametric);
+        Hash.Update(Settings.BakingRays);
+        Hash.Update(Settings.BakingBounces);
+        Hash.Update(Settings.BakingDuration);
+        Hash.Update(Settings.BakingAmbisonicOrder);
+        Hash.Update(Settings.BakingIrradianceMinDistance);
+    }
+
+    return Hash.Finalize();
+}
+
+static void BakeProbeVolume(FProbeVolumeBakeJob& Job, IPLContext Context, IPLReflectionsBakeParams ReflectionsBakeParams,
+    IPLPathBakeParams PathBakeParams)
+{
+    if (Job.Tasks.Num() == 0)
+        return;
+
+    ASteamAudioProbeVolume* ProbeVolume = Job.ProbeVolume;
+    FString ProbeVolumeName = ProbeVolume->GetName();
+
+    IPLProbeBatch ProbeBatch = SteamAudio::RunInGameThread<IPLProbeBatch>([&]()
+    {
+        return SteamAudio::LoadProbeBatchFromAsset(ProbeVolume->Asset, Context);
+    });
+    if (!ProbeBatch)
+    {
+        UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to load probe batch: %s"), *ProbeVolume->Asset.GetAssetPathString());
+        GNumBakeTasksCompleted += Job.Tasks.Num();
+        return;
+    }
+
+    ReflectionsBakeParams.probeBatch = ProbeBatch;
+    PathBakeParams.probeBatch = ProbeBatch;
+
+    for (int TaskIndex = 0; TaskIndex < Job.Tasks.Num(); ++TaskIndex)
+    {
+        if (!GIsBaking)
+            break;
+
+        const FBakeTask* Task = Job.Tasks[TaskIndex];
+
+        IPLBakedDataIdentifier Identifier = GetBakedDataIdentifier(*Task);
+        FString LayerName = Task->GetLayerName();
+
+        double StartTime = FPlatformTime::Seconds();
+
+        if (Task->Type == EBakeTaskType::PATHING)
+        {
+            PathBakeParams.identifier = Identifier;
+            iplPathBakerBake(Context, &PathBakeParams, BakeProgressCallback, nullptr);
+        }
+        else
+        {
+            ReflectionsBakeParams.identifier = Identifier;
+            iplReflectionsBakerBake(Context, &ReflectionsBakeParams, BakeProgressCallback, nullptr);
+        }
+
+        double Seconds = FPlatformTime::Seconds() - StartTime;
+        GNumBakeTasksCompleted++;
+
+        // A cancelled bake leaves a partially-baked layer in the probe batch, which must not be saved.
+        if (!GIsBaking)
+        {
+            Job.Timings.Add({ProbeVolumeName, LayerName, Task->Type, Seconds, 0, false, false});
+            break;
+        }
+
+        int LayerSize = iplProbeBatchGetDataSize(ProbeBatch, &Identifier);
+
+        SteamAudio::RunInGameThread<void>([&]()
+        {
+            ProbeVolume->AddOrUpdateLayer(LayerName, Identifier, LayerSize, Job.TaskContentHashes[TaskIndex], static_cast<float>(Seconds));
+        });
+
+        bool bSaved = SaveProbeBatch(Context, ProbeVolume, ProbeBatch);
+
+        Job.Timings.Add({ProbeVolumeName, LayerName, Task->Type, Seconds, LayerSize, bSaved, false});
+        if (bSaved)
+        {
+            Job.NumBakesSucceeded++;
+        }
+    }
+
+    iplProbeBatchRelease(&ProbeBatch);
+}
+
+static void LogBakeSummary(const TArray<FProbeVolumeBakeJob>& Jobs, double TotalSeconds)
+{
+    UE_LOG(LogSteamAudioEditor, Log, TEXT("Bake summary (%.1f s total):"), TotalSeconds);
+    UE_LOG(LogSteamAudioEditor, Log, TEXT("  %-32s %-32s %-16s %10s %12s  %s"), TEXT("Probe Volume"), TEXT("Layer"), TEXT("Type"), TEXT("Time (s)"), TEXT("Size (bytes)"), TEXT("Result"));
+
+    for (const FProbeVolumeBakeJob& Job : Jobs)
+    {
+        for (const FBakeTaskTiming& Timing : Job.Timings)
+        {
+            UE_LOG(LogSteamAudioEditor, Log, TEXT("  %-32s %-32s %-16s %10.1f %12d  %s"), *Timing.ProbeVolumeName, *Timing.LayerName,
+                GetBakeTaskTypeName(Timing.Type), Timing.Seconds, Timing.DataSize, Timing.bSkipped ? TEXT("UP TO DATE") : (Timing.bSucceeded ? TEXT("OK") : TEXT("FAILED")));
+        }
+    }
+}
+
+static EBakeResult BakeInternal(ASteamAudioStaticMeshActor* StaticMeshActor, const TArray<AActor*>& ProbeVolumes, const TArray<FBakeTask>& Tasks,
+    TArray<FBakeTaskTiming>* OutTimings)
+{
+    FSteamAudioSettings Settings{};
+    FString StaticGeometryContentHash;
+    SteamAudio::RunInGameThread<void>([&]()
+    {
+        Settings = GetDefault<USteamAudioSettings>()->GetSettings();
+
+        USteamAudioSerializedObject* StaticMeshAsset = Cast<USteamAudioSerializedObject>(StaticMeshActor->Asset.TryLoad());
+        StaticGeometryContentHash = StaticMeshAsset ? StaticMeshAsset->ContentHash : FString();
+    });
+
+    // Work out which tasks need to run for each probe volume. Layers that were last baked with exactly the same
+    // inputs are skipped.
+    TArray<FProbeVolumeBakeJob> Jobs;
+    int NumBakesRequested = 0;
+    int NumBakesSkipped = 0;
+    for (AActor* Actor : ProbeVolumes)
+    {
+        ASteamAudioProbeVolume* ProbeVolume = Cast<ASteamAudioProbeVolume>(Actor);
+        if (!ProbeVolume || !ProbeVolume->Asset.IsValid())
+        {
+            UE_LOG(LogSteamAudioEditor, Warning, TEXT("No probes generated in probe volume, skipping."));
+            continue;
+        }
+
+        FProbeVolumeBakeJob Job{ProbeVolume, {}, {}, {}, 0};
+        for (const FBakeTask& Task : Tasks)
+        {
+            if (Task.Type == EBakeTaskType::PATHING && Task.PathingProbeVolume != ProbeVolume)
+                continue;
+
+            NumBakesRequested++;
+
+            FString LayerName = Task.GetLayerName();
+            FString ContentHash = CalcBakeTaskContentHash(Task, GetBakedDataIdentifier(Task), ProbeVolume->ProbeContentHash, StaticGeometryContentHash, Settings);
+
+            int LayerIndex = ProbeVolume->FindLayer(LayerName);
+            if (!ContentHash.IsEmpty() && LayerIndex != INDEX_NONE && ProbeVolume->DetailedStats[LayerIndex].ContentHash == ContentHash)
+            {
+                Job.Timings.Add({ProbeVolume->GetName(), LayerName, Task.Type, 0.0, ProbeVolume->DetailedStats[LayerIndex].Size, true, true});
+                NumBakesSkipped++;
+                continue;
+            }
+
+            Job.Tasks.Add(&Task);
+            Job.TaskContentHashes.Add(ContentHash);
+        }
+
+        Jobs.Add(MoveTemp(Job));
+    }
+
+    if (NumBakesRequested == 0)
+        return EBakeResult::FAILURE;
+
+    int NumBakesToRun = NumBakesRequested - NumBakesSkipped;
+
+    GNumBakeTasks = NumBakesToRun;
+    GNumBakeTasksCompleted = 0;
+
     TPromise<int> Promise;
 
-    Async(EAsyncExecution::Thread, [StaticMeshActor, ProbeVolumes, Tasks, &Promise]()
+    Async(EAsyncExecution::Thread, [StaticMeshActor, NumBakesToRun, &Jobs, &Promise]()
     {
-        int NumBakesSucceeded = 0;
+        if (NumBakesToRun == 0)
+        {
+            UE_LOG(LogSteamAudioEditor, Log, TEXT("All baked data is up to date."));
+            LogBakeSummary(Jobs, 0.0);
+            Promise.SetValue(0);
+            return;
+        }
 
 		SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
         bool bInitializeSucceeded = SteamAudio::RunInGameThread<bool>([&]()
@@ -114,10 +417,26 @@ static EBakeResult BakeInternal(ASteamAudioStaticMeshActor* StaticMeshActor, con
         }
 
         iplStaticMeshAdd(StaticMesh, Scene);
+
+        // Shared geometry is placed using instanced meshes, which are kept alive by the scene.
+        TArray<IPLInstancedMesh> InstancedMeshes;
+        SteamAudio::RunInGameThread<bool>([&]()
+        {
+            return SteamAudio::LoadInstancedMeshesFromAsset(StaticMeshActor->Asset, Context, Scene, InstancedMeshes);
+        });
+        for (IPLInstancedMesh& InstancedMesh : InstancedMeshes)
+        {
+            iplInstancedMeshAdd(InstancedMesh, Scene);
+            iplInstancedMeshRelease(&InstancedMesh);
+        }
+
         iplSceneCommit(Scene);
 
         IPLSimulationSettings SimulationSettings = Manager.GetBakingSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
 
+        int NumReflectionsThreads = GetNumThreadsForCPUCoresPercentage(GetDefault<USteamAudioSettings>()->BakingCPUCoresPercentage);
+        int NumPathingThreads = GetNumThreadsForCPUCoresPercentage(GetDefault<USteamAudioSettings>()->BakedPathingCPUCoresPercentage);
+
         IPLReflectionsBakeParams ReflectionsBakeParams{};
         ReflectionsBakeParams.scene = Scene;
         ReflectionsBakeParams.sceneType = SimulationSettings.sceneType;
@@ -127,7 +446,7 @@ static EBakeResult BakeInternal(ASteamAudioStaticMeshActor* StaticMeshActor, con
         ReflectionsBakeParams.simulatedDuration = SimulationSettings.maxDuration;
         ReflectionsBakeParams.savedDuration = SimulationSettings.maxDuration;
         ReflectionsBakeParams.order = SimulationSettings.maxOrder;
-        ReflectionsBakeParams.numThreads = GetNumThreadsForCPUCoresPercentage(GetDefault<USteamAudioSettings>()->BakingCPUCoresPercentage);
+        ReflectionsBakeParams.numThreads = NumReflectionsThreads;
         ReflectionsBakeParams.rayBatchSize = 1;
         ReflectionsBakeParams.irradianceMinDistance = GetDefault<USteamAudioSettings>()->BakingIrradianceMinDistance;
         ReflectionsBakeParams.bakeBatchSize = (SimulationSettings.sceneType == IPL_SCENETYPE_RADEONRAYS) ? GetDefault<USteamAudioSettings>()->BakingBatchSize : 1;
@@ -150,123 +469,27 @@ static EBakeResult BakeInternal(ASteamAudioStaticMeshActor* StaticMeshActor, con
         PathBakeParams.threshold = GetDefault<USteamAudioSettings>()->BakingVisibilityThreshold;
         PathBakeParams.visRange = GetDefault<USteamAudioSettings>()->BakingVisibilityRange;
         PathBakeParams.pathRange = GetDefault<USteamAudioSettings>()->BakingPathRange;
-        PathBakeParams.numThreads = GetNumThreadsForCPUCoresPercentage(GetDefault<USteamAudioSettings>()->BakedPathingCPUCoresPercentage);
-
-        for (AActor* Actor : ProbeVolumes)
-        {
-            ASteamAudioProbeVolume* ProbeVolume = Cast<ASteamAudioProbeVolume>(Actor);
-            if (!ProbeVolume || !ProbeVolume->Asset.IsValid())
-            {
-                UE_LOG(LogSteamAudioEditor, Warning, TEXT("No probes generated in probe volume, skipping."));
-                GCurrentProbeVolume++;
-                continue;
-            }
+        PathBakeParams.numThreads = NumPathingThreads;
 
-            IPLProbeBatch ProbeBatch = SteamAudio::RunInGameThread<IPLProbeBatch>([&]()
-            {
-                return SteamAudio::LoadProbeBatchFromAsset(ProbeVolume->Asset, Context);
-            });
-            if (!ProbeBatch)
-            {
-                UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to load probe batch: %s"), *ProbeVolume->Asset.GetAssetPathString());
-                GCurrentProbeVolume++;
-                continue;
-            }
-
-            ReflectionsBakeParams.probeBatch = ProbeBatch;
-            PathBakeParams.probeBatch = ProbeBatch;
-
-            int NumBakesSucceededForProbeBatch = 0;
+        double StartTime = FPlatformTime::Seconds();
 
-            for (const FBakeTask& Task : Tasks)
-            {
-                if (Task.Type == EBakeTaskType::PATHING && Task.PathingProbeVolume != ProbeVolume)
-                {
-                    GCurrentBakeTask++;
-                    continue;
-                }
-
-                if (Task.Type == EBakeTaskType::PATHING)
-                {
-                    PathBakeParams.identifier.type = IPL_BAKEDDATATYPE_PATHING;
-                    PathBakeParams.identifier.variation = IPL_BAKEDDATAVARIATION_DYNAMIC;
-                }
-                else
-                {
-                    ReflectionsBakeParams.identifier.type = IPL_BAKEDDATATYPE_REFLECTIONS;
-                    if (Task.Type == EBakeTaskType::STATIC_SOURCE_REFLECTIONS)
-                    {
-                        ReflectionsBakeParams.identifier.variation = IPL_BAKEDDATAVARIATION_STATICSOURCE;
-
-                        if (Task.BakedSource)
-                        {
-                            ReflectionsBakeParams.identifier.endpointInfluence.center = SteamAudio::ConvertVector(Task.BakedSource->GetOwner()->GetTransform().GetLocation());
-                            ReflectionsBakeParams.identifier.endpointInfluence.radius = Task.BakedSource->InfluenceRadius;
-                        }
-                    }
-                    else if (Task.Type == EBakeTaskType::STATIC_LISTENER_REFLECTIONS)
-                    {
-                        ReflectionsBakeParams.identifier.variation = IPL_BAKEDDATAVARIATION_STATICLISTENER;
-
-                        if (Task.BakedListener)
-                        {
-                            ReflectionsBakeParams.identifier.endpointInfluence.center = SteamAudio::ConvertVector(Task.BakedListener->GetOwner()->GetTransform().GetLocation());
-                            ReflectionsBakeParams.identifier.endpointInfluence.radius = Task.BakedListener->InfluenceRadius;
-                        }
-                    }
-                    else if (Task.Type == EBakeTaskType::REVERB)
-                    {
-                        ReflectionsBakeParams.identifier.variation = IPL_BAKEDDATAVARIATION_REVERB;
-                    }
-                }
-
-                if (Task.Type == EBakeTaskType::PATHING)
-                {
-                    iplPathBakerBake(Context, &PathBakeParams, BakeProgressCallback, nullptr);
-                }
-                else
-                {
-                    iplReflectionsBakerBake(Context, &ReflectionsBakeParams, BakeProgressCallback, nullptr);
-                }
-
-                IPLBakedDataIdentifier& Identifier = (Task.Type == EBakeTaskType::PATHING) ? PathBakeParams.identifier : ReflectionsBakeParams.identifier;
-                FString LayerName = Task.GetLayerName();
-                int LayerSize = iplProbeBatchGetDataSize(ProbeBatch, &Identifier);
-
-                SteamAudio::RunInGameThread<void>([&]()
-                {
-                    ProbeVolume->AddOrUpdateLayer(LayerName, Identifier, LayerSize);
-                });
-
-                NumBakesSucceededForProbeBatch++;
-                GCurrentBakeTask++;
-            }
-
-            IPLSerializedObjectSettings SerializedObjectSettings{};
+        // Steam Audio only allows one bake to be in progress at a time, so probe volumes are baked one after the
+        // other, each using all the threads. To bake several maps at once, use the SteamAudioBake commandlet's -Jobs
+        // option, which runs each map in its own process.
+        for (FProbeVolumeBakeJob& Job : Jobs)
+        {
+            if (!GIsBaking)
+                break;
 
-            IPLSerializedObject SerializedObject = nullptr;
-            IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
-            if (Status != IPL_STATUS_SUCCESS)
-            {
-                UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to create serialized object. [%d]"), Status);
-                iplProbeBatchRelease(&ProbeBatch);
-                GCurrentProbeVolume++;
-                continue;
-            }
+            BakeProbeVolume(Job, Context, ReflectionsBakeParams, PathBakeParams);
+        }
 
-            iplProbeBatchSave(ProbeBatch, SerializedObject);
+        LogBakeSummary(Jobs, FPlatformTime::Seconds() - StartTime);
 
-            SteamAudio::RunInGameThread<void>([&]()
-            {
-                ProbeVolume->Asset = USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, ProbeVolume->Asset.GetAssetPathString());
-                ProbeVolume->UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject));
-                ProbeVolume->MarkPackageDirty();
-            });
-
-            iplSerializedObjectRelease(&SerializedObject);
-            iplProbeBatchRelease(&ProbeBatch);
-            NumBakesSucceeded += NumBakesSucceededForProbeBatch;
-            GCurrentProbeVolume++;
+        int NumBakesSucceeded = 0;
+        for (const FProbeVolumeBakeJob& Job : Jobs)
+        {
+            NumBakesSucceeded += Job.NumBakesSucceeded;
         }
 
         iplStaticMeshRelease(&StaticMesh);
@@ -279,9 +502,19 @@ static EBakeResult BakeInternal(ASteamAudioStaticMeshActor* StaticMeshActor, con
 
     int NumBakesSucceeded = Future.Get();
 
+    if (OutTimings)
+    {
+        for (const FProbeVolumeBakeJob& Job : Jobs)
+        {
+            OutTimings->Append(Job.Timings);
+        }
+    }
+
+    NumBakesSucceeded += NumBakesSkipped;
+
     if (NumBakesSucceeded == 0)
         return EBakeResult::FAILURE;
-    else if (NumBakesSucceeded == GNumBakeTasks * GNumProbeVolumes)
+    else if (NumBakesSucceeded == NumBakesRequested)
         return EBakeResult::SUCCESS;
     else
         return EBakeResult::PARTIAL_SUCCESS;
@@ -314,14 +547,9 @@ void Bake(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks, FSteamAu
         return;
     }
 
-    GNumBakeTasks = Tasks.Num();
-    GNumProbeVolumes = ProbeVolumes.Num();
-    GCurrentBakeTask = 1;
-    GCurrentProbeVolume = 1;
-
     Async(EAsyncExecution::Thread, [StaticMeshActor, ProbeVolumes, Tasks, OnBakeComplete]()
     {
-        EBakeResult BakeResult = BakeInternal(StaticMeshActor, ProbeVolumes, Tasks);
+        EBakeResult BakeResult = BakeInternal(StaticMeshActor, ProbeVolumes, Tasks, nullptr);
         if (BakeResult == EBakeResult::SUCCESS)
         {
             FSteamAudioEditorModule::NotifySucceeded(NSLOCTEXT("SteamAudio", "BakeSucceeded", "Bake succeeded."));
@@ -340,4 +568,37 @@ void Bake(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks, FSteamAu
     });
 }
 
+EBakeResult BakeAndWait(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks, TArray<FBakeTaskTiming>* OutTimings /* = nullptr */)
+{
+    check(World);
+    check(Level);
+    check(!IsInGameThread());
+
+    ASteamAudioStaticMeshActor* StaticMeshActor = nullptr;
+    TArray<AActor*> ProbeVolumes;
+    SteamAudio::RunInGameThread<void>([&]()
+    {
+        StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
+        UGameplayStatics::GetAllActorsOfClass(World, ASteamAudioProbeVolume::StaticClass(), ProbeVolumes);
+    });
+
+    if (!StaticMeshActor || !StaticMeshActor->Asset.IsValid())
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Bake failed: no static geometry."));
+        return EBakeResult::FAILURE;
+    }
+
+    if (ProbeVolumes.Num() <= 0)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Bake failed: no probe volumes."));
+        return EBakeResult::FAILURE;
+    }
+
+    GIsBaking = true;
+    EBakeResult BakeResult = BakeInternal(StaticMeshActor, ProbeVolumes, Tasks, OutTimings);
+    GIsBaking = false;
+
+    return BakeResult;
+}
+
 }
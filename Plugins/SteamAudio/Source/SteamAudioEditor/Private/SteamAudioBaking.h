@@ -56,6 +56,23 @@ struct FBakeTask
     FString GetLayerName() const;
 };
 
+/** Timing and results for a single bake task. */
+struct FBakeTaskTiming
+{
+    FString ProbeVolumeName;
+    FString LayerName;
+    EBakeTaskType Type;
+    double Seconds;
+    int DataSize;
+    bool bSucceeded;
+
+    /** True if the layer was already baked with the same inputs, so it was not baked again. */
+    bool bSkipped;
+};
+
+/** Returns a human-readable name for the given type of bake task. */
+const TCHAR* STEAMAUDIOEDITOR_API GetBakeTaskTypeName(EBakeTaskType Type);
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Baking
@@ -71,6 +88,11 @@ DECLARE_DELEGATE(FSteamAudioBakeComplete);
 void STEAMAUDIOEDITOR_API Bake(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks,
     FSteamAudioBakeComplete OnBakeComplete = FSteamAudioBakeComplete());
 
+/** Runs one or more bakes for a level, and waits for them to complete. Must not be called from the game thread, which
+    must keep processing tasks until this returns. Optionally returns the timing and results for each task. */
+EBakeResult STEAMAUDIOEDITOR_API BakeAndWait(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks,
+    TArray<FBakeTaskTiming>* OutTimings = nullptr);
+
 #endif
 
 }
@@ -0,0 +1,496 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioBenchmarkCommandlet.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeExit.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "SteamAudioBenchmark.h"
+#include "SteamAudioCommandletHelpers.h"
+#include "SteamAudioEditorModule.h"
+#include "SteamAudioManager.h"
+#include "SteamAudioScene.h"
+#include "SteamAudioSerializedObject.h"
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------------------------------------------------
+
+static bool SaveOutput(const TArray<float>& Output, const FString& FileName)
+{
+    TArrayView<const uint8> Bytes(reinterpret_cast<const uint8*>(Output.GetData()), Output.Num() * sizeof(float));
+    return FFileHelper::SaveArrayToFile(Bytes, *FileName);
+}
+
+static bool LoadOutput(const FString& FileName, TArray<float>& OutOutput)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FileName) || (Bytes.Num() % sizeof(float)) != 0)
+        return false;
+
+    OutOutput.SetNumUninitialized(Bytes.Num() / sizeof(float));
+    FMemory::Memcpy(OutOutput.GetData(), Bytes.GetData(), Bytes.Num());
+    return true;
+}
+
+static TSharedPtr<FJsonObject> MakeTimingsReport(const SteamAudio::FSteamAudioBenchmarkTimings& Timings)
+{
+    TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetNumberField(TEXT("calls"), Timings.Microseconds.Num());
+    Report->SetNumberField(TEXT("meanMicroseconds"), Timings.GetMean());
+    Report->SetNumberField(TEXT("p50Microseconds"), Timings.GetPercentile(50.0));
+    Report->SetNumberField(TEXT("p99Microseconds"), Timings.GetPercentile(99.0));
+    Report->SetNumberField(TEXT("maxMicroseconds"), Timings.GetPercentile(100.0));
+    return Report;
+}
+
+static void LogTimings(const TCHAR* Name, const SteamAudio::FSteamAudioBenchmarkTimings& Timings)
+{
+    if (Timings.Microseconds.Num() == 0)
+        return;
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("  %-16s %8d calls  mean %8.2f us  p50 %8.2f us  p99 %8.2f us  max %8.2f us"), Name,
+        Timings.Microseconds.Num(), Timings.GetMean(), Timings.GetPercentile(50.0), Timings.GetPercentile(99.0), Timings.GetPercentile(100.0));
+}
+
+/**
+ * Times a full rebuild of the static geometry of every level in the given world against an incremental rebuild of
+ * NumChanged of its components, times the export of its Static Mesh geometry run serially against the same export run
+ * in parallel, and adds one report entry per level.
+ */
+static bool RunStaticGeometryBenchmark(UWorld* World, int32 NumChanged, TArray<TSharedPtr<FJsonValue>>& OutReport)
+{
+    if (!SteamAudio::FSteamAudioModule::BeginOfflineSession())
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to initialize Steam Audio for benchmarking."));
+        return false;
+    }
+
+    ON_SCOPE_EXIT
+    {
+        SteamAudio::FSteamAudioModule::EndOfflineSession();
+    };
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("  Static geometry rebuild:"));
+
+    for (ULevel* Level : World->GetLevels())
+    {
+        if (!Level || !SteamAudio::DoesLevelHaveStaticGeometryForExport(World, Level))
+            continue;
+
+        FString LevelName = Level->GetOutermost()->GetName();
+
+        SteamAudio::FStaticGeometryCache::FRebuildBenchmarkResult Result;
+        if (!SteamAudio::FStaticGeometryCache::RunRebuildBenchmark(World, Level, NumChanged, Result))
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to rebuild the static geometry of %s."), *LevelName);
+            return false;
+        }
+
+        double FullTime = Result.FullGatherTime + Result.FullBuildTime;
+        double IncrementalTime = Result.IncrementalGatherTime + Result.IncrementalBuildTime;
+        double Speedup = (IncrementalTime > 0.0) ? FullTime / IncrementalTime : 0.0;
+
+        UE_LOG(LogSteamAudioEditor, Display, TEXT("    %s: full (%d components) gather %8.2f ms  build %8.2f ms; incremental (%d components) gather %8.2f ms  build %8.2f ms  (%.1fx faster)"),
+            *LevelName, Result.NumComponents, Result.FullGatherTime, Result.FullBuildTime, Result.NumChanged,
+            Result.IncrementalGatherTime, Result.IncrementalBuildTime, Speedup);
+
+        TSharedPtr<FJsonObject> Full = MakeShared<FJsonObject>();
+        Full->SetNumberField(TEXT("components"), Result.NumComponents);
+        Full->SetNumberField(TEXT("gatherMilliseconds"), Result.FullGatherTime);
+        Full->SetNumberField(TEXT("buildMilliseconds"), Result.FullBuildTime);
+
+        TSharedPtr<FJsonObject> Incremental = MakeShared<FJsonObject>();
+        Incremental->SetNumberField(TEXT("components"), Result.NumChanged);
+        Incremental->SetNumberField(TEXT("gatherMilliseconds"), Result.IncrementalGatherTime);
+        Incremental->SetNumberField(TEXT("buildMilliseconds"), Result.IncrementalBuildTime);
+
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("level"), LevelName);
+        Entry->SetObjectField(TEXT("full"), Full);
+        Entry->SetObjectField(TEXT("incremental"), Incremental);
+        Entry->SetNumberField(TEXT("speedup"), Speedup);
+
+        // Best of a few runs each, since a single export of a small level can take well under a millisecond.
+        SteamAudio::FStaticGeometryExportBenchmarkResult ExportResult;
+        if (!SteamAudio::RunStaticGeometryExportBenchmark(World, Level, 5, ExportResult))
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to export the static geometry of %s."), *LevelName);
+            return false;
+        }
+
+        if (!ExportResult.bOutputsMatch)
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Serial and parallel exports of %s produced different geometry."), *LevelName);
+            return false;
+        }
+
+        double ExportSpeedup = (ExportResult.ParallelExtractTime > 0.0) ? ExportResult.SerialExtractTime / ExportResult.ParallelExtractTime : 0.0;
+
+        UE_LOG(LogSteamAudioEditor, Display, TEXT("    %s: export (%d components, %d triangles) gather %8.2f ms  extract serial %8.2f ms  parallel %8.2f ms  (%.1fx faster)"),
+            *LevelName, ExportResult.NumComponents, ExportResult.NumTriangles, ExportResult.GatherTime,
+            ExportResult.SerialExtractTime, ExportResult.ParallelExtractTime, ExportSpeedup);
+
+        TSharedPtr<FJsonObject> Export = MakeShared<FJsonObject>();
+        Export->SetNumberField(TEXT("components"), ExportResult.NumComponents);
+        Export->SetNumberField(TEXT("triangles"), ExportResult.NumTriangles);
+        Export->SetNumberField(TEXT("gatherMilliseconds"), ExportResult.GatherTime);
+        Export->SetNumberField(TEXT("serialExtractMilliseconds"), ExportResult.SerialExtractTime);
+        Export->SetNumberField(TEXT("parallelExtractMilliseconds"), ExportResult.ParallelExtractTime);
+        Export->SetNumberField(TEXT("speedup"), ExportSpeedup);
+        Entry->SetObjectField(TEXT("export"), Export);
+
+        OutReport.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+
+    return true;
+}
+
+/**
+ * Times the Steam Audio Manager's tick with the given number of Steam Audio Sources moving around in the given world.
+ */
+static bool RunSourcesBenchmark(UWorld* World, int32 NumSources, int32 NumTicks, TSharedPtr<FJsonObject>& OutReport)
+{
+    if (!SteamAudio::FSteamAudioModule::BeginOfflineSession())
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to initialize Steam Audio for benchmarking."));
+        return false;
+    }
+
+    ON_SCOPE_EXIT
+    {
+        SteamAudio::FSteamAudioModule::EndOfflineSession();
+    };
+
+    // Sources only register with the manager once they begin play, which needs the world's actors to be initialized.
+    if (!World->AreActorsInitialized())
+    {
+        World->InitializeActorsForPlay(FURL());
+    }
+
+    SteamAudio::FSteamAudioSourceBenchmarkResult Result;
+    if (!SteamAudio::RunSourceBenchmark(World, NumSources, NumTicks, Result))
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to run the source benchmark."));
+        return false;
+    }
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("  Sources: %d sources, %d ticks: tick mean %8.2f us  p99 %8.2f us  max %8.2f us  (%.3f us/source)"),
+        Result.NumSources, Result.NumTicks, Result.Tick.GetMean(), Result.Tick.GetPercentile(99.0),
+        Result.Tick.GetPercentile(100.0), Result.GetMicrosecondsPerSource());
+
+    OutReport = MakeShared<FJsonObject>();
+    OutReport->SetNumberField(TEXT("sources"), Result.NumSources);
+    OutReport->SetNumberField(TEXT("ticks"), Result.NumTicks);
+    OutReport->SetObjectField(TEXT("tick"), MakeTimingsReport(Result.Tick));
+    OutReport->SetNumberField(TEXT("microsecondsPerSource"), Result.GetMicrosecondsPerSource());
+
+    return true;
+}
+
+static bool WriteReport(const TSharedPtr<FJsonObject>& Report, const FString& FileName)
+{
+    FString Contents;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Contents);
+    if (!FJsonSerializer::Serialize(Report.ToSharedRef(), Writer))
+        return false;
+
+    return FFileHelper::SaveStringToFile(Contents, *FileName);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioBenchmarkCommandlet
+// ---------------------------------------------------------------------------------------------------------------------
+
+USteamAudioBenchmarkCommandlet::USteamAudioBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 USteamAudioBenchmarkCommandlet::Main(const FString& Params)
+{
+    SteamAudio::FSteamAudioBenchmarkSettings Settings;
+
+    FString TrajectoryFileName;
+    if (FParse::Value(*Params, TEXT("Trajectory="), TrajectoryFileName) && !Settings.Trajectory.Load(TrajectoryFileName))
+        return 1;
+
+    FString SceneName;
+    if (FParse::Value(*Params, TEXT("Scene="), SceneName))
+    {
+        Settings.Scene = Cast<USteamAudioSerializedObject>(FSoftObjectPath(SceneName).TryLoad());
+        if (!Settings.Scene)
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to load scene: %s"), *SceneName);
+            return 1;
+        }
+    }
+
+    FParse::Value(*Params, TEXT("Voices="), Settings.NumVoices);
+    FParse::Value(*Params, TEXT("Listeners="), Settings.NumListeners);
+    FParse::Value(*Params, TEXT("Buffers="), Settings.NumBuffers);
+    FParse::Value(*Params, TEXT("Warmup="), Settings.NumWarmupBuffers);
+    FParse::Value(*Params, TEXT("ReflectionsInterval="), Settings.ReflectionsInterval);
+    FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+    Settings.bOcclusion = !FParse::Param(*Params, TEXT("NoOcclusion"));
+    Settings.bSpatialization = !FParse::Param(*Params, TEXT("NoSpatialization"));
+    Settings.bReverb = !FParse::Param(*Params, TEXT("NoReverb"));
+
+    FString ReportFileName;
+    FParse::Value(*Params, TEXT("Report="), ReportFileName);
+
+    FString OutputFileName;
+    FParse::Value(*Params, TEXT("Output="), OutputFileName);
+
+    FString BaselineFileName;
+    FParse::Value(*Params, TEXT("Baseline="), BaselineFileName);
+
+    float Tolerance = 0.0f;
+    FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+
+    bool bListenerScaling = FParse::Param(*Params, TEXT("ListenerScaling"));
+
+    FString MapName;
+    FParse::Value(*Params, TEXT("Map="), MapName);
+
+    bool bStaticGeometry = FParse::Param(*Params, TEXT("StaticGeometry"));
+
+    int32 NumChangedComponents = 16;
+    FParse::Value(*Params, TEXT("Changed="), NumChangedComponents);
+
+    int32 NumSources = 0;
+    FParse::Value(*Params, TEXT("Sources="), NumSources);
+
+    int32 NumTicks = 100;
+    FParse::Value(*Params, TEXT("Ticks="), NumTicks);
+
+    UWorld* World = nullptr;
+    if (!MapName.IsEmpty())
+    {
+        World = SteamAudio::LoadWorld(MapName);
+        if (!World)
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to load map: %s"), *MapName);
+            return 1;
+        }
+    }
+
+    ON_SCOPE_EXIT
+    {
+        if (World)
+        {
+            SteamAudio::UnloadWorld(World);
+        }
+    };
+
+    double StartTime = FPlatformTime::Seconds();
+
+    SteamAudio::FSteamAudioBenchmarkResult Result;
+    if (!SteamAudio::RunBenchmark(Settings, Result))
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Steam Audio benchmark failed."));
+        return 1;
+    }
+
+    double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("Steam Audio benchmark: %d voices, %d listeners, %d buffers of %d samples at %d Hz (%.1f s total):"),
+        Result.NumVoices, Result.NumListeners, Result.NumBuffers, Result.FrameSize, Result.SamplingRate, TotalSeconds);
+    LogTimings(TEXT("Occlusion"), Result.Occlusion);
+    LogTimings(TEXT("Spatialization"), Result.Spatialization);
+    LogTimings(TEXT("Reverb"), Result.Reverb);
+    LogTimings(TEXT("Reverb Submix"), Result.ReverbSubmix);
+    LogTimings(TEXT("Simulation"), Result.Simulation);
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("  Voices per core: %.1f (p50), %.1f (p99)"), Result.GetVoicesPerCore(50.0), Result.GetVoicesPerCore(99.0));
+
+    bool bSucceeded = true;
+
+    // Run again with each number of listeners, to see how the cost of simulation grows as players are added.
+    TArray<TSharedPtr<FJsonValue>> ListenerScalingReport;
+    if (bListenerScaling)
+    {
+        if (!Settings.Scene)
+        {
+            UE_LOG(LogSteamAudioEditor, Warning, TEXT("Listener scaling only measures simulation, which needs -Scene."));
+        }
+
+        UE_LOG(LogSteamAudioEditor, Display, TEXT("  Listener scaling:"));
+
+        double BaseMicroseconds = 0.0;
+        for (int32 NumListeners = 1; NumListeners <= SteamAudio::MaxListeners; ++NumListeners)
+        {
+            SteamAudio::FSteamAudioBenchmarkSettings ScalingSettings = Settings;
+            ScalingSettings.NumListeners = NumListeners;
+
+            SteamAudio::FSteamAudioBenchmarkResult ScalingResult;
+            if (!SteamAudio::RunBenchmark(ScalingSettings, ScalingResult))
+            {
+                UE_LOG(LogSteamAudioEditor, Error, TEXT("Steam Audio benchmark failed with %d listeners."), NumListeners);
+                bSucceeded = false;
+                break;
+            }
+
+            double Microseconds = ScalingResult.Simulation.GetPercentile(50.0);
+            if (NumListeners == 1)
+            {
+                BaseMicroseconds = Microseconds;
+            }
+
+            double Ratio = (BaseMicroseconds > 0.0) ? Microseconds / BaseMicroseconds : 0.0;
+
+            UE_LOG(LogSteamAudioEditor, Display, TEXT("    %d listeners: simulation p50 %8.2f us  p99 %8.2f us  (%.2fx one listener)"),
+                NumListeners, Microseconds, ScalingResult.Simulation.GetPercentile(99.0), Ratio);
+
+            TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+            Entry->SetNumberField(TEXT("listeners"), NumListeners);
+            Entry->SetObjectField(TEXT("simulation"), MakeTimingsReport(ScalingResult.Simulation));
+            Entry->SetNumberField(TEXT("costRelativeToOneListener"), Ratio);
+            ListenerScalingReport.Add(MakeShared<FJsonValueObject>(Entry));
+        }
+    }
+
+    // Rebuild the static geometry of the map in full and incrementally, to see what runtime geometry changes cost.
+    TArray<TSharedPtr<FJsonValue>> StaticGeometryReport;
+    if (bStaticGeometry)
+    {
+        if (!World)
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("The static geometry benchmark needs -Map."));
+            bSucceeded = false;
+        }
+        else if (!RunStaticGeometryBenchmark(World, NumChangedComponents, StaticGeometryReport))
+        {
+            bSucceeded = false;
+        }
+    }
+
+    // Tick the manager with many sources in the map, to see what each source costs on the game thread.
+    TSharedPtr<FJsonObject> SourcesReport;
+    if (NumSources > 0)
+    {
+        if (!World)
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("The source benchmark needs -Map."));
+            bSucceeded = false;
+        }
+        else if (!RunSourcesBenchmark(World, NumSources, NumTicks, SourcesReport))
+        {
+            bSucceeded = false;
+        }
+    }
+
+    if (!OutputFileName.IsEmpty() && !SaveOutput(Result.Output, OutputFileName))
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to write output: %s"), *OutputFileName);
+        bSucceeded = false;
+    }
+
+    TSharedPtr<FJsonObject> ComparisonReport;
+    if (!BaselineFileName.IsEmpty())
+    {
+        ComparisonReport = MakeShared<FJsonObject>();
+        ComparisonReport->SetStringField(TEXT("baseline"), BaselineFileName);
+        ComparisonReport->SetNumberField(TEXT("tolerance"), Tolerance);
+
+        TArray<float> Baseline;
+        if (LoadOutput(BaselineFileName, Baseline))
+        {
+            float MaxError = 0.0f;
+            int64 NumMismatches = SteamAudio::CompareBenchmarkOutputs(Result.Output, Baseline, Tolerance, MaxError);
+
+            ComparisonReport->SetNumberField(TEXT("mismatches"), NumMismatches);
+            ComparisonReport->SetNumberField(TEXT("maxError"), MaxError);
+            ComparisonReport->SetBoolField(TEXT("passed"), NumMismatches == 0);
+
+            if (NumMismatches == 0)
+            {
+                UE_LOG(LogSteamAudioEditor, Display, TEXT("  Output matches baseline %s (max error %g)."), *BaselineFileName, MaxError);
+            }
+            else
+            {
+                UE_LOG(LogSteamAudioEditor, Error, TEXT("Output differs from baseline %s in %lld samples (max error %g, tolerance %g)."),
+                    *BaselineFileName, NumMismatches, MaxError, Tolerance);
+                bSucceeded = false;
+            }
+        }
+        else
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to read baseline: %s"), *BaselineFileName);
+            ComparisonReport->SetBoolField(TEXT("passed"), false);
+            bSucceeded = false;
+        }
+    }
+
+    if (!ReportFileName.IsEmpty())
+    {
+        TSharedPtr<FJsonObject> Callbacks = MakeShared<FJsonObject>();
+        Callbacks->SetObjectField(TEXT("occlusion"), MakeTimingsReport(Result.Occlusion));
+        Callbacks->SetObjectField(TEXT("spatialization"), MakeTimingsReport(Result.Spatialization));
+        Callbacks->SetObjectField(TEXT("reverb"), MakeTimingsReport(Result.Reverb));
+        Callbacks->SetObjectField(TEXT("reverbSubmix"), MakeTimingsReport(Result.ReverbSubmix));
+        Callbacks->SetObjectField(TEXT("simulation"), MakeTimingsReport(Result.Simulation));
+
+        TSharedPtr<FJsonObject> VoicesPerCore = MakeShared<FJsonObject>();
+        VoicesPerCore->SetNumberField(TEXT("p50"), Result.GetVoicesPerCore(50.0));
+        VoicesPerCore->SetNumberField(TEXT("p99"), Result.GetVoicesPerCore(99.0));
+
+        TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+        Report->SetStringField(TEXT("trajectory"), TrajectoryFileName);
+        Report->SetStringField(TEXT("scene"), SceneName);
+        Report->SetStringField(TEXT("map"), MapName);
+        Report->SetNumberField(TEXT("samplingRate"), Result.SamplingRate);
+        Report->SetNumberField(TEXT("frameSize"), Result.FrameSize);
+        Report->SetNumberField(TEXT("voices"), Result.NumVoices);
+        Report->SetNumberField(TEXT("listeners"), Result.NumListeners);
+        Report->SetNumberField(TEXT("buffers"), Result.NumBuffers);
+        Report->SetNumberField(TEXT("seconds"), TotalSeconds);
+        Report->SetObjectField(TEXT("callbacks"), Callbacks);
+        Report->SetObjectField(TEXT("voicesPerCore"), VoicesPerCore);
+        if (bListenerScaling)
+        {
+            Report->SetArrayField(TEXT("listenerScaling"), ListenerScalingReport);
+        }
+        if (bStaticGeometry)
+        {
+            Report->SetArrayField(TEXT("staticGeometry"), StaticGeometryReport);
+        }
+
+        if (SourcesReport)
+        {
+            Report->SetObjectField(TEXT("sources"), SourcesReport);
+        }
+        if (ComparisonReport)
+        {
+            Report->SetObjectField(TEXT("comparison"), ComparisonReport);
+        }
+        Report->SetBoolField(TEXT("succeeded"), bSucceeded);
+
+        if (!WriteReport(Report, ReportFileName))
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to write report: %s"), *ReportFileName);
+            return 1;
+        }
+    }
+
+    return bSucceeded ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SteamAudioBenchmarkCommandlet.generated.h"
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioBenchmarkCommandlet
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Replays a recorded trajectory through the occlusion, spatialization, and reverb plugins with no audio device, and
+ * reports the time taken by each callback. Optionally compares the output audio against a baseline from an earlier
+ * run, so DSP changes can be checked for regressions.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=SteamAudioBenchmark [options] -nullrhi -nosound
+ *
+ * Options:
+ *   -Trajectory=<file>   Trajectory recorded with SteamAudio.RecordTrajectory. If not given, voices circle the listener.
+ *   -Scene=<asset>       Exported static geometry to simulate occlusion, transmission, and reflections against.
+ *   -Voices=<n>          Number of voices to play at once (default 32).
+ *   -Listeners=<n>       Number of listeners, as with local split-screen (default 1, at most 4). Extra listeners stand
+ *                        in a circle around the trajectory's listener, and each voice is rendered for the closest.
+ *   -Buffers=<n>         Number of audio buffers to process (default: the length of the trajectory).
+ *   -Warmup=<n>          Number of buffers processed before timing starts (default 8).
+ *   -ReflectionsInterval=<n>  Simulate reflections once every n buffers (default 4).
+ *   -Seed=<n>            Seed for the noise played by each voice (default 0).
+ *   -NoOcclusion, -NoSpatialization, -NoReverb   Skip a plugin.
+ *   -Report=<file>       Write a JSON report with timings for each callback.
+ *   -Output=<file>       Write the output audio (interleaved stereo, 32-bit float) to a file.
+ *   -Baseline=<file>     Compare the output audio against a file written with -Output, and fail if it differs.
+ *   -Tolerance=<x>       Largest allowed difference per sample when comparing (default 0, i.e., bit-exact).
+ *   -ListenerScaling     Also run with 1 to 4 listeners, and report how the cost of simulation grows.
+ *   -Map=<map>           Map to load for the static geometry benchmark.
+ *   -StaticGeometry      Also rebuild the static geometry of each level in -Map in full, and incrementally for a few
+ *                        changed components (as at runtime), and report both. Also export its Static Mesh geometry
+ *                        serially and in parallel, and report both.
+ *   -Changed=<n>         Number of changed components for -StaticGeometry (default 16).
+ *   -Sources=<n>         Also spawn n Steam Audio Sources around the listener in -Map, move them while ticking the
+ *                        Steam Audio Manager, and report the game thread time per tick.
+ *   -Ticks=<n>           Number of ticks for -Sources (default 100).
+ */
+UCLASS()
+class USteamAudioBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USteamAudioBenchmarkCommandlet();
+
+    /**
+     * Inherited from UCommandlet
+     */
+
+    /** Runs the commandlet. */
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,77 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#include "SteamAudioCommandletHelpers.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/World.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Commandlet Helpers
+// ---------------------------------------------------------------------------------------------------------------------
+
+UWorld* LoadWorld(const FString& MapName)
+{
+    UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+    UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+    if (!World)
+        return nullptr;
+
+    World->WorldType = EWorldType::Editor;
+    World->AddToRoot();
+
+    if (!World->bIsWorldInitialized)
+    {
+        UWorld::InitializationValues InitializationValues;
+        InitializationValues.RequiresHitProxies(false)
+            .ShouldSimulatePhysics(false)
+            .EnableTraceCollision(false)
+            .CreateNavigation(false)
+            .CreateAISystem(false)
+            .AllowAudioPlayback(false)
+            .CreatePhysicsScene(true);
+
+        World->InitWorld(InitializationValues);
+    }
+
+    World->UpdateWorldComponents(true, false);
+
+    // Load all sublevels, since each one can have its own static geometry and probe volumes.
+    for (ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+    {
+        if (StreamingLevel)
+        {
+            StreamingLevel->SetShouldBeLoaded(true);
+            StreamingLevel->SetShouldBeVisible(true);
+        }
+    }
+
+    World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+
+    return World;
+}
+
+void UnloadWorld(UWorld* World)
+{
+    World->DestroyWorld(false);
+    World->RemoveFromRoot();
+
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+}
@@ -0,0 +1,41 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#pragma once
+
+#include "SteamAudioEditorModule.h"
+
+class UWorld;
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Commandlet Helpers
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Loads the given map and all of its sublevels, with their components registered, for use by a commandlet. Returns
+ * null if the map could not be loaded.
+ */
+UWorld* LoadWorld(const FString& MapName);
+
+/**
+ * Destroys a world loaded with LoadWorld, and collects garbage.
+ */
+void UnloadWorld(UWorld* World);
+
+}
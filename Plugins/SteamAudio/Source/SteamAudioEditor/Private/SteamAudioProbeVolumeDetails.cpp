@@ -70,6 +70,10 @@ void FSteamAudioProbeVolumeDetails::CustomizeDetails(IDetailLayoutBuilder& Detai
 	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, GenerationType));
 	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, HorizontalSpacing));
 	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, HeightAboveFloor));
+	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, bAdaptiveSpacing));
+	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, MinHorizontalSpacing));
+	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, MaxHorizontalSpacing));
+	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, BakedDataCompression));
 
     DetailLayout.EditCategory("ProbeBatchSettings").AddCustomRow(NSLOCTEXT("SteamAudio", "GenerateProbes", "Generate Probes"))
         .NameContent()
@@ -110,7 +114,24 @@ void FSteamAudioProbeVolumeDetails::CustomizeDetails(IDetailLayoutBuilder& Detai
         ];
 
 	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, NumProbes));
+	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, NumUniformProbes));
+
+    DetailLayout.EditCategory("ProbeBatchSettings").AddCustomRow(NSLOCTEXT("SteamAudio", "AdaptiveSavings", "Adaptive Savings"))
+        .NameContent()
+        [
+            SNew(STextBlock)
+            .Text(NSLOCTEXT("SteamAudio", "AdaptiveSavings", "Adaptive Savings"))
+            .Font(IDetailLayoutBuilder::GetDetailFont())
+        ]
+        .ValueContent()
+        .MinDesiredWidth(200)
+        [
+            SNew(STextBlock)
+            .Text(this, &FSteamAudioProbeVolumeDetails::GetAdaptiveSavingsText)
+            .Font(IDetailLayoutBuilder::GetDetailFont())
+        ];
 	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, DataSize));
+	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, CompressedDataSize));
 
     TSharedPtr<IPropertyHandle> DetailedStatsProperty = DetailLayout.GetProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, DetailedStats));
     TSharedRef<FDetailArrayBuilder> DetailedStatsArrayBuilder = MakeShareable(new FDetailArrayBuilder(DetailedStatsProperty.ToSharedRef()));
@@ -177,6 +198,26 @@ void FSteamAudioProbeVolumeDetails::OnGenerateDetailedStats(TSharedRef<IProperty
 			];
 }
 
+FText FSteamAudioProbeVolumeDetails::GetAdaptiveSavingsText() const
+{
+    if (!ProbeVolume.IsValid() || ProbeVolume->NumProbes <= 0 || ProbeVolume->NumUniformProbes <= 0)
+        return NSLOCTEXT("SteamAudio", "AdaptiveSavingsNone", "No probes generated");
+
+    int32 NumProbesRemoved = ProbeVolume->NumUniformProbes - ProbeVolume->NumProbes;
+    if (NumProbesRemoved <= 0)
+        return NSLOCTEXT("SteamAudio", "AdaptiveSavingsNoReduction", "No fewer probes than uniform spacing");
+
+    FText ProbeReduction = FText::Format(NSLOCTEXT("SteamAudio", "AdaptiveSavingsProbes", "{0} fewer probes ({1})"),
+        FText::AsNumber(NumProbesRemoved), FText::AsPercent(static_cast<float>(NumProbesRemoved) / ProbeVolume->NumUniformProbes));
+
+    float BakeSecondsSaved = ProbeVolume->GetEstimatedBakeSecondsSaved();
+    if (BakeSecondsSaved <= 0.0f)
+        return ProbeReduction;
+
+    return FText::Format(NSLOCTEXT("SteamAudio", "AdaptiveSavingsBakeTime", "{0}, ~{1} bake time saved"),
+        ProbeReduction, FText::FromString(FTimespan::FromSeconds(BakeSecondsSaved).ToString(TEXT("%h:%m:%s"))));
+}
+
 void FSteamAudioProbeVolumeDetails::OnClearBakedDataLayer(const int32 ArrayIndex)
 {
     IPLContext Context = SteamAudio::FSteamAudioModule::GetManager().GetContext();
@@ -201,8 +242,10 @@ void FSteamAudioProbeVolumeDetails::OnClearBakedDataLayer(const int32 ArrayIndex
         {
             iplProbeBatchSave(ProbeBatch, SerializedObject);
 
-            ProbeVolume->Asset = USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, ProbeVolume->Asset.GetAssetPathString());
-            ProbeVolume->UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject));
+            USteamAudioSerializedObject* AssetObject = USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, ProbeVolume->Asset.GetAssetPathString(),
+                {}, {}, FString(), ProbeVolume->GetCompressionFormat());
+            ProbeVolume->Asset = AssetObject;
+            ProbeVolume->UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject), AssetObject ? AssetObject->GetStoredDataSize() : 0);
             ProbeVolume->RemoveLayer(Info.Name);
             ProbeVolume->MarkPackageDirty();
 
@@ -281,8 +324,10 @@ FReply FSteamAudioProbeVolumeDetails::OnClearBakedData()
         {
             iplProbeBatchSave(ProbeBatch, SerializedObject);
 
-            ProbeVolume->Asset = USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, ProbeVolume->Asset.GetAssetPathString());
-            ProbeVolume->UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject));
+            USteamAudioSerializedObject* AssetObject = USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, ProbeVolume->Asset.GetAssetPathString(),
+                {}, {}, FString(), ProbeVolume->GetCompressionFormat());
+            ProbeVolume->Asset = AssetObject;
+            ProbeVolume->UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject), AssetObject ? AssetObject->GetStoredDataSize() : 0);
             ProbeVolume->ResetLayers();
             ProbeVolume->MarkPackageDirty();
 
@@ -41,6 +41,7 @@ private:
 
     void OnGenerateDetailedStats(TSharedRef<IPropertyHandle> PropertyHandle, int32 ArrayIndex, IDetailChildrenBuilder& ChildrenBuilder);
     void OnClearBakedDataLayer(const int32 ArrayIndex);
+    FText GetAdaptiveSavingsText() const;
 
     FReply OnGenerateProbes();
     FReply OnClearBakedData();
@@ -29,6 +29,7 @@ public class SteamAudioEditor : ModuleRules
             "CoreUObject",
             "Engine",
             "InputCore",
+            "Json",
             "Projects",
             "PropertyEditor",
             "Slate",